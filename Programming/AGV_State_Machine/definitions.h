@@ -27,6 +27,17 @@
 #include <SimplePWM.h>              // Motors
 #include <SimpleTimer.h>            // Control time
 #include <algorithm>                // Process data
+#include <EchoArray.h>              // Non-blocking ultrasonic ranging, sensors pinging in turns
+#include <SpeedGovernor.h>          // Range tracking and time to collision speed
+#include <StateMachine.h>           // Transition table state machine
+#include <AgvPipeline.h>            // Sensing/control snapshot handoff
+#include <LineController.h>         // Timer driven line following PID
+#include <ComLink.h>                // Framed messages on the communication wire
+#include <TelemetryLog.h>           // Binary event log drained by a background task
+#include <Instrumentation.h>        // Timing probes, compiled out with INSTRUMENTATION=0
+#include <SensorTrace.h>            // Raw sensor samples for host replay, SENSOR_TRACE=1
+#include <PinMap.h>                 // Pin map checked by the compiler
+#include <driver/uart.h>            // Telemetry and sensor trace output
 
 //GPIO pins
 //  DC motor
@@ -36,8 +47,12 @@
 #define LINE_FOLLOWER1_GPIO 33
 #define LINE_FOLLOWER2_GPIO 32
 //  Collision avoidance
-#define COLL_AVOIDANCE1_TRIG_GPIO 17
+#define COLL_AVOIDANCE1_TRIG_GPIO 17 // Front
 #define COLL_AVOIDANCE1_ECHO_GPIO 18
+#define COLL_AVOIDANCE2_TRIG_GPIO 13 // Left
+#define COLL_AVOIDANCE2_ECHO_GPIO 34
+#define COLL_AVOIDANCE3_TRIG_GPIO 14 // Right
+#define COLL_AVOIDANCE3_ECHO_GPIO 35
 //  Comm sensor
 #define COMM_SENSOR_GPIO 16
 // LEDs to indicate phases
@@ -45,6 +60,38 @@
 #define RED_LED_GPIO 4 // Check with teammate the number
 // Switch button to change agv state
 #define GOLPE_AVISA_GPIO 15
+//  Telemetry (binary records, decode with telemetry_decode)
+#define TELEMETRY_UART UART_NUM_1
+#define TELEMETRY_TX_GPIO 23
+#define TELEMETRY_BAUD 921600
+//  Sensor trace (SENSOR_TRACE=1, replay with agv_replay)
+#define SENSOR_TRACE_UART UART_NUM_2
+#define SENSOR_TRACE_TX_GPIO 19
+#define SENSOR_TRACE_BAUD 921600
+//  Console (printf)
+#define CONSOLE_TX_GPIO 1
+
+//Pin map: every pin above, the build stops on a pin used twice or beyond its pad (PinMap.h)
+constexpr PinSpec agvPins[] = {
+    {DCMOTOR1_GPIO, PIN_PWM, "DC motor 1"},
+    {DCMOTOR2_GPIO, PIN_PWM, "DC motor 2"},
+    {LINE_FOLLOWER1_GPIO, PIN_INPUT, "Line follower 1"},
+    {LINE_FOLLOWER2_GPIO, PIN_INPUT, "Line follower 2"},
+    {COLL_AVOIDANCE1_TRIG_GPIO, PIN_OUTPUT, "Front ultrasonic trigger"},
+    {COLL_AVOIDANCE1_ECHO_GPIO, PIN_INPUT, "Front ultrasonic echo"},
+    {COLL_AVOIDANCE2_TRIG_GPIO, PIN_OUTPUT, "Left ultrasonic trigger"},
+    {COLL_AVOIDANCE2_ECHO_GPIO, PIN_INPUT, "Left ultrasonic echo"},
+    {COLL_AVOIDANCE3_TRIG_GPIO, PIN_OUTPUT, "Right ultrasonic trigger"},
+    {COLL_AVOIDANCE3_ECHO_GPIO, PIN_INPUT, "Right ultrasonic echo"},
+    {COMM_SENSOR_GPIO, PIN_OUTPUT, "Communication sensor"},
+    {GREEN_LED_GPIO, PIN_OUTPUT, "Green LED"},
+    {RED_LED_GPIO, PIN_OUTPUT, "Red LED"},
+    {GOLPE_AVISA_GPIO, PIN_INPUT, "State button"},
+    {TELEMETRY_TX_GPIO, PIN_UART_TX, "Telemetry"},
+    {SENSOR_TRACE_TX_GPIO, PIN_UART_TX, "Sensor trace"},
+    {CONSOLE_TX_GPIO, PIN_UART_TX, "Console"},
+};
+static_assert(kPinMapChecked<agvPins>);
 
 //Object creation
 //  DC Motor
@@ -53,15 +100,29 @@ SimplePWM dcMotor_2;
 //  Line follower
 SimpleGPIO lineFollower_1;
 SimpleGPIO lineFollower_2;
-//  Collision avoidance
-SimpleGPIO colliAvoidance_1_trig;
-SimpleGPIO colliAvoidance_1_echo;
+LineController lineControl;
+//  Collision avoidance: the front sensor pings alone, left and right face away from each other and ping together
+const EchoSensorPins colliAvoidancePins[] = {
+    {COLL_AVOIDANCE1_TRIG_GPIO, COLL_AVOIDANCE1_ECHO_GPIO, 0},
+    {COLL_AVOIDANCE2_TRIG_GPIO, COLL_AVOIDANCE2_ECHO_GPIO, 1},
+    {COLL_AVOIDANCE3_TRIG_GPIO, COLL_AVOIDANCE3_ECHO_GPIO, 1},
+};
+EchoArray colliAvoidance;
+RangeTracker rangeTracker;
+SpeedGovernor speedGovernor;
 //  Communication sensor
 SimpleGPIO agvComSensor;
+ComTransmitter agvComLink;
 // LEDs
 SimpleGPIO greenLed;
 SimpleGPIO redLed;
 // Button
 SimpleGPIO golpeAvisa;
+// Sensing core to control core handoff
+TripleBuffer<AgvSnapshot> sensorBuffer;
+// Event log of the control loop
+TelemetryLog telemetry;
+// Every sensor sample, when built with SENSOR_TRACE=1
+SensorRecorder sensorTrace;
 
 #endif // _DEFINITIONS_H_
\ No newline at end of file
@@ -4,11 +4,25 @@
  * Author: Oscar Gadiel Ramo Martínez
  * Description:
  *   Implements the finite state machine for the AGV, including:
- *     - Line follower logic
- *     - Collision avoidance using ultrasonic sensors
- *     - Communication sensor signaling
+ *     - Sensing task on one core handing snapshots to the control loop on the
+ *       other through a lock-free TripleBuffer
+ *     - Line following PID running at 500 Hz from a timer (LineController)
+ *     - Collision avoidance using front, left and right ultrasonic sensors
+ *       (non-blocking EchoArray, groups pinging in turns against crosstalk),
+ *       the nearest reading tracked by an alpha-beta filter and the duty
+ *       set from the time to collision (SpeedGovernor)
+ *     - Status frames to the lift over the communication wire (coupled,
+ *       obstacle, arrived, abort), sent on changes and repeated
+ *     - Binary telemetry log (obstacle changes, every control cycle, sent
+ *       frames) drained to a spare UART by a low-priority task, instead of
+ *       printf in the control loop
+ *     - Optional sensor trace (SENSOR_TRACE=1): every line sensor, echo,
+ *       button and wire sample to a second UART, for agv_replay
+ *     - Timing probes: time in each state, sensing and control loop
+ *       jitter, printed at the end (INSTRUMENTATION=0 removes them)
  *     - LED indicators for status feedback
  *     - State transitions (setup, movement without collision sensors, movement with collision sensors)
+ *       as a StateMachine transition table
  *
  * Date: June 2025
  * License: MIT (see LICENSE file in repository)
@@ -17,96 +31,106 @@
 #include <definitions.h>
 
 // Constant definitions
-#define MIN_DISTANCE 30 // cm
-#define MAX_DISTANCE 10 // cm
-#define SOUND_AIR_SPEED 343 // m/s
+#define STOP_DISTANCE 10 // cm, gap kept when stopped in front of an obstacle
+#define TTC_MARGIN_MS 1000 // Time to reach the stop gap never shorter than this
+#define BRAKE_DECEL 60 // cm/s^2, braking the drive train can do
+#define AIR_TEMPERATURE_C 20 // Aisle air, sets the sound speed
+#define SENSING_PERIOD_MS 10 // Sensing task period, one FreeRTOS tick at 100 Hz
+#define CONTROL_PERIOD_MS 10 // Control loop period
+#define LINE_PERIOD_US 2000 // Line following PID period, 500 Hz
+#define CRUISE_DUTY 50 // Duty percentage on straight line
+#define OPEN_AISLE_DUTY 80 // Duty percentage with the collision sensors on and nothing ahead
+#define DRIVE_CM_S_PER_DUTY 0.4 // AGV speed per duty percentage
+#define DRIVE_LAG_MS 150 // Drive train time constant
+#define COM_REPEAT_MS 500 // Status frame repeat period, recovers a frame lost to noise
 
-enum states {state0, state1, state2};
+enum states {state0, state1, state2, stateDone, stateFault, stateCount};
+enum events {success, failure, eventCount};
 
-// SUPPORT-FUNCTIONS
-// Line Follower
-bool lineFollowerLogic(int a, int b) {
-    switch ((a << 1) | b) {
-        case 0b00: // Both sensors off
-            dcMotor_1.setDuty(00);
-            dcMotor_2.setDuty(00);
-            comSensorObstacleLogic(3);
-            return true;
-            break;
-        case 0b01: // Left On, Right Off
-            dcMotor_1.setDuty(25);
-            dcMotor_2.setDuty(75);
-            return false;
-            break;
-        case 0b10: // Left Off, Right On
-            dcMotor_1.setDuty(75);
-            dcMotor_2.setDuty(25);
-            return false;
-            break;
-        case 0b11: // Both sensors on
-            dcMotor_1.setDuty(50);
-            dcMotor_2.setDuty(50);
-            return false;
-            break;
-    }
+// Timing probes
+const char *const stateNames[stateCount] = {"setup", "move", "move_collision", "done", "fault"};
+StateTimer<stateCount> stateTimes("state", stateNames);
+PeriodProbe sensingLoop("sensing_loop", SENSING_PERIOD_MS * 1000);
+PeriodProbe controlLoop("control_loop", CONTROL_PERIOD_MS * 1000);
 
-}
+// Forward declarations
+void comSensorObstacleLogic(int com_State, float distance = -1);
+void sensingTask(void *arg);
 
+// SUPPORT-FUNCTIONS
 // Collision Avoidance
-float read_distance(SimpleGPIO &trig, SimpleGPIO &echo) {
-    int64_t start_time = 0, end_time = 0, delta_time;
-    float distance;
-    // Activate trig
-    trig.set(0);
-    ets_delay_us(2); // Short delay
-    trig.set(1);
-    ets_delay_us(10); // 10 us high pulse
-    trig.set(0);
-    // Echo readings
-    while (echo.get() == 0);
-    start_time = esp_timer_get_time(); //Wait for echo to go high
-    while (echo.get() == 1);
-    end_time = esp_timer_get_time(); // Wait for echo to go low (signal complete)
-    delta_time = end_time - start_time;
-    if (delta_time > 0) distance = (delta_time * 1e-6 * SOUND_AIR_SPEED * 100) / 2; // us to seconds    
-    else return -1; // Invalid distance
-    return distance;
-          
-}
-
-void collisionAvoidanceLogic(float distance) {
-    const float m = 50/(MIN_DISTANCE - MAX_DISTANCE);
-    const float b = -m * MAX_DISTANCE;
-    int percentage = static_cast<int>(m * distance + b);
-    percentage = std::clamp(percentage, 0, 100); // Ensure percentage is within 0-100
-    dcMotor_1.setDuty(percentage);
-    dcMotor_2.setDuty(percentage);
+void read_distance(EchoArray &array, AgvSnapshot &snapshot) {
+    EchoSample nearest = array.nearest(); // Closest newest measurement of any sensor, never waits for an echo
+    rangeTracker.update(nearest); // Only new samples move the track
+    RangeEstimate range = rangeTracker.at(snapshot.timestamp_us);
+    snapshot.distance = nearest.distance_cm;
+    snapshot.range_cm = range.distance_cm;
+    snapshot.closing_cm_s = range.closing_cm_s;
+}
+
+int collisionAvoidanceLogic(const AgvSnapshot &snapshot) {
+    int percentage = speedGovernor.update({snapshot.range_cm, snapshot.closing_cm_s, snapshot.timestamp_us});
+    lineControl.setSpeed(percentage); // Steering keeps running at the governed speed
+    return percentage;
 }
 
 // Communication Sensor
-void comSensorObstacleLogic(int com_State, bool obstacleDetected = false) {
-    // Communication sensor blink variables
-    static bool blinkState = false; // Blink state
-    static int64_t lastBlink = 0; // Last blink time
-    int64_t now;
+// States: 1 coupled, 2 moving (obstacle when distance >= 0), 3 arrived, 4 aborted
+void comSensorObstacleLogic(int com_State, float distance) {
+    static ComMessageType lastType = COM_NONE; // Last status sent
+    static int64_t lastSent = 0; // Last frame time
+    ComMessage msg = {COM_COUPLED, 0, 0};
     switch (com_State) {
-        case 1:
-            agvComSensor.set(1);
-            break;
         case 2:
-            now = esp_timer_get_time() / 1000; // Get current time in milliseconds
-            if (obstacleDetected && (now - lastBlink > 200)) {
-                blinkState = !blinkState; // Toggle blink state
-                agvComSensor.set(blinkState); // Toggle signal
-                lastBlink = now; // Update last blink time
-            }
-            else if (obstacleDetected == false) agvComSensor.set(1);
+            if (distance >= 0) msg = {COM_OBSTACLE, static_cast<uint16_t>(distance), 0};
             break;
         case 3:
-            agvComSensor.set(0);
+            msg.type = COM_ARRIVED;
+            break;
+        case 4:
+            msg.type = COM_ABORT;
             break;
     }
+    int64_t now = esp_timer_get_time() / 1000; // Get current time in milliseconds
+    if (msg.type == lastType && now - lastSent < COM_REPEAT_MS) return; // Unchanged, repeat later
+    if (agvComLink.send(msg)) {
+        telemetry.log(TLM_COM_SENT, msg.type, msg.value);
+        lastType = msg.type;
+        lastSent = now;
+    }
+}
+
+// Telemetry
+void telemetrySink(const uint8_t *data, size_t length) {
+    uart_write_bytes(TELEMETRY_UART, data, length); // Copied to the driver's TX buffer
+}
+
+bool telemetrySetup() {
+    const uart_config_t config = {TELEMETRY_BAUD, UART_DATA_8_BITS, UART_PARITY_DISABLE, UART_STOP_BITS_1,
+                                  UART_HW_FLOWCTRL_DISABLE, 0, UART_SCLK_DEFAULT};
+    if (uart_param_config(TELEMETRY_UART, &config) != ESP_OK) return false;
+    if (uart_set_pin(TELEMETRY_UART, TELEMETRY_TX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) return false;
+    if (uart_driver_install(TELEMETRY_UART, 256, 2048, 0, NULL, 0) != ESP_OK) return false; // RX unused, 2 KB TX buffer
+    return telemetry.setup(telemetrySink); // Drain task, every 20 ms
+}
+
+// Sensor trace
+#if SENSOR_TRACE
+void sensorTraceSink(const uint8_t *data, size_t length) {
+    uart_write_bytes(SENSOR_TRACE_UART, data, length); // Copied to the driver's TX buffer
+}
+
+bool sensorTraceSetup() {
+    const uart_config_t config = {SENSOR_TRACE_BAUD, UART_DATA_8_BITS, UART_PARITY_DISABLE, UART_STOP_BITS_1,
+                                  UART_HW_FLOWCTRL_DISABLE, 0, UART_SCLK_DEFAULT};
+    if (uart_param_config(SENSOR_TRACE_UART, &config) != ESP_OK) return false;
+    if (uart_set_pin(SENSOR_TRACE_UART, SENSOR_TRACE_TX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) return false;
+    if (uart_driver_install(SENSOR_TRACE_UART, 256, 4096, 0, NULL, 0) != ESP_OK) return false; // RX unused, 4 KB TX buffer
+    if (!sensorTrace.setup(sensorTraceSink)) return false; // Drain task, every 10 ms
+    sensorTrace.start(); // Before the first sensor is read
+    return true;
 }
+#endif
 
 // Function for led blinking
 void ledBlink(SimpleGPIO &sensor, int repetition, int duration) {
@@ -120,99 +144,173 @@ void ledBlink(SimpleGPIO &sensor, int repetition, int duration) {
 
 // MAIN FUNCTIONS
 bool setup() {
+    if (!telemetrySetup()) return false;
+#if SENSOR_TRACE
+    if (!sensorTraceSetup()) return false;
+#endif
     lineFollower_1.setup(LINE_FOLLOWER1_GPIO, GPI); // GPIO, input mode, default pull
     lineFollower_2.setup(LINE_FOLLOWER2_GPIO, GPI); // GPIO, input mode, default pull
     dcMotor_1.setup(DCMOTOR1_GPIO, 0); // GPIO, channel, else = default setup
     dcMotor_2.setup(DCMOTOR2_GPIO, 1); // GPIO, channel, else = default setup
-    colliAvoidance_1_trig.setup(COLL_AVOIDANCE1_TRIG_GPIO, GPIO); // GPIO, output mode, default pull
-    colliAvoidance_1_echo.setup(COLL_AVOIDANCE1_ECHO_GPIO, GPI); // GPIO, input mode, default pull
+    int rangers = sizeof(colliAvoidancePins) / sizeof(colliAvoidancePins[0]);
+    if (!colliAvoidance.setup(colliAvoidancePins, rangers, EchoRanger::soundSpeed_m_s(AIR_TEMPERATURE_C))) return false; // Pin list, count, sound speed
+    rangeTracker.setup(); // Default alpha-beta gains, nothing ahead past 4 m
+    speedGovernor.setup({STOP_DISTANCE, TTC_MARGIN_MS / 1000.0f, BRAKE_DECEL, DRIVE_CM_S_PER_DUTY, DRIVE_LAG_MS / 1000.0f, OPEN_AISLE_DUTY});
     agvComSensor.setup(COMM_SENSOR_GPIO, GPIO); // GPIO pin, input mode, default pull
+    if (!agvComLink.setup(agvComSensor)) return false; // Idle low, 1 ms Manchester bits
     greenLed.setup(GREEN_LED_GPIO, GPO); // GPIO pin, output mode, default pull
     redLed.setup(RED_LED_GPIO, GPO); // GPIO pin, output mode, default pull
     golpeAvisa.setup(GOLPE_AVISA_GPIO, GPI); // GPIO pin, input mode, default pull
-    return true;
+    // Left, right sensor; motor 1 drives the right wheel, motor 2 the left one
+    if (!lineControl.setup(lineFollower_1, lineFollower_2, dcMotor_1, dcMotor_2, LineGains(), LINE_PERIOD_US)) return false;
+    // Sensing on its own core, control stays with app_main
+    BaseType_t created = xTaskCreatePinnedToCore(sensingTask, "agv_sensing", 4096, NULL, 5, NULL, AGV_SENSING_CORE);
+    return created == pdPASS;
+}
+
+// SENSING CORE
+// Reads every sensor and hands the snapshot to the control loop, never blocks on it
+void sensingTask(void *arg) {
+    AgvSnapshot snapshot = {};
+    while(true) {
+        sensingLoop.tick();
+        snapshot.lineLeft = sensorTraceGet(lineFollower_1);
+        snapshot.lineRight = sensorTraceGet(lineFollower_2);
+        snapshot.button = sensorTraceGet(golpeAvisa);
+        snapshot.timestamp_us = esp_timer_get_time();
+        read_distance(colliAvoidance, snapshot); // Nearest ranging sample and the track, -1 if none
+        snapshot.seq++;
+        sensorBuffer.publish(snapshot);
+        vTaskDelay(pdMS_TO_TICKS(SENSING_PERIOD_MS));
+    }
 }
 
+// CONTROL CORE
 int move_agv(int agv_state) {
     // Variables defined
-    float distance;
+    AgvSnapshot snapshot; // Latest sensor readings from the sensing core
+    LatencyStats latency; // Sensor read to duty update
+    float distance = -1; // No reading until the collision sensor is enabled
     bool obstacleDetected = false;
-    bool read_collision;
-    bool exit;
+    bool lastObstacle = false; // Last logged obstacle state
+    int speed = CRUISE_DUTY; // Duty percentage set by the collision avoidance
+    bool read_collision = false;
+    int c = 0;
     // AGV moving state
     switch (agv_state) {
         case 1:
             read_collision = false;
-            comSensorObstacleLogic(1);
             break;
         case 2:
             read_collision = true;
+            speedGovernor.reset(); // Starting from standstill
+            colliAvoidance.start(); // Ranging runs in the background from now on
             break;
     }
-    // Initialize motors
-    dcMotor_1.setDuty(50); // Duty percentage
-    dcMotor_2.setDuty(50); // Duty percentage
-    // Infinite loop
-    while(true) {
-        // Readings
-        int a = lineFollower_1.get(); //int a = gpio_get_level((gpio_num_t)LINE_FOLLOWER1_GPIO);
-        int b = lineFollower_2.get(); //int b = gpio_get_level((gpio_num_t)LINE_FOLLOWER2_GPIO);
-        int c = golpeAvisa.get();
-        if (read_collision == true) distance = read_distance(colliAvoidance_1_trig, colliAvoidance_1_echo);
-        // Infrarred sensors
-        exit = lineFollowerLogic(a, b);
-        if (exit == true) return 1;
+    // Steering runs on its own timer until the next station mark
+    lineControl.start(CRUISE_DUTY);
+    // Control loop, runs once per fresh snapshot
+    controlLoop.restart();
+    while(lineControl.atMark() == false && c != 1) {
+        controlLoop.tick();
+        if (sensorBuffer.read(snapshot) == false) {
+            vTaskDelay(pdMS_TO_TICKS(CONTROL_PERIOD_MS));
+            continue;
+        }
+        c = snapshot.button;
         // Collision Avoidance Sensors
-        if (distance <= MIN_DISTANCE && distance >= MAX_DISTANCE) {
-            printf("Obstacle detected! At %.2f\n", distance);
-            collisionAvoidanceLogic(distance);
-            obstacleDetected = true;
-            comSensorObstacleLogic(2, obstacleDetected);
+        if (read_collision == true) {
+            distance = snapshot.range_cm;
+            speed = collisionAvoidanceLogic(snapshot);
+            obstacleDetected = speedGovernor.limiting(); // Slower than the open aisle because of something ahead
+            if (obstacleDetected == true) comSensorObstacleLogic(2, distance);
+            else comSensorObstacleLogic(2);
         }
-        else if (distance > MIN_DISTANCE) {
-            printf("No obstacle nearby! Distance is %.2f\n", distance);
-            obstacleDetected = false;
-            comSensorObstacleLogic(2, obstacleDetected);
+        int64_t cycleLatency = esp_timer_get_time() - snapshot.timestamp_us;
+        latency.add(cycleLatency);
+        // Binary records only, formatted on the host by telemetry_decode
+        if (read_collision == true) {
+            telemetry.log(TLM_AGV_CYCLE, tlmFloat(distance), static_cast<int32_t>(cycleLatency));
+            if (obstacleDetected != lastObstacle) {
+                if (obstacleDetected == true) telemetry.log(TLM_AGV_OBSTACLE, tlmFloat(distance), speed);
+                else telemetry.log(TLM_AGV_CLEAR, tlmFloat(distance));
+                lastObstacle = obstacleDetected;
+            }
         }
-        else obstacleDetected = false;
-        // Switch button
-        if (c == 1) return c;
-        vTaskDelay(pdMS_TO_TICKS(500));
+        vTaskDelay(pdMS_TO_TICKS(CONTROL_PERIOD_MS));
     }
+    bool atMark = lineControl.atMark();
+    bool lineLost = lineControl.lost();
+    lineControl.stop();
+    colliAvoidance.stop();
+    if (atMark == false) comSensorObstacleLogic(4); // Stopped by the switch button
+    else if (lineLost == true) comSensorObstacleLogic(4); // Line lost: not a station, the lift must not go on
+    else if (agv_state == 1) comSensorObstacleLogic(1); // Under the lift: coupled
+    else comSensorObstacleLogic(3); // Unloading station
+    const LoopJitter &jitter = lineControl.jitter();
+    printf("Sensor-to-PWM latency: avg %lld us, max %lld us over %lld cycles\n", static_cast<long long>(latency.average_us()),
+           static_cast<long long>(latency.max_us), static_cast<long long>(latency.count));
+    printf("Line PID jitter: avg %lld us, max %lld us over %lld steps\n", static_cast<long long>(jitter.average_us()),
+           static_cast<long long>(jitter.maxDeviation_us), static_cast<long long>(jitter.count));
+    if (lineLost == true) {
+        printf("Line lost, stopped before a station\n");
+        return 0;
+    }
+    return 1; // End of line or switch button
+}
+
+bool move_without_collision() {
+    return move_agv(1) == 1;
 }
 
+bool move_with_collision() {
+    return move_agv(2) == 1;
+}
+
+// STATE MACHINE
+// Transition actions
+void greenBlink() {
+    ledBlink(greenLed, 1, 1000);
+}
+
+void redBlink() {
+    ledBlink(redLed, 1, 2000);
+}
+
+// Timing hook: where the cycle time goes
+void logTransition(const TransitionTiming<states, events> &t) {
+    stateTimes.record(t.from, t.stateTime_us);
+    printf("State %d -> %d after %lld ms (action %lld ms)\n", t.from, t.to,
+           static_cast<long long>(t.stateTime_us / 1000), static_cast<long long>(t.actionTime_us / 1000));
+}
+
+// Work done in each state, indexed by state
+bool (*const stateWork[])() = {setup, move_without_collision, move_with_collision};
+
+constexpr Transition<states, events> agvTransitions[] = {
+    {state0, success, state1, nullptr, greenBlink},         // Setup all components
+    {state0, failure, stateFault, nullptr, redBlink},
+    {state1, success, state2, nullptr, greenBlink},         // Move AGV without collision sensors
+    {state1, failure, stateFault, nullptr, nullptr},
+    {state2, success, stateDone, nullptr, greenBlink},      // Move AGV with collision sensors
+    {state2, failure, stateFault, nullptr, nullptr},
+};
+constexpr auto agvTable = makeTable<stateCount, eventCount>(agvTransitions);
+static_assert(sizeof(stateWork) / sizeof(stateWork[0]) == stateDone, "Every working state needs a work function");
+
 extern "C" void app_main() {
-    int next_state;
-    bool good;
-    states state = state0;
-    for (int i = 0; i < 3; i++) {
-        switch (state) {
-            case state0: // Setup all components
-                good = setup();
-                if (good == true) {
-                    ledBlink(greenLed, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    break;
-                }
-                else {
-                    ledBlink(redLed, 1, 2000);
-                    exit(0);
-                }
-            case state1: //Move AGV without collision sensors
-                next_state = move_agv(1);
-                if (next_state == 1) {
-                    ledBlink(greenLed, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    break;
-                }
-                else exit(0);
-            case state2: //Move AGV without collision sensors
-                next_state = move_agv(2);
-                if (next_state == 1) {
-                    ledBlink(greenLed, 1, 1000);
-                    exit(0);
-                    break;
-                }
-        }
+    StateMachine<agvTable> fsm(state0, logTransition);
+    while (fsm.state() < stateDone) {
+        bool good = stateWork[fsm.state()]();
+        fsm.dispatch(good ? success : failure);
     }
+    TimingProbe::dumpAll();
+    telemetry.flush(); // Last records out before the program ends
+    uart_wait_tx_done(TELEMETRY_UART, pdMS_TO_TICKS(100));
+#if SENSOR_TRACE
+    sensorTrace.stop();
+    sensorTrace.flush();
+    uart_wait_tx_done(SENSOR_TRACE_UART, pdMS_TO_TICKS(100));
+#endif
+    exit(0);
 }
\ No newline at end of file
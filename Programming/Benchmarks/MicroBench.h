@@ -0,0 +1,260 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: MicroBench.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Small micro-benchmark harness for the host:
+ *     - BenchSuite: sizes a batch of each case to about 2 ms, warms
+ *       them up, then times the batches round robin; each result is the
+ *       median time per call with its median absolute deviation (MAD),
+ *       min and p90, so one preempted batch does not move it.
+ *       measure() runs a single case
+ *     - benchJson() / parseBenchJson(): the results as JSON, and the
+ *       reader for a stored file of the same format (not a general
+ *       JSON parser)
+ *     - compareBench(): a case is a regression when its median is more
+ *       than the tolerance above the baseline median and the gap is
+ *       larger than three MADs of either run. When both runs have the
+ *       reference case (benchReference(), a fixed chain of integer
+ *       operations), the baseline is first scaled by the ratio of the
+ *       two reference medians, so a host running at another clock (or
+ *       another machine) does not read as a regression of every case
+ *   Header only, host builds only.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _MICRO_BENCH_H_
+#define _MICRO_BENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchResult {
+    std::string name;
+    double median_ns = 0;       // Per call
+    double mad_ns = 0;          // Median absolute deviation of the batches
+    double min_ns = 0;
+    double p90_ns = 0;
+    int samples = 0;            // Timed batches
+    uint64_t iterations = 0;    // Calls per batch
+};
+
+struct BenchOptions {
+    int samples = 31;
+    double batch_ns = 2e6;      // Target time of one batch
+    int warmup_batches = 3;
+};
+
+// Keeps a value the compiler could otherwise drop
+template <typename T>
+inline void benchKeep(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Fixed work that only depends on the core clock: 64 dependent multiply-adds
+inline uint32_t benchReference(uint32_t seed) {
+    for (int i = 0; i < 64; i++) seed = seed * 1664525u + 1013904223u;
+    return seed;
+}
+
+// STATISTICS
+inline double benchMedian(std::vector<double> values) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+inline double benchMad(const std::vector<double> &values, double median) {
+    std::vector<double> deviations;
+    for (double v : values) deviations.push_back(v > median ? v - median : median - v);
+    return benchMedian(deviations);
+}
+
+inline BenchResult benchSummary(const std::string &name, std::vector<double> perCall_ns, uint64_t iterations) {
+    BenchResult r;
+    r.name = name;
+    r.samples = static_cast<int>(perCall_ns.size());
+    r.iterations = iterations;
+    if (perCall_ns.empty()) return r;
+    std::sort(perCall_ns.begin(), perCall_ns.end());
+    r.median_ns = benchMedian(perCall_ns);
+    r.mad_ns = benchMad(perCall_ns, r.median_ns);
+    r.min_ns = perCall_ns.front();
+    r.p90_ns = perCall_ns[std::min(perCall_ns.size() - 1, perCall_ns.size() * 9 / 10)];
+    return r;
+}
+
+// MEASUREMENT
+// Cases are timed round robin, one batch of each per round, so a slow spell of the
+// host lands on every case instead of on whichever one was running
+class BenchSuite {
+public:
+    // op(i) is one call; i counts up so the operation can walk through its inputs
+    template <typename Op>
+    void add(const std::string &name, Op op) {
+        cases.push_back({name, [op](uint64_t n) mutable {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < n; i++) op(i);
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        }});
+    }
+
+    std::vector<BenchResult> run(const BenchOptions &options = BenchOptions()) {
+        std::vector<uint64_t> iterations;
+        for (Case &c : cases) iterations.push_back(batchSize(c, options.batch_ns));
+        for (int w = 0; w < options.warmup_batches; w++) {
+            for (size_t k = 0; k < cases.size(); k++) cases[k].batch(iterations[k]);
+        }
+        std::vector<std::vector<double>> perCall(cases.size());
+        for (int s = 0; s < options.samples; s++) {
+            for (size_t k = 0; k < cases.size(); k++) {
+                perCall[k].push_back(cases[k].batch(iterations[k]) / iterations[k]);
+            }
+        }
+        std::vector<BenchResult> results;
+        for (size_t k = 0; k < cases.size(); k++) results.push_back(benchSummary(cases[k].name, perCall[k], iterations[k]));
+        return results;
+    }
+
+private:
+    struct Case {
+        std::string name;
+        std::function<double(uint64_t)> batch;      // Runs n calls, returns the ns taken
+    };
+
+    // Grows the batch until it is long enough to time, then scales it to batch_ns
+    static uint64_t batchSize(Case &c, double batch_ns) {
+        uint64_t n = 1;
+        while (n < (uint64_t(1) << 30)) {
+            double ns = c.batch(n);
+            if (ns >= batch_ns / 4) return std::max<uint64_t>(1, static_cast<uint64_t>(n * batch_ns / ns));
+            n *= 4;
+        }
+        return n;
+    }
+
+    std::vector<Case> cases;
+};
+
+// One case on its own
+template <typename Op>
+BenchResult measure(const std::string &name, Op op, const BenchOptions &options = BenchOptions()) {
+    BenchSuite suite;
+    suite.add(name, op);
+    return suite.run(options)[0];
+}
+
+// JSON
+inline std::string benchJson(const char *suite, const std::vector<BenchResult> &results) {
+    std::string out = std::string("{\n  \"suite\": \"") + suite + "\",\n  \"unit\": \"ns\",\n  \"results\": [\n";
+    char line[256];
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        snprintf(line, sizeof(line),
+                 "    {\"name\": \"%s\", \"median_ns\": %.3f, \"mad_ns\": %.3f, \"min_ns\": %.3f, \"p90_ns\": %.3f, "
+                 "\"samples\": %d, \"iterations\": %llu}%s\n",
+                 r.name.c_str(), r.median_ns, r.mad_ns, r.min_ns, r.p90_ns, r.samples,
+                 static_cast<unsigned long long>(r.iterations), i + 1 < results.size() ? "," : "");
+        out += line;
+    }
+    return out + "  ]\n}\n";
+}
+
+// Objects of the "results" array; false when the text is not in that format
+inline bool parseBenchJson(const std::string &text, std::vector<BenchResult> &results) {
+    size_t pos = text.find("\"results\"");
+    if (pos == std::string::npos || (pos = text.find('[', pos)) == std::string::npos) return false;
+    results.clear();
+    while (true) {
+        size_t open = text.find_first_of("{]", pos);
+        if (open == std::string::npos) return false;
+        if (text[open] == ']') return true;
+        size_t close = text.find('}', open);
+        if (close == std::string::npos) return false;
+        BenchResult r;
+        size_t key = open;
+        while ((key = text.find('"', key + 1)) < close) {
+            size_t keyEnd = text.find('"', key + 1);
+            size_t colon = text.find(':', keyEnd);
+            if (keyEnd >= close || colon >= close) return false;
+            std::string name = text.substr(key + 1, keyEnd - key - 1);
+            size_t value = text.find_first_not_of(" \t\r\n", colon + 1);
+            if (value >= close) return false;
+            if (text[value] == '"') {
+                size_t valueEnd = text.find('"', value + 1);
+                if (valueEnd >= close) return false;
+                if (name == "name") r.name = text.substr(value + 1, valueEnd - value - 1);
+                key = valueEnd;
+                continue;
+            }
+            double number = strtod(text.c_str() + value, nullptr);
+            if (name == "median_ns") r.median_ns = number;
+            else if (name == "mad_ns") r.mad_ns = number;
+            else if (name == "min_ns") r.min_ns = number;
+            else if (name == "p90_ns") r.p90_ns = number;
+            else if (name == "samples") r.samples = static_cast<int>(number);
+            else if (name == "iterations") r.iterations = static_cast<uint64_t>(number);
+            key = text.find_first_of(",}", value) - 1;
+        }
+        if (r.name.empty()) return false;
+        results.push_back(r);
+        pos = close + 1;
+    }
+}
+
+// COMPARISON
+enum BenchVerdict : uint8_t { BENCH_SAME, BENCH_FASTER, BENCH_SLOWER, BENCH_NEW };
+
+struct BenchComparison {
+    std::string name;
+    BenchVerdict verdict;
+    double change;              // Median against the baseline, +0.25 = 25 % slower
+};
+
+inline const BenchResult *findBench(const std::vector<BenchResult> &results, const std::string &name) {
+    for (const BenchResult &r : results) {
+        if (r.name == name) return &r;
+    }
+    return nullptr;
+}
+
+// reference: name of the benchReference() case, nullptr to compare raw times
+inline std::vector<BenchComparison> compareBench(const std::vector<BenchResult> &current,
+                                                 const std::vector<BenchResult> &baseline, double tolerance,
+                                                 const char *reference = nullptr) {
+    double scale = 1;
+    const BenchResult *currentRef = reference != nullptr ? findBench(current, reference) : nullptr;
+    const BenchResult *baseRef = reference != nullptr ? findBench(baseline, reference) : nullptr;
+    if (currentRef != nullptr && baseRef != nullptr && baseRef->median_ns > 0 && currentRef->median_ns > 0) {
+        scale = currentRef->median_ns / baseRef->median_ns;
+    }
+    std::vector<BenchComparison> out;
+    for (const BenchResult &r : current) {
+        const BenchResult *base = findBench(baseline, r.name);
+        if (base == nullptr || base->median_ns <= 0) {
+            out.push_back({r.name, BENCH_NEW, 0});
+            continue;
+        }
+        double baseMedian = base->median_ns * scale;
+        double change = r.median_ns / baseMedian - 1;
+        double noise = 3 * std::max(r.mad_ns, base->mad_ns * scale);
+        bool beyondNoise = std::abs(r.median_ns - baseMedian) > noise;
+        BenchVerdict verdict = BENCH_SAME;
+        if (change > tolerance && beyondNoise) verdict = BENCH_SLOWER;
+        else if (change < -tolerance && beyondNoise) verdict = BENCH_FASTER;
+        out.push_back({r.name, verdict, change});
+    }
+    return out;
+}
+
+#endif // _MICRO_BENCH_H_
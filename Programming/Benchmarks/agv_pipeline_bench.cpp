@@ -0,0 +1,124 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: agv_pipeline_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Real-time host version of the AGV sensing/control split using
+ *   std::thread, to measure sensor-to-PWM latency:
+ *     - serial: one loop reads the line sensors, waits for the ultrasonic
+ *       echo, then sets the duties (the old move_agv() structure)
+ *     - pipelined: a sensing thread publishes AgvSnapshot through the
+ *       TripleBuffer and a control thread applies the newest one
+ *   Usage: agv_pipeline_bench [seconds per mode] [echo wait us]
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <AgvPipeline.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Busy wait, like polling the echo pin
+void spinUs(int64_t us) {
+    int64_t end = nowUs() + us;
+    while (nowUs() < end) {}
+}
+
+// Same decision as lineFollowerLogic(): duties for motor 1 and 2
+volatile float duty1, duty2;
+void applyDuties(const AgvSnapshot &s) {
+    static const float left[4] = {0, 25, 75, 50};
+    static const float right[4] = {0, 75, 25, 50};
+    int index = (s.lineLeft << 1) | s.lineRight;
+    duty1 = left[index];
+    duty2 = right[index];
+}
+
+AgvSnapshot readSensors(uint32_t seq) {
+    AgvSnapshot s = {};
+    s.lineLeft = (seq / 7) & 1;
+    s.lineRight = (seq / 5) & 1;
+    s.timestamp_us = nowUs();
+    s.seq = seq;
+    return s;
+}
+
+void printStats(const char *mode, std::vector<int64_t> &samples) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    printf("%-10s cycles %7zu  latency p50 %6lld us  p99 %6lld us  max %6lld us\n", mode, samples.size(),
+           static_cast<long long>(samples[samples.size() / 2]),
+           static_cast<long long>(samples[samples.size() * 99 / 100]), static_cast<long long>(samples.back()));
+}
+
+void runSerial(double seconds, int64_t echoWait_us, int64_t period_us) {
+    std::vector<int64_t> latency;
+    int64_t end = nowUs() + static_cast<int64_t>(seconds * 1e6);
+    uint32_t seq = 0;
+    Clock::time_point next = Clock::now();
+    while (nowUs() < end) {
+        AgvSnapshot s = readSensors(++seq);
+        spinUs(echoWait_us);                            // Blocking echo measurement
+        applyDuties(s);
+        latency.push_back(nowUs() - s.timestamp_us);
+        next += std::chrono::microseconds(period_us);
+        std::this_thread::sleep_until(next);
+    }
+    printStats("serial", latency);
+}
+
+void runPipelined(double seconds, int64_t echoWait_us, int64_t period_us) {
+    TripleBuffer<AgvSnapshot> buffer;
+    std::atomic<bool> running{true};
+    std::vector<int64_t> latency;
+    std::thread sensing([&]() {
+        uint32_t seq = 0;
+        int64_t lastPing = 0;
+        Clock::time_point next = Clock::now();
+        while (running.load()) {
+            buffer.publish(readSensors(++seq));
+            if (nowUs() - lastPing > 60000) {           // The ranging wait only delays sensing
+                spinUs(echoWait_us);
+                lastPing = nowUs();
+            }
+            next += std::chrono::microseconds(period_us);
+            std::this_thread::sleep_until(next);
+        }
+    });
+    int64_t end = nowUs() + static_cast<int64_t>(seconds * 1e6);
+    AgvSnapshot s;
+    while (nowUs() < end) {
+        if (buffer.read(s)) {
+            applyDuties(s);
+            latency.push_back(nowUs() - s.timestamp_us);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(period_us / 4));
+    }
+    running.store(false);
+    sensing.join();
+    printStats("pipelined", latency);
+}
+
+int main(int argc, char **argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    int64_t echoWait_us = argc > 2 ? atoll(argv[2]) : 5800;     // 1 m obstacle
+    const int64_t period_us = 10000;                            // CONTROL_PERIOD_MS
+    printf("AGV sensor-to-PWM latency, %.1f s per mode, echo wait %lld us, %u hardware threads\n", seconds,
+           static_cast<long long>(echoWait_us), std::thread::hardware_concurrency());
+    runSerial(seconds, echoWait_us, period_us);
+    runPipelined(seconds, echoWait_us, period_us);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: com_link_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Latency, throughput and noise benchmark of the communication link:
+ *     - Latency: time from the AGV deciding a status to the lift task
+ *       seeing it, for the old level signals (held level polled every
+ *       50 ms by comSensorDetect) and for frames (ComTransmitter to
+ *       ComReceiver::waitMessage), on the virtual clock
+ *     - Throughput: messages per second for each bit period
+ *     - Noise: frames with random half-bit flips and edge jitter fed to
+ *       ComDecoder; delivered, rejected and wrong messages
+ *     - Decoder cost per edge on the host
+ *   Usage: com_link_bench [frames per noise point]
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ComLink.h>
+#include <HostSim.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kTxPin = 16;                      // As in AGV_State_Machine/definitions.h
+constexpr int kRxPin = 35;                      // As in ScissorLift_StateMachine/definitions.h
+constexpr int kRuns = 50;
+
+// AGV output wired to the lift input
+class WireWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Com wire"; }
+    bool missionComplete() const override { return true; }
+    void pinWritten(int pin, int value) override {
+        if (pin == kTxPin) drive(kRxPin, value);
+    }
+};
+
+// The old comSensorDetect(): level polled every interval_ms until it held for duration_ms
+int64_t levelDetect(int expected, int duration_ms, int interval_ms = 50) {
+    int64_t startTime = -1;
+    while (true) {
+        int64_t now = esp_timer_get_time() / 1000;
+        if (gpio_get_level((gpio_num_t)kRxPin) == expected) {
+            if (startTime < 0) startTime = now;
+            else if (now - startTime >= duration_ms) return esp_timer_get_time();
+        }
+        else startTime = -1;
+        vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    }
+}
+
+struct Latency {
+    double avg_ms = 0, max_ms = 0;
+    void add(int64_t us) {
+        avg_ms += us / 1000.0 / kRuns;
+        max_ms = std::max(max_ms, us / 1000.0);
+    }
+};
+
+// Old signal: the AGV sets 'level' at a random phase of the lift's poll
+Latency levelLatency(int level, int duration_ms, std::mt19937 &rng) {
+    Latency latency;
+    for (int run = 0; run < kRuns; run++) {
+        WireWorld world;
+        hostsim::install(world);
+        world.drive(kRxPin, !level);
+        int64_t at = 100000 + rng() % 50000;
+        hostsim::clock().at(at, [&world, level]() { world.drive(kRxPin, level); });
+        latency.add(levelDetect(level, duration_ms) - at);
+    }
+    return latency;
+}
+
+// Frame: send() at a random phase, the lift task waits in waitMessage()
+Latency frameLatency(ComMessageType type, std::mt19937 &rng) {
+    Latency latency;
+    for (int run = 0; run < kRuns; run++) {
+        WireWorld world;
+        hostsim::install(world);
+        SimpleGPIO pin;
+        pin.setup(kTxPin, GPO);
+        ComTransmitter tx;
+        ComReceiver rx;
+        tx.setup(pin);
+        rx.setup(kRxPin);
+        int64_t at = 100000 + rng() % 50000;
+        hostsim::clock().at(at, [&tx, type]() { tx.send({type, 25, 0}); });
+        ComMessage msg;
+        while (!rx.waitMessage(msg, 1000)) {}
+        latency.add(esp_timer_get_time() - at);
+    }
+    return latency;
+}
+
+void latencyTable() {
+    std::mt19937 rng(1);
+    printf("Status latency, AGV decision to lift task, %d runs each\n\n", kRuns);
+    printf("%-10s %-30s %10s %10s\n", "message", "signal", "avg ms", "max ms");
+    struct Row {
+        const char *name;
+        ComMessageType type;
+        int level, hold_ms;
+    } rows[] = {{"coupled", COM_COUPLED, 1, 3000}, {"obstacle", COM_OBSTACLE, 0, 200}, {"arrived", COM_ARRIVED, 0, 3000}};
+    for (const Row &r : rows) {
+        Latency old = levelLatency(r.level, r.hold_ms, rng);
+        Latency frame = frameLatency(r.type, rng);
+        char signal[40];
+        snprintf(signal, sizeof(signal), "level %d held %d ms", r.level, r.hold_ms);
+        printf("%-10s %-30s %10.1f %10.1f\n", r.name, signal, old.avg_ms, old.max_ms);
+        snprintf(signal, sizeof(signal), "frame, %d bytes", comPayloadLength(r.type) + 4);
+        printf("%-10s %-30s %10.1f %10.1f\n", "", signal, frame.avg_ms, frame.max_ms);
+    }
+}
+
+void throughputTable() {
+    printf("\nThroughput, back-to-back frames with a %d bit gap\n\n", kComGapBits);
+    printf("%-10s %14s %14s %14s\n", "bit us", "frame ms", "msg/s", "msg/s (2 B)");
+    for (uint32_t bit : {2000u, 1000u, 500u, 250u}) {
+        double shortFrame = (4 * 8 + kComGapBits) * bit / 1000.0;
+        double longFrame = (6 * 8 + kComGapBits) * bit / 1000.0;
+        printf("%-10u %6.1f - %5.1f %14.1f %14.1f\n", bit, shortFrame - kComGapBits * bit / 1000.0,
+               longFrame - kComGapBits * bit / 1000.0, 1000.0 / shortFrame, 1000.0 / longFrame);
+    }
+}
+
+struct NoiseResult {
+    int delivered = 0, rejected = 0, wrong = 0;
+};
+
+// Random messages through ComDecoder; each half-bit flips with probability flip, edges move by up to jitter
+NoiseResult noiseRun(int frames, double flip, double jitter, uint32_t seed, uint64_t &edges) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const int64_t half = kComBitPeriod_us / 2;
+    const ComMessageType types[] = {COM_COUPLED, COM_OBSTACLE, COM_ARRIVED, COM_ABORT, COM_WEIGHT};
+    ComDecoder decoder;
+    NoiseResult result;
+    int64_t start = 0;
+    for (int f = 0; f < frames; f++) {
+        ComMessage sent = {types[rng() % 5], 0, 0};
+        if (comPayloadLength(sent.type) > 0) sent.value = static_cast<uint16_t>(rng());
+        uint8_t frame[kComMaxFrameBytes];
+        int halves = comEncode(sent, frame) * 16;
+        int level = 0;
+        bool got = false, good = false;
+        ComMessage msg;
+        for (int h = 0; h <= halves; h++) {
+            int next = h < halves ? comHalfLevel(frame, h) : 0;
+            if (h < halves && uniform(rng) < flip) next = !next;
+            if (next == level) continue;
+            level = next;
+            int64_t t = start + h * half + static_cast<int64_t>((uniform(rng) * 2 - 1) * jitter * half);
+            edges++;
+            if (decoder.edge(t, level, msg)) {
+                got = true;
+                good = msg.type == sent.type && msg.value == sent.value;
+            }
+        }
+        start += halves * half + 2 * kComGapBits * half;
+        if (!got) result.rejected++;
+        else if (good) result.delivered++;
+        else result.wrong++;
+    }
+    return result;
+}
+
+void noiseTable(int frames) {
+    printf("\nNoise, %d random frames per point at a %u us bit\n\n", frames, kComBitPeriod_us);
+    printf("%-12s %-10s %12s %12s %12s\n", "half-bit BER", "jitter", "delivered", "rejected", "wrong");
+    uint64_t edges = 0;
+    for (double flip : {0.0, 1e-4, 1e-3, 1e-2, 5e-2}) {
+        for (double jitter : {0.0, 0.2, 0.3}) {
+            NoiseResult r = noiseRun(frames, flip, jitter, 42, edges);
+            printf("%-12g %8.0f %% %11.2f%% %11.2f%% %12d\n", flip, jitter * 100, 100.0 * r.delivered / frames,
+                   100.0 * r.rejected / frames, r.wrong);
+        }
+    }
+}
+
+void decoderCost() {
+    uint64_t edges = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    NoiseResult r = noiseRun(200000, 0.0, 0.0, 7, edges);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / edges;
+    printf("\nComDecoder::edge() plus frame generation: %.1f ns per edge on the host (%d frames)\n", ns, r.delivered);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 20000;
+    latencyTable();
+    throughputTable();
+    noiseTable(frames);
+    decoderCost();
+    return 0;
+}
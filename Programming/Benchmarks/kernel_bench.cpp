@@ -0,0 +1,296 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: kernel_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   CPU cost of the control kernels on the host, one call each:
+ *     - line_estimator, line_controller: the line following step
+ *       (LineEstimator alone, then LineController::update() with the
+ *       simulated GPIO and PWM calls)
+ *     - collision_speed: one ranging sample through the range tracker
+ *       (AGV sensing task) and the time to collision governor and
+ *       setSpeed() (collisionAvoidanceLogic() in the control task)
+ *     - echo_to_cm: the echo width conversion behind read_distance()
+ *     - Conversions in float and in fixed point (the integer versions are
+ *       the ones usable in ISRs): echo_to_cm_q16 (echo width to cm),
+ *       mv_to_kg / uv_to_kg_q20 (load cell calibration) and
+ *       standing_duty / standing_duty_q16 (distance to duty)
+ *     - load_cell_sample: one timer sample of the load cell, four
+ *       readings averaged, calibrated and pushed through LoadCellStats
+ *     - keypad_scan: one KeypadScanner scan with debouncing, driven by
+ *       the virtual clock (includes the host timer dispatch)
+ *     - keypad_entry: KeypadEntry turning "1", "2", "A" into 12 kg, as in
+ *       the lift's keypadNumber()
+ *   Statistics and JSON come from MicroBench.h. With --baseline, every
+ *   case is compared to a stored run and the exit code is 1 when one
+ *   got slower by more than the tolerance (and more than its noise).
+ *   The "reference" case is fixed integer work; the baseline is scaled
+ *   by its ratio first, which takes out most of the host clock changes.
+ *   Usage: kernel_bench [--json out.json] [--baseline base.json]
+ *                       [--tolerance percent] [--samples n]
+ *     e.g. ./build/kernel_bench --baseline Benchmarks/kernel_bench_baseline.json
+ *   Write a new baseline with --json after a change of compiler, before
+ *   the change to be measured, and in the same commit as any change to
+ *   the cases. The file is only ever written by --json.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <EchoRanger.h>
+#include <HostKeypad.h>
+#include <HostSim.h>
+#include <KeypadScanner.h>
+#include <LineController.h>
+#include <LoadCellCalibration.h>
+#include <LoadCellFilter.h>
+#include <SpeedGovernor.h>
+#include "MicroBench.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+// Pins and limits, as in AGV_State_Machine and ScissorLift_StateMachine
+constexpr int kMotor1Pin = 25;
+constexpr int kMotor2Pin = 26;
+constexpr int kLine1Pin = 33;
+constexpr int kLine2Pin = 32;
+const GovernorLimits kGovernorLimits = {10, 1.0f, 60, 0.4f, 0.15f, 80};     // STOP_DISTANCE ... OPEN_AISLE_DUTY
+constexpr int64_t kEchoCycle_us = 51600;        // EchoArray cycle, one new sample per call
+const uint8_t kKeypadRows[4] = {5, 18, 19, 21};
+const uint8_t kKeypadCols[4] = {15, 4, 22, 23};
+const char *const kKeypadMap[4] = {"123A", "456B", "789C", "*0#D"};
+
+constexpr int kInputs = 1024;                   // Inputs each case cycles through (power of two)
+
+class BenchWorld : public hostsim::World {
+public:
+    BenchWorld() : keypad(kKeypadRows, kKeypadCols, kKeypadMap) {}
+    const char *name() const override { return "Bench"; }
+    bool missionComplete() const override { return true; }
+
+    int pinLevel(int pin) override {
+        if (keypad.isColumn(pin)) return keypad.columnLevel(pin, level);
+        return World::pinLevel(pin);
+    }
+
+    hostsim::KeyMatrix keypad;
+};
+
+// Digits typed until 'A', through the KeypadEntry used by keypadNumber() in ScissorLift_StateMachine/main.cpp
+float keypadNumber(const char *keys) {
+    KeypadEntry entry;
+    for (const char *k = keys; *k != '\0'; k++) {
+        if (entry.key(*k) == KeypadEntry::ENTRY_DONE) return entry.value();
+    }
+    return -1;
+}
+
+bool readFile(const char *path, std::string &text) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream content;
+    content << in.rdbuf();
+    text = content.str();
+    return true;
+}
+
+std::vector<BenchResult> runKernels(const BenchOptions &options) {
+    BenchSuite suite;
+    std::mt19937 rng(7);
+    BenchWorld world;
+    hostsim::install(world);
+
+    suite.add("reference", [&](uint64_t i) {         // Clock of this run, see MicroBench.h
+        benchKeep(benchReference(static_cast<uint32_t>(i)));
+    });
+
+    // Line following
+    std::vector<uint8_t> patterns(kInputs);
+    int pattern = 3;
+    for (uint8_t &p : patterns) {
+        if (rng() % 8 == 0) pattern = rng() % 4;        // Runs of the same reading, as on the tape
+        p = static_cast<uint8_t>(pattern);
+    }
+    LineEstimator estimator;
+    suite.add("line_estimator", [&](uint64_t i) {
+        uint8_t p = patterns[i & (kInputs - 1)];
+        benchKeep(estimator.update(p & 1, p >> 1));
+    });
+
+    SimpleGPIO leftSensor, rightSensor;
+    SimplePWM motorRight, motorLeft;
+    leftSensor.setup(kLine1Pin, GPI);
+    rightSensor.setup(kLine2Pin, GPI);
+    motorRight.setup(kMotor1Pin, 0);
+    motorLeft.setup(kMotor2Pin, 1);
+    LineController lineControl;
+    lineControl.setup(leftSensor, rightSensor, motorRight, motorLeft);
+    lineControl.start(50, false);
+    suite.add("line_controller", [&](uint64_t i) {
+        uint8_t p = patterns[i & (kInputs - 1)];
+        world.level[kLine1Pin] = p & 1;
+        world.level[kLine2Pin] = p >> 1;
+        lineControl.update();
+    });
+
+    // Collision avoidance and ranging
+    std::vector<float> distances(kInputs);
+    std::vector<int64_t> widths(kInputs);
+    for (int i = 0; i < kInputs; i++) {
+        distances[i] = 250.0f - i * 0.23f + (rng() % 200) * 0.01f;  // Noisy approach from 2.5 m to 15 cm
+        widths[i] = 100 + rng() % 23000;                // 2 cm to 4 m
+    }
+    RangeTracker tracker;
+    SpeedGovernor governor;
+    tracker.setup();
+    governor.setup(kGovernorLimits);
+    suite.add("collision_speed", [&](uint64_t i) {
+        EchoSample sample = {ECHO_OK, distances[i & (kInputs - 1)], static_cast<int64_t>(i + 1) * kEchoCycle_us, 0};
+        tracker.update(sample);                         // Sensing task
+        int percentage = governor.update(tracker.at(sample.timestamp_us));     // Control task
+        lineControl.setSpeed(percentage);
+        benchKeep(percentage);
+    });
+
+    EchoRanger ranger;
+    suite.add("echo_to_cm", [&](uint64_t i) {
+        benchKeep(ranger.widthToCm(widths[i & (kInputs - 1)]));
+    });
+    suite.add("echo_to_cm_q16", [&](uint64_t i) {
+        benchKeep(ranger.widthToCmQ(widths[i & (kInputs - 1)]).raw());
+    });
+
+    // Float and fixed-point conversions
+    LoadCalibration calibration;
+    twoPointCalibration(16.0f, 416.0f, 10.0f, calibration);
+    FixedLine<20, 40> fixedKg = calibration.fixedKg();
+    std::vector<float> readings_mV(kInputs);
+    std::vector<int32_t> readings_uV(kInputs);
+    std::vector<Q16> distancesQ(kInputs);
+    for (int i = 0; i < kInputs; i++) {
+        readings_mV[i] = 16.0f + (rng() % 500000) * 0.001f;
+        readings_uV[i] = static_cast<int32_t>(readings_mV[i] * 1000.0f);
+        distancesQ[i] = Q16::fromFloat(distances[i]);
+    }
+    suite.add("mv_to_kg", [&](uint64_t i) {
+        benchKeep(calibration.kg(readings_mV[i & (kInputs - 1)]));
+    });
+    suite.add("uv_to_kg_q20", [&](uint64_t i) {
+        benchKeep(fixedKg.at(readings_uV[i & (kInputs - 1)]).raw());
+    });
+    FixedRamp<16> standingRamp = governor.standingRamp();
+    suite.add("standing_duty", [&](uint64_t i) {
+        benchKeep(governor.standingDuty(distances[i & (kInputs - 1)]));
+    });
+    suite.add("standing_duty_q16", [&](uint64_t i) {
+        benchKeep(standingRamp.at(distancesQ[i & (kInputs - 1)]).raw());
+    });
+
+    // Load cell: four ADC readings around a pouring fill
+    std::vector<float> millivolts(kInputs * 4);
+    std::normal_distribution<float> noise(0.0f, 0.4f);
+    for (int i = 0; i < kInputs * 4; i++) millivolts[i] = 120.0f + i * 0.05f + noise(rng);
+    LoadCellStats loadStats;
+    loadStats.setTarget(5.0f);
+    const float slope = 0.025f, offset = -0.4f;
+    suite.add("load_cell_sample", [&](uint64_t i) {
+        const float *reading = &millivolts[(i & (kInputs - 1)) * 4];
+        float mv = 0;
+        for (int k = 0; k < 4; k++) mv += reading[k];
+        benchKeep(loadStats.push(slope * (mv / 4) + offset));
+    });
+
+    // Keypad
+    KeypadScanner keypad;
+    keypad.setup(kKeypadRows, kKeypadCols);
+    const char typed[] = "0123456789ABCD*#";
+    suite.add("keypad_scan", [&](uint64_t i) {
+        if (i % 100 == 0) {                             // A new keystroke every 100 scans, the last one released
+            world.keypad = hostsim::KeyMatrix(kKeypadRows, kKeypadCols, kKeypadMap);
+            world.keypad.press(typed[(i / 100) % 16], hostsim::clock().now() + 1000, 40000);
+        }
+        hostsim::clock().advance(KeypadScanner::kDefaultPeriod_us);
+        KeyEvent event;
+        while (keypad.nextEvent(event)) benchKeep(event);
+    });
+
+    const char *entries[4] = {"12A", "5A", "9B7A", "1C25A"};
+    suite.add("keypad_entry", [&](uint64_t i) {
+        benchKeep(keypadNumber(entries[i & 3]));
+    });
+
+    std::vector<BenchResult> results = suite.run(options);
+    lineControl.stop();
+    keypad.stop();
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *jsonPath = nullptr;
+    const char *baselinePath = nullptr;
+    double tolerance = 0.20;
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) tolerance = atof(argv[++i]) / 100;
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) options.samples = std::max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "Usage: %s [--json out.json] [--baseline base.json] [--tolerance percent] [--samples n]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> baseline;
+    if (baselinePath != nullptr) {
+        std::string text;
+        if (!readFile(baselinePath, text) || !parseBenchJson(text, baseline)) {
+            fprintf(stderr, "Cannot read the baseline %s\n", baselinePath);
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results = runKernels(options);
+    std::vector<BenchComparison> comparison = compareBench(results, baseline, tolerance, "reference");
+    printf("Control kernels, host ns per call (median of %d batches)\n\n", options.samples);
+    printf("%-18s %10s %8s %10s %10s %12s\n", "kernel", "median", "MAD", "min", "p90",
+           baselinePath != nullptr ? "vs baseline" : "");
+    int slower = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        char verdict[32] = "";
+        if (baselinePath != nullptr) {
+            const BenchComparison &c = comparison[i];
+            const char *word = c.verdict == BENCH_SLOWER ? "SLOWER" : c.verdict == BENCH_FASTER ? "faster" : "";
+            if (c.verdict == BENCH_NEW) snprintf(verdict, sizeof(verdict), "new");
+            else snprintf(verdict, sizeof(verdict), "%+6.1f%% %s", c.change * 100, word);
+            if (c.verdict == BENCH_SLOWER) slower++;
+        }
+        printf("%-18s %10.2f %8.2f %10.2f %10.2f  %s\n", r.name.c_str(), r.median_ns, r.mad_ns, r.min_ns, r.p90_ns,
+               verdict);
+    }
+
+    if (jsonPath != nullptr) {
+        std::ofstream out(jsonPath);
+        out << benchJson("kernel_bench", results);
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", jsonPath);
+            return 2;
+        }
+    }
+    if (baselinePath != nullptr) {
+        printf("\n%d of %zu kernels slower than the baseline by more than %.0f%%\n", slower, results.size(),
+               tolerance * 100);
+    }
+    return slower > 0 ? 1 : 0;
+}
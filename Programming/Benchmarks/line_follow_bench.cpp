@@ -0,0 +1,251 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: line_follow_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tracking-error and loop-jitter benchmark of the line following
+ *   controller on the virtual clock, using a 2D differential drive model
+ *   of the AGV over a track with left and right arcs:
+ *     - bang-bang: the old lineFollowerLogic() duties every 10 ms, which
+ *       stops the AGV when both sensors leave the tape
+ *     - pid: LineController at 500 Hz and 1 kHz, then at 500 Hz with a
+ *       random delay added to every timer period
+ *   Each case runs at rising cruise duties; the table shows RMS and max
+ *   lateral error and how far the AGV got. The last line is the real CPU
+ *   cost of one LineController::update() on this machine.
+ *   Usage: line_follow_bench [full speed cm/s]
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LineController.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Pins, as in AGV_State_Machine/definitions.h
+constexpr int kMotor1Pin = 25;                  // Right wheel
+constexpr int kMotor2Pin = 26;                  // Left wheel
+constexpr int kLine1Pin = 33;                   // Left sensor
+constexpr int kLine2Pin = 32;                   // Right sensor
+
+// Chassis and sensors
+constexpr double kWheelBase_cm = 15.0;
+constexpr double kWheelLag_s = 0.05;            // Per wheel first order speed lag
+constexpr double kSensorAhead_cm = 8.0;         // Sensor bar ahead of the axle
+constexpr double kSensorHalfGap_cm = 0.8;       // Sensors at +-0.8 cm from the centre
+constexpr double kTapeHalfWidth_cm = 1.25;      // 2.5 cm tape
+constexpr double kDerailed_cm = 6.0;            // Further than this the AGV is off the track
+constexpr double kStep_s = 100e-6;              // Model integration step
+constexpr double kTrackEnd_cm = 560.0;
+
+// Track: length of each piece and its curvature (1/radius, positive turns left)
+struct Piece {
+    double length_cm, curvature;
+};
+const Piece kTrack[] = {
+    {100, 0}, {60, 1.0 / 60}, {50, 0}, {90, -1.0 / 60}, {80, 0}, {60, 1.0 / 40}, {40, 0}, {60, -1.0 / 40}, {100, 0},
+};
+
+double curvatureAt(double s) {
+    for (const Piece &p : kTrack) {
+        if (s < p.length_cm) return p.curvature;
+        s -= p.length_cm;
+    }
+    return 0;
+}
+
+// Path frame: s along the tape, y left of the tape, psi heading relative to the tape
+class TrackWorld : public hostsim::World {
+public:
+    explicit TrackWorld(double fullSpeed_cm_s) : fullSpeed(fullSpeed_cm_s) {}
+
+    const char *name() const override { return "Track"; }
+    bool missionComplete() const override { return s >= kTrackEnd_cm; }
+
+    int pinLevel(int pin) override {
+        integrate();
+        double centre = y + kSensorAhead_cm * std::sin(psi);
+        if (pin == kLine1Pin) return std::fabs(centre + kSensorHalfGap_cm) < kTapeHalfWidth_cm;
+        if (pin == kLine2Pin) return std::fabs(centre - kSensorHalfGap_cm) < kTapeHalfWidth_cm;
+        return World::pinLevel(pin);
+    }
+
+    void pwmDuty(int pin, float percent) override {
+        integrate();
+        if (pin == kMotor1Pin) dutyRight = percent;
+        else if (pin == kMotor2Pin) dutyLeft = percent;
+    }
+
+    void integrate() {
+        int64_t now = hostsim::clock().now();
+        while (modelTime_us + kStep_s * 1e6 <= now && !derailed) {
+            modelTime_us += static_cast<int64_t>(kStep_s * 1e6);
+            double decay = kStep_s / (kWheelLag_s + kStep_s);
+            vLeft += (fullSpeed * dutyLeft / 100.0 - vLeft) * decay;
+            vRight += (fullSpeed * dutyRight / 100.0 - vRight) * decay;
+            double v = (vLeft + vRight) / 2.0;
+            double omega = (vRight - vLeft) / kWheelBase_cm;
+            double kappa = curvatureAt(s);
+            s += v * std::cos(psi) / (1.0 - kappa * y) * kStep_s;
+            y += v * std::sin(psi) * kStep_s;
+            psi += (omega - kappa * v * std::cos(psi) / (1.0 - kappa * y)) * kStep_s;
+            sumSquares += y * y;
+            samples++;
+            maxError = std::max(maxError, std::fabs(y));
+            if (std::fabs(y) > kDerailed_cm) derailed = true;
+        }
+    }
+
+    double rmsError() const { return samples > 0 ? std::sqrt(sumSquares / samples) : 0; }
+
+    double fullSpeed;
+    double s = 0, y = 0, psi = 0;
+    double vLeft = 0, vRight = 0;
+    float dutyLeft = 0, dutyRight = 0;
+    int64_t modelTime_us = 0;
+    double sumSquares = 0, maxError = 0;
+    int64_t samples = 0;
+    bool derailed = false;
+};
+
+SimpleGPIO leftSensor, rightSensor;
+SimplePWM motorRight, motorLeft;
+
+void setupPins() {
+    leftSensor.setup(kLine1Pin, GPI);
+    rightSensor.setup(kLine2Pin, GPI);
+    motorRight.setup(kMotor1Pin, 0);
+    motorLeft.setup(kMotor2Pin, 1);
+}
+
+struct Result {
+    double rms, max, reached, seconds;
+    bool stopped, derailed;
+    LoopJitter jitter;
+};
+
+constexpr int64_t kRunLimit_us = 60000000;
+
+bool runOver(TrackWorld &world) {
+    world.integrate();
+    return world.s >= kTrackEnd_cm || world.derailed || hostsim::clock().now() >= kRunLimit_us;
+}
+
+Result finish(TrackWorld &world, bool stopped) {
+    return {world.rmsError(), world.maxError, world.s, hostsim::clock().now() * 1e-6, stopped, world.derailed, {}};
+}
+
+// Old four-case mapping, duties scaled from the 50 % cruise
+Result runBangBang(double fullSpeed, float cruise) {
+    TrackWorld world(fullSpeed);
+    hostsim::install(world);
+    setupPins();
+    bool stopped = false;
+    while (!runOver(world)) {
+        int a = leftSensor.get();
+        int b = rightSensor.get();
+        switch ((a << 1) | b) {
+            case 0b00:
+                stopped = true;
+                break;
+            case 0b01:
+                motorRight.setDuty(cruise * 0.5f);
+                motorLeft.setDuty(std::min(cruise * 1.5f, 100.0f));
+                break;
+            case 0b10:
+                motorRight.setDuty(std::min(cruise * 1.5f, 100.0f));
+                motorLeft.setDuty(cruise * 0.5f);
+                break;
+            case 0b11:
+                motorRight.setDuty(cruise);
+                motorLeft.setDuty(cruise);
+                break;
+        }
+        if (stopped) break;
+        hostsim::clock().advance(10000);
+    }
+    return finish(world, stopped);
+}
+
+// LineController on its esp_timer, or stepped by hand with up to jitter_us of extra delay
+Result runPid(double fullSpeed, float cruise, uint32_t period_us, int64_t jitter_us) {
+    TrackWorld world(fullSpeed);
+    hostsim::install(world);
+    setupPins();
+    LineController controller;
+    controller.setup(leftSensor, rightSensor, motorRight, motorLeft, LineGains(), period_us);
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int64_t> delay(0, jitter_us);
+    controller.start(cruise, jitter_us == 0);
+    int64_t nextRun = hostsim::clock().now();
+    while (!runOver(world) && !controller.atMark()) {
+        if (jitter_us == 0) {
+            hostsim::clock().advance(10000);
+            continue;
+        }
+        nextRun += period_us;
+        int64_t at = nextRun + delay(random);           // Late by a random amount, never early
+        hostsim::clock().advance(at - hostsim::clock().now());
+        controller.update();
+    }
+    Result result = finish(world, controller.atMark());
+    result.jitter = controller.jitter();
+    controller.stop();
+    return result;
+}
+
+void printRow(const char *name, float cruise, const Result &r) {
+    const char *outcome = r.derailed ? "derailed" : r.stopped ? "stopped (line lost)" : r.reached >= kTrackEnd_cm ? "finished" : "timeout";
+    printf("%-16s %5.0f %% %8.2f %8.2f %8.0f %8.2f  %-20s", name, cruise, r.rms, r.max, r.reached, r.seconds, outcome);
+    if (r.jitter.count > 0) printf(" jitter avg %lld max %lld us", static_cast<long long>(r.jitter.average_us()),
+                                   static_cast<long long>(r.jitter.maxDeviation_us));
+    printf("\n");
+}
+
+// Real time of one update() against a latched pin bank
+void measureCpu() {
+    struct StillWorld : hostsim::World {
+        const char *name() const override { return "Still"; }
+        bool missionComplete() const override { return true; }
+    } world;
+    hostsim::install(world);
+    setupPins();
+    world.level[kLine1Pin] = 1;
+    world.level[kLine2Pin] = 0;
+    LineController controller;
+    controller.setup(leftSensor, rightSensor, motorRight, motorLeft);
+    controller.start(50, false);
+    const int kCalls = 1000000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCalls; i++) {
+        if ((i & 63) == 0) world.level[kLine2Pin] ^= 1;     // Keep the error and duties moving
+        controller.update();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / kCalls;
+    controller.stop();
+    printf("\nLineController::update(): %.0f ns per call on the host (includes the simulated GPIO and PWM calls)\n", ns);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    double fullSpeed = argc > 1 ? atof(argv[1]) : 120.0;
+    printf("Line following over %.0f cm, %.0f cm/s at 100 %% duty, derailed past %.0f cm\n\n", kTrackEnd_cm, fullSpeed,
+           kDerailed_cm);
+    printf("%-16s %7s %8s %8s %8s %8s  %s\n", "controller", "cruise", "rms cm", "max cm", "reached", "time s", "outcome");
+    const float cruises[] = {30, 50, 70, 90};
+    for (float cruise : cruises) printRow("bang-bang 100Hz", cruise, runBangBang(fullSpeed, cruise));
+    for (float cruise : cruises) printRow("pid 500Hz", cruise, runPid(fullSpeed, cruise, 2000, 0));
+    for (float cruise : cruises) printRow("pid 1kHz", cruise, runPid(fullSpeed, cruise, 1000, 0));
+    for (float cruise : cruises) printRow("pid 500Hz+1ms", cruise, runPid(fullSpeed, cruise, 2000, 1000));
+    measureCpu();
+    return 0;
+}
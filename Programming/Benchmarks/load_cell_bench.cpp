@@ -0,0 +1,259 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: load_cell_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Time-to-decision and false-trigger benchmark of the load cell
+ *   stability check, replaying ADC traces on the virtual clock:
+ *     - 1 Hz: the old loadCellLogic() loop, one reading per second and
+ *       two consecutive readings within 0.05 kg of the target
+ *     - filter: LoadCellFilter at 500 Hz with 4x oversampling, polled
+ *       every 50 ms like the new loadCellLogic()
+ *   Without arguments it generates fill scenarios (plain noise, heavy
+ *   noise, bumps, pouring impact with bounce, slow creep) for several
+ *   targets and start phases. The table shows the delay from the moment
+ *   the true weight settles to the decision, decisions taken before that
+ *   moment (false triggers) and runs with no decision in 30 s.
+ *   Usage: load_cell_bench [trace.csv target_kg [settle_s]]
+ *          load_cell_bench --write (saves one CSV per scenario)
+ *   CSV lines are "time_us,mV"; the calibration is 0.1 kg/mV + 0.1 kg.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LoadCellFilter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kCellPin = 39;                    // As in ScissorLift_StateMachine/definitions.h
+constexpr float kSlope = 0.1f;                  // Firmware calibration
+constexpr float kOffset = 0.1f;
+constexpr float kTolerance = 0.05f;             // Both checks
+constexpr int64_t kSample_us = 100;             // Generated traces at 10 kHz
+constexpr int64_t kRunLimit_us = 30000000;
+constexpr int kSeeds = 20;
+
+// ADC trace in millivolts, replayed as a sample-and-hold signal
+struct Trace {
+    std::vector<int64_t> time_us;
+    std::vector<float> mv;
+    std::vector<float> kg;                      // Noise-free weight, generated traces only
+    int64_t settle_us = -1;                     // True weight within tolerance from here on, -1 unknown
+
+    size_t index(int64_t t) const {
+        auto it = std::upper_bound(time_us.begin(), time_us.end(), t);
+        return it == time_us.begin() ? 0 : it - time_us.begin() - 1;
+    }
+    float at(int64_t t) const { return mv[index(t)]; }
+};
+
+class TraceWorld : public hostsim::World {
+public:
+    explicit TraceWorld(const Trace &trace) : trace(trace) {}
+    const char *name() const override { return "Load cell trace"; }
+    bool missionComplete() const override { return true; }
+    float adcMilliVolts(int pin) override { return pin == kCellPin ? trace.at(hostsim::clock().now()) : 0.0f; }
+
+    const Trace &trace;
+};
+
+enum Scenario { FILL, NOISY, BUMPS, IMPACT, CREEP, SCENARIO_COUNT };
+const char *const kScenarioNames[] = {"fill", "noisy", "bumps", "impact", "creep"};
+
+// Noise-free weight of a scenario (kg) at t seconds after the pour starts
+double cleanWeight(Scenario scenario, double target, double t) {
+    const double pour = 4.0;
+    if (t <= 0) return 0;
+    double poured = std::min(1.0, t / pour) * target;
+    switch (scenario) {
+        case IMPACT:                                    // Falling beans push harder, the plate bounces after
+            if (t < pour) return poured + 0.4;
+            return poured + 0.4 * std::exp(-(t - pour) / 0.15) * std::cos(2 * M_PI * 8.0 * (t - pour));
+        case CREEP:                                     // Beans settling into the basket
+            return poured - 0.3 * std::exp(-std::max(0.0, t - pour) / 1.5) * std::min(1.0, t / pour);
+        default:
+            return poured;
+    }
+}
+
+Trace makeTrace(Scenario scenario, double target, double startDelay_s, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, scenario == NOISY ? 2.0 : 1.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Trace trace;
+    int64_t lastOutside = 0;
+    double bump = 0;
+    for (int64_t t = 0; t <= kRunLimit_us; t += kSample_us) {
+        double kg = cleanWeight(scenario, target, (t - startDelay_s * 1e6) / 1e6);
+        if (std::fabs(kg - target) >= kTolerance) lastOutside = t;
+        if (scenario == BUMPS) {                        // Short knocks on the frame, about two per second
+            if (unit(rng) < 2.0 * kSample_us / 1e6) bump = (unit(rng) < 0.5 ? -3.0 : 3.0);
+            else bump *= 0.8;
+        }
+        double mv = (kg - kOffset) / kSlope + bump / kSlope + noise(rng);
+        trace.time_us.push_back(t);
+        trace.mv.push_back(static_cast<float>(std::max(0.0, std::round(mv))));
+        trace.kg.push_back(static_cast<float>(kg));
+    }
+    trace.settle_us = lastOutside + kSample_us;
+    return trace;
+}
+
+// Decision time of the old loop, -1 when none
+int64_t runOneHertz(const Trace &trace, float target) {
+    TraceWorld world(trace);
+    hostsim::install(world);
+    SimpleADC cell;
+    cell.setup(kCellPin);
+    int stableCount = 0;
+    while (hostsim::clock().now() < kRunLimit_us) {
+        float realWeight = kSlope * cell.read(ADC_READ_MV) + kOffset;
+        if (std::fabs(realWeight - target) < kTolerance) stableCount++;
+        else stableCount = 0;
+        if (stableCount >= 2) return hostsim::clock().now();
+        hostsim::clock().advance(1000000);
+    }
+    return -1;
+}
+
+int64_t runFilter(const Trace &trace, float target) {
+    TraceWorld world(trace);
+    hostsim::install(world);
+    SimpleADC cell;
+    cell.setup(kCellPin);
+    LoadCellFilter filter;
+    filter.setup(cell, kSlope, kOffset);
+    filter.start(target);
+    int64_t decided = -1;
+    while (decided < 0 && hostsim::clock().now() < kRunLimit_us) {
+        hostsim::clock().advance(50000);
+        if (filter.latest().settled) decided = hostsim::clock().now();
+    }
+    filter.stop();
+    return decided;
+}
+
+struct Tally {
+    double sumDelay = 0, maxDelay = 0, maxError = 0;
+    int decisions = 0, early = 0, missed = 0;
+
+    void add(int64_t decided, const Trace &trace, float target) {
+        if (decided < 0) {
+            missed++;
+            return;
+        }
+        maxError = std::max(maxError, std::fabs(trace.kg[trace.index(decided)] - static_cast<double>(target)));
+        if (decided < trace.settle_us) {
+            early++;
+            return;
+        }
+        double delay = (decided - trace.settle_us) / 1e6;
+        sumDelay += delay;
+        maxDelay = std::max(maxDelay, delay);
+        decisions++;
+    }
+};
+
+void printRow(const char *scenario, const char *check, const Tally &t, int runs) {
+    printf("%-8s %-7s %10.2f %10.2f %8d/%d %8d/%d %10.3f\n", scenario, check,
+           t.decisions > 0 ? t.sumDelay / t.decisions : 0, t.maxDelay, t.early, runs, t.missed, runs, t.maxError);
+}
+
+void runScenarios() {
+    const float targets[] = {2, 5, 10};
+    printf("Settling check on synthetic fills, %d runs per scenario\n\n", kSeeds * 3);
+    printf("%-8s %-7s %10s %10s %10s %10s %10s\n", "trace", "check", "avg s", "max s", "early", "missed", "worst kg");
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        Tally oneHertz, filter;
+        for (float target : targets) {
+            for (int seed = 0; seed < kSeeds; seed++) {
+                double startDelay = 0.2 + seed / static_cast<double>(kSeeds);   // Phase against the 1 s loop
+                Trace trace = makeTrace(static_cast<Scenario>(s), target, startDelay, 100 * s + seed);
+                oneHertz.add(runOneHertz(trace, target), trace, target);
+                filter.add(runFilter(trace, target), trace, target);
+            }
+        }
+        printRow(kScenarioNames[s], "1 Hz", oneHertz, kSeeds * 3);
+        printRow(kScenarioNames[s], "filter", filter, kSeeds * 3);
+    }
+}
+
+bool loadCsv(const char *path, Trace &trace) {
+    FILE *in = fopen(path, "r");
+    if (in == nullptr) return false;
+    long long t;
+    float mv;
+    char line[128];
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        if (sscanf(line, "%lld,%f", &t, &mv) != 2) continue;    // Header or comment
+        trace.time_us.push_back(t);
+        trace.mv.push_back(mv);
+    }
+    fclose(in);
+    return !trace.time_us.empty();
+}
+
+void writeScenarios() {
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        Trace trace = makeTrace(static_cast<Scenario>(s), 2.0, 0.5, 100 * s);
+        std::string path = std::string("load_cell_") + kScenarioNames[s] + ".csv";
+        FILE *out = fopen(path.c_str(), "w");
+        if (out == nullptr) continue;
+        fprintf(out, "time_us,mV\n");
+        for (size_t i = 0; i < trace.time_us.size(); i++) {
+            fprintf(out, "%lld,%.0f\n", static_cast<long long>(trace.time_us[i]), trace.mv[i]);
+        }
+        fclose(out);
+        printf("%s: target 2 kg, settles at %.3f s\n", path.c_str(), trace.settle_us / 1e6);
+    }
+}
+
+// Real time of one LoadCellStats::push()
+void measureCpu() {
+    LoadCellStats stats;
+    stats.setTarget(2.0f);
+    const int kCalls = 1000000;
+    float sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCalls; i++) sink += stats.push(2.0f + (i % 7) * 0.01f).weight_kg;
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / kCalls;
+    printf("\nLoadCellStats::push(): %.0f ns per sample on the host (checksum %.0f)\n", ns, sink);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 1 && std::string(argv[1]) == "--write") {
+        writeScenarios();
+        return 0;
+    }
+    if (argc > 2) {
+        Trace trace;
+        if (!loadCsv(argv[1], trace)) {
+            fprintf(stderr, "Cannot read %s\n", argv[1]);
+            return 1;
+        }
+        float target = static_cast<float>(atof(argv[2]));
+        trace.settle_us = argc > 3 ? static_cast<int64_t>(atof(argv[3]) * 1e6) : -1;
+        int64_t oneHertz = runOneHertz(trace, target);
+        int64_t filter = runFilter(trace, target);
+        printf("%s, target %.2f kg\n", argv[1], target);
+        printf("1 Hz:   %s%.2f s\n", oneHertz < 0 ? "no decision, " : "", oneHertz / 1e6);
+        printf("filter: %s%.2f s\n", filter < 0 ? "no decision, " : "", filter / 1e6);
+        if (trace.settle_us >= 0) printf("true settle at %.2f s\n", trace.settle_us / 1e6);
+        return 0;
+    }
+    runScenarios();
+    measureCpu();
+    return 0;
+}
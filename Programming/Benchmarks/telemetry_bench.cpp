@@ -0,0 +1,149 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Benchmarks
+ * File: telemetry_bench.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Cost of one control-loop message on the host, TelemetryLog against
+ *   the printf it replaced ("Obstacle detected! At %.2f"):
+ *     - log(): one record into the ring, the drain measured apart
+ *     - log() from two and four threads at once, racing for the shared
+ *       head index (only meaningful on a multi-core host)
+ *     - snprintf() of the message alone, and fprintf() to /dev/null
+ *   and the bytes each one puts on the UART, with the wire time at the
+ *   console's 115200 baud and the telemetry port's 921600.
+ *   Usage: telemetry_bench [messages]
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <TelemetryLog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+size_t sinkBytes = 0;
+
+void countingSink(const uint8_t *data, size_t length) {
+    sinkBytes += length;
+}
+
+double nsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Distances the AGV would see while closing in on an obstacle
+float distanceAt(int i) {
+    return 30.0f - (i % 2000) * 0.01f;
+}
+
+// Logs in blocks of a ring's worth, draining between blocks outside the timed part
+void singleWriter(int messages, double &logNs, double &drainNs) {
+    static TelemetryLog log;
+    log.setup(countingSink, 0);
+    logNs = drainNs = 0;
+    for (int done = 0; done < messages; done += TelemetryLog::kCapacity) {
+        Clock::time_point t0 = Clock::now();
+        for (uint32_t i = 0; i < TelemetryLog::kCapacity; i++) {
+            log.log(TLM_AGV_OBSTACLE, tlmFloat(distanceAt(done + i)), 50);
+        }
+        logNs += nsSince(t0);
+        t0 = Clock::now();
+        log.drain();
+        drainNs += nsSince(t0);
+    }
+    int total = (messages + TelemetryLog::kCapacity - 1) / TelemetryLog::kCapacity * TelemetryLog::kCapacity;
+    logNs /= total;
+    drainNs /= total;
+}
+
+// Writers racing for slots: each round they share a ring's worth, the reader drains between rounds
+double contendedWriters(int writers, int messages) {
+    static TelemetryLog log;
+    log.setup(countingSink, 0);
+    const int share = TelemetryLog::kCapacity / writers;
+    const int rounds = messages / (share * writers);
+    std::atomic<int> round{-1};
+    std::atomic<int> finished{0};
+    std::atomic<int64_t> busyNs{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w]() {
+            for (int r = 0; r < rounds; r++) {
+                while (round.load(std::memory_order_acquire) < r) std::this_thread::yield();
+                Clock::time_point t0 = Clock::now();
+                for (int i = 0; i < share; i++) log.log(TLM_AGV_CYCLE, tlmFloat(distanceAt(i)), w);
+                busyNs += static_cast<int64_t>(nsSince(t0));
+                finished++;
+            }
+        });
+    }
+    for (int r = 0; r < rounds; r++) {
+        round.store(r, std::memory_order_release);
+        while (finished.load() < writers * (r + 1)) std::this_thread::yield();
+        log.drain();
+    }
+    for (std::thread &t : threads) t.join();
+    if (log.dropped() > 0) printf("Unexpected drops: %u\n", log.dropped());
+    return static_cast<double>(busyNs) / (static_cast<double>(rounds) * share * writers);
+}
+
+double snprintfCost(int messages) {
+    char line[64];
+    size_t total = 0;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < messages; i++) total += snprintf(line, sizeof(line), "Obstacle detected! At %.2f\n", distanceAt(i));
+    double ns = nsSince(t0) / messages;
+    if (total == 0) printf("?");                        // Keeps the loop
+    return ns;
+}
+
+double fprintfCost(int messages) {
+    FILE *null = fopen("/dev/null", "w");
+    if (null == nullptr) return 0;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < messages; i++) fprintf(null, "Obstacle detected! At %.2f\n", distanceAt(i));
+    double ns = nsSince(t0) / messages;
+    fclose(null);
+    return ns;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int messages = argc > 1 ? atoi(argv[1]) : 2000000;
+    double logNs, drainNs;
+    singleWriter(messages, logNs, drainNs);
+    double two = contendedWriters(2, messages);
+    double four = contendedWriters(4, messages);
+    double formatted = snprintfCost(messages);
+    double printed = fprintfCost(messages);
+    char line[64];
+    int textBytes = snprintf(line, sizeof(line), "Obstacle detected! At %.2f\n", 25.0f);
+
+    printf("Cost of one control-loop message, %d messages, host ns per call\n\n", messages);
+    printf("%-38s %10s\n", "path", "ns/msg");
+    printf("%-38s %10.1f\n", "TelemetryLog::log()", logNs);
+    printf("%-38s %10.1f\n", "  2 writers at once", two);
+    printf("%-38s %10.1f\n", "  4 writers at once", four);
+    printf("%-38s %10.1f\n", "  drain task, per record", drainNs);
+    printf("%-38s %10.1f\n", "snprintf(\"...%.2f\")", formatted);
+    printf("%-38s %10.1f\n", "fprintf(\"...%.2f\") to /dev/null", printed);
+
+    printf("\nUART bytes per message and wire time (10 bits per byte)\n\n");
+    printf("%-12s %8s %14s %14s\n", "format", "bytes", "115200 us", "921600 us");
+    printf("%-12s %8d %14.0f %14.0f\n", "text", textBytes, textBytes * 1e7 / 115200, textBytes * 1e7 / 921600);
+    printf("%-12s %8d %14.0f %14.0f\n", "record", static_cast<int>(kTelemetryRecordBytes),
+           kTelemetryRecordBytes * 1e7 / 115200, kTelemetryRecordBytes * 1e7 / 921600);
+    printf("\nRing: %u records, %u bytes of RAM\n", TelemetryLog::kCapacity,
+           static_cast<unsigned>(sizeof(TelemetryLog)));
+    return sinkBytes > 0 ? 0 : 1;
+}
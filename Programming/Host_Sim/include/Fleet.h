@@ -0,0 +1,75 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: Fleet.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Fleet model for delivery throughput: N AGVs feeding M scissor lifts.
+ *     - Every unit runs the firmware's own building blocks on its own
+ *       state: a StateMachine transition table per unit type, the
+ *       LineEstimator on a taped track every control period, the
+ *       LoadCellStats filter at 500 Hz while the basket fills, and the
+ *       lift and tilt StepProfile ramps step by step
+ *     - One virtual clock for the whole fleet, advanced in sync windows
+ *       (500 ms: the AGV repeats its status frame that often, so the lift
+ *       learns of a change within one window). Inside a window the units
+ *       are independent and run in parallel on a WorkPool; docking and
+ *       release are settled between windows, in unit order, so a run
+ *       gives the same result on any number of threads
+ *     - An AGV that reaches a lift's dock queues there; back from the
+ *       station it takes the lift with the shortest queue
+ *   Reports deliveries per hour, kilograms delivered, the dock queue wait
+ *   and the share of time each unit type spends in each state.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _FLEET_H_
+#define _FLEET_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// AGV: drive to a lift dock, wait in its queue, take the load, drive to the station, unload
+enum AgvPhase { agvToLift, agvQueued, agvCoupled, agvToStation, agvUnloading, agvPhaseCount };
+enum AgvEvent { agvArrived, agvGranted, agvReleased, agvUnloaded, agvEventCount };
+
+// Lift: fill the basket, wait for an AGV, lift, tilt, unload into the AGV, lower
+enum LiftPhase { liftFilling, liftWaiting, liftLifting, liftTilting, liftUnloading, liftLowering, liftPhaseCount };
+enum LiftEvent { liftDone, liftDocked, liftEventCount };
+
+struct FleetConfig {
+    int agvs = 4;
+    int lifts = 1;
+    int threads = 0;                    // 0 = one per core
+    double hours = 1.0;                 // Virtual time simulated
+    uint32_t seed = 1;                  // Obstacles, pour noise and batch weights
+    int64_t sync_us = 500000;           // Sync window, the AGV status frame repeat
+};
+
+struct FleetReport {
+    FleetConfig config;
+    uint64_t deliveries = 0;            // Loads unloaded at the station
+    double delivered_kg = 0;
+    double deliveriesPerHour = 0;
+    uint64_t queued = 0;                // Dockings, each with its wait in the queue
+    double queueMean_s = 0;
+    double queueMax_s = 0;
+    double queueP95_s = 0;
+    double agvShare[agvPhaseCount] = {};    // Fraction of AGV time in each phase, all AGVs
+    double liftShare[liftPhaseCount] = {};  // Fraction of lift time in each phase, all lifts
+    uint64_t windows = 0;
+    uint64_t steals = 0;                // Chunks run by a thread that did not own them
+    double wall_s = 0;
+
+    void print(FILE *out) const;
+};
+
+const char *agvPhaseName(int phase);
+const char *liftPhaseName(int phase);
+
+// Builds the fleet and runs it for config.hours of virtual time
+FleetReport runFleet(const FleetConfig &config);
+
+#endif // _FLEET_H_
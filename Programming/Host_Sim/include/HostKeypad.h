@@ -0,0 +1,90 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostKeypad.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Operator at a 4x4 matrix keypad, for Worlds of firmware that scans
+ *   the matrix itself. A column reads low while a held key's row is
+ *   driven low; the contacts bounce for kBounce_us after every press
+ *   and release.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_KEYPAD_H_
+#define _HOST_KEYPAD_H_
+
+#include <HostSim.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace hostsim {
+
+class KeyMatrix {
+public:
+    static constexpr int64_t kBounce_us = 3000;
+    static constexpr int64_t kBounceToggle_us = 300;    // Contact chatter period while bouncing
+
+    // rows/cols: pin numbers; map[row] holds the four key characters of that row
+    KeyMatrix(const uint8_t *rows, const uint8_t *cols, const char *const *map) {
+        for (int i = 0; i < 4; i++) {
+            rowPins[i] = rows[i];
+            colPins[i] = cols[i];
+            keys[i] = map[i];
+        }
+    }
+
+    // Schedule a key held from at_us for hold_us; false for a key not on the map
+    bool press(char key, int64_t at_us, int64_t hold_us) {
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) {
+                if (keys[r][c] != key) continue;
+                presses.push_back({r, c, at_us, at_us + hold_us});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isColumn(int pin) const {
+        for (int c = 0; c < 4; c++) {
+            if (colPins[c] == pin) return true;
+        }
+        return false;
+    }
+
+    // Level of a column pin given the rows the firmware drives (pulled up when open)
+    int columnLevel(int pin, const int *level) const {
+        int64_t now = clock().now();
+        for (const Press &p : presses) {
+            if (colPins[p.col] != pin || level[rowPins[p.row]] != 0) continue;
+            if (closed(p, now)) return 0;
+        }
+        return 1;
+    }
+
+private:
+    struct Press {
+        int row, col;
+        int64_t down_us, up_us;
+    };
+
+    static bool chatter(int64_t since_us) { return (since_us / kBounceToggle_us) % 2 == 0; }
+
+    static bool closed(const Press &p, int64_t t) {
+        if (t < p.down_us || t >= p.up_us + kBounce_us) return false;
+        if (t < p.down_us + kBounce_us) return chatter(t - p.down_us);          // Closing bounce
+        if (t < p.up_us) return true;
+        return !chatter(t - p.up_us);                                           // Opening bounce
+    }
+
+    int rowPins[4], colPins[4];
+    const char *keys[4];
+    std::vector<Press> presses;
+};
+
+} // namespace hostsim
+
+#endif // _HOST_KEYPAD_H_
@@ -0,0 +1,146 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostSim.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Core of the Linux host build. Provides:
+ *     - A discrete-event virtual clock that replaces esp_timer, FreeRTOS
+ *       ticks and ets_delay_us (time only moves when the firmware waits)
+ *     - A simulated GPIO bank shared by the stand-in libraries
+ *     - The World interface used by each firmware scenario to drive inputs
+ *       (line sensors, echo pins, keys, ADC...) and observe outputs
+ *     - runMission(), which runs app_main() against a World and reports
+ *     - The actuator log: every output change the firmware makes (GPIO
+ *       level, PWM duty, LCD text) with its time, one line each, so two
+ *       runs can be compared (live run against a sensor trace replay)
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_SIM_H_
+#define _HOST_SIM_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+constexpr int kPinCount = 40;                   // ESP32 GPIO 0..39
+constexpr int64_t kGpioReadCost_us = 1;         // Virtual cost of one SimpleGPIO::get()
+constexpr int64_t kAdcReadCost_us = 10;         // Virtual cost of one SimpleADC::read() conversion
+constexpr int64_t kLcdByteCost_us = 40;         // NibbleLCD character or command: two nibbles and the execution time
+constexpr int64_t kLcdClearCost_us = 1600;      // CMD_CLEAR and CMD_HOME execution time
+
+// Thrown when the virtual clock passes the mission deadline
+struct MissionTimeout : std::runtime_error {
+    explicit MissionTimeout(int64_t at_us);
+    int64_t at_us;
+};
+
+// Discrete-event clock: events fire in (time, insertion) order while advancing
+class VirtualClock {
+public:
+    using Event = std::function<void()>;
+
+    int64_t now() const { return now_us; }
+    uint64_t at(int64_t time_us, Event event);          // Schedule at absolute time
+    uint64_t after(int64_t delay_us, Event event);      // Schedule relative to now
+    void cancel(uint64_t id);
+    void advance(int64_t delta_us);                     // Move time forward, firing due events
+    int64_t nextEventTime();                            // Earliest pending event, INT64_MAX when none
+    void setDeadline(int64_t time_us) { deadline_us = time_us; }
+    uint64_t eventsFired() const { return fired; }
+    void reset();
+
+private:
+    struct Entry {
+        int64_t time_us;
+        uint64_t id;
+        bool operator>(const Entry &o) const {
+            return time_us != o.time_us ? time_us > o.time_us : id > o.id;
+        }
+    };
+    int64_t now_us = 0;
+    int64_t deadline_us = INT64_MAX;
+    uint64_t nextId = 1;
+    uint64_t fired = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    std::map<uint64_t, Event> pending;
+};
+
+// Environment model of one firmware; the default pin behaviour is a plain latch
+class World {
+public:
+    virtual ~World() = default;
+    virtual const char *name() const = 0;
+    virtual void begin() {}                                     // Called before app_main()
+    virtual void pinWritten(int pin, int level) {}              // Firmware drove an output
+    virtual int pinLevel(int pin);                              // Firmware samples an input
+    virtual float adcMilliVolts(int pin) { return 0.0f; }
+    virtual void pwmDuty(int pin, float percent) {}
+    virtual char nextKey() { return '\0'; }
+    virtual void lcdText(const char *text) {}                  // Visible screen after each LCD write
+    virtual bool missionComplete() const = 0;
+    virtual void report(FILE *out) const {}
+
+    void drive(int pin, int value);                             // Set an input, firing its GPIO ISR on an edge
+
+    int level[kPinCount] = {0};                                 // Latched pin levels
+};
+
+// GPIO ISR service entry for one pin (see driver/gpio.h)
+struct PinInterrupt {
+    void (*handler)(void *arg) = nullptr;
+    void *arg = nullptr;
+    int type = 0;                                               // gpio_int_type_t
+};
+
+// Simulator singletons
+VirtualClock &clock();
+World &world();
+PinInterrupt &pinInterrupt(int pin);
+bool verbose();
+
+// Makes world the active World on a fresh clock (used directly by host tests)
+void install(World &world);
+
+// Backing file of the NVS stand-in, read at nvs_flash_init(); nullptr keeps it in memory
+void setNvsFile(const char *path);
+
+// Capture file of a UART stand-in port, opened at uart_driver_install(); nullptr discards the bytes
+void setUartFile(int port, const char *path);
+
+// GPIO that UART0 reads as console RX: 3 until esp_rom_gpio_connect_in_signal() routes U0RXD elsewhere, -1 for no pad
+int consoleRxPin();
+
+// Actuator log, off until enabled; setActuatorFile() enables it and writes the log at the end of the mission
+void recordActuators(bool on);
+void setActuatorFile(const char *path);
+void quietActuator(int pin);                    // Leave a pin out of the log, e.g. a keypad row being scanned
+void actuatorGpio(int pin, int level);          // Called by the stand-ins on each output change
+void actuatorPwm(int pin, float percent);
+void actuatorLcd(const char *text);
+const std::string &actuatorLog();               // "time_us gpio pin level", "time_us pwm pin duty", "time_us lcd text"
+uint64_t actuatorCommands();
+
+// Log a timestamped line to stderr when running with -v
+void trace(const char *fmt, ...);
+
+// Prints the report and ends the process (any task may call it)
+[[noreturn]] void endMission(const char *outcome, int code);
+
+// Runs entry() (normally app_main) against the world until it returns,
+// calls exit() or the virtual deadline passes. Returns the process exit code.
+// Options: -v, --nvs file, --uartN file (N = 0..2), --actuators file
+int runMission(World &world, void (*entry)(), int64_t deadline_us, int argc, char **argv);
+
+} // namespace hostsim
+
+#endif // _HOST_SIM_H_
@@ -0,0 +1,42 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: NibbleLCD.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the NibbleLCD (HD44780, 4-bit bus) library. Models
+ *   the DDRAM and cursor of a 16x2 display: printStr() writes at the
+ *   cursor ('\n' moves to the second row), set-address commands (0x80 |
+ *   address) move it. Every byte costs bus time on the virtual clock; the
+ *   visible screen is handed to the active World and traced with -v.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _NIBBLE_LCD_H_
+#define _NIBBLE_LCD_H_
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include <cstdint>
+#include <cstdio>
+
+// HD44780 commands
+#define CMD_CLEAR 0x01
+#define CMD_HOME 0x02
+
+class NibbleLCD {
+public:
+    NibbleLCD();
+    void setup(uint8_t *pins);
+    void writeCommand(uint8_t command);
+    void printStr(const char *text);
+
+private:
+    void show();
+
+    char ddram[2][40];
+    int row = 0, col = 0;
+};
+
+#endif // _NIBBLE_LCD_H_
@@ -0,0 +1,37 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: SimpleADC.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the SimpleADC library. Readings come from the
+ *   active World in millivolts; raw counts assume an 11 dB, 3.3 V range.
+ *   Every read() costs kAdcReadCost_us of virtual time, like a conversion.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SIMPLE_ADC_H_
+#define _SIMPLE_ADC_H_
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include <cstdint>
+#include <cstdio>
+
+// Read modes
+#define ADC_READ_RAW 0
+#define ADC_READ_MV 1
+
+class SimpleADC {
+public:
+    void setup(int gpio, int width = 12);
+    float read(int mode = ADC_READ_RAW);
+    int pin() const { return gpio; }
+
+private:
+    int gpio = -1;
+    int width = 12;
+};
+
+#endif // _SIMPLE_ADC_H_
@@ -0,0 +1,42 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: SimpleGPIO.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the SimpleGPIO library. Pins live in the simulated
+ *   GPIO bank of the active World; every get() costs kGpioReadCost_us of
+ *   virtual time so busy-wait loops make progress.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SIMPLE_GPIO_H_
+#define _SIMPLE_GPIO_H_
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "rom/ets_sys.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Pin modes
+#define GPI 1           // Input
+#define GPO 2           // Output
+#define GPIO 3          // Input and output
+
+class SimpleGPIO {
+public:
+    void setup(int gpio, int mode, int pull = 0);
+    void set(int level);
+    int get();
+    int pin() const { return gpio; }
+
+private:
+    int gpio = -1;
+    int mode = 0;
+};
+
+#endif // _SIMPLE_GPIO_H_
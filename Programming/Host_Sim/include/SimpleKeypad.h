@@ -0,0 +1,30 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: SimpleKeypad.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the SimpleKeypad (4x4 matrix) library. Keys are
+ *   taken from the script of the active World.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SIMPLE_KEYPAD_H_
+#define _SIMPLE_KEYPAD_H_
+
+#include "freertos/FreeRTOS.h"
+#include <cstdint>
+
+class SimpleKeypad {
+public:
+    SimpleKeypad(uint8_t *rows, uint8_t *cols) : rows(rows), cols(cols) {}
+    void setup();
+    char getKey();
+
+private:
+    uint8_t *rows;
+    uint8_t *cols;
+};
+
+#endif // _SIMPLE_KEYPAD_H_
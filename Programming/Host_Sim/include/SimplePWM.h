@@ -0,0 +1,34 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: SimplePWM.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the SimplePWM (LEDC) library. Duty changes are
+ *   forwarded to the active World.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SIMPLE_PWM_H_
+#define _SIMPLE_PWM_H_
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include <cstdint>
+#include <cstdio>
+
+class SimplePWM {
+public:
+    void setup(int gpio, int channel, int frequency = 5000, int resolution = 10);
+    void setDuty(float percent);
+    float getDuty() const { return duty; }
+
+private:
+    int gpio = -1;
+    int channel = 0;
+    float duty = 0.0f;
+};
+
+#endif // _SIMPLE_PWM_H_
@@ -0,0 +1,35 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: SimpleTimer.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the SimpleTimer library, a thin wrapper over the
+ *   esp_timer stand-in (callbacks run when firmware time advances).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SIMPLE_TIMER_H_
+#define _SIMPLE_TIMER_H_
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include <cstdint>
+
+typedef void (*timer_cb_t)(void *arg);
+
+class SimpleTimer {
+public:
+    void setup(timer_cb_t callback, const char *name, void *arg = nullptr);
+    void startPeriodic(uint64_t period_us);
+    void startOnce(uint64_t timeout_us);
+    void stopPeriodic();
+    void stop() { stopPeriodic(); }
+
+private:
+    esp_timer_handle_t handle = nullptr;
+};
+
+#endif // _SIMPLE_TIMER_H_
@@ -0,0 +1,76 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: WorkPool.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Work-stealing thread pool for the host tools (fleet_sim):
+ *     - parallelFor() cuts a range into chunks and deals them out in
+ *       contiguous blocks, one deque per thread; the calling thread is
+ *       thread 0 and works too
+ *     - A thread takes its own chunks from the back of its deque and,
+ *       once it runs dry, steals from the front of the others, so a slow
+ *       chunk does not hold the rest of the range back
+ *     - Idle workers spin briefly before sleeping, since parallelFor() is
+ *       called once per simulation step
+ *   Host builds only.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _WORK_POOL_H_
+#define _WORK_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkPool {
+public:
+    using Body = std::function<void(size_t begin, size_t end)>;
+
+    explicit WorkPool(int threads = 0);         // 0 = one per core
+    ~WorkPool();
+    WorkPool(const WorkPool &) = delete;
+    WorkPool &operator=(const WorkPool &) = delete;
+
+    // Runs body over [0, count) in chunks of at most grain items; returns once all ran
+    void parallelFor(size_t count, size_t grain, const Body &body);
+
+    int threads() const { return static_cast<int>(queues.size()); }
+    uint64_t chunks() const { return ran.load(std::memory_order_relaxed); }
+    uint64_t steals() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk {
+        size_t begin, end;
+    };
+    struct Queue {                              // Owner pops the back, thieves take the front
+        std::mutex lock;
+        std::deque<Chunk> chunks;
+    };
+
+    bool take(int self, Chunk &chunk);
+    void runChunks(int self);
+    void workerLoop(int self);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    const Body *job = nullptr;                  // Set before the chunks are queued
+    std::atomic<size_t> remaining{0};           // Chunks of the current call not finished yet
+    std::atomic<uint64_t> generation{0};        // Bumped by every call, wakes the workers
+    std::atomic<bool> quit{false};
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    std::atomic<uint64_t> ran{0};
+    std::atomic<uint64_t> stolen{0};
+};
+
+#endif // _WORK_POOL_H_
@@ -0,0 +1,90 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: driver/rmt.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ESP-IDF RMT transmit driver (legacy API). Items
+ *   written to a channel memory block are played back as pin edges on the
+ *   virtual clock, and the tx-end callback runs when the block ends.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_DRIVER_RMT_H_
+#define _HOST_DRIVER_RMT_H_
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include <cstddef>
+#include <cstdint>
+
+#define RMT_MEM_ITEM_NUM 64                 // Items per memory block
+
+typedef enum {
+    RMT_CHANNEL_0, RMT_CHANNEL_1, RMT_CHANNEL_2, RMT_CHANNEL_3,
+    RMT_CHANNEL_4, RMT_CHANNEL_5, RMT_CHANNEL_6, RMT_CHANNEL_7,
+    RMT_CHANNEL_MAX,
+} rmt_channel_t;
+
+typedef enum {
+    RMT_MODE_TX = 0,
+    RMT_MODE_RX,
+} rmt_mode_t;
+
+typedef enum {
+    RMT_IDLE_LEVEL_LOW = 0,
+    RMT_IDLE_LEVEL_HIGH,
+} rmt_idle_level_t;
+
+// One item: level0 for duration0 ticks, then level1 for duration1; a zero duration ends the block
+typedef struct {
+    union {
+        struct {
+            uint32_t duration0 : 15;
+            uint32_t level0 : 1;
+            uint32_t duration1 : 15;
+            uint32_t level1 : 1;
+        };
+        uint32_t val;
+    };
+} rmt_item32_t;
+
+typedef struct {
+    bool loop_en;
+    bool carrier_en;
+    bool idle_output_en;
+    rmt_idle_level_t idle_level;
+} rmt_tx_config_t;
+
+typedef struct {
+    rmt_mode_t rmt_mode;
+    rmt_channel_t channel;
+    gpio_num_t gpio_num;
+    uint8_t clk_div;                        // 80 MHz APB clock divider, 80 = 1 us ticks
+    uint8_t mem_block_num;
+    uint32_t flags;
+    rmt_tx_config_t tx_config;
+} rmt_config_t;
+
+#define RMT_DEFAULT_CONFIG_TX(gpio, channel_id)                                             \
+    {                                                                                       \
+        RMT_MODE_TX, channel_id, gpio, 80, 1, 0, {false, false, true, RMT_IDLE_LEVEL_LOW}   \
+    }
+
+typedef void (*rmt_tx_end_fn_t)(rmt_channel_t channel, void *arg);
+typedef struct {
+    rmt_tx_end_fn_t function;
+    void *arg;
+} rmt_tx_end_callback_t;
+
+esp_err_t rmt_config(const rmt_config_t *rmt_param);
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t rx_buf_size, int intr_alloc_flags);
+esp_err_t rmt_driver_uninstall(rmt_channel_t channel);
+esp_err_t rmt_set_gpio(rmt_channel_t channel, rmt_mode_t mode, gpio_num_t gpio_num, bool invert_signal);
+esp_err_t rmt_fill_tx_items(rmt_channel_t channel, const rmt_item32_t *item, uint16_t item_num, uint16_t mem_offset);
+esp_err_t rmt_tx_start(rmt_channel_t channel, bool tx_idx_rst);
+esp_err_t rmt_tx_stop(rmt_channel_t channel);
+rmt_tx_end_callback_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void *arg);
+
+#endif // _HOST_DRIVER_RMT_H_
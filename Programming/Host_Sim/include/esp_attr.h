@@ -0,0 +1,18 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: esp_attr.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ESP-IDF placement attributes (no-ops on Linux).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_ESP_ATTR_H_
+#define _HOST_ESP_ATTR_H_
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif // _HOST_ESP_ATTR_H_
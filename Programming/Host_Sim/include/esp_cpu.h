@@ -0,0 +1,28 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: esp_cpu.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the CPU cycle counter. Counts real host time in
+ *   240 MHz cycles, so handler costs measured on the host are comparable
+ *   between implementations (not with the ESP32 itself).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_ESP_CPU_H_
+#define _HOST_ESP_CPU_H_
+
+#include <chrono>
+#include <cstdint>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count() {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<esp_cpu_cycle_count_t>(ns * 240 / 1000);
+}
+
+#endif // _HOST_ESP_CPU_H_
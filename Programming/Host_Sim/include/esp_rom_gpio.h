@@ -0,0 +1,21 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: esp_rom_gpio.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ROM GPIO matrix routing, input side only: only
+ *   the console RX signal (U0RXD_IN_IDX) is modelled, so the UART
+ *   stand-in knows whether UART0 still reads GPIO 3.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_ESP_ROM_GPIO_H_
+#define _HOST_ESP_ROM_GPIO_H_
+
+#include <cstdint>
+
+void esp_rom_gpio_connect_in_signal(uint32_t gpio_num, uint32_t signal_idx, bool inv);
+
+#endif // _HOST_ESP_ROM_GPIO_H_
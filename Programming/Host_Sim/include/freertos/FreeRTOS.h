@@ -0,0 +1,32 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: freertos/FreeRTOS.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the FreeRTOS base types. One tick = 1 ms,
+ *   matching CONFIG_FREERTOS_HZ=1000 on the ESP32 targets.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_FREERTOS_H_
+#define _HOST_FREERTOS_H_
+
+#include <cstdint>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portYIELD_FROM_ISR(...) ((void)0)            // The woken task runs at the next switch anyway
+
+#include "freertos/task.h"
+
+#endif // _HOST_FREERTOS_H_
@@ -0,0 +1,41 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: freertos/task.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the FreeRTOS task API. Tasks are threads that take
+ *   turns on a single baton (see HostTasks.cpp): vTaskDelay advances the
+ *   virtual clock to the earliest waking task and switches to it, so runs
+ *   stay deterministic. Core affinity is recorded but not simulated.
+ *   Direct-to-task notifications wake a task blocked in ulTaskNotifyTake()
+ *   at the virtual time of the notify, even when it comes from an ISR.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_FREERTOS_TASK_H_
+#define _HOST_FREERTOS_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *createdTask, BaseType_t coreId);
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *createdTask);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken);
+
+#endif // _HOST_FREERTOS_TASK_H_
@@ -0,0 +1,20 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: nvs_flash.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the NVS partition init and erase calls.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_NVS_FLASH_H_
+#define _HOST_NVS_FLASH_H_
+
+#include "nvs.h"
+
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
+
+#endif // _HOST_NVS_FLASH_H_
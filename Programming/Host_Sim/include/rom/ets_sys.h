@@ -0,0 +1,19 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: rom/ets_sys.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ROM busy-wait delay; advances the virtual clock.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_ETS_SYS_H_
+#define _HOST_ETS_SYS_H_
+
+#include <cstdint>
+
+void ets_delay_us(uint32_t us);
+
+#endif // _HOST_ETS_SYS_H_
@@ -0,0 +1,27 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: soc/gpio_reg.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ESP32 GPIO register addresses used by FastPin:
+ *   output, write-one-to-set, write-one-to-clear and input, for GPIO 0-31
+ *   and for GPIO 32-39 (the *1* registers, bit 0 is GPIO 32).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_GPIO_REG_H_
+#define _HOST_GPIO_REG_H_
+
+#define DR_REG_GPIO_BASE 0x3ff44000
+#define GPIO_OUT_REG (DR_REG_GPIO_BASE + 0x0004)
+#define GPIO_OUT_W1TS_REG (DR_REG_GPIO_BASE + 0x0008)
+#define GPIO_OUT_W1TC_REG (DR_REG_GPIO_BASE + 0x000c)
+#define GPIO_OUT1_REG (DR_REG_GPIO_BASE + 0x0010)
+#define GPIO_OUT1_W1TS_REG (DR_REG_GPIO_BASE + 0x0014)
+#define GPIO_OUT1_W1TC_REG (DR_REG_GPIO_BASE + 0x0018)
+#define GPIO_IN_REG (DR_REG_GPIO_BASE + 0x003c)
+#define GPIO_IN1_REG (DR_REG_GPIO_BASE + 0x0040)
+
+#endif // _HOST_GPIO_REG_H_
@@ -0,0 +1,19 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: soc/gpio_sig_map.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the ESP32 GPIO matrix signal numbers used by the
+ *   firmware: the console RX input and the constant-high input source.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_GPIO_SIG_MAP_H_
+#define _HOST_GPIO_SIG_MAP_H_
+
+#define U0RXD_IN_IDX 14
+#define GPIO_FUNC_IN_HIGH 0x38      // Input signal held at 1, no pad
+
+#endif // _HOST_GPIO_SIG_MAP_H_
@@ -0,0 +1,26 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: soc/soc.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host stand-in for the peripheral register access macros. Only the GPIO
+ *   registers of soc/gpio_reg.h exist; they are kept in HostHal.cpp.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_SOC_H_
+#define _HOST_SOC_H_
+
+#include <cstdint>
+
+namespace hostsim {
+uint32_t regRead(uint32_t reg);
+void regWrite(uint32_t reg, uint32_t value);
+}
+
+#define REG_READ(_r) hostsim::regRead(_r)
+#define REG_WRITE(_r, _v) hostsim::regWrite((_r), (_v))
+
+#endif // _HOST_SOC_H_
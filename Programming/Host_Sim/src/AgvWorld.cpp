@@ -0,0 +1,187 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: AgvWorld.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Environment model for AGV_State_Machine/main.cpp, including:
+ *     - 1D track with line tape, curves and two station marks
+ *     - Drive-train model (first order speed lag) fed by the motor duties
+ *     - HC-SR04 echo timing for an obstacle crossing the aisle (front
+ *       sensor) and open floor (left and right sensors)
+ *     - Lift side of the communication wire: decodes the status frames
+ *     - LED observers for the report
+ *   Builds the agv_sim executable, which runs the unmodified app_main().
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ComLink.h>
+#include <HostSim.h>
+
+#include <algorithm>
+#include <cmath>
+
+extern "C" void app_main();
+
+namespace {
+
+// Pins, mirrors AGV_State_Machine/definitions.h
+constexpr int kMotor1Pin = 25;
+constexpr int kMotor2Pin = 26;
+constexpr int kLine1Pin = 33;
+constexpr int kLine2Pin = 32;
+constexpr int kTrigPin = 17;
+constexpr int kEchoPin = 18;
+constexpr int kSideTrigPins[2] = {13, 14};
+constexpr int kSideEchoPins[2] = {34, 35};
+constexpr int kComPin = 16;
+constexpr int kGreenLedPin = 2;
+constexpr int kRedLedPin = 4;
+
+// Drive train
+constexpr double kFullSpeed_cm_s = 40.0;        // Speed at 100 % duty on both motors
+constexpr double kSpeedLag_s = 0.15;            // First order time constant
+
+// HC-SR04
+constexpr int64_t kEchoDelay_us = 450;          // Trigger to echo rising edge
+constexpr double kEchoPerCm_us = 58.3;          // Round trip at 343 m/s
+constexpr int64_t kNoEcho_us = 38000;           // Pulse width when nothing is in range
+constexpr double kMaxRange_cm = 400.0;
+
+// Track: tape segments with the expected (left, right) sensor reading
+struct Segment {
+    double from_cm, to_cm;
+    int left, right;
+};
+
+const Segment kTrack[] = {
+    {60, 80, 0, 1},                             // Gentle left curve
+    {110, 130, 1, 0},                           // Gentle right curve
+    {150, 165, 0, 0},                           // Lift coupling mark
+    {600, 615, 0, 0},                           // Unloading station mark
+};
+constexpr double kStationFrom_cm = 600;
+constexpr double kStationTo_cm = 615;
+
+// Obstacle crossing the aisle
+constexpr double kObstacle_cm = 330;
+constexpr int64_t kObstacleOn_us = 15000000;
+constexpr int64_t kObstacleOff_us = 22000000;
+
+class AgvWorld : public hostsim::World {
+public:
+    const char *name() const override { return "AGV"; }
+
+    void pinWritten(int pin, int value) override {
+        if (pin == kTrigPin) {
+            if (lastTrig == 1 && value == 0) startEcho();   // HC-SR04 fires on the falling edge
+            lastTrig = value;
+        }
+        else if (pin == kSideTrigPins[0] || pin == kSideTrigPins[1]) {
+            int side = pin == kSideTrigPins[0] ? 0 : 1;
+            if (lastSideTrig[side] == 1 && value == 0) {
+                sidePings++;
+                int echo = kSideEchoPins[side];
+                hostsim::clock().after(kEchoDelay_us, [this, echo]() { drive(echo, 1); });
+                hostsim::clock().after(kEchoDelay_us + kNoEcho_us, [this, echo]() { drive(echo, 0); });
+            }
+            lastSideTrig[side] = value;
+        }
+        else if (pin == kComPin && value != lastCom) {
+            lastCom = value;
+            ComMessage msg;
+            if (comDecoder.edge(hostsim::clock().now(), value, msg)) {
+                comFrames[msg.type]++;
+                hostsim::trace("COM  %s %u", comTypeName(msg.type), msg.value);
+            }
+        }
+        else if (pin == kGreenLedPin && value) greenBlinks++;
+        else if (pin == kRedLedPin && value) redBlinks++;
+    }
+
+    int pinLevel(int pin) override {
+        if (pin == kLine1Pin || pin == kLine2Pin) {
+            integrate();
+            int left = 1, right = 1;
+            for (const Segment &s : kTrack) {
+                if (position >= s.from_cm && position < s.to_cm) {
+                    left = s.left;
+                    right = s.right;
+                }
+            }
+            return pin == kLine1Pin ? left : right;
+        }
+        return World::pinLevel(pin);
+    }
+
+    void pwmDuty(int pin, float percent) override {
+        integrate();
+        if (pin == kMotor1Pin) duty1 = percent;
+        else if (pin == kMotor2Pin) duty2 = percent;
+    }
+
+    bool missionComplete() const override {
+        return position >= kStationFrom_cm && position < kStationTo_cm && minGap > 0 && comFrames[COM_COUPLED] > 0 &&
+               comFrames[COM_OBSTACLE] > 0 && comFrames[COM_ARRIVED] == 1 && comFrames[COM_ABORT] == 0;
+    }
+
+    void report(FILE *out) const override {
+        fprintf(out, "Final position: %.1f cm (station %.0f-%.0f cm)\n", position, kStationFrom_cm, kStationTo_cm);
+        fprintf(out, "Obstacle gap:   %.1f cm minimum\n", minGap);
+        fprintf(out, "Pings:          %d front, %d sides\n", pings, sidePings);
+        const ComLinkStats &com = comDecoder.stats();
+        fprintf(out, "Com frames:     %d coupled, %d obstacle, %d arrived, %d abort (%lu bad)\n", comFrames[COM_COUPLED],
+                comFrames[COM_OBSTACLE], comFrames[COM_ARRIVED], comFrames[COM_ABORT],
+                static_cast<unsigned long>(com.crcErrors + com.framingErrors));
+        fprintf(out, "LED blinks:     %d green, %d red\n", greenBlinks, redBlinks);
+    }
+
+private:
+    bool obstaclePresent(int64_t now) const {
+        return now >= kObstacleOn_us && now < kObstacleOff_us;
+    }
+
+    // Advance the drive-train model up to the current virtual time
+    void integrate() {
+        int64_t now = hostsim::clock().now();
+        double dt = (now - lastUpdate) * 1e-6;
+        lastUpdate = now;
+        if (dt <= 0) return;
+        double target = kFullSpeed_cm_s * (duty1 + duty2) / 200.0;
+        double decay = std::exp(-dt / kSpeedLag_s);
+        position += target * dt + (velocity - target) * kSpeedLag_s * (1.0 - decay);
+        velocity = target + (velocity - target) * decay;
+        if (obstaclePresent(now) && position < kObstacle_cm) minGap = std::min(minGap, kObstacle_cm - position);
+        if (obstaclePresent(now) && position >= kObstacle_cm) minGap = 0;
+    }
+
+    void startEcho() {
+        integrate();
+        pings++;
+        int64_t now = hostsim::clock().now();
+        double range = kObstacle_cm - position;
+        int64_t width = kNoEcho_us;
+        if (obstaclePresent(now) && range > 0 && range < kMaxRange_cm) width = static_cast<int64_t>(range * kEchoPerCm_us);
+        hostsim::clock().after(kEchoDelay_us, [this]() { drive(kEchoPin, 1); });
+        hostsim::clock().after(kEchoDelay_us + width, [this]() { drive(kEchoPin, 0); });
+    }
+
+    double position = 0, velocity = 0;
+    double duty1 = 0, duty2 = 0;
+    double minGap = 1e9;
+    int64_t lastUpdate = 0;
+    int lastTrig = 0, lastCom = 0;
+    int lastSideTrig[2] = {};
+    int sidePings = 0;
+    int pings = 0, greenBlinks = 0, redBlinks = 0;
+    ComDecoder comDecoder;
+    int comFrames[COM_TYPE_COUNT] = {};
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    static AgvWorld world;
+    return hostsim::runMission(world, app_main, 120 * 1000000LL, argc, argv);
+}
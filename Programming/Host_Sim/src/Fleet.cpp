@@ -0,0 +1,530 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: Fleet.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Units, sync windows and statistics of the fleet model (Fleet.h).
+ *   A unit only ever waits for another one while it is idle (an AGV in a
+ *   dock queue or coupled, a lift with a full basket), so a docking is
+ *   settled at its exact time: the later of the AGV arrival and the lift
+ *   becoming ready. The sync window only bounds how far a unit runs ahead
+ *   of the others.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <Fleet.h>
+#include <WorkPool.h>
+#include <LineController.h>
+#include <LoadCellFilter.h>
+#include <StateMachine.h>
+#include <StepperProfile.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <memory>
+
+namespace {
+
+// AGV, as in AGV_State_Machine/main.cpp and the AGV world
+constexpr int64_t kControlPeriod_us = 10000;    // CONTROL_PERIOD_MS
+constexpr double kCruise_cm_s = 40.0 * 50 / 100;// kFullSpeed_cm_s at CRUISE_DUTY
+constexpr double kSpeedLag_s = 0.15;            // Drive-train time constant
+constexpr double kCurveSlowdown = 0.1;          // Speed lost per unit of line error (differential duties)
+constexpr double kFirstLeg_cm = 150;            // Start to the lift coupling mark
+constexpr double kLeg_cm = 450;                 // Lift mark to station mark, and back
+constexpr double kMark_cm = 15;
+constexpr double kCurve_cm = 20;
+constexpr double kObstacleChance = 0.25;        // Per leg
+constexpr int64_t kObstacleMin_us = 2000000;    // Time the aisle stays blocked
+constexpr int64_t kObstacleMax_us = 8000000;
+constexpr int64_t kStationUnload_us = 3000000;
+
+// Scissor lift, as in ScissorLift_StateMachine/main.cpp and the lift world
+const MotionProfile kLiftMotion = {200, 1000, 8000, PROFILE_SCURVE};
+const MotionProfile kTiltMotion = {100, 400, 2000, PROFILE_TRAPEZOID};
+constexpr int32_t kLiftSteps = 1000;            // Rest to the height sensor
+constexpr int32_t kTiltSteps = 150;             // TILT_STEPS
+constexpr int64_t kLoadPeriod_us = LoadCellFilter::kDefaultPeriod_us;
+constexpr int64_t kFillTime_us = 4000000;       // Time to pour a batch
+constexpr int64_t kFillGiveUp_us = 30000000;    // Go on with an unsettled reading after this
+constexpr double kPourNoise_kg = 0.03;          // Standard deviation of one reading
+constexpr double kBatchMin_kg = 8.0;
+constexpr double kBatchMax_kg = 12.0;
+constexpr int64_t kServoOpen_us = 1000000;      // SERVO_OPEN_MS
+
+// TRANSITION TABLES
+constexpr Transition<AgvPhase, AgvEvent> agvTransitions[] = {
+    {agvToLift, agvArrived, agvQueued, nullptr, nullptr},
+    {agvQueued, agvGranted, agvCoupled, nullptr, nullptr},
+    {agvCoupled, agvReleased, agvToStation, nullptr, nullptr},
+    {agvToStation, agvArrived, agvUnloading, nullptr, nullptr},
+    {agvUnloading, agvUnloaded, agvToLift, nullptr, nullptr},
+};
+constexpr auto agvTable = makeTable<agvPhaseCount, agvEventCount>(agvTransitions);
+
+constexpr Transition<LiftPhase, LiftEvent> liftTransitions[] = {
+    {liftFilling, liftDone, liftWaiting, nullptr, nullptr},
+    {liftWaiting, liftDocked, liftLifting, nullptr, nullptr},
+    {liftLifting, liftDone, liftTilting, nullptr, nullptr},
+    {liftTilting, liftDone, liftUnloading, nullptr, nullptr},
+    {liftUnloading, liftDone, liftLowering, nullptr, nullptr},
+    {liftLowering, liftDone, liftFilling, nullptr, nullptr},
+};
+constexpr auto liftTable = makeTable<liftPhaseCount, liftEventCount>(liftTransitions);
+
+// Every thread runs one unit at a time; its state machine reads that unit's time
+thread_local int64_t unitNow_us = 0;
+
+int64_t unitClock() {
+    return unitNow_us;
+}
+
+// Deterministic per-unit random numbers
+class UnitRandom {
+public:
+    UnitRandom(uint32_t seed, uint32_t unit) : state(seed * 2654435761u ^ (unit + 1) * 40503u) {
+        for (int i = 0; i < 4; i++) next();
+    }
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    }
+    double uniform() { return (next() >> 8) / static_cast<double>(1 << 24); }
+    double uniform(double low, double high) { return low + (high - low) * uniform(); }
+    // Roughly normal (sum of four uniforms), unit variance
+    double noise() {
+        double sum = 0;
+        for (int i = 0; i < 4; i++) sum += uniform() - 0.5;
+        return sum * std::sqrt(3.0);
+    }
+
+private:
+    uint32_t state;
+};
+
+// What a unit did that another unit has to know, settled between windows
+enum NoteKind { noteArrived, noteReleased, noteUnloaded };
+
+struct Note {
+    int64_t time_us;
+    int unit;                           // Unit that wrote it, AGVs first then lifts
+    NoteKind kind;
+    int other;                          // Lift for noteArrived, AGV for noteReleased
+    float kg;
+};
+
+// AGV
+class Agv {
+public:
+    Agv(int index, uint32_t seed, int lift) : index(index), lift(lift), random(seed, index), fsm(agvToLift, nullptr, unitClock) {
+        startLeg(kFirstLeg_cm);
+    }
+
+    void advance(int64_t end_us) {
+        while (time_us < end_us) {
+            unitNow_us = time_us;
+            switch (fsm.state()) {
+                case agvToLift:
+                case agvToStation:
+                    drive();
+                    break;
+                case agvUnloading:
+                    time_us = std::min(end_us, unloadDoneAt_us);
+                    unitNow_us = time_us;
+                    if (time_us == unloadDoneAt_us) {
+                        notes.push_back({time_us, index, noteUnloaded, lift, load_kg});
+                        enter(agvUnloaded);
+                    }
+                    break;
+                default:
+                    return;                     // Queued or coupled: idle until the lift acts
+            }
+        }
+    }
+
+    // Called between windows
+    void granted(int64_t at_us) {
+        time_us = at_us;
+        enter(agvGranted);
+    }
+
+    void released(int64_t at_us, float kg) {
+        time_us = at_us;
+        load_kg = kg;
+        enter(agvReleased);
+    }
+
+    AgvPhase phase() const { return fsm.state(); }
+    int64_t timeIn(int phase, int64_t horizon_us) const {
+        int64_t open = phase == fsm.state() ? std::max<int64_t>(0, horizon_us - since_us) : 0;
+        return fsm.timeIn(static_cast<AgvPhase>(phase)) + open;
+    }
+
+    const int index;
+    int lift;                           // Dock this AGV is heading for or queued at
+    int64_t time_us = 0;
+    std::vector<Note> notes;
+
+private:
+    void enter(AgvEvent event) {
+        unitNow_us = time_us;
+        fsm.dispatch(event);
+        since_us = time_us;
+        switch (fsm.state()) {
+            case agvToLift:
+            case agvToStation:
+                startLeg(kLeg_cm);
+                break;
+            case agvUnloading:
+                unloadDoneAt_us = time_us + kStationUnload_us;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void startLeg(double length_cm) {
+        leg_cm = length_cm;
+        distance_cm = 0;
+        velocity_cm_s = 0;
+        error = 0;
+        line.reset();
+        obstacle_cm = random.uniform() < kObstacleChance ? random.uniform(0.2, 0.8) * length_cm : -1;
+        blockedUntil_us = 0;
+    }
+
+    // Tape under the two sensors at a distance along the leg: two curves, then the mark at the end
+    void tape(double d, int &left, int &right) const {
+        left = right = 1;
+        if (d >= leg_cm - kMark_cm) left = right = 0;
+        else if (d >= 0.3 * leg_cm && d < 0.3 * leg_cm + kCurve_cm) left = 0;
+        else if (d >= 0.6 * leg_cm && d < 0.6 * leg_cm + kCurve_cm) right = 0;
+    }
+
+    // One control period: drive-train lag, obstacle stop, line sensors
+    void drive() {
+        double target = time_us < blockedUntil_us ? 0 : kCruise_cm_s * (1.0 - kCurveSlowdown * std::abs(error));
+        double dt = kControlPeriod_us * 1e-6;
+        double decay = std::exp(-dt / kSpeedLag_s);
+        distance_cm += target * dt + (velocity_cm_s - target) * kSpeedLag_s * (1.0 - decay);
+        velocity_cm_s = target + (velocity_cm_s - target) * decay;
+        time_us += kControlPeriod_us;
+        if (obstacle_cm >= 0 && distance_cm >= obstacle_cm) {
+            blockedUntil_us = time_us + static_cast<int64_t>(random.uniform(kObstacleMin_us, kObstacleMax_us));
+            obstacle_cm = -1;
+        }
+        int left, right;
+        tape(distance_cm, left, right);
+        error = line.update(left, right);
+        if (!line.atMark()) return;
+        if (fsm.state() == agvToLift) notes.push_back({time_us, index, noteArrived, lift, 0});
+        enter(agvArrived);
+    }
+
+    UnitRandom random;
+    StateMachine<agvTable> fsm;
+    LineEstimator line;
+    int64_t since_us = 0;
+    double leg_cm = 0, distance_cm = 0, velocity_cm_s = 0;
+    int error = 0;
+    double obstacle_cm = -1;
+    int64_t blockedUntil_us = 0;
+    int64_t unloadDoneAt_us = 0;
+    float load_kg = 0;
+};
+
+// SCISSOR LIFT
+class Lift {
+public:
+    Lift(int index, int unit, uint32_t seed) : index(index), unit(unit), random(seed, unit), fsm(liftFilling, nullptr, unitClock) {
+        liftProfile.build(kLiftMotion);
+        tiltProfile.build(kTiltMotion);
+        startFill();
+    }
+
+    void advance(int64_t end_us) {
+        while (time_us < end_us) {
+            unitNow_us = time_us;
+            switch (fsm.state()) {
+                case liftFilling:
+                    sampleLoad();
+                    break;
+                case liftLifting:
+                case liftLowering:
+                    step(liftProfile);
+                    break;
+                case liftTilting:
+                    step(tiltProfile);
+                    break;
+                case liftUnloading:
+                    time_us = std::min(end_us, servoDoneAt_us);
+                    if (time_us == servoDoneAt_us) {
+                        notes.push_back({time_us, unit, noteReleased, agv, batch_kg});
+                        enter(liftDone);
+                    }
+                    break;
+                default:
+                    return;                     // Waiting with a full basket
+            }
+        }
+    }
+
+    // Called between windows
+    void docked(int64_t at_us, int agvIndex) {
+        time_us = at_us;
+        agv = agvIndex;
+        enter(liftDocked);
+    }
+
+    LiftPhase phase() const { return fsm.state(); }
+    int64_t timeIn(int phase, int64_t horizon_us) const {
+        int64_t open = phase == fsm.state() ? std::max<int64_t>(0, horizon_us - since_us) : 0;
+        return fsm.timeIn(static_cast<LiftPhase>(phase)) + open;
+    }
+
+    struct Waiting {
+        int agv;
+        int64_t since_us;
+    };
+
+    const int index;
+    const int unit;
+    int64_t time_us = 0;
+    std::deque<Waiting> queue;          // AGVs at the dock, in arrival order
+    int inbound = 0;                    // AGVs heading for this dock
+    uint32_t unsettled = 0;             // Fills that gave up waiting for a settled reading
+    std::vector<Note> notes;
+
+private:
+    void enter(LiftEvent event) {
+        unitNow_us = time_us;
+        fsm.dispatch(event);
+        since_us = time_us;
+        switch (fsm.state()) {
+            case liftFilling:
+                startFill();
+                break;
+            case liftLifting:
+            case liftLowering:
+                liftProfile.begin(kLiftSteps);
+                break;
+            case liftTilting:
+                tiltProfile.begin(kTiltSteps);
+                break;
+            case liftUnloading:
+                servoDoneAt_us = time_us + kServoOpen_us;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void startFill() {
+        batch_kg = static_cast<float>(random.uniform(kBatchMin_kg, kBatchMax_kg));
+        cell.reset();
+        cell.setTarget(batch_kg);
+        fillStart_us = time_us;
+    }
+
+    // One load cell sample of the beans pouring in
+    void sampleLoad() {
+        time_us += kLoadPeriod_us;
+        double progress = std::min(1.0, (time_us - fillStart_us) / static_cast<double>(kFillTime_us));
+        LoadStats load = cell.push(static_cast<float>(progress * batch_kg + random.noise() * kPourNoise_kg));
+        if (load.settled) enter(liftDone);
+        else if (time_us - fillStart_us >= kFillGiveUp_us) {
+            unsettled++;
+            enter(liftDone);
+        }
+    }
+
+    void step(StepProfile &profile) {
+        uint32_t interval = profile.nextStep();
+        if (interval == 0) enter(liftDone);
+        else time_us += interval;
+    }
+
+    UnitRandom random;
+    StateMachine<liftTable> fsm;
+    LoadCellStats cell;
+    StepProfile liftProfile, tiltProfile;
+    int64_t since_us = 0;
+    int64_t fillStart_us = 0;
+    int64_t servoDoneAt_us = 0;
+    float batch_kg = 0;
+    int agv = -1;                       // AGV coupled under the basket
+};
+
+// FLEET
+class Fleet {
+public:
+    explicit Fleet(const FleetConfig &config) : config(config) {
+        unitNow_us = 0;                 // The state machines start their first state now
+        for (int i = 0; i < config.lifts; i++) lifts.push_back(std::make_unique<Lift>(i, config.agvs + i, config.seed));
+        for (int i = 0; i < config.agvs; i++) {
+            agvs.push_back(std::make_unique<Agv>(i, config.seed, i % config.lifts));
+            lifts[i % config.lifts]->inbound++;
+        }
+    }
+
+    void run(FleetReport &report) {
+        WorkPool pool(config.threads);
+        int64_t horizon_us = static_cast<int64_t>(config.hours * 3600e6);
+        size_t units = agvs.size() + lifts.size();
+        size_t grain = std::max<size_t>(1, units / (pool.threads() * 8));
+        for (int64_t end_us = 0; end_us < horizon_us;) {
+            end_us = std::min(horizon_us, end_us + config.sync_us);
+            pool.parallelFor(units, grain, [&](size_t begin, size_t last) {
+                for (size_t u = begin; u < last; u++) {
+                    if (u < agvs.size()) agvs[u]->advance(end_us);
+                    else lifts[u - agvs.size()]->advance(end_us);
+                }
+            });
+            settle(horizon_us);
+            report.windows++;
+        }
+        report.config.threads = pool.threads();
+        report.steals = pool.steals();
+        summarize(horizon_us, report);
+    }
+
+private:
+    // Between windows, single threaded: apply the notes in time order, then dock
+    void settle(int64_t horizon_us) {
+        notes.clear();
+        for (auto &agv : agvs) {
+            notes.insert(notes.end(), agv->notes.begin(), agv->notes.end());
+            agv->notes.clear();
+        }
+        for (auto &lift : lifts) {
+            notes.insert(notes.end(), lift->notes.begin(), lift->notes.end());
+            lift->notes.clear();
+        }
+        std::sort(notes.begin(), notes.end(), [](const Note &a, const Note &b) {
+            return a.time_us != b.time_us ? a.time_us < b.time_us : a.unit < b.unit;
+        });
+        for (const Note &note : notes) {
+            switch (note.kind) {
+                case noteArrived:
+                    lifts[note.other]->inbound--;
+                    lifts[note.other]->queue.push_back({note.unit, note.time_us});
+                    break;
+                case noteReleased:
+                    agvs[note.other]->released(note.time_us, note.kg);
+                    break;
+                case noteUnloaded:
+                    if (note.time_us <= horizon_us) {
+                        deliveries++;
+                        delivered_kg += note.kg;
+                    }
+                    route(*agvs[note.unit]);
+                    break;
+            }
+        }
+        for (auto &lift : lifts) {
+            if (lift->phase() != liftWaiting || lift->queue.empty()) continue;
+            Lift::Waiting next = lift->queue.front();
+            lift->queue.pop_front();
+            int64_t at_us = std::max(lift->time_us, next.since_us);
+            waits_s.push_back((at_us - next.since_us) * 1e-6);
+            lift->docked(at_us, next.agv);
+            agvs[next.agv]->granted(at_us);
+        }
+    }
+
+    // Back from the station: the dock with the fewest AGVs queued or on the way
+    void route(Agv &agv) {
+        int best = 0;
+        size_t bestLoad = SIZE_MAX;
+        for (auto &lift : lifts) {
+            size_t load = lift->queue.size() + lift->inbound;
+            if (load < bestLoad) {
+                best = lift->index;
+                bestLoad = load;
+            }
+        }
+        agv.lift = best;
+        lifts[best]->inbound++;
+    }
+
+    void summarize(int64_t horizon_us, FleetReport &report) const {
+        report.deliveries = deliveries;
+        report.delivered_kg = delivered_kg;
+        report.deliveriesPerHour = deliveries / config.hours;
+        report.queued = waits_s.size();
+        if (!waits_s.empty()) {
+            std::vector<double> sorted = waits_s;
+            std::sort(sorted.begin(), sorted.end());
+            double sum = 0;
+            for (double w : sorted) sum += w;
+            report.queueMean_s = sum / sorted.size();
+            report.queueMax_s = sorted.back();
+            report.queueP95_s = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+        }
+        for (int p = 0; p < agvPhaseCount; p++) {
+            int64_t total = 0;
+            for (auto &agv : agvs) total += agv->timeIn(p, horizon_us);
+            report.agvShare[p] = agvs.empty() ? 0 : total / (static_cast<double>(horizon_us) * agvs.size());
+        }
+        for (int p = 0; p < liftPhaseCount; p++) {
+            int64_t total = 0;
+            for (auto &lift : lifts) total += lift->timeIn(p, horizon_us);
+            report.liftShare[p] = total / (static_cast<double>(horizon_us) * lifts.size());
+        }
+    }
+
+    const FleetConfig config;
+    std::vector<std::unique_ptr<Agv>> agvs;
+    std::vector<std::unique_ptr<Lift>> lifts;
+    std::vector<Note> notes;
+    std::vector<double> waits_s;
+    uint64_t deliveries = 0;
+    double delivered_kg = 0;
+};
+
+const char *const kAgvPhaseNames[agvPhaseCount] = {"to lift", "queued", "coupled", "to station", "unloading"};
+const char *const kLiftPhaseNames[liftPhaseCount] = {"filling", "waiting", "lifting", "tilting", "unloading", "lowering"};
+
+} // namespace
+
+const char *agvPhaseName(int phase) {
+    return phase >= 0 && phase < agvPhaseCount ? kAgvPhaseNames[phase] : "?";
+}
+
+const char *liftPhaseName(int phase) {
+    return phase >= 0 && phase < liftPhaseCount ? kLiftPhaseNames[phase] : "?";
+}
+
+FleetReport runFleet(const FleetConfig &config) {
+    FleetReport report;
+    report.config = config;
+    report.config.lifts = std::max(1, config.lifts);
+    report.config.agvs = std::max(0, config.agvs);
+    auto start = std::chrono::steady_clock::now();
+    Fleet fleet(report.config);
+    fleet.run(report);
+    report.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void FleetReport::print(FILE *out) const {
+    fprintf(out, "Fleet:          %d AGVs, %d lifts, %.2f h (seed %u), %d threads\n", config.agvs, config.lifts,
+            config.hours, static_cast<unsigned>(config.seed), config.threads);
+    fprintf(out, "Deliveries:     %llu (%.1f per hour, %.1f kg)\n", static_cast<unsigned long long>(deliveries),
+            deliveriesPerHour, delivered_kg);
+    fprintf(out, "Dock queue:     %llu waits, mean %.2f s, p95 %.2f s, max %.2f s\n",
+            static_cast<unsigned long long>(queued), queueMean_s, queueP95_s, queueMax_s);
+    fprintf(out, "AGV time:      ");
+    for (int p = 0; p < agvPhaseCount; p++) fprintf(out, " %s %.1f %%%s", agvPhaseName(p), agvShare[p] * 100, p + 1 < agvPhaseCount ? "," : "\n");
+    fprintf(out, "Lift time:     ");
+    for (int p = 0; p < liftPhaseCount; p++) fprintf(out, " %s %.1f %%%s", liftPhaseName(p), liftShare[p] * 100, p + 1 < liftPhaseCount ? "," : "\n");
+    fprintf(out, "AGV moving:     %.1f %%, lift busy: %.1f %%\n", (agvShare[agvToLift] + agvShare[agvToStation]) * 100,
+            (1.0 - liftShare[liftWaiting]) * 100);
+    fprintf(out, "Simulation:     %llu windows of %lld ms, %llu steals, %.3f s wall (%.0fx real time)\n",
+            static_cast<unsigned long long>(windows), static_cast<long long>(config.sync_us / 1000),
+            static_cast<unsigned long long>(steals), wall_s, wall_s > 0 ? config.hours * 3600 / wall_s : 0.0);
+}
@@ -0,0 +1,326 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostHal.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Implements the stand-ins for the professor-provided libraries
+ *   (SimpleGPIO, SimplePWM, SimpleADC, SimpleTimer, NibbleLCD,
+ *   SimpleKeypad) and the FreeRTOS/esp_timer/ROM calls on top of the
+ *   virtual clock and the active World.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <SimpleADC.h>
+#include <SimpleGPIO.h>
+#include <SimpleKeypad.h>
+#include <SimplePWM.h>
+#include <SimpleTimer.h>
+#include <NibbleLCD.h>
+#include <driver/gpio.h>
+#include <soc/gpio_reg.h>
+#include <soc/soc.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using hostsim::clock;
+using hostsim::world;
+
+// FREERTOS / ESP-IDF (tasks and vTaskDelay live in HostTasks.cpp)
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(clock().now() / (portTICK_PERIOD_MS * 1000));
+}
+
+int64_t esp_timer_get_time() {
+    return clock().now();
+}
+
+void ets_delay_us(uint32_t us) {
+    clock().advance(us);
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    clock().advance(hostsim::kGpioReadCost_us);
+    return world().pinLevel(gpio_num);
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    if (gpio_num < 0 || gpio_num >= hostsim::kPinCount) return ESP_ERR_INVALID_ARG;
+    int previous = world().level[gpio_num];
+    world().level[gpio_num] = level ? 1 : 0;
+    if (world().level[gpio_num] != previous) hostsim::actuatorGpio(gpio_num, level ? 1 : 0);
+    world().pinWritten(gpio_num, level ? 1 : 0);
+    return ESP_OK;
+}
+
+esp_err_t gpio_pullup_en(gpio_num_t gpio_num) {
+    return gpio_num >= 0 && gpio_num < hostsim::kPinCount ? ESP_OK : ESP_ERR_INVALID_ARG;   // The World models the pull
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num) {
+    return gpio_num >= 0 && gpio_num < hostsim::kPinCount ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) {
+    return gpio_num >= 0 && gpio_num < hostsim::kPinCount ? ESP_OK : ESP_ERR_INVALID_ARG;   // Writes are never refused
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type) {
+    if (gpio_num < 0 || gpio_num >= hostsim::kPinCount) return ESP_ERR_INVALID_ARG;
+    hostsim::pinInterrupt(gpio_num).type = intr_type;
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args) {
+    if (gpio_num < 0 || gpio_num >= hostsim::kPinCount) return ESP_ERR_INVALID_ARG;
+    hostsim::pinInterrupt(gpio_num).handler = isr_handler;
+    hostsim::pinInterrupt(gpio_num).arg = args;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num) {
+    if (gpio_num < 0 || gpio_num >= hostsim::kPinCount) return ESP_ERR_INVALID_ARG;
+    hostsim::pinInterrupt(gpio_num).handler = nullptr;
+    return ESP_OK;
+}
+
+// ESP TIMER
+struct host_esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    uint64_t period_us;                                 // 0 = one shot
+    uint64_t eventId;
+};
+
+static void armTimer(esp_timer_handle_t timer, uint64_t delay_us) {
+    timer->eventId = clock().after(static_cast<int64_t>(delay_us), [timer]() {
+        timer->eventId = 0;
+        if (timer->period_us > 0) armTimer(timer, timer->period_us);    // Re-arm first so the callback may stop it
+        timer->callback(timer->arg);
+    });
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle) {
+    if (create_args == nullptr || create_args->callback == nullptr || out_handle == nullptr) return ESP_ERR_INVALID_ARG;
+    *out_handle = new host_esp_timer{create_args->callback, create_args->arg, 0, 0};
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if (timer->eventId != 0) return ESP_ERR_INVALID_STATE;
+    timer->period_us = 0;
+    armTimer(timer, timeout_us);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+    if (timer->eventId != 0) return ESP_ERR_INVALID_STATE;
+    timer->period_us = period > 0 ? period : 1;
+    armTimer(timer, timer->period_us);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (timer->eventId == 0) return ESP_ERR_INVALID_STATE;
+    clock().cancel(timer->eventId);
+    timer->eventId = 0;
+    timer->period_us = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer->eventId != 0) return ESP_ERR_INVALID_STATE;
+    delete timer;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+    return timer->eventId != 0;
+}
+
+// GPIO REGISTERS (FastPin): the pins of a bank through the same World calls as one pin
+namespace {
+
+void writeBank(int first, uint32_t bits, int level) {
+    for (int bit = 0; bit < 32 && first + bit < hostsim::kPinCount; bit++) {
+        if (bits & (uint32_t(1) << bit)) gpio_set_level(first + bit, level);
+    }
+}
+
+uint32_t readBank(int first, bool latched) {
+    uint32_t bits = 0;
+    for (int bit = 0; bit < 32 && first + bit < hostsim::kPinCount; bit++) {
+        int level = latched ? world().level[first + bit] : world().pinLevel(first + bit);
+        if (level) bits |= uint32_t(1) << bit;
+    }
+    return bits;
+}
+
+}
+
+namespace hostsim {
+
+uint32_t regRead(uint32_t reg) {
+    switch (reg) {
+    case GPIO_IN_REG: clock().advance(kGpioReadCost_us); return readBank(0, false);    // One load for the bank
+    case GPIO_IN1_REG: clock().advance(kGpioReadCost_us); return readBank(32, false);
+    case GPIO_OUT_REG: return readBank(0, true);
+    case GPIO_OUT1_REG: return readBank(32, true);
+    }
+    fprintf(stderr, "REG_READ of 0x%08x, not simulated\n", static_cast<unsigned>(reg));
+    abort();
+}
+
+void regWrite(uint32_t reg, uint32_t value) {
+    switch (reg) {
+    case GPIO_OUT_W1TS_REG: return writeBank(0, value, 1);
+    case GPIO_OUT_W1TC_REG: return writeBank(0, value, 0);
+    case GPIO_OUT1_W1TS_REG: return writeBank(32, value, 1);
+    case GPIO_OUT1_W1TC_REG: return writeBank(32, value, 0);
+    case GPIO_OUT_REG: writeBank(0, value, 1); return writeBank(0, ~value, 0);
+    case GPIO_OUT1_REG: writeBank(32, value, 1); return writeBank(32, ~value, 0);
+    }
+    fprintf(stderr, "REG_WRITE of 0x%08x, not simulated\n", static_cast<unsigned>(reg));
+    abort();
+}
+
+}
+
+// SIMPLE GPIO
+void SimpleGPIO::setup(int gpio, int mode, int pull) {
+    this->gpio = gpio;
+    this->mode = mode;
+}
+
+void SimpleGPIO::set(int level) {
+    if (gpio < 0 || !(mode & GPO)) return;              // Input-only pins ignore writes
+    gpio_set_level(gpio, level);
+}
+
+int SimpleGPIO::get() {
+    if (gpio < 0) return 0;
+    return gpio_get_level(gpio);
+}
+
+// SIMPLE PWM
+void SimplePWM::setup(int gpio, int channel, int frequency, int resolution) {
+    if (gpio >= 0 && gpio == hostsim::consoleRxPin()) {  // The duty would echo into the console RX
+        fprintf(stderr, "LEDC output on GPIO %d, still read by UART0\n", gpio);
+        abort();
+    }
+    this->gpio = gpio;
+    this->channel = channel;
+}
+
+void SimplePWM::setDuty(float percent) {
+    if (gpio >= 0 && percent != duty) hostsim::actuatorPwm(gpio, percent);
+    duty = percent;
+    if (gpio >= 0) world().pwmDuty(gpio, percent);
+}
+
+// SIMPLE ADC
+void SimpleADC::setup(int gpio, int width) {
+    this->gpio = gpio;
+    this->width = width;
+}
+
+float SimpleADC::read(int mode) {
+    clock().advance(hostsim::kAdcReadCost_us);
+    float mv = world().adcMilliVolts(gpio);
+    if (mode == ADC_READ_MV) return mv;
+    float counts = mv / 3300.0f * ((1 << width) - 1);
+    return counts < 0 ? 0 : counts;
+}
+
+// SIMPLE TIMER
+void SimpleTimer::setup(timer_cb_t callback, const char *name, void *arg) {
+    if (handle != nullptr) {                            // Re-setup replaces the previous timer
+        stopPeriodic();
+        esp_timer_delete(handle);
+    }
+    esp_timer_create_args_t args = {callback, arg, ESP_TIMER_TASK, name, false};
+    esp_timer_create(&args, &handle);
+}
+
+void SimpleTimer::startPeriodic(uint64_t period_us) {
+    stopPeriodic();
+    esp_timer_start_periodic(handle, period_us);
+}
+
+void SimpleTimer::startOnce(uint64_t timeout_us) {
+    stopPeriodic();
+    esp_timer_start_once(handle, timeout_us);
+}
+
+void SimpleTimer::stopPeriodic() {
+    if (handle != nullptr && esp_timer_is_active(handle)) esp_timer_stop(handle);
+}
+
+// NIBBLE LCD
+NibbleLCD::NibbleLCD() {
+    memset(ddram, ' ', sizeof(ddram));
+}
+
+void NibbleLCD::setup(uint8_t *pins) {}
+
+void NibbleLCD::writeCommand(uint8_t command) {
+    if (command == CMD_CLEAR || command == CMD_HOME) {
+        clock().advance(hostsim::kLcdClearCost_us);
+        if (command == CMD_CLEAR) memset(ddram, ' ', sizeof(ddram));
+        row = col = 0;
+        if (command == CMD_CLEAR) show();
+        return;
+    }
+    clock().advance(hostsim::kLcdByteCost_us);
+    if (command & 0x80) {                               // Set DDRAM address: row 2 starts at 0x40
+        int address = command & 0x7F;
+        row = address >= 0x40 ? 1 : 0;
+        col = (address & 0x3F) % 40;
+    }
+}
+
+void NibbleLCD::printStr(const char *text) {
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == '\n') {
+            row = 1;
+            col = 0;
+            continue;
+        }
+        clock().advance(hostsim::kLcdByteCost_us);
+        ddram[row][col] = *c;
+        col = (col + 1) % 40;
+    }
+    show();
+}
+
+// Visible 16 columns of both rows, trailing blanks dropped
+void NibbleLCD::show() {
+    std::string screen;
+    for (int r = 0; r < 2; r++) {
+        std::string line(ddram[r], 16);
+        line.erase(line.find_last_not_of(' ') + 1);
+        if (r == 1 && !line.empty()) screen += '\n';
+        screen += line;
+    }
+    hostsim::trace("LCD  \"%s\"", screen.c_str());
+    hostsim::actuatorLcd(screen.c_str());
+    world().lcdText(screen.c_str());
+}
+
+// SIMPLE KEYPAD
+void SimpleKeypad::setup() {}
+
+char SimpleKeypad::getKey() {
+    char key = world().nextKey();
+    if (key != '\0') hostsim::trace("KEY  '%c'", key);
+    return key;
+}
@@ -0,0 +1,148 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostNvs.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   NVS stand-in. Every entry is kept as namespace, key and blob; the
+ *   backing file holds them as "namespace\0key\0" + uint32 length + data.
+ *   nvs_flash_init() plays the role of a boot: it reloads the file and
+ *   drops anything that was set but never committed.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <nvs_flash.h>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Entries = std::map<std::pair<std::string, std::string>, std::vector<uint8_t>>;
+
+Entries committed;                              // What the flash holds
+Entries working;                                // Committed plus pending sets
+std::string nvsPath;
+bool initialized = false;
+std::vector<std::pair<std::string, bool>> handles;  // Namespace and writable, index + 1 = handle
+
+bool readString(FILE *in, std::string &out) {
+    out.clear();
+    int c;
+    while ((c = fgetc(in)) != EOF && c != '\0') out += static_cast<char>(c);
+    return c == '\0';
+}
+
+void loadFile() {
+    committed.clear();
+    if (nvsPath.empty()) return;
+    FILE *in = fopen(nvsPath.c_str(), "rb");
+    if (in == nullptr) return;                          // Blank flash
+    std::string ns, key;
+    uint32_t length;
+    while (readString(in, ns) && readString(in, key) && fread(&length, sizeof(length), 1, in) == 1) {
+        std::vector<uint8_t> data(length);
+        if (length > 0 && fread(data.data(), 1, length, in) != length) break;
+        committed[{ns, key}] = std::move(data);
+    }
+    fclose(in);
+}
+
+bool saveFile() {
+    if (nvsPath.empty()) return true;
+    FILE *out = fopen(nvsPath.c_str(), "wb");
+    if (out == nullptr) return false;
+    for (const auto &entry : committed) {
+        uint32_t length = static_cast<uint32_t>(entry.second.size());
+        fwrite(entry.first.first.c_str(), 1, entry.first.first.size() + 1, out);
+        fwrite(entry.first.second.c_str(), 1, entry.first.second.size() + 1, out);
+        fwrite(&length, sizeof(length), 1, out);
+        fwrite(entry.second.data(), 1, length, out);
+    }
+    return fclose(out) == 0;
+}
+
+const std::pair<std::string, bool> *lookup(nvs_handle_t handle) {
+    if (handle == 0 || handle > handles.size() || handles[handle - 1].first.empty()) return nullptr;
+    return &handles[handle - 1];
+}
+
+} // namespace
+
+namespace hostsim {
+
+void setNvsFile(const char *path) {
+    nvsPath = path != nullptr ? path : "";
+    initialized = false;
+}
+
+} // namespace hostsim
+
+esp_err_t nvs_flash_init(void) {
+    loadFile();
+    working = committed;
+    handles.clear();
+    initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    committed.clear();
+    working.clear();
+    return saveFile() ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) {
+    if (!initialized) return ESP_ERR_NVS_NOT_INITIALIZED;
+    if (name == nullptr || name[0] == '\0' || strlen(name) > 15 || out_handle == nullptr) return ESP_ERR_INVALID_ARG;
+    handles.emplace_back(name, open_mode == NVS_READWRITE);
+    *out_handle = static_cast<nvs_handle_t>(handles.size());
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    if (lookup(handle) != nullptr) handles[handle - 1].first.clear();
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+    const auto *h = lookup(handle);
+    if (h == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    auto it = working.find({h->first, key});
+    if (it == working.end()) return ESP_ERR_NVS_NOT_FOUND;
+    if (out_value == nullptr) {                         // Size query
+        *length = it->second.size();
+        return ESP_OK;
+    }
+    if (*length < it->second.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, it->second.data(), it->second.size());
+    *length = it->second.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    const auto *h = lookup(handle);
+    if (h == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!h->second) return ESP_ERR_NVS_READ_ONLY;
+    const uint8_t *bytes = static_cast<const uint8_t *>(value);
+    working[{h->first, key}] = std::vector<uint8_t>(bytes, bytes + length);
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key) {
+    const auto *h = lookup(handle);
+    if (h == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!h->second) return ESP_ERR_NVS_READ_ONLY;
+    return working.erase({h->first, key}) > 0 ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    if (lookup(handle) == nullptr) return ESP_ERR_NVS_INVALID_HANDLE;
+    committed = working;
+    return saveFile() ? ESP_OK : ESP_FAIL;
+}
@@ -0,0 +1,133 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostRmt.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   RMT transmit stand-in. tx_start schedules every edge of the channel
+ *   memory on the virtual clock (written through gpio_set_level, so the
+ *   World sees them) and an end event that returns the pin to its idle
+ *   level and calls the tx-end callback, like the RMT interrupt.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <driver/rmt.h>
+
+#include <vector>
+
+using hostsim::clock;
+
+namespace {
+
+struct RmtChannel {
+    bool configured = false;
+    bool installed = false;
+    gpio_num_t gpio = -1;
+    uint8_t clk_div = 80;
+    int idleLevel = 0;
+    std::vector<rmt_item32_t> memory;
+    std::vector<uint64_t> pending;          // Scheduled edge events, cancelled by tx_stop
+};
+
+RmtChannel channels[RMT_CHANNEL_MAX];
+rmt_tx_end_callback_t txEnd = {nullptr, nullptr};
+
+bool valid(rmt_channel_t channel) {
+    return channel >= RMT_CHANNEL_0 && channel < RMT_CHANNEL_MAX;
+}
+
+// Ticks to virtual microseconds (80 MHz APB)
+int64_t ticksToUs(const RmtChannel &c, uint32_t ticks) {
+    return static_cast<int64_t>(ticks) * c.clk_div / 80;
+}
+
+} // namespace
+
+esp_err_t rmt_config(const rmt_config_t *rmt_param) {
+    if (rmt_param == nullptr || !valid(rmt_param->channel) || rmt_param->rmt_mode != RMT_MODE_TX) return ESP_ERR_INVALID_ARG;
+    if (rmt_param->clk_div == 0 || rmt_param->mem_block_num == 0) return ESP_ERR_INVALID_ARG;
+    RmtChannel &c = channels[rmt_param->channel];
+    c.configured = true;
+    c.gpio = rmt_param->gpio_num;
+    c.clk_div = rmt_param->clk_div;
+    c.idleLevel = rmt_param->tx_config.idle_level == RMT_IDLE_LEVEL_HIGH ? 1 : 0;
+    c.memory.assign(RMT_MEM_ITEM_NUM * rmt_param->mem_block_num, rmt_item32_t{});
+    return ESP_OK;
+}
+
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t rx_buf_size, int intr_alloc_flags) {
+    if (!valid(channel) || !channels[channel].configured) return ESP_ERR_INVALID_STATE;
+    if (channels[channel].installed) return ESP_ERR_INVALID_STATE;
+    channels[channel].installed = true;
+    return ESP_OK;
+}
+
+esp_err_t rmt_driver_uninstall(rmt_channel_t channel) {
+    if (!valid(channel) || !channels[channel].installed) return ESP_ERR_INVALID_STATE;
+    rmt_tx_stop(channel);
+    channels[channel] = RmtChannel();
+    return ESP_OK;
+}
+
+esp_err_t rmt_set_gpio(rmt_channel_t channel, rmt_mode_t mode, gpio_num_t gpio_num, bool invert_signal) {
+    if (!valid(channel) || mode != RMT_MODE_TX) return ESP_ERR_INVALID_ARG;
+    channels[channel].gpio = gpio_num;
+    return ESP_OK;
+}
+
+esp_err_t rmt_fill_tx_items(rmt_channel_t channel, const rmt_item32_t *item, uint16_t item_num, uint16_t mem_offset) {
+    if (!valid(channel) || item == nullptr) return ESP_ERR_INVALID_ARG;
+    RmtChannel &c = channels[channel];
+    if (mem_offset + item_num > c.memory.size()) return ESP_ERR_INVALID_ARG;
+    for (uint16_t i = 0; i < item_num; i++) c.memory[mem_offset + i] = item[i];
+    if (mem_offset + item_num < c.memory.size()) c.memory[mem_offset + item_num].val = 0;   // End marker
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_start(rmt_channel_t channel, bool tx_idx_rst) {
+    if (!valid(channel) || !channels[channel].installed) return ESP_ERR_INVALID_STATE;
+    RmtChannel &c = channels[channel];
+    rmt_tx_stop(channel);
+    int64_t at = clock().now();
+    gpio_num_t gpio = c.gpio;
+    for (const rmt_item32_t &item : c.memory) {
+        uint32_t durations[2] = {item.duration0, item.duration1};
+        int levels[2] = {static_cast<int>(item.level0), static_cast<int>(item.level1)};
+        bool ended = false;
+        for (int half = 0; half < 2; half++) {
+            if (durations[half] == 0) {
+                ended = true;
+                break;
+            }
+            int level = levels[half];
+            c.pending.push_back(clock().at(at, [gpio, level]() { gpio_set_level(gpio, level); }));
+            at += ticksToUs(c, durations[half]);
+        }
+        if (ended) break;
+    }
+    c.pending.push_back(clock().at(at, [channel]() {
+        RmtChannel &done = channels[channel];
+        done.pending.clear();
+        gpio_set_level(done.gpio, done.idleLevel);
+        if (txEnd.function != nullptr) txEnd.function(channel, txEnd.arg);
+    }));
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_stop(rmt_channel_t channel) {
+    if (!valid(channel)) return ESP_ERR_INVALID_ARG;
+    RmtChannel &c = channels[channel];
+    if (c.pending.empty()) return ESP_OK;
+    for (uint64_t id : c.pending) clock().cancel(id);
+    c.pending.clear();
+    gpio_set_level(c.gpio, c.idleLevel);                // Output falls back to the idle level
+    return ESP_OK;
+}
+
+rmt_tx_end_callback_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void *arg) {
+    rmt_tx_end_callback_t previous = txEnd;
+    txEnd = {function, arg};
+    return previous;
+}
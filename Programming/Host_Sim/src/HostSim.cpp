@@ -0,0 +1,242 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostSim.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Virtual clock, world registry and mission runner for the host build.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+
+namespace hostsim {
+
+MissionTimeout::MissionTimeout(int64_t at) : std::runtime_error("mission deadline exceeded"), at_us(at) {}
+
+// VIRTUAL CLOCK
+uint64_t VirtualClock::at(int64_t time_us, Event event) {
+    uint64_t id = nextId++;
+    if (time_us < now_us) time_us = now_us;             // Never schedule in the past
+    queue.push({time_us, id});
+    pending.emplace(id, std::move(event));
+    return id;
+}
+
+uint64_t VirtualClock::after(int64_t delay_us, Event event) {
+    return at(now_us + delay_us, std::move(event));
+}
+
+void VirtualClock::cancel(uint64_t id) {
+    pending.erase(id);                                  // Stale queue entry is skipped when popped
+}
+
+void VirtualClock::advance(int64_t delta_us) {
+    int64_t target = now_us + (delta_us > 0 ? delta_us : 0);
+    while (!queue.empty() && queue.top().time_us <= target) {
+        Entry next = queue.top();
+        queue.pop();
+        auto it = pending.find(next.id);
+        if (it == pending.end()) continue;              // Cancelled
+        Event event = std::move(it->second);
+        pending.erase(it);
+        if (next.time_us > now_us) now_us = next.time_us; // Nested advance() from an event may be ahead
+        if (now_us > deadline_us) throw MissionTimeout(now_us);
+        fired++;
+        event();                                        // May schedule or cancel more events
+    }
+    if (target > now_us) now_us = target;
+    if (now_us > deadline_us) throw MissionTimeout(now_us);
+}
+
+int64_t VirtualClock::nextEventTime() {
+    while (!queue.empty() && pending.count(queue.top().id) == 0) queue.pop();     // Drop cancelled entries
+    return queue.empty() ? INT64_MAX : queue.top().time_us;
+}
+
+void VirtualClock::reset() {
+    now_us = 0;
+    deadline_us = INT64_MAX;
+    fired = 0;
+    queue = {};
+    pending.clear();
+}
+
+// WORLD
+int World::pinLevel(int pin) {
+    return (pin >= 0 && pin < kPinCount) ? level[pin] : 0;
+}
+
+void World::drive(int pin, int value) {
+    if (pin < 0 || pin >= kPinCount) return;
+    value = value ? 1 : 0;
+    int previous = level[pin];
+    level[pin] = value;
+    PinInterrupt &irq = pinInterrupt(pin);
+    if (irq.handler == nullptr || previous == value) return;
+    bool rising = value == 1;
+    if (irq.type == 3 || (irq.type == 1 && rising) || (irq.type == 2 && !rising)) irq.handler(irq.arg);
+}
+
+namespace {
+VirtualClock simClock;
+World *simWorld = nullptr;
+PinInterrupt simInterrupts[kPinCount];
+bool simVerbose = false;
+std::chrono::steady_clock::time_point wallStart;
+
+// Actuator log
+bool actuatorsOn = false;
+std::string actuatorPath;
+std::string actuatorText;
+uint64_t actuatorCount = 0;
+bool actuatorQuiet[kPinCount] = {};
+
+void actuatorLine(const char *fmt, ...) {
+    if (!actuatorsOn) return;
+    char line[160];
+    int n = snprintf(line, sizeof(line), "%lld ", static_cast<long long>(simClock.now()));
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line + n, sizeof(line) - n, fmt, args);
+    va_end(args);
+    actuatorText += line;
+    actuatorText += '\n';
+    actuatorCount++;
+}
+
+uint64_t fnv1a(const std::string &text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : text) hash = (hash ^ c) * 1099511628211ull;
+    return hash;
+}
+
+void writeActuatorFile() {
+    if (actuatorPath.empty()) return;
+    FILE *out = fopen(actuatorPath.c_str(), "w");
+    if (out == nullptr) {
+        fprintf(stderr, "Cannot write %s\n", actuatorPath.c_str());
+        return;
+    }
+    fwrite(actuatorText.data(), 1, actuatorText.size(), out);
+    fclose(out);
+}
+
+void printReport(const char *outcome) {
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double virtual_s = simClock.now() * 1e-6;
+    printf("\n=== %s: %s ===\n", simWorld->name(), outcome);
+    printf("Virtual time:   %.3f s\n", virtual_s);
+    printf("Wall time:      %.3f ms\n", wall_s * 1e3);
+    if (wall_s > 0) printf("Speed-up:       %.0fx real time\n", virtual_s / wall_s);
+    printf("Events fired:   %llu\n", static_cast<unsigned long long>(simClock.eventsFired()));
+    if (actuatorsOn) {
+        printf("Actuator log:   %llu commands, hash %016llx\n", static_cast<unsigned long long>(actuatorCount),
+               static_cast<unsigned long long>(fnv1a(actuatorText)));
+    }
+    simWorld->report(stdout);
+    fflush(stdout);
+    writeActuatorFile();
+}
+
+// app_main() ends with exit(0) on the AGV, so the verdict is also taken at exit
+void onFirmwareExit() {
+    bool complete = simWorld->missionComplete();
+    printReport(complete ? "MISSION COMPLETE (exit)" : "MISSION INCOMPLETE (exit)");
+    std::_Exit(complete ? 0 : 1);
+}
+} // namespace
+
+void endMission(const char *outcome, int code) {
+    printReport(outcome);
+    std::_Exit(code);
+}
+
+VirtualClock &clock() { return simClock; }
+World &world() { return *simWorld; }
+PinInterrupt &pinInterrupt(int pin) { return simInterrupts[pin]; }
+bool verbose() { return simVerbose; }
+
+void install(World &world) {
+    simWorld = &world;
+    simClock.reset();
+    for (PinInterrupt &irq : simInterrupts) irq = PinInterrupt();
+    actuatorText.clear();
+    actuatorCount = 0;
+    for (bool &quiet : actuatorQuiet) quiet = false;
+    world.begin();
+}
+
+// ACTUATOR LOG
+void recordActuators(bool on) { actuatorsOn = on; }
+
+void setActuatorFile(const char *path) {
+    actuatorPath = path != nullptr ? path : "";
+    if (!actuatorPath.empty()) actuatorsOn = true;
+}
+
+void quietActuator(int pin) {
+    if (pin >= 0 && pin < kPinCount) actuatorQuiet[pin] = true;
+}
+
+void actuatorGpio(int pin, int level) {
+    if (pin >= 0 && pin < kPinCount && !actuatorQuiet[pin]) actuatorLine("gpio %d %d", pin, level);
+}
+
+void actuatorPwm(int pin, float percent) {
+    if (pin >= 0 && pin < kPinCount && !actuatorQuiet[pin]) actuatorLine("pwm %d %.3f", pin, percent);
+}
+
+void actuatorLcd(const char *text) {
+    std::string screen = text;
+    for (char &c : screen) {
+        if (c == '\n') c = '|';                         // One line per command
+    }
+    actuatorLine("lcd %s", screen.c_str());
+}
+
+const std::string &actuatorLog() { return actuatorText; }
+uint64_t actuatorCommands() { return actuatorCount; }
+
+void trace(const char *fmt, ...) {
+    if (!simVerbose) return;
+    fprintf(stderr, "[%10.3f ms] ", simClock.now() / 1000.0);
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+int runMission(World &world, void (*entry)(), int64_t deadline_us, int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) simVerbose = true;
+        else if (strcmp(argv[i], "--nvs") == 0 && i + 1 < argc) setNvsFile(argv[++i]);
+        else if (strncmp(argv[i], "--uart", 6) == 0 && argv[i][6] >= '0' && argv[i][6] <= '2' && argv[i][7] == '\0' &&
+                 i + 1 < argc) {
+            int port = argv[i][6] - '0';
+            setUartFile(port, argv[++i]);
+        }
+        else if (strcmp(argv[i], "--actuators") == 0 && i + 1 < argc) setActuatorFile(argv[++i]);
+    }
+    install(world);
+    simClock.setDeadline(deadline_us);
+    wallStart = std::chrono::steady_clock::now();
+    std::atexit(onFirmwareExit);
+    try {
+        entry();
+    }
+    catch (const MissionTimeout &timeout) {
+        endMission("TIMEOUT", 2);
+    }
+    bool complete = world.missionComplete();
+    endMission(complete ? "MISSION COMPLETE" : "MISSION INCOMPLETE", complete ? 0 : 1);
+}
+
+} // namespace hostsim
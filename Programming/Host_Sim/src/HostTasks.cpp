@@ -0,0 +1,192 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostTasks.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   FreeRTOS task stand-in. Every task (including the thread that runs
+ *   app_main) is a std::thread, but only the holder of the baton runs.
+ *   vTaskDelay records the wake time, advances the virtual clock to the
+ *   earliest waking task (firing timers and ISRs on the way) and hands
+ *   the baton over. Ties go to the higher priority, then creation order.
+ *   The clock moves one event at a time, so a notify from a timer or ISR
+ *   can bring a blocked task's wake time forward.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <freertos/FreeRTOS.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct host_task {
+    int id;
+    const char *name;
+    UBaseType_t priority;
+    BaseType_t core;
+    int64_t wake_us;
+    bool alive;
+    uint32_t notifications;                             // Pending notification count
+    bool takingNotify;                                  // Blocked in ulTaskNotifyTake()
+    std::condition_variable turn;
+};
+
+namespace {
+
+// Thrown inside a task thread by vTaskDelete(NULL) to unwind it
+struct TaskExit {};
+
+// Never destroyed: detached task threads may still be parked at exit
+struct Scheduler {
+    std::mutex lock;
+    std::vector<host_task *> tasks;
+    host_task *running = nullptr;
+};
+
+Scheduler &scheduler() {
+    static Scheduler *instance = new Scheduler();
+    return *instance;
+}
+
+thread_local host_task *self = nullptr;
+
+// The first thread to touch the scheduler is the main task
+host_task *currentTask() {
+    if (self == nullptr) {
+        Scheduler &s = scheduler();
+        std::lock_guard<std::mutex> guard(s.lock);
+        self = new host_task{static_cast<int>(s.tasks.size()), "main", 1, 0, hostsim::clock().now(), true, 0, false, {}};
+        s.tasks.push_back(self);
+        if (s.running == nullptr) s.running = self;
+    }
+    return self;
+}
+
+host_task *earliestTask() {
+    host_task *best = nullptr;
+    for (host_task *t : scheduler().tasks) {
+        if (!t->alive) continue;
+        if (best == nullptr || t->wake_us < best->wake_us ||
+            (t->wake_us == best->wake_us && t->priority > best->priority)) best = t;
+    }
+    return best;
+}
+
+// Advance to the next task to run and give it the baton; returns when 'me' runs again
+void switchTasks(host_task *me) {
+    Scheduler &s = scheduler();
+    host_task *next = earliestTask();
+    if (next == nullptr) hostsim::endMission("ALL TASKS ENDED", 1);
+    // Event by event: timers may create tasks or notify one meanwhile
+    while (next->wake_us > hostsim::clock().now()) {
+        int64_t until = std::min(next->wake_us, hostsim::clock().nextEventTime());
+        hostsim::clock().advance(until - hostsim::clock().now());
+        next = earliestTask();
+        if (next == nullptr) hostsim::endMission("ALL TASKS ENDED", 1);
+    }
+    if (next == me) return;
+    std::unique_lock<std::mutex> guard(s.lock);
+    s.running = next;
+    next->turn.notify_one();
+    if (!me->alive) return;
+    me->turn.wait(guard, [&]() { return s.running == me; });
+}
+
+void taskEntry(host_task *task, TaskFunction_t function, void *arg) {
+    self = task;
+    Scheduler &s = scheduler();
+    {
+        std::unique_lock<std::mutex> guard(s.lock);
+        task->turn.wait(guard, [&]() { return s.running == task; });
+    }
+    try {
+        function(arg);
+    }
+    catch (const TaskExit &) {
+        return;                                         // Baton already handed over
+    }
+    catch (const hostsim::MissionTimeout &) {
+        hostsim::endMission("TIMEOUT", 2);
+    }
+    task->alive = false;                                // Returned without vTaskDelete
+    switchTasks(task);
+}
+
+} // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *createdTask, BaseType_t coreId) {
+    currentTask();
+    Scheduler &s = scheduler();
+    host_task *created;
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        created = new host_task{static_cast<int>(s.tasks.size()), name, priority, coreId, hostsim::clock().now(), true, 0, false, {}};
+        s.tasks.push_back(created);
+    }
+    std::thread(taskEntry, created, task, arg).detach();
+    hostsim::trace("TASK \"%s\" created on core %d", name, coreId);
+    if (createdTask != nullptr) *createdTask = created;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *createdTask) {
+    return xTaskCreatePinnedToCore(task, name, stackDepth, arg, priority, createdTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    host_task *me = currentTask();
+    if (task == nullptr || task == me) {
+        me->alive = false;
+        switchTasks(me);
+        throw TaskExit();
+    }
+    task->alive = false;                                // Parked thread is never resumed
+}
+
+void vTaskDelay(TickType_t ticks) {
+    host_task *me = currentTask();
+    me->wake_us = hostsim::clock().now() + static_cast<int64_t>(ticks) * portTICK_PERIOD_MS * 1000;
+    switchTasks(me);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask();
+}
+
+BaseType_t xPortGetCoreID() {
+    BaseType_t core = currentTask()->core;
+    return core == tskNO_AFFINITY ? 0 : core;
+}
+
+// TASK NOTIFICATIONS
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    host_task *me = currentTask();
+    if (me->notifications == 0 && ticksToWait > 0) {
+        me->takingNotify = true;
+        me->wake_us = ticksToWait == portMAX_DELAY ? INT64_MAX
+                                                   : hostsim::clock().now() + static_cast<int64_t>(ticksToWait) * portTICK_PERIOD_MS * 1000;
+        switchTasks(me);
+        me->takingNotify = false;
+    }
+    uint32_t count = me->notifications;
+    if (count > 0) me->notifications = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    task->notifications++;
+    if (task->takingNotify && task->wake_us > hostsim::clock().now()) task->wake_us = hostsim::clock().now();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken) {
+    bool blocked = task->takingNotify;
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken != nullptr && blocked) *higherPriorityTaskWoken = pdTRUE;
+}
@@ -0,0 +1,92 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: HostUart.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   UART transmit stand-in. The driver buffers and the line take no
+ *   virtual time; written bytes land in the port's capture file as soon
+ *   as they are written, like a logic analyser on the TX pin. The console
+ *   RX input is tracked through the GPIO matrix so a pin still read by
+ *   UART0 is not silently reused.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <driver/uart.h>
+#include <esp_rom_gpio.h>
+#include <soc/gpio_sig_map.h>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+struct UartPort {
+    bool installed = false;
+    std::string path;
+    FILE *out = nullptr;
+};
+
+UartPort ports[UART_NUM_MAX];
+int consoleRx = 3;                  // U0RXD through the IO_MUX after reset
+
+bool valid(uart_port_t port) {
+    return port >= 0 && port < UART_NUM_MAX;
+}
+
+} // namespace
+
+namespace hostsim {
+
+void setUartFile(int port, const char *path) {
+    if (!valid(port)) return;
+    if (ports[port].out != nullptr) fclose(ports[port].out);
+    ports[port].out = nullptr;
+    ports[port].path = path != nullptr ? path : "";
+}
+
+int consoleRxPin() {
+    return consoleRx;
+}
+
+} // namespace hostsim
+
+void esp_rom_gpio_connect_in_signal(uint32_t gpio_num, uint32_t signal_idx, bool inv) {
+    if (signal_idx != U0RXD_IN_IDX) return;
+    consoleRx = gpio_num < static_cast<uint32_t>(hostsim::kPinCount) ? static_cast<int>(gpio_num) : -1;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config) {
+    return valid(uart_num) && uart_config != nullptr && uart_config->baud_rate > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num) {
+    if (!valid(uart_num) || tx_io_num >= hostsim::kPinCount) return ESP_ERR_INVALID_ARG;
+    // A TX pin UART0 still reads would echo every byte into the console RX
+    if (uart_num != UART_NUM_0 && tx_io_num >= 0 && tx_io_num == consoleRx) return ESP_ERR_INVALID_STATE;
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags) {
+    if (!valid(uart_num)) return ESP_ERR_INVALID_ARG;
+    if (ports[uart_num].installed) return ESP_FAIL;
+    ports[uart_num].installed = true;
+    if (!ports[uart_num].path.empty()) ports[uart_num].out = fopen(ports[uart_num].path.c_str(), "wb");
+    return ESP_OK;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size) {
+    if (!valid(uart_num) || !ports[uart_num].installed) return -1;
+    if (ports[uart_num].out != nullptr) {
+        fwrite(src, 1, size, ports[uart_num].out);
+        fflush(ports[uart_num].out);                    // Complete even when the firmware calls exit()
+    }
+    return static_cast<int>(size);
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait) {
+    return valid(uart_num) && ports[uart_num].installed ? ESP_OK : ESP_FAIL;
+}
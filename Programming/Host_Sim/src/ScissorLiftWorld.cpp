@@ -0,0 +1,238 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: ScissorLiftWorld.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Environment model for ScissorLift_StateMachine/main.cpp, including:
+ *     - Operator typing the load weight on the keypad matrix (with
+ *       contact bounce), during the prompt
+ *     - AGV side of the communication wire: status frames for coupling,
+ *       an obstacle and arrival, one of them corrupted on the way
+ *     - Lift and tilt stepper step counting; the scissor geometry turns the
+ *       lift steps into a platform height, which trips the height sensor
+ *     - Load cell filling curve (with ADC noise and 1 mV steps) and basket
+ *       servomotor observer
+ *     - Unloading interlocks, checked on every step and servo command: no
+ *       tilt below the frame clearance, no open basket unless the platform
+ *       stands still at the unloading height and the basket leans to pour
+ *   Builds the scissor_lift_sim executable, which runs the unmodified app_main().
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ComLink.h>
+#include <HostKeypad.h>
+#include <HostSim.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+
+extern "C" void app_main();
+
+namespace {
+
+// Pins, mirrors ScissorLift_StateMachine/definitions.h
+constexpr int kServoPin = 3;
+constexpr int kTiltPulPin = 0;
+constexpr int kTiltDirPin = 32;
+constexpr int kTiltEnaPin = 33;
+constexpr int kLiftPulPin = 25;
+constexpr int kLiftDirPin = 26;
+constexpr int kLiftEnaPin = 27;
+constexpr int kHeightPin = 34;
+constexpr int kLoadCellPin = 39;
+constexpr int kComPin = 35;
+const uint8_t kKeypadRows[4] = {5, 18, 19, 21};
+const uint8_t kKeypadCols[4] = {15, 4, 22, 23};
+const char *const kKeypadMap[4] = {"123A", "456B", "789C", "*0#D"};
+
+// Mechanics
+constexpr double kLinkMm = 202.5;               // Scissor link, pin to pin
+constexpr double kRestDeg = 5;                  // Links at rest
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kScrewStepMm = 0.1;            // Lower roller travel per lift step
+constexpr double kSensorMm = 350;               // Platform height where the height sensor trips
+constexpr double kEndStopMm = 365;              // Platform height at the upper end stop
+constexpr double kTargetMm = 320;               // Mirrors LIFT_TARGET_MM
+constexpr double kTargetToleranceMm = 0.5;      // A bit more than one step at that height
+constexpr double kTiltClearMm = 250;            // Basket clears the frame above this height
+constexpr int kPourSteps = 110;                 // Tilt steps before the beans can leave the basket
+constexpr double kBeansMvPerKg = 10.0;          // Inverse of the firmware calibration slope
+constexpr double kZeroKg = 0.1;                 // Firmware calibration offset: weight read at 0 mV
+constexpr double kAdcNoise_mv = 1.0;            // Standard deviation of one conversion
+constexpr int64_t kFillTime_us = 4000000;       // Time to pour the requested weight
+
+// Operator script: key, virtual time (typed over the prompt, which starts at 2 s)
+struct KeyPress {
+    char key;
+    int64_t at_us;
+};
+const KeyPress kKeys[] = {{'2', 2400000}, {'A', 2700000}};
+constexpr int64_t kKeyHold_us = 120000;
+
+// AGV script on the communication wire: status from time, repeated like the AGV firmware does
+struct ComStatus {
+    ComMessage msg;
+    int64_t from_us;
+};
+const ComStatus kComScript[] = {
+    {{COM_COUPLED, 0, 0}, 12000000},            // Coupled and moving
+    {{COM_OBSTACLE, 28, 0}, 20000000},          // Obstacle crossing the aisle
+    {{COM_COUPLED, 0, 0}, 21500000},            // Path clear again
+    {{COM_ARRIVED, 0, 0}, 26000000},            // Arrived at unloading station
+};
+constexpr size_t kComSteps = sizeof(kComScript) / sizeof(kComScript[0]);
+constexpr int64_t kComRepeat_us = 500000;
+constexpr int64_t kComCorruptAt_us = 16000000;  // This frame gets a flipped bit
+
+class ScissorLiftWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Scissor Lift"; }
+
+    ScissorLiftWorld() : keypad(kKeypadRows, kKeypadCols, kKeypadMap) {}
+
+    void begin() override {
+        for (uint8_t row : kKeypadRows) hostsim::quietActuator(row);  // Scanned every few ms, not a command
+        for (const KeyPress &k : kKeys) {
+            keys.push_back(k);
+            keypad.press(k.key, k.at_us, kKeyHold_us);
+            hostsim::clock().at(k.at_us, [this]() { keyPressed(); });
+        }
+        for (size_t i = 0; i + 1 < kComSteps; i++) {
+            for (int64_t t = kComScript[i].from_us; t < kComScript[i + 1].from_us; t += kComRepeat_us) {
+                sendFrame(kComScript[i].msg, t, t == kComCorruptAt_us);
+            }
+        }
+        sendFrame(kComScript[kComSteps - 1].msg, kComScript[kComSteps - 1].from_us, false);
+        level[kHeightPin] = 1;                          // Sensor idle high, active low
+    }
+
+    void pinWritten(int pin, int value) override {
+        if (pin == kLiftPulPin && value == 1 && level[kLiftEnaPin] == 0) {
+            liftSteps += level[kLiftDirPin] == 0 ? 1 : -1;
+            height = heightAt(liftSteps);
+            maxHeight = std::max(maxHeight, height);
+            level[kHeightPin] = height >= kSensorMm ? 0 : 1;
+            if (servoOpen) violation("lift moved with the basket open");
+        }
+        else if (pin == kTiltPulPin && value == 1 && level[kTiltEnaPin] == 0) {
+            tiltSteps++;
+            if (height < kTiltClearMm) violation("tilt below the frame clearance");
+        }
+    }
+
+    float adcMilliVolts(int pin) override {
+        if (pin != kLoadCellPin || weightEnteredAt < 0) return 0.0f;
+        double progress = std::min(1.0, (hostsim::clock().now() - weightEnteredAt) / static_cast<double>(kFillTime_us));
+        double mv = (progress * weight - kZeroKg) * kBeansMvPerKg + noise() * kAdcNoise_mv;
+        return static_cast<float>(std::max(0.0, std::round(mv)));
+    }
+
+    void pwmDuty(int pin, float percent) override {
+        if (pin != kServoPin) return;
+        servoOpen = percent > 0;
+        if (servoOpen) {
+            servoOpened = true;
+            if (level[kLiftEnaPin] == 0) violation("basket opened with the lift motor on");
+            if (std::fabs(height - kTargetMm) > kTargetToleranceMm) violation("basket opened away from the unloading height");
+            if (tiltSteps < kPourSteps) violation("basket opened before it leans to pour");
+        }
+        else if (servoOpened) servoClosed = true;
+    }
+
+    int pinLevel(int pin) override {
+        if (keypad.isColumn(pin)) return keypad.columnLevel(pin, level);
+        return World::pinLevel(pin);
+    }
+
+    // Drives one frame onto the wire, half-bit by half-bit
+    void sendFrame(const ComMessage &msg, int64_t at_us, bool corrupt) {
+        uint8_t frame[kComMaxFrameBytes];
+        int halves = comEncode(msg, frame) * 16;
+        if (corrupt) frame[2] ^= 0x20;                  // Coupled now reads as arrived, caught by the CRC
+        for (int h = 0; h <= halves; h++) {
+            int value = h < halves ? comHalfLevel(frame, h) : 0;
+            hostsim::clock().at(at_us + h * kComBitPeriod_us / 2, [this, value]() { drive(kComPin, value); });
+        }
+        hostsim::clock().at(at_us, [msg, corrupt]() { hostsim::trace("COM  %s%s", comTypeName(msg.type), corrupt ? " (corrupted)" : ""); });
+    }
+
+    void keyPressed() {
+        char key = keys.front().key;
+        keys.pop_front();
+        hostsim::trace("KEY  '%c' pressed", key);
+        if (key >= '0' && key <= '9') typed += key;
+        if (key == 'A') {
+            weight = atof(typed.c_str());
+            weightEnteredAt = hostsim::clock().now();
+        }
+    }
+
+    void lcdText(const char *text) override {
+        lcdWrites++;
+        lastLcd = text;
+    }
+
+    bool missionComplete() const override {
+        return keys.empty() && std::fabs(height - kTargetMm) <= kTargetToleranceMm && maxHeight < kEndStopMm &&
+               level[kLiftEnaPin] == 1 &&
+               tiltSteps > 0 && level[kTiltEnaPin] == 1 && servoOpened && servoClosed && violations == 0;
+    }
+
+    void report(FILE *out) const override {
+        fprintf(out, "Weight entered: %.0f kg\n", weight);
+        fprintf(out, "Lift height:    %.1f mm after %d steps (target %.0f mm, sensor at %.0f mm)\n", height, liftSteps,
+                kTargetMm, kSensorMm);
+        fprintf(out, "Tilt steps:     %d\n", tiltSteps);
+        fprintf(out, "Basket servo:   %s\n", servoClosed ? "opened and closed" : servoOpened ? "left open" : "never opened");
+        fprintf(out, "Interlocks:     %d violations%s%s\n", violations, violations > 0 ? ", first: " : "", firstViolation.c_str());
+        fprintf(out, "LCD writes:     %d, last \"%s\"\n", lcdWrites, lastLcd.c_str());
+    }
+
+private:
+    void violation(const char *what) {
+        if (violations++ == 0) firstViolation = what;
+        hostsim::trace("INTERLOCK %s", what);
+    }
+
+    // Platform height for a step count from rest: the roller moves along the base, the links rise
+    static double heightAt(int steps) {
+        double c = std::cos(kRestDeg * kPi / 180) - steps * kScrewStepMm / kLinkMm;
+        return 2 * kLinkMm * std::sin(std::acos(std::min(1.0, std::max(0.0, c))));
+    }
+
+    // Deterministic, roughly normal noise (sum of four uniforms), unit variance
+    double noise() {
+        double sum = 0;
+        for (int i = 0; i < 4; i++) {
+            noiseState = noiseState * 1664525u + 1013904223u;
+            sum += (noiseState >> 8) / static_cast<double>(1 << 24) - 0.5;
+        }
+        return sum * std::sqrt(3.0);
+    }
+
+    hostsim::KeyMatrix keypad;
+    std::deque<KeyPress> keys;
+    std::string typed;
+    std::string lastLcd;
+    double weight = 0;
+    int64_t weightEnteredAt = -1;
+    int liftSteps = 0, tiltSteps = 0, lcdWrites = 0;
+    double height = heightAt(0), maxHeight = heightAt(0);
+    bool servoOpen = false, servoOpened = false, servoClosed = false;
+    int violations = 0;
+    std::string firstViolation;
+    uint32_t noiseState = 12345;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    static ScissorLiftWorld world;
+    return hostsim::runMission(world, app_main, 120 * 1000000LL, argc, argv);
+}
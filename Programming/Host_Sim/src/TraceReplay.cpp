@@ -0,0 +1,165 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: TraceReplay.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Replays a sensor trace (lib/SensorTrace) through the unmodified
+ *   app_main(), as fast as the host runs it:
+ *     - Every digital sample is driven onto its pin at its recorded time
+ *       (firing the pin's ISR on an edge, like the live input did)
+ *     - An ADC read returns the newest analog sample of its pin
+ *     - No other input model: whatever the firmware does comes from the
+ *       trace, so the same trace always gives the same actuator log
+ *   With --expect, the mission passes only when the actuator log equals
+ *   the live one (written by agv_sim / scissor_lift_sim --actuators);
+ *   the report shows the first command that differs.
+ *   Built twice: agv_replay, and scissor_lift_replay with REPLAY_LIFT.
+ *   Usage: agv_replay trace.strc [--expect live.txt] [--actuators out.txt] [-v]
+ *     e.g. ./build/agv_sim --uart2 agv.strc --actuators live.txt
+ *          ./build/agv_replay agv.strc --expect live.txt
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <SensorTrace.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C" void app_main();
+
+namespace {
+
+#ifdef REPLAY_LIFT
+const char *const kName = "Scissor Lift replay";
+const std::vector<int> kQuietPins = {5, 18, 19, 21};    // Keypad rows, as in ScissorLiftWorld.cpp
+#else
+const char *const kName = "AGV replay";
+const std::vector<int> kQuietPins = {};
+#endif
+
+constexpr int64_t kTail_us = 10 * 1000000LL;            // Firmware time allowed after the last sample
+
+bool readFile(const char *path, std::string &text) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+class ReplayWorld : public hostsim::World {
+public:
+    const char *name() const override { return kName; }
+
+    bool load(const char *tracePath, const char *expectPath) {
+        std::string bytes;
+        if (!readFile(tracePath, bytes)) {
+            fprintf(stderr, "Cannot read the trace %s\n", tracePath);
+            return false;
+        }
+        stats = sensorTraceParse(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size(), samples);
+        if (stats.samples == 0 && !stats.complete) {
+            fprintf(stderr, "%s is not a sensor trace\n", tracePath);
+            return false;
+        }
+        for (const SensorSample &s : samples) end_us = std::max(end_us, s.time_us);
+        if (expectPath != nullptr && !readFile(expectPath, expected)) {
+            fprintf(stderr, "Cannot read %s\n", expectPath);
+            return false;
+        }
+        checking = expectPath != nullptr;
+        return true;
+    }
+
+    int64_t end() const { return end_us; }
+
+    void begin() override {
+        hostsim::recordActuators(true);
+        for (int pin : kQuietPins) hostsim::quietActuator(pin);
+        for (std::vector<SensorSample> &pin : analog) pin.clear();
+        for (const SensorSample &s : samples) {
+            if (s.analog) {
+                analog[s.gpio].push_back(s);
+                continue;
+            }
+            int pin = s.gpio, value = s.value;
+            hostsim::clock().at(s.time_us, [this, pin, value]() { drive(pin, value); });
+        }
+        for (std::vector<SensorSample> &pin : analog) {     // Time order, an ISR can record out of it
+            std::stable_sort(pin.begin(), pin.end(),
+                             [](const SensorSample &a, const SensorSample &b) { return a.time_us < b.time_us; });
+        }
+    }
+
+    float adcMilliVolts(int pin) override {
+        if (pin < 0 || pin >= hostsim::kPinCount) return 0.0f;
+        const std::vector<SensorSample> &readings = analog[pin];
+        int64_t now = hostsim::clock().now();
+        auto next = std::upper_bound(readings.begin(), readings.end(), now,
+                                     [](int64_t t, const SensorSample &s) { return t < s.time_us; });
+        return next == readings.begin() ? 0.0f : (next - 1)->value / 1000.0f;
+    }
+
+    bool missionComplete() const override {
+        return hostsim::clock().now() >= end_us && (!checking || hostsim::actuatorLog() == expected);
+    }
+
+    void report(FILE *out) const override {
+        fprintf(out, "Trace:          %u samples over %.3f s, %u dropped%s\n", stats.samples, end_us * 1e-6,
+                stats.dropped, stats.complete ? "" : ", cut short");
+        if (hostsim::clock().now() < end_us) fprintf(out, "Firmware ended before the trace did\n");
+        if (!checking) return;
+        const std::string &log = hostsim::actuatorLog();
+        if (log == expected) {
+            fprintf(out, "Actuator log matches the live run\n");
+            return;
+        }
+        std::istringstream live(expected), replay(log);
+        std::string liveLine, replayLine;
+        for (size_t line = 1;; line++) {
+            bool moreLive = static_cast<bool>(std::getline(live, liveLine));
+            bool moreReplay = static_cast<bool>(std::getline(replay, replayLine));
+            if (moreLive && moreReplay && liveLine == replayLine) continue;
+            fprintf(out, "Actuator log differs from line %zu\n", line);
+            fprintf(out, "  live:   %s\n", moreLive ? liveLine.c_str() : "(end)");
+            fprintf(out, "  replay: %s\n", moreReplay ? replayLine.c_str() : "(end)");
+            return;
+        }
+    }
+
+private:
+    std::vector<SensorSample> samples;
+    std::vector<SensorSample> analog[hostsim::kPinCount];
+    SensorTraceStats stats;
+    int64_t end_us = 0;
+    std::string expected;
+    bool checking = false;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *tracePath = nullptr;
+    const char *expectPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) expectPath = argv[++i];
+        else if (argv[i][0] == '-') {
+            if (strcmp(argv[i], "-v") != 0 && i + 1 < argc) i++;  // Simulator option and its file
+        }
+        else if (tracePath == nullptr) tracePath = argv[i];
+    }
+    if (tracePath == nullptr) {
+        fprintf(stderr, "Usage: %s trace.strc [--expect live.txt] [--actuators out.txt] [-v]\n", argv[0]);
+        return 2;
+    }
+    static ReplayWorld world;
+    if (!world.load(tracePath, expectPath)) return 2;
+    return hostsim::runMission(world, app_main, world.end() + kTail_us, argc, argv);
+}
@@ -0,0 +1,111 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Simulator
+ * File: WorkPool.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Chunk deques, stealing and worker wake-up of WorkPool.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <WorkPool.h>
+
+#include <algorithm>
+
+namespace {
+constexpr int kSpinRounds = 4000;               // Yields before an idle worker sleeps
+}
+
+WorkPool::WorkPool(int threads) {
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+    for (int i = 1; i < threads; i++) workers.emplace_back(&WorkPool::workerLoop, this, i);
+}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> hold(wakeLock);
+        quit.store(true, std::memory_order_release);
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+void WorkPool::parallelFor(size_t count, size_t grain, const Body &body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    size_t chunkCount = (count + grain - 1) / grain;
+    if (queues.size() == 1 || chunkCount == 1) {
+        for (size_t begin = 0; begin < count; begin += grain) body(begin, std::min(count, begin + grain));
+        ran.fetch_add(chunkCount, std::memory_order_relaxed);
+        return;
+    }
+    job = &body;
+    remaining.store(chunkCount, std::memory_order_release);
+    // Contiguous blocks, so each thread starts on neighbouring items
+    size_t perQueue = (chunkCount + queues.size() - 1) / queues.size();
+    for (size_t q = 0; q < queues.size(); q++) {
+        std::lock_guard<std::mutex> hold(queues[q]->lock);
+        for (size_t c = q * perQueue; c < std::min(chunkCount, (q + 1) * perQueue); c++) {
+            queues[q]->chunks.push_back({c * grain, std::min(count, (c + 1) * grain)});
+        }
+    }
+    {
+        std::lock_guard<std::mutex> hold(wakeLock);
+        generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    wake.notify_all();
+    runChunks(0);
+    while (remaining.load(std::memory_order_acquire) != 0) std::this_thread::yield();   // Last chunks still running
+}
+
+bool WorkPool::take(int self, Chunk &chunk) {
+    {
+        Queue &own = *queues[self];
+        std::lock_guard<std::mutex> hold(own.lock);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue &victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> hold(victim.lock);
+        if (victim.chunks.empty()) continue;
+        chunk = victim.chunks.front();
+        victim.chunks.pop_front();
+        stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkPool::runChunks(int self) {
+    Chunk chunk;
+    while (remaining.load(std::memory_order_acquire) != 0 && take(self, chunk)) {
+        (*job)(chunk.begin, chunk.end);
+        ran.fetch_add(1, std::memory_order_relaxed);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void WorkPool::workerLoop(int self) {
+    uint64_t seen = 0;
+    while (true) {
+        for (int spin = 0; spin < kSpinRounds && generation.load(std::memory_order_acquire) == seen; spin++) {
+            if (quit.load(std::memory_order_acquire)) return;
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock<std::mutex> hold(wakeLock);
+            wake.wait(hold, [&]() {
+                return quit.load(std::memory_order_acquire) || generation.load(std::memory_order_acquire) != seen;
+            });
+            if (quit.load(std::memory_order_acquire)) return;
+            seen = generation.load(std::memory_order_acquire);
+        }
+        runChunks(self);
+    }
+}
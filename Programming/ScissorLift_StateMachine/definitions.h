@@ -25,20 +25,43 @@
 //Libraries to use
 #include <SimpleADC.h>              //Analog signals
 #include <SimpleGPIO.h>             //Digital signals
-#include <SimpleKeypad.h>           //Keypad
+#include <KeypadScanner.h>          //Keypad matrix scanner and event queue
 #include <NibbleLCD.h>              //LCD
 #include <SimplePWM.h>              //Motors
 #include <SimpleTimer.h>            //Control time
 #include <cmath>                    //Math functions
+#include <StateMachine.h>           //Transition table state machine
+#include <StepperProfile.h>         //Stepper acceleration ramps
+#include <StepPulseTrain.h>         //RMT step pulse trains
+#include <ActuatorScheduler.h>      //Overlapped actuator jobs with interlocks
+#include <LoadCellFilter.h>         //Load cell filter and settling detection
+#include <LoadCellCalibration.h>    //Load cell calibration stored in NVS
+#include <LiftLoadLimits.h>         //Safe load per platform height, generated by lift_statics
+#include <LiftStepHeights.h>        //Platform height per lift step, generated by lift_statics
+#include <LcdFramebuffer.h>         //Diffing LCD framebuffer and flush task
+#include <ComLink.h>                //Framed messages on the communication wire
+#include <TelemetryLog.h>           //Binary event log drained by a background task
+#include <Instrumentation.h>        //Timing probes, compiled out with INSTRUMENTATION=0
+#include <SensorTrace.h>            //Raw sensor samples for host replay, SENSOR_TRACE=1
+#include <PinMap.h>                 //Pin map checked by the compiler
+#include <FastPin.h>                //Step pins driven through the GPIO registers
+#include <driver/uart.h>            //Telemetry and sensor trace output
+#include <esp_rom_gpio.h>            //Console RX detached from its pin
+#include <soc/gpio_sig_map.h>
 
 //GPIO pins
 
-//  Basket servomotor
-#define SERVOMOTOR_GPIO 36
+//  Basket servomotor: on the console RX pin (nothing is typed there, UART0 is detached from it first), GPIO 36
+//  cannot drive
+#define SERVOMOTOR_GPIO 3
 //  Tilting stepper motor
 #define TILT_PUL_GPIO 0
 #define TILT_DIR_GPIO 32
 #define TILT_ENA_GPIO 33
+//  Step pulse backend: 1 = RMT pulse trains refilled per chunk, 0 = one timer callback per pulse edge
+#define STEP_PULSE_RMT 1
+#define TILT_RMT_CHANNEL RMT_CHANNEL_0
+#define LIFT_RMT_CHANNEL RMT_CHANNEL_1
 //  Lifting stepper motor
 #define LIFT_PUL_GPIO 25
 #define LIFT_DIR_GPIO 26
@@ -47,43 +70,115 @@
 #define HEIGHT_SEN_GPIO 34
 //  Load cell
 #define LOAD_CELL_GPIO 39
-//  Buzzer
-#define BUZZER_GPIO 1
+#define LOAD_CELL_SLOPE 0.1f        // Default calibration until one is stored, kg per mV
+#define LOAD_CELL_OFFSET 0.1f       // Default calibration until one is stored, kg at 0 mV
+//  Buzzer: no output pin left once the servo took the console RX pin, BUZZER_GPIO is defined when the board frees
+//  one; until then the blinks keep only their pauses
 //  LCD
-//                      D0  D1    D2    D3    D4    D5 D6  D7  RS  RW    EN
-uint8_t lcd_pins[11] = {13, NULL, NULL, NULL, NULL, 2, 16, 17, 14, NULL, 12};
+#define LCD_D0_GPIO 13
+#define LCD_D5_GPIO 2
+#define LCD_D6_GPIO 16
+#define LCD_D7_GPIO 17
+#define LCD_RS_GPIO 14
+#define LCD_EN_GPIO 12
+#define LCD_UNUSED 0                // Lines not wired to the ESP32, left out by NibbleLCD
+//                      D0           D1          D2          D3          D4          D5           D6           D7           RS           RW          EN
+uint8_t lcd_pins[11] = {LCD_D0_GPIO, LCD_UNUSED, LCD_UNUSED, LCD_UNUSED, LCD_UNUSED, LCD_D5_GPIO, LCD_D6_GPIO, LCD_D7_GPIO, LCD_RS_GPIO, LCD_UNUSED, LCD_EN_GPIO};
 //  Keypad
-uint8_t keypad_rows[4] = {5, 18, 19, 21};
-uint8_t keypad_cols[4] = {15, 4, 22, 23};
+constexpr uint8_t keypad_rows[4] = {5, 18, 19, 21};
+constexpr uint8_t keypad_cols[4] = {15, 4, 22, 23};
 //  Communication sensor
 #define COMM_SENSOR_GPIO 35
+//  Telemetry: no spare pin, shares the console port (telemetry_decode skips the text)
+#define TELEMETRY_UART UART_NUM_0
+#define TELEMETRY_TX_GPIO 1
+#define TELEMETRY_BAUD 115200
+//  Sensor trace (SENSOR_TRACE=1, replay with scissor_lift_replay): takes the console TX pin from UART0, console
+//  text and telemetry are not sent in these builds
+#define SENSOR_TRACE_UART UART_NUM_1
+#define SENSOR_TRACE_TX_GPIO 1
+#define SENSOR_TRACE_BAUD 921600
+
+//Pin map: every pin above, the build stops on a pin used twice or beyond its pad (PinMap.h)
+constexpr PinSpec liftPins[] = {
+    {SERVOMOTOR_GPIO, PIN_PWM, "Basket servomotor"},
+    {TILT_PUL_GPIO, PIN_OUTPUT, "Tilt pulse"},
+    {TILT_DIR_GPIO, PIN_OUTPUT, "Tilt direction"},
+    {TILT_ENA_GPIO, PIN_OUTPUT, "Tilt enable"},
+    {LIFT_PUL_GPIO, PIN_OUTPUT, "Lift pulse"},
+    {LIFT_DIR_GPIO, PIN_OUTPUT, "Lift direction"},
+    {LIFT_ENA_GPIO, PIN_OUTPUT, "Lift enable"},
+    {HEIGHT_SEN_GPIO, PIN_INPUT, "Height sensor"},
+    {LOAD_CELL_GPIO, PIN_ADC, "Load cell"},
+#ifdef BUZZER_GPIO
+    {BUZZER_GPIO, PIN_OUTPUT, "Buzzer"},
+#endif
+    {LCD_D0_GPIO, PIN_OUTPUT, "LCD D0"},
+    {LCD_D5_GPIO, PIN_OUTPUT, "LCD D5"},
+    {LCD_D6_GPIO, PIN_OUTPUT, "LCD D6"},
+    {LCD_D7_GPIO, PIN_OUTPUT, "LCD D7"},
+    {LCD_RS_GPIO, PIN_OUTPUT, "LCD RS"},
+    {LCD_EN_GPIO, PIN_OUTPUT, "LCD EN"},
+    {keypad_rows[0], PIN_OUTPUT, "Keypad row 1"},
+    {keypad_rows[1], PIN_OUTPUT, "Keypad row 2"},
+    {keypad_rows[2], PIN_OUTPUT, "Keypad row 3"},
+    {keypad_rows[3], PIN_OUTPUT, "Keypad row 4"},
+    {keypad_cols[0], PIN_INPUT_PULLUP, "Keypad column 1"},
+    {keypad_cols[1], PIN_INPUT_PULLUP, "Keypad column 2"},
+    {keypad_cols[2], PIN_INPUT_PULLUP, "Keypad column 3"},
+    {keypad_cols[3], PIN_INPUT_PULLUP, "Keypad column 4"},
+    {COMM_SENSOR_GPIO, PIN_INPUT, "Communication sensor"},
+#if SENSOR_TRACE
+    {SENSOR_TRACE_TX_GPIO, PIN_UART_TX, "Sensor trace"},
+#else
+    {TELEMETRY_TX_GPIO, PIN_UART_TX, "Console and telemetry"},
+#endif
+};
+static_assert(kPinMapChecked<liftPins>);
 
 //Object creation
 //  Basket servomotor
 SimplePWM servoMotor;
 //  Tilting stepper motor
-SimpleGPIO tiltPul; //Pulse
-SimpleGPIO tiltDir; //Direction
-SimpleGPIO tiltEna; //Enable
+FastPin<TILT_PUL_GPIO> tiltPul; //Pulse
+FastPin<TILT_DIR_GPIO> tiltDir; //Direction
+FastPin<TILT_ENA_GPIO> tiltEna; //Enable
 SimpleTimer tiltTimer;
-SimpleTimer tiltStopTimer;
+StepProfile tiltProfile;
+PulseTrain tiltPulses;
+StepLoad tiltLoad;
 //  Lifting stepper motor
-SimpleGPIO liftPul;
-SimpleGPIO liftDir;
-SimpleGPIO liftEna;
+FastPin<LIFT_PUL_GPIO> liftPul;
+FastPin<LIFT_DIR_GPIO> liftDir;
+FastPin<LIFT_ENA_GPIO> liftEna;
 SimpleTimer liftTimer;
+StepProfile liftProfile;
+PulseTrain liftPulses;
+StepLoad liftLoad;
+int32_t liftPosition = 0;   // Lift steps from rest, homed at setup(), corrected at the height sensor
 //  Height sensor
 SimpleGPIO heightSensor;
 //  Load Cell
 SimpleADC loadCell;
+LoadCellFilter loadFilter;
+CalibrationStore calStore;
+LoadCalibration loadCal = {LOAD_CELL_SLOPE, LOAD_CELL_OFFSET, 0, 0};
+float basketLoad_kg = 0;    // Settled weight of the beans, checked before lifting
 // Buzzer
+#ifdef BUZZER_GPIO
 SimpleGPIO ledAct;
+#endif
 //  LCD
 NibbleLCD lcdDisplay;
+LcdFramebuffer lcdScreen;   // Post text here, only its flush task drives lcdDisplay
 char lcdBuffer[100]; // Buffer for LCD display
 //  Keypad
-SimpleKeypad keypad(keypad_rows, keypad_cols);
+KeypadScanner keypad;
 //  Communication
 SimpleGPIO slComSensor;
+ComReceiver slComLink;      // Decodes the AGV frames from the pin's edges
+//  Telemetry
+TelemetryLog telemetry;     // Step ISR and load loop events
+SensorRecorder sensorTrace; // Every sensor sample, when built with SENSOR_TRACE=1
 
 #endif // _DEFINITIONS_H_
\ No newline at end of file
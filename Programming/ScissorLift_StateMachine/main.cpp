@@ -5,14 +5,36 @@
  * Description:
  *   Implements the finite state machine for the Scissor Lift, including:
  *     - LED actuator feedback
- *     - Keypad input logic
- *     - Load cell calibration and weight detection
- *     - Communication sensor detection
- *     - Lifting stepper motor control with height sensor
- *     - Tilting stepper motor control
+ *     - Keypad input logic, consuming debounced events from a background
+ *       matrix scanner (the prompt can be typed over)
+ *     - LCD text posted to a diffing framebuffer, flushed by its own task
+ *     - Two-point load cell calibration ('D' at the weight prompt), kept
+ *       in NVS and loaded at setup()
+ *     - Load cell weight detection (500 Hz filter with variance-based
+ *       settling)
+ *     - Typed AGV messages (coupled, obstacle, arrived, abort) decoded
+ *       from the communication wire's edges, waited for together with
+ *       wire faults (held high, AGV silent) under a deadline
+ *     - Lifting stepper motor control (S-curve ramp) to any platform
+ *       height in one move: steps counted from rest and converted with the
+ *       geometry's step/height table, the height sensor kept as the top
+ *       limit and position check; refused when the basket load is over the
+ *       statics table limit
+ *     - Tilting stepper motor control (trapezoidal ramp, fixed step count)
+ *     - Step pulses from RMT chunks or one timer callback per edge (STEP_PULSE_RMT)
  *     - Basket servomotor for unloading
+ *     - Lift, tilt and unload as actuator jobs run together by a scheduler:
+ *       the tilt starts once the basket clears the frame, the servo once
+ *       the lift has stopped and the basket leans far enough to pour
+ *     - Binary telemetry log (height sensor seen by the step ISRs, load
+ *       settled) drained to the console UART by a low-priority task
+ *     - Optional sensor trace (SENSOR_TRACE=1): every keypad, height,
+ *       load cell and wire sample to a second UART, for scissor_lift_replay
+ *     - Timing probes: time in each state, step ISR duration and timer
+ *       lateness, load loop jitter; printed with '#' at a keypad prompt
+ *       and at the end (INSTRUMENTATION=0 removes them)
  *     - State transitions (setup, load beans, wait for AGV, move mechanism,
- *       lifting, tilting, unloading)
+ *       unloading) as a StateMachine transition table
  *
  * Date: June 2025
  * License: MIT (see LICENSE file in repository)
@@ -20,355 +42,621 @@
 
 #include <definitions.h>
 
-enum states {state0, state1, state2, state3, state4, state5, state6};
+// Motion profiles: start rate (steps/s), cruise rate (steps/s), acceleration (steps/s^2)
+const MotionProfile liftMotion = {200, 1000, 8000, PROFILE_SCURVE};
+const MotionProfile tiltMotion = {100, 400, 2000, PROFILE_TRAPEZOID};
+#define TILT_STEPS 150 // Basket tilt travel
+#define LIFT_REST_MM 35 // Platform height at rest, links at 5 degrees
+#define LIFT_TOP_MM 350 // Platform height at the height sensor, links at 60 degrees
+#define LIFT_TARGET_MM 320 // Unloading height, anywhere up to the height sensor
+#define LIFT_SLIP_STEPS 24 // Largest step count error accepted at the height sensor (RMT chunk plus slip)
+#define TILT_CLEAR_MM 250 // Platform height where the basket clears the frame, the tilt may start
+#define TILT_POUR_STEPS 110 // Basket tilted far enough to pour, the servo may open
+#define SERVO_OPEN_MS 1000 // Basket held open to unload
+#define UNLOAD_TIMEOUT_MS 10000 // Longest lift, tilt and unload
+#define MOTION_POLL_MS 10 // Check for the end of a move
+#define LIFT_CHUNK_STEPS 16 // Lift steps per RMT chunk, bounds how late the height sensor is seen
+#define LOAD_POLL_MS 50 // Check the load cell filter output
+#define LOAD_PRINT_MS 250 // Minimum time between weight updates on the LCD
+#define CAL_AVERAGE_MS 500 // Load cell averaging time for each calibration point
+#define PROMPT_MS 3000 // Weight prompt time, unless a key is typed first
+#define KEY_WAIT_MS 1000 // Longest single wait for a key press
+#define COUPLE_TIMEOUT_MS 120000 // Longest wait for the AGV to couple
+#define MOVE_TIMEOUT_MS 60000 // Longest trip to the unloading station
+#define COM_SILENT_MS 2000 // The AGV repeats its status every 500 ms, longer silence means the link is lost
+#define COM_STUCK_MS 20 // Frames never hold the wire high this long
+
+enum states {state0, state1, state2, state3, state4, stateDone, stateFault, stateCount};
+enum events {success, failure, eventCount};
+
+// Timing probes
+const char *const stateNames[stateCount] = {"setup", "load_beans", "waiting_agv", "move_mechanism", "unloading",
+                                            "done", "fault"};
+StateTimer<stateCount> stateTimes("state", stateNames);
+CycleTimer liftIsrTime("lift_isr");                     // Step callback or RMT chunk callback
+CycleTimer tiltIsrTime("tilt_isr");
+LatencyProbe liftTimerLate("lift_timer_late");          // One-edge-per-callback backend only
+LatencyProbe tiltTimerLate("tilt_timer_late");
+PeriodProbe loadLoop("load_loop", LOAD_POLL_MS * 1000);
 
 // SUPPORT FUNCTIONS
-//LED Actuator
-void blinkLED(SimpleGPIO &sensor, int repetition, int ms = 200) {
+//Buzzer: builds without a BUZZER_GPIO keep only its pauses
+void buzzer(int on) {
+#ifdef BUZZER_GPIO
+    ledAct.set(on);
+#endif
+}
+
+void blinkLED(int repetition, int ms = 200) {
     for (int i = 0; i < repetition; i++) {
-        sensor.set(1);                                  // Turn on sensor
+        buzzer(1);                                      // Turn on buzzer
         vTaskDelay(pdMS_TO_TICKS(ms));                 // Wait for ms
-        sensor.set(0);                                  // Turn off sensor
+        buzzer(0);                                      // Turn off buzzer
         vTaskDelay(pdMS_TO_TICKS(ms));                 // Wait for ms
     }
 }
 
-// Lift callback function
+// UART0 reads the console RX pin through the IO_MUX until its input is tied high
+void releaseConsoleRx() {
+    esp_rom_gpio_connect_in_signal(GPIO_FUNC_IN_HIGH, U0RXD_IN_IDX, false);
+}
+
+// Height sensor check, from the lift step ISRs: top limit while going up
+bool liftUp = true;                                     // Direction of the current move
+int32_t liftStart = 0;                                  // liftPosition when the move began
+volatile int32_t heightTripAt = -1;                     // Step position where the sensor tripped, -1 if not seen
+void IRAM_ATTR liftHeightCheck() {
+    if (!liftUp || sensorTraceGet(heightSensor) != 0) return;
+    liftProfile.stop();                                 // Limit reached, ramp down
+    if (heightTripAt < 0) {
+        heightTripAt = liftStart + liftProfile.stepsDone();
+        telemetry.log(TLM_LIFT_HEIGHT, heightTripAt);
+    }
+}
+
+// Lift callback function: one call per pulse edge, timing comes from the profile
 void IRAM_ATTR liftCallback(void* arg) {
-    static bool state = false;
-    state = !state;
-    liftPul.set(state);                                 // Toggle the pulse signal for the lift motor
+    liftTimerLate.fired();                              // Against the time the edge was scheduled for
+    CycleScope timing(liftIsrTime);
+    StepLoadScope scope(liftLoad);                      // Interrupt and CPU counters
+    StepEdge edge = liftProfile.nextEdge();
+    if (edge.delay_us == 0) return;                     // Move finished
+    liftPul.set(edge.level);                            // Pulse edge for the lift motor
+    if (edge.level == 1) {
+        liftLoad.steps++;
+        liftHeightCheck();                              // Sensor sampled once per step
+    }
+    liftTimer.startOnce(edge.delay_us);                 // Schedule the next edge
+    liftTimerLate.expect(esp_timer_get_time() + edge.delay_us);
+}
+
+// Lift chunk callback: RMT backend, once per chunk of steps
+void IRAM_ATTR liftChunkCallback(void *arg) {
+    CycleScope timing(liftIsrTime);
+    liftHeightCheck();
 }
 
 // Tilt callback function
 void IRAM_ATTR tiltCallback(void *arg) {
-    static bool state = false;
-    state = !state;
-    tiltPul.set(state);                                 // Toggle the pulse signal for the tilt motor
+    tiltTimerLate.fired();
+    CycleScope timing(tiltIsrTime);
+    StepLoadScope scope(tiltLoad);                      // Interrupt and CPU counters
+    StepEdge edge = tiltProfile.nextEdge();
+    if (edge.delay_us == 0) return;                     // All steps done
+    tiltPul.set(edge.level);                            // Pulse edge for the tilt motor
+    if (edge.level == 1) tiltLoad.steps++;
+    tiltTimer.startOnce(edge.delay_us);                 // Schedule the next edge
+    tiltTimerLate.expect(esp_timer_get_time() + edge.delay_us);
+}
+
+// Runs a prepared profile on the selected step backend
+void startSteps(PulseTrain &pulses, StepLoad &load, void (*edgeCallback)(void *)) {
+    load.reset();
+#if STEP_PULSE_RMT
+    pulses.start();
+#else
+    edgeCallback(NULL);                                 // First edge, the timer takes over
+#endif
 }
 
-// Tilt stop callback function
-void IRAM_ATTR tiltStopCallback(void* arg) {
-    tiltTimer.stopPeriodic();                           // Stop generating steps
-    tiltEna.set(1);                                     // Disable motor (if 1 = disable on your driver)
+bool stepsRunning(PulseTrain &pulses, StepProfile &profile) {
+#if STEP_PULSE_RMT
+    return pulses.busy();
+#else
+    return profile.busy();
+#endif
 }
 
+void printStepLoad(const char *name, const StepLoad &load) {
+    printf("%s: %lu steps, %.0f interrupts/s, CPU %.2f %%\n", name, static_cast<unsigned long>(load.steps),
+           load.interruptsPerSecond(), load.cpuLoad());
+}
+
+bool calibrateLoadCell();
+
 // Keypad
-float keypadLogic() {
-    // Setup
-    lcdDisplay.setup(lcd_pins);
-    keypad.setup();
-    char buffer[3] = {'\0'};                            // Buffer to store the input weight
-    int index = 0;                                      // Index for the buffer
-    // Input weight from user
-    lcdDisplay.printStr("Input load\nweight in kg");
-    vTaskDelay(pdMS_TO_TICKS(3000));
-    lcdDisplay.printStr("Press 'A' to\nconfirm");
+// Digits until 'A', 'B' deletes, 'C' clears, '#' prints the timing probes; 'D' runs the load cell
+// calibration when allowed.
+// firstKey is a press already taken from the scanner (typed over the prompt)
+float keypadNumber(bool calibrationKey = false, char firstKey = '\0') {
+    KeypadEntry entry;                                  // Digits of the input weight
     while(true) {
-        char key = keypad.getKey();
+        char key = firstKey != '\0' ? firstKey : keypad.waitKey(KEY_WAIT_MS);   // Wakes within a few ms of a press
+        firstKey = '\0';
         if (key != '\0') {
-            if (key >= '0' && key <= '9' && index < sizeof(buffer) - 1) {
-                buffer[index++] = key;                  // Store the digit in the buffer
-                buffer[index] = '\0';                   // Null-terminate the string
-                lcdDisplay.writeCommand(CMD_CLEAR);
-                lcdDisplay.printStr(buffer);
-            }
-            else if (key == 'A' && index > 0) {
-                return atof(buffer);             // Convert to float and return
-            }
-            else if (key == 'C') {
-                lcdDisplay.writeCommand(CMD_CLEAR);
-                buffer[0] = '\0';                       // Clear the buffer
-                index = 0;                              // Reset index
-            }
-            else if (key == 'B' && index > 0) {
-                index--;                                // Decrement index
-                buffer[index] = '\0';                   // Remove last character
-                lcdDisplay.writeCommand(CMD_CLEAR);
-                lcdDisplay.printStr(buffer);
+            switch (entry.key(key)) {
+                case KeypadEntry::ENTRY_DONE:
+                    return entry.value();               // Convert to float and return
+                case KeypadEntry::ENTRY_CHANGED:
+                    lcdScreen.print(entry.text());
+                    break;
+                case KeypadEntry::ENTRY_CLEARED:
+                    lcdScreen.clear();
+                    break;
+                case KeypadEntry::ENTRY_IGNORED:
+                    if (key == '#') {
+                        TimingProbe::dumpAll();         // On the console, the prompt stays
+                    }
+                    else if (key == 'D' && calibrationKey) {
+                        calibrateLoadCell();
+                        entry.clear();                  // Start the weight over
+                        lcdScreen.print("Input load\nweight, 'A'");
+                    }
+                    break;
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(200));
     }
 }
 
+float keypadLogic() {
+    // Input weight from user; typing during the prompt skips it
+    lcdScreen.print("Input load\nweight in kg");
+    char key = keypad.waitKey(PROMPT_MS);
+    if (key == '\0') lcdScreen.print("Press 'A' to\nconfirm");
+    return keypadNumber(true, key);
+}
+
+// Load Cell Calibration
+// Mean load cell reading in mV: the filter runs with a unit calibration for CAL_AVERAGE_MS
+float averageMilliVolts() {
+    loadFilter.setCalibration(1.0f, 0.0f);
+    loadFilter.start(0.0f);
+    vTaskDelay(pdMS_TO_TICKS(CAL_AVERAGE_MS));
+    LoadStats reading = loadFilter.latest();
+    loadFilter.stop();
+    loadFilter.setCalibration(loadCal.slope, loadCal.offset);
+    return reading.weight_kg;                           // mV with the unit calibration
+}
+
+// Empty basket, then a known mass typed on the keypad; saved to NVS when valid
+bool calibrateLoadCell() {
+    float tare, reference, mass;                        // Empty and loaded readings (mV), known mass (kg)
+    LoadCalibration calibration;
+    char msg[32];                                       // Buffer for messages
+    lcdScreen.print("Calibration:\nempty, press A");
+    while (keypad.waitKey(KEY_WAIT_MS) != 'A') {}
+    tare = averageMilliVolts();
+    lcdScreen.print("Load known mass\nkg, then A");
+    mass = keypadNumber();
+    reference = averageMilliVolts();
+    if (!twoPointCalibration(tare, reference, mass, calibration)) {
+        lcdScreen.print("Calibration\nfailed!");
+        vTaskDelay(pdMS_TO_TICKS(2000));
+        return false;
+    }
+    loadCal = calibration;
+    loadFilter.setCalibration(loadCal.slope, loadCal.offset);
+    bool saved = calStore.save(loadCal);
+    printf("Load cell calibrated: %.4f kg/mV, %.3f kg (%s)\n", loadCal.slope, loadCal.offset,
+           saved ? "saved" : "not saved");
+    sprintf(msg, "%.4f kg/mV\n%s", loadCal.slope, saved ? "saved" : "NOT saved");
+    lcdScreen.print(msg);
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    return saved;
+}
+
 // Load Cell
 void loadCellLogic() {
     // Variables defined
     float inputWeight;                                  // User input weight
-    float reads;                                        // Variable to store the load cell reading
-    const float m = 0.1, b = 0.1;                       // Calibration constants
-    float realWeight;                                   // Real weight from load cell
+    LoadStats load;                                     // Newest filter output
     float lastPrintedWeight = -1000;                    // Last printed weight to avoid flickering
-    int stableCount = 0;                                // Counter for stable weight readings
+    int64_t lastPrintTime = 0;                          // Time of the last printed weight (us)
     char msg[32];                                       // Buffer for messages
     inputWeight = keypadLogic();
-    lcdDisplay.printStr("Loading beans\nPlease wait...");
+    lcdScreen.print("Loading beans\nPlease wait...");
+    loadFilter.start(inputWeight);                      // Sampling and settling detection run on the timer
+    loadLoop.restart();
     while(true) {
-        reads = loadCell.read(ADC_READ_MV);             // Read load cell value
-        realWeight = m*reads + b;                       // Real weight calculation
+        loadLoop.tick();
+        load = loadFilter.latest();
         //Show weight only if it changed
-        if (fabs(realWeight - lastPrintedWeight) > 0.05f) {
-            sprintf(msg, "Current Weight:\n%.2f kg", realWeight);
-            lcdDisplay.printStr(msg);
-            lastPrintedWeight = realWeight;             // Update last printed weight
-        }
-        
-        // Check if weight is stable
-        if (fabs(realWeight - inputWeight) < 0.05f) {
-            stableCount++;
+        if (load.seq > 0 && fabs(load.weight_kg - lastPrintedWeight) > 0.05f &&
+            load.timestamp_us - lastPrintTime >= LOAD_PRINT_MS * 1000) {
+            sprintf(msg, "Current Weight:\n%.2f kg", load.weight_kg);
+            lcdScreen.print(msg);
+            lastPrintedWeight = load.weight_kg;         // Update last printed weight
+            lastPrintTime = load.timestamp_us;
         }
-        else {
-            stableCount = 0;                            // Reset stable count if weight is not stable
-        }
-        if (stableCount >= 2) {                         // 2 second stability check
-            ledAct.set(1);                              // Turn on buzzer
-            lcdDisplay.printStr("Load weight\nreached!");
+
+        // Quiet window with its mean at the input weight
+        if (load.settled) {
+            loadFilter.stop();
+            basketLoad_kg = load.weight_kg;
+            telemetry.log(TLM_LOAD_SETTLED, tlmFloat(load.weight_kg), tlmFloat(load.stddev_kg));
+            buzzer(1);                                  // Turn on buzzer
+            lcdScreen.print("Load weight\nreached!");
             vTaskDelay(pdMS_TO_TICKS(3000));            // Wait for 3 seconds
-            ledAct.set(0);                              // Turn off buzzer
-            break;                                      // Exit the loop)
+            buzzer(0);                                  // Turn off buzzer
+            break;                                      // Exit the loop
         }
-        vTaskDelay(pdMS_TO_TICKS(1000));                // Wait for 1 sec before next reading
+        vTaskDelay(pdMS_TO_TICKS(LOAD_POLL_MS));
     }
 }
 
 // Scissor Lift Communication Sensor
-bool comSensorDetect(SimpleGPIO &sensor, int expectedState, int duration_ms, const char *msg, int interval_ms = 50) {
-int read; // Variable to store comm sensor reading
-int64_t now; // Variable to store current time
-int64_t startTime = 0; // Variable to store start time of detection
-while(true) {
-    read = sensor.get(); // Comm sensor reading
-    now = esp_timer_get_time() / 1000; // Current time in ms
-    if (read == expectedState) {
-        if (startTime == 0) { // First detection
-            startTime = now; // Start detection time
-        }
-        else if (now - startTime >= duration_ms) { // Signal stable for specified duration
-            lcdDisplay.printStr(msg);
-            return true; // Successful detection
-        }
-    }
-    else startTime = 0; // Reset timer if signal is lost
-    vTaskDelay(pdMS_TO_TICKS(interval_ms)); // Check every interval
+// Shows why the AGV wait ended without the expected message
+bool comSensorFailed(const char *msg) {
+    lcdScreen.print(msg);
+    return false;
+}
+
+// Telemetry
+void telemetrySink(const uint8_t *data, size_t length) {
+    uart_write_bytes(TELEMETRY_UART, data, length);     // Copied to the driver's TX buffer
+}
+
+bool telemetrySetup() {
+    const uart_config_t config = {TELEMETRY_BAUD, UART_DATA_8_BITS, UART_PARITY_DISABLE, UART_STOP_BITS_1,
+                                  UART_HW_FLOWCTRL_DISABLE, 0, UART_SCLK_DEFAULT};
+    if (uart_param_config(TELEMETRY_UART, &config) != ESP_OK) return false;
+    if (uart_driver_install(TELEMETRY_UART, 256, 2048, 0, NULL, 0) != ESP_OK) return false;    // Console pins kept
+    return telemetry.setup(telemetrySink);              // Drain task, every 20 ms
 }
-return false; // Detection failed
+
+// Sensor trace
+#if SENSOR_TRACE
+void sensorTraceSink(const uint8_t *data, size_t length) {
+    uart_write_bytes(SENSOR_TRACE_UART, data, length);  // Copied to the driver's TX buffer
+}
+
+bool sensorTraceSetup() {
+    const uart_config_t config = {SENSOR_TRACE_BAUD, UART_DATA_8_BITS, UART_PARITY_DISABLE, UART_STOP_BITS_1,
+                                  UART_HW_FLOWCTRL_DISABLE, 0, UART_SCLK_DEFAULT};
+    if (uart_param_config(SENSOR_TRACE_UART, &config) != ESP_OK) return false;
+    if (uart_set_pin(SENSOR_TRACE_UART, SENSOR_TRACE_TX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) return false;
+    if (uart_driver_install(SENSOR_TRACE_UART, 256, 4096, 0, NULL, 0) != ESP_OK) return false;   // RX unused, 4 KB TX buffer
+    if (!sensorTrace.setup(sensorTraceSink)) return false;  // Drain task, every 10 ms
+    sensorTrace.start();                                // Before the first sensor is read
+    return true;
 }
+#endif
 
 // MAIN FUNCTIONS
 bool setup() {
+    if (!telemetrySetup()) return false;
+#if SENSOR_TRACE
+    if (!sensorTraceSetup()) return false;
+#endif
     // LCD
-    lcdDisplay.setup(lcd_pins);                         // LCD pins
-    lcdDisplay.printStr("System Initializing...");
+    if (!lcdScreen.setup(lcdDisplay, lcd_pins)) return false;  // LCD pins, flush task
+    lcdScreen.print("System\nInitializing...");
     // Servomotor
+    releaseConsoleRx();                                 // The servo takes the console RX pin
     servoMotor.setup(SERVOMOTOR_GPIO, 0);               // GPIO pin, channel, rest = default
     // Tilt Stepper motor
-    tiltPul.setup(TILT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltDir.setup(TILT_DIR_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltEna.setup(TILT_ENA_GPIO, GPO);                  // GPIO pin, output mode, default pull
+    tiltPul.setup<GPO>();                               // Output mode, edges through the GPIO registers
+    tiltDir.setup<GPO>();                               // Output mode
+    tiltEna.setup<GPO>();                               // Output mode
     tiltDir.set(1);                                     // Direction for tilt motor
     tiltEna.set(1);                                     // tilt motor off
     tiltTimer.setup(tiltCallback, "tilt_timer");
-    tiltStopTimer.setup(tiltStopCallback, "tilt_stop_timer");
     // Lift Stepper Motor
-    liftPul.setup(LIFT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    liftDir.setup(LIFT_DIR_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    liftEna.setup(LIFT_ENA_GPIO, GPO);                  // GPIO pin, output mode, default pull
+    liftPul.setup<GPO>();                               // Output mode, edges through the GPIO registers
+    liftDir.setup<GPO>();                               // Output mode
+    liftEna.setup<GPO>();                               // Output mode
     liftDir.set(1);                                     // Direction for lift motor
     liftEna.set(1);                                     // Lift motor off
     liftTimer.setup(liftCallback, "lift_timer");
+    liftPosition = 0;                                   // Home: the platform powers up lowered onto its rest stop
     // Other components
     heightSensor.setup(HEIGHT_SEN_GPIO, GPI);           // GPIO pin, input mode, default pull
     loadCell.setup(LOAD_CELL_GPIO);                     // GPIO pin, default width = bit 12
-    ledAct.setup(BUZZER_GPIO, GPO);                     // GPIO pin, output mode, default pull
-    keypad.setup();
+    // Stored calibration, or the defaults until the first calibration
+    if (!calStore.begin()) return false;
+    CalibrationStatus calStatus = calStore.load(loadCal);
+    printf("Load cell calibration: %s, %.4f kg/mV, %.3f kg\n", CalibrationStore::statusName(calStatus),
+           loadCal.slope, loadCal.offset);
+    if (!loadFilter.setup(loadCell, loadCal.slope, loadCal.offset)) return false;
+#ifdef BUZZER_GPIO
+    ledAct.setup(BUZZER_GPIO, GPO);                     // GPIO pin, output mode
+#endif
+    if (!keypad.setup(keypad_rows, keypad_cols)) return false;    // 1 kHz matrix scan, debounced events
     slComSensor.setup(COMM_SENSOR_GPIO, GPI);           // GPIO pin, input mode, default pull
+    if (!slComLink.setup(COMM_SENSOR_GPIO)) return false;      // Edge ISR, 1 ms Manchester bits
+    // Step interval tables for both ramps
+    if (!liftProfile.build(liftMotion) || !tiltProfile.build(tiltMotion)) return false;
+#if STEP_PULSE_RMT
+    if (!liftPulses.setup(LIFT_PUL_GPIO, LIFT_RMT_CHANNEL, liftProfile, liftLoad, LIFT_CHUNK_STEPS, liftChunkCallback)) return false;
+    if (!tiltPulses.setup(TILT_PUL_GPIO, TILT_RMT_CHANNEL, tiltProfile, tiltLoad)) return false;
+#endif
     return true;
 }
 
 bool load_beans() {
-    keypadLogic();
-    // loadCellLogic();
+    loadCellLogic();
     return true;
 }
 
 bool waiting_agv() {
     char msg[] = "AGV coupled succesfully!\nMoving mechanism...";
-    lcdDisplay.printStr("Waiting for AGV\nto couple...");
-    while(true) {
-        return comSensorDetect(slComSensor, 1, 3000, msg); // Detect if mechanism is fully coupled 
+    enum {coupled, aborted, stuck};
+    const ComPattern patterns[] = {comExpect(COM_COUPLED), comExpect(COM_ABORT), comHeld(1, COM_STUCK_MS)};
+    ComMessage frame;
+    lcdScreen.print("Waiting for AGV\nto couple...");
+    switch (slComLink.waitFor(patterns, 3, COUPLE_TIMEOUT_MS, frame)) { // Any of them, whichever comes first
+        case coupled: // Mechanism is fully coupled
+            lcdScreen.print(msg);
+            return true;
+        case aborted:
+            return comSensorFailed("AGV stopped!");
+        case stuck:
+            return comSensorFailed("Com wire fault!");
+        default:
+            return comSensorFailed("AGV did not\ncouple!");
     }
-    return true;
 }
 
 bool move_mechanism() {
-    char msg_1[] = "Obstacle detected!";
+    char msg_1[] = "Obstacle detected!\n%u cm ahead";
     char msg_2[] = "The mechanism has arrived at the unloading station!";
-    lcdDisplay.printStr("Moving to unload\nstation...");
+    char msg_3[] = "Moving to unload\nstation...";
+    enum {obstacleAhead, pathClear, arrived, aborted, silent, stuck};
+    const ComPattern patterns[] = {comExpect(COM_OBSTACLE), comExpect(COM_COUPLED), comExpect(COM_ARRIVED),
+                                   comExpect(COM_ABORT), comHeld(0, COM_SILENT_MS), comHeld(1, COM_STUCK_MS)};
+    int64_t deadline = esp_timer_get_time() / 1000 + MOVE_TIMEOUT_MS; // Whole trip, in ms
+    bool obstacle = false; // Obstacle shown on the LCD
+    ComMessage frame;
+    lcdScreen.print(msg_3);
     while(true) {
-        comSensorDetect(slComSensor, 0, 200, msg_1); // Detect if mechanism encounters an obstacle
-        return comSensorDetect(slComSensor, 0, 3000, msg_2); // Detect if mechanism arrives at unloading station
+        int64_t left = deadline - esp_timer_get_time() / 1000;
+        int match = left > 0 ? slComLink.waitFor(patterns, 6, static_cast<uint32_t>(left), frame) : kComTimeout;
+        switch (match) {
+            case obstacleAhead: // AGV slowed down, repeated with the new distance
+                snprintf(lcdBuffer, sizeof(lcdBuffer), msg_1, static_cast<unsigned>(frame.value));
+                lcdScreen.print(lcdBuffer);
+                obstacle = true;
+                break;
+            case pathClear:
+                if (obstacle == true) lcdScreen.print(msg_3);
+                obstacle = false;
+                break;
+            case arrived: // Mechanism at the unloading station
+                lcdScreen.print(msg_2);
+                return true;
+            case aborted:
+                return comSensorFailed("AGV stopped!");
+            case silent:
+                return comSensorFailed("AGV link lost!");
+            case stuck:
+                return comSensorFailed("Com wire fault!");
+            default:
+                return comSensorFailed("AGV did not\narrive!");
+        }
     }
-    return true;
 }
 
-bool lifting_motor() {
-    // LCD Setup
-    lcdDisplay.setup(lcd_pins);
-    heightSensor.setup(HEIGHT_SEN_GPIO, GPI);           // GPIO pin, input mode, default pull
+// UNLOADING JOBS
+// Lowest the platform can be right now, in steps from rest, also in the middle of a move
+int32_t liftStepsAtLeast() {
+    if (!stepsRunning(liftPulses, liftProfile)) return liftPosition;
+    int32_t done = liftProfile.stepsDone();
+    if (!liftUp) return liftStart - done;
+#if STEP_PULSE_RMT
+    done = done > LIFT_CHUNK_STEPS ? done - LIFT_CHUNK_STEPS : 0;   // A chunk is handed out before it is stepped
+#endif
+    return liftStart + done;
+}
+
+bool liftJobStart() {
+    static_assert(LIFT_TARGET_MM <= LIFT_TOP_MM, "The height sensor is the top limit");
+    int32_t target = liftHeightTable.steps(LIFT_TARGET_MM);  // Steps from rest
+    int32_t sensorAt = liftHeightTable.steps(LIFT_TOP_MM);
+    // Worst case over this travel, from the statics table (no solve here)
+    float limit = liftLoadTable.limit_kg(liftHeightTable.height_mm(liftPosition), LIFT_TARGET_MM);
+    if (basketLoad_kg > limit) {
+        snprintf(lcdBuffer, sizeof(lcdBuffer), "Load %.1f kg over\n%.1f kg limit!", basketLoad_kg, limit);
+        lcdScreen.print(lcdBuffer);
+        return false;
+    }
     // Lift Stepper Motor Setup
-    liftPul.setup(LIFT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    liftDir.setup(LIFT_DIR_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    liftEna.setup(LIFT_ENA_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    liftDir.set(0);                                     // Direction for lift motor
+    liftUp = target >= liftPosition;
+    liftDir.set(liftUp ? 0 : 1);                        // Direction for lift motor
     liftEna.set(1);                                     // Lift motor off
-    liftTimer.setup(liftCallback, "lift_timer");
     // Variables
-    int read;
     char msg[] = "Lifting mechanism...\nPlease wait...";
     liftEna.set(0); // Enable lift motor
-    liftTimer.startPeriodic(3500); // Constant stepping speed
-    lcdDisplay.printStr(msg);
-    while(true) {
-        read = heightSensor.get(); // Read height sensor
-        if (read ==0) { // Height sensor triggered
-            liftTimer.stopPeriodic(); // Stop generating steps
-            liftEna.set(1); // Disable lift motor
-            lcdDisplay.printStr("Desired height\nreached!");
-            return true;
+    liftStart = liftPosition;
+    heightTripAt = -1;
+    int32_t steps = liftUp ? target - liftPosition : liftPosition - target;
+    if (target >= sensorAt) steps += LIFT_SLIP_STEPS;   // At the top the sensor ends the move, not the count
+    liftProfile.begin(steps); // One move, ramps included
+    startSteps(liftPulses, liftLoad, liftCallback);
+    lcdScreen.print(msg);
+    return true;
+}
+
+JobStatus liftJobPoll() {
+    if (stepsRunning(liftPulses, liftProfile)) return JOB_RUNNING;  // Ramp down not finished yet
+    liftEna.set(1); // Disable lift motor
+    liftPosition = liftStart + (liftUp ? liftProfile.stepsDone() : -liftProfile.stepsDone());
+    printStepLoad("Lift", liftLoad);
+    // The sensor is the only absolute reference: it has to trip where the count says, and only there
+    int32_t target = liftHeightTable.steps(LIFT_TARGET_MM);
+    int32_t sensorAt = liftHeightTable.steps(LIFT_TOP_MM);
+    if (heightTripAt < 0) {
+        if (target >= sensorAt) {
+            lcdScreen.print("Height sensor\nnot seen!");
+            return JOB_FAILED;
         }
-        vTaskDelay(pdMS_TO_TICKS(200)); // Wait ms before next reading
     }
-    return true;
+    else {
+        int32_t error = heightTripAt - sensorAt;
+        liftPosition -= error;                          // Steps lost or gained, corrected at the sensor
+        if (target < sensorAt - LIFT_SLIP_STEPS || error < -LIFT_SLIP_STEPS || error > LIFT_SLIP_STEPS) {
+            snprintf(lcdBuffer, sizeof(lcdBuffer), "Height sensor at\n%.0f mm counted!",
+                     liftHeightTable.height_mm(heightTripAt));
+            lcdScreen.print(lcdBuffer);
+            return JOB_FAILED;
+        }
+    }
+    snprintf(lcdBuffer, sizeof(lcdBuffer), "Height %.0f mm\nreached!", liftHeightTable.height_mm(liftPosition));
+    lcdScreen.print(lcdBuffer);
+    return JOB_DONE;
+}
+
+void liftJobAbort() {
+    liftProfile.stop();                                 // Ramp down, the fault state takes over
 }
 
-bool tilting_motor() {
-    // LCD Setup
-    lcdDisplay.setup(lcd_pins);
+// The basket clears the frame: it may tilt while the lift is still rising
+bool tiltJobReady() {
+    return liftHeightTable.height_mm(liftStepsAtLeast()) >= TILT_CLEAR_MM;
+}
+
+bool tiltJobStart() {
     // Tilt stepper motor setup
-    tiltPul.setup(TILT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltDir.setup(TILT_DIR_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltEna.setup(TILT_ENA_GPIO, GPO);                  // GPIO pin, output mode, default pull
     tiltDir.set(0);                                     // Direction for tilt motor
     tiltEna.set(1);                                     // tilt motor off
-    // Timer setup
-    tiltTimer.setup(tiltCallback, "tilt_timer");
-    tiltStopTimer.setup(tiltStopCallback, "tilt_stop_timer");
     // Variables
     char msg[] = "Tilting basket...\nPlease wait...";
-    lcdDisplay.printStr(msg);
+    lcdScreen.print(msg);
     tiltEna.set(0); // Tilt motor ON
-    tiltTimer.startPeriodic(15000);                      // Generate steps every 2 seconds
-    tiltStopTimer.startOnce(4500000);                   // Stop after 3 seconds
-    vTaskDelay(pdMS_TO_TICKS(5500)); // Wait 5.5 seconds to ensure the movement completes
-    lcdDisplay.printStr("Tilting complete!");
+    tiltProfile.begin(TILT_STEPS); // Ramp up, cruise and ramp down over the tilt travel
+    startSteps(tiltPulses, tiltLoad, tiltCallback);
     return true;
 }
 
-bool servomotor() {
-    // Initialize
-    lcdDisplay.setup(lcd_pins);
-    servoMotor.setup(SERVOMOTOR_GPIO, 0);
-    servoMotor.setDuty(0);
+JobStatus tiltJobPoll() {
+    if (stepsRunning(tiltPulses, tiltProfile)) return JOB_RUNNING;  // Last step not out yet
+    tiltEna.set(1); // Tilt motor off
+    printStepLoad("Tilt", tiltLoad);
+    lcdScreen.print("Tilting complete!");
+    return JOB_DONE;
+}
+
+void tiltJobAbort() {
+    tiltProfile.stop();
+}
+
+// Tilt steps the motor has made; with RMT, stepsDone() also counts the chunk that is not stepped yet
+int32_t tiltStepsOut() {
+#if STEP_PULSE_RMT
+    return tiltPulses.stepsOut();
+#else
+    return tiltProfile.stepsDone();
+#endif
+}
+
+// The platform is still at the unloading height (the job runs after the lift) and the basket leans far enough to pour
+bool servoJobReady() {
+    return tiltStepsOut() >= TILT_POUR_STEPS;
+}
+
+int64_t servoOpenedAt = 0;
+bool servoJobStart() {
     // Actions
-    lcdDisplay.printStr("Opening basket...\nUnloading beans...");
+    lcdScreen.print("Opening basket...\nUnloading beans...");
     servoMotor.setDuty(10);
-    vTaskDelay(pdMS_TO_TICKS(1000));
-    servoMotor.setDuty(0);
-    lcdDisplay.printStr("Unloading\ncomplete!");
+    servoOpenedAt = esp_timer_get_time();
     return true;
 }
 
+JobStatus servoJobPoll() {
+    if (esp_timer_get_time() - servoOpenedAt < SERVO_OPEN_MS * 1000LL) return JOB_RUNNING;
+    servoMotor.setDuty(0);
+    lcdScreen.print("Unloading\ncomplete!");
+    return JOB_DONE;
+}
+
+void servoJobAbort() {
+    servoMotor.setDuty(0);
+}
+
+// Actuators each job drives, and the jobs in add() order
+enum actuators {actLift = 1 << 0, actTilt = 1 << 1, actServo = 1 << 2};
+enum unloadJobs {jobLift, jobTilt, jobServo, jobCount};
+const ActuatorJob unloadJobTable[jobCount] = {
+    {"lift", actLift, 0, nullptr, liftJobStart, liftJobPoll, liftJobAbort},
+    {"tilt", actTilt, 0, tiltJobReady, tiltJobStart, tiltJobPoll, tiltJobAbort},
+    {"servo", actServo, 1u << jobLift, servoJobReady, servoJobStart, servoJobPoll, servoJobAbort},
+};
+
+// Lift, tilt and unload, overlapped wherever the interlocks allow
+bool unloading() {
+    ActuatorScheduler jobs;
+    for (const ActuatorJob &job : unloadJobTable) {
+        if (jobs.add(job) == ActuatorScheduler::kNoJob) return false;
+    }
+    bool good = jobs.run(MOTION_POLL_MS, UNLOAD_TIMEOUT_MS);
+    jobs.print();
+    return good;
+}
+
+// STATE MACHINE
+// Transition actions
+void stepSucceeded() {
+    blinkLED(1, 1000);
+}
+
+void stepFailed() {
+    blinkLED(3);
+}
+
+// Timing hook: where the cycle time goes
+void logTransition(const TransitionTiming<states, events> &t) {
+    stateTimes.record(t.from, t.stateTime_us);
+    printf("State %d -> %d after %lld ms (action %lld ms)\n", t.from, t.to,
+           static_cast<long long>(t.stateTime_us / 1000), static_cast<long long>(t.actionTime_us / 1000));
+}
+
+// Work done in each state, indexed by state
+bool (*const stateWork[])() = {setup, load_beans, waiting_agv, move_mechanism, unloading};
+
+constexpr Transition<states, events> liftTransitions[] = {
+    {state0, success, state1, nullptr, stepSucceeded},      // Setup all components
+    {state0, failure, stateFault, nullptr, stepFailed},
+    {state1, success, state2, nullptr, stepSucceeded},      // Load beans
+    {state1, failure, stateFault, nullptr, stepFailed},
+    {state2, success, state3, nullptr, stepSucceeded},      // Wait for AGV to couple
+    {state2, failure, stateFault, nullptr, stepFailed},
+    {state3, success, state4, nullptr, stepSucceeded},      // Move to unloading station
+    {state3, failure, stateFault, nullptr, stepFailed},
+    {state4, success, stateDone, nullptr, stepSucceeded},   // Lift, tilt and unload
+    {state4, failure, stateFault, nullptr, stepFailed},
+};
+constexpr auto liftTable = makeTable<stateCount, eventCount>(liftTransitions);
+static_assert(sizeof(stateWork) / sizeof(stateWork[0]) == stateDone, "Every working state needs a work function");
+static_assert(nextState<liftTable, state4, success>() == stateDone, "Unloading ends the cycle");
+
 extern "C" void app_main() {
-    int next_state;
-    bool good;
-    states state = state0;
-    for (int i = 0; i < 7; i++) {
-        switch (state) {
-            case state0: // Setup all components
-                good = setup();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state1: //Move AGV without collision sensors
-                good = load_beans();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state2: //Move AGV without collision sensors
-                good = waiting_agv();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state3:
-                good = move_mechanism();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state4:
-                good = lifting_motor();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state5:
-                good = tilting_motor();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-            case state6:
-                good = servomotor();
-                if (good == true) {
-                    blinkLED(ledAct, 1, 1000);
-                    state = static_cast<states>(static_cast<int>(state) + 1);
-                    continue;
-                }
-                else {
-                    blinkLED(ledAct, 3);
-                    exit(0);
-                }
-                break;
-        }
+    StateMachine<liftTable> fsm(state0, logTransition);
+    while (fsm.state() < stateDone) {
+        bool good = stateWork[fsm.state()]();
+        fsm.dispatch(good ? success : failure);
     }
+    const LcdFlushStats &lcd = lcdScreen.stats();
+    printf("LCD: %lu posts, %lu flushes, %lu characters sent\n", static_cast<unsigned long>(lcd.posts),
+           static_cast<unsigned long>(lcd.flushes), static_cast<unsigned long>(lcd.characters));
+    ComLinkStats com = slComLink.stats();
+    printf("Com link: %lu frames, %lu CRC errors, %lu framing errors\n", static_cast<unsigned long>(com.frames),
+           static_cast<unsigned long>(com.crcErrors), static_cast<unsigned long>(com.framingErrors));
+    TimingProbe::dumpAll();
+    telemetry.flush();
+#if SENSOR_TRACE
+    sensorTrace.stop();
+    sensorTrace.flush();
+    uart_wait_tx_done(SENSOR_TRACE_UART, pdMS_TO_TICKS(100));
+#endif
+    if (fsm.in(stateFault)) exit(0);
 }
\ No newline at end of file
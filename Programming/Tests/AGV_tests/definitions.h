@@ -27,6 +27,7 @@
 #include <cmath>                    //Math functions
 #include <algorithm>                //Process data
 #include <stdio.h>                  //Get in the terminal answers
+#include <PinMap.h>                 //Pin map checked by the compiler
 
 //AGV GPIO pins
 //  DC motor
@@ -43,6 +44,23 @@
 // LEDs to indicate phases
 #define GREEN_LED_GPIO 2 // Check with teammate the number
 #define RED_LED_GPIO 4 // Check with teammate the number
+//  Console: the collision test prints its readings
+#define CONSOLE_TX_GPIO 1
+
+//Pin map: every pin above, the build stops on a pin used twice or beyond its pad (PinMap.h)
+constexpr PinSpec testPins[] = {
+    {DCMOTOR1_GPIO, PIN_PWM, "DC motor 1"},
+    {DCMOTOR2_GPIO, PIN_PWM, "DC motor 2"},
+    {LINE_FOLLOWER1_GPIO, PIN_INPUT, "Line follower 1"},
+    {LINE_FOLLOWER2_GPIO, PIN_INPUT, "Line follower 2"},
+    {COLL_AVOIDANCE1_TRIG_GPIO, PIN_OUTPUT, "Ultrasonic trigger"},
+    {COLL_AVOIDANCE1_ECHO_GPIO, PIN_INPUT, "Ultrasonic echo"},
+    {COMM_SENSOR_GPIO, PIN_INPUT, "Communication sensor"},
+    {GREEN_LED_GPIO, PIN_OUTPUT, "Green LED"},
+    {RED_LED_GPIO, PIN_OUTPUT, "Red LED"},
+    {CONSOLE_TX_GPIO, PIN_UART_TX, "Console"},
+};
+static_assert(kPinMapChecked<testPins>);
 
 // AGV OBJECTS
 //  DC Motor
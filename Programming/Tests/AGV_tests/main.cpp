@@ -116,7 +116,7 @@ float read_distance(SimpleGPIO &trig, SimpleGPIO &echo) {
 }
 
 void collisionAvoidanceLogic(float distance) {
-    const float m = 50/(MIN_DISTANCE - MAX_DISTANCE);
+    const float m = 50.0f/(MIN_DISTANCE - MAX_DISTANCE);
     const float b = -m * MAX_DISTANCE;
     int percentage = static_cast<int>(m * distance + b);
     percentage = std::clamp(percentage, 0, 100); // Ensure percentage is within 0-100
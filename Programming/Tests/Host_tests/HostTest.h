@@ -0,0 +1,41 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: HostTest.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Minimal check helpers shared by the host test programs. Each program
+ *   runs its *_test() routines from main() and returns the failure count.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+#include <cmath>
+#include <cstdio>
+
+inline int &hostTestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                 \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            hostTestFailures()++;                                                   \
+        }                                                                           \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol) CHECK(std::fabs((double)(a) - (double)(b)) <= (tol))
+
+#define RUN_TEST(fn)                                                                \
+    do {                                                                            \
+        int before = hostTestFailures();                                            \
+        fn();                                                                       \
+        printf("%s %s\n", hostTestFailures() == before ? "PASS" : "FAIL", #fn);     \
+    } while (0)
+
+#endif // _HOST_TEST_H_
@@ -0,0 +1,134 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: actuator_scheduler_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests ActuatorScheduler with timed jobs on the virtual clock:
+ *   - Jobs start as soon as their precondition holds, overlapping the
+ *     ones still running, and the cycle gets shorter than back to back
+ *   - Jobs sharing an actuator or waiting on another never overlap
+ *   - A failed or late job stops the run and aborts the running ones
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ActuatorScheduler.h>
+#include <HostSim.h>
+#include "HostTest.h"
+
+#include <esp_timer.h>
+
+class IdleWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Jobs"; }
+    bool missionComplete() const override { return true; }
+};
+
+// Fake motions: job I runs for length_us[I] from its start
+int64_t length_us[4], started_us[4];
+bool fails[4], aborted[4];
+
+int64_t elapsed(int job) {
+    return started_us[job] < 0 ? -1 : esp_timer_get_time() - started_us[job];
+}
+
+template <int I>
+bool fakeStart() {
+    started_us[I] = esp_timer_get_time();
+    return true;
+}
+
+template <int I>
+JobStatus fakePoll() {
+    if (elapsed(I) < length_us[I]) return JOB_RUNNING;
+    return fails[I] ? JOB_FAILED : JOB_DONE;
+}
+
+template <int I>
+void fakeAbort() {
+    aborted[I] = true;
+}
+
+bool halfOfFirst() { return elapsed(0) >= length_us[0] / 2; }
+bool mostOfSecond() { return elapsed(1) >= length_us[1] * 3 / 4; }
+
+void reset(int64_t a, int64_t b, int64_t c) {
+    const int64_t lengths[4] = {a, b, c, 0};
+    for (int i = 0; i < 4; i++) {
+        length_us[i] = lengths[i];
+        started_us[i] = -1;
+        fails[i] = aborted[i] = false;
+    }
+}
+
+bool overlaps(const ActuatorScheduler &jobs, int a, int b) {
+    return jobs.timing(a).start_us < jobs.timing(b).end_us && jobs.timing(b).start_us < jobs.timing(a).end_us;
+}
+
+void overlap_test() {
+    IdleWorld world;
+    hostsim::install(world);
+    reset(1000000, 800000, 1000000);
+    ActuatorScheduler jobs;
+    CHECK(jobs.add({"lift", 1, 0, nullptr, fakeStart<0>, fakePoll<0>, fakeAbort<0>}) == 0);
+    CHECK(jobs.add({"tilt", 2, 0, halfOfFirst, fakeStart<1>, fakePoll<1>, fakeAbort<1>}) == 1);
+    CHECK(jobs.add({"servo", 4, 1u << 0, mostOfSecond, fakeStart<2>, fakePoll<2>, fakeAbort<2>}) == 2);
+    CHECK(jobs.run(10, 10000));
+    for (int j = 0; j < 3; j++) CHECK(jobs.status(j) == JOB_DONE);
+    // Each start waits for its interlock, then at most one poll period
+    CHECK(jobs.timing(1).start_us - jobs.timing(0).start_us >= 500000);
+    CHECK(jobs.timing(1).start_us - jobs.timing(0).start_us <= 510000);
+    CHECK(jobs.timing(2).start_us >= jobs.timing(0).end_us);
+    CHECK(jobs.timing(2).start_us - jobs.timing(1).start_us >= 600000);
+    CHECK(overlaps(jobs, 0, 1) && overlaps(jobs, 1, 2));
+    CHECK(jobs.serial_us() >= 2800000);
+    CHECK(jobs.makespan_us() <= 2130000);               // Tilt hidden under the lift and the servo
+    CHECK(!aborted[0] && !aborted[1] && !aborted[2]);
+}
+
+void interlock_test() {
+    IdleWorld world;
+    hostsim::install(world);
+    reset(300000, 300000, 300000);
+    ActuatorScheduler jobs;
+    jobs.add({"a", 1, 0, nullptr, fakeStart<0>, fakePoll<0>, nullptr});
+    jobs.add({"b", 1, 0, nullptr, fakeStart<1>, fakePoll<1>, nullptr});           // Same actuator as a
+    jobs.add({"c", 2, 1u << 1, nullptr, fakeStart<2>, fakePoll<2>, nullptr});     // After b
+    CHECK(jobs.run(10, 10000));
+    CHECK(!overlaps(jobs, 0, 1) && !overlaps(jobs, 1, 2));
+    CHECK(jobs.makespan_us() >= 900000);
+    ActuatorScheduler bad;
+    CHECK(bad.add({"self", 1, 1u << 0, nullptr, fakeStart<0>, fakePoll<0>, nullptr}) == ActuatorScheduler::kNoJob);
+    CHECK(bad.add({"none", 1, 0, nullptr, nullptr, fakePoll<0>, nullptr}) == ActuatorScheduler::kNoJob);
+}
+
+void failure_test() {
+    IdleWorld world;
+    hostsim::install(world);
+    reset(1000000, 200000, 100000);
+    fails[1] = true;
+    ActuatorScheduler jobs;
+    jobs.add({"lift", 1, 0, nullptr, fakeStart<0>, fakePoll<0>, fakeAbort<0>});
+    jobs.add({"tilt", 2, 0, nullptr, fakeStart<1>, fakePoll<1>, fakeAbort<1>});
+    jobs.add({"servo", 4, 1u << 0, nullptr, fakeStart<2>, fakePoll<2>, fakeAbort<2>});
+    CHECK(!jobs.run(10, 10000));
+    CHECK(jobs.failedJob() == 1);
+    CHECK(aborted[0] && !aborted[1]);                   // The lift was still running
+    CHECK(jobs.status(2) == JOB_WAITING && started_us[2] < 0);
+
+    reset(1000000, 0, 0);
+    ActuatorScheduler late;
+    late.add({"lift", 1, 0, nullptr, fakeStart<0>, fakePoll<0>, fakeAbort<0>});
+    int64_t start = esp_timer_get_time();
+    CHECK(!late.run(10, 500));
+    CHECK(late.failedJob() == 0 && aborted[0]);
+    CHECK(esp_timer_get_time() - start < 520000);
+}
+
+int main() {
+    RUN_TEST(overlap_test);
+    RUN_TEST(interlock_test);
+    RUN_TEST(failure_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,309 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: com_link_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the communication link codec and decoder, and the transmitter
+ *   and receiver over a simulated wire:
+ *   - Every message type round trips, with every edge moved by just
+ *     under a quarter of a half-bit
+ *   - One edge moved by just under half a half-bit still decodes, half a
+ *     half-bit late it does not
+ *   - Every single and double bit error is rejected, and so are random
+ *     triple errors; the next frame still decodes
+ *   - A glitch inside a frame is a framing error, not a message
+ *   - Queued messages arrive in order, tens of milliseconds after send()
+ *   - waitFor() returns the first of several patterns (messages, levels
+ *     held for a time) to match, when it matches, or times out
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ComLink.h>
+#include <HostSim.h>
+#include "HostTest.h"
+
+#include <cstring>
+#include <vector>
+
+constexpr int64_t kHalf_us = kComBitPeriod_us / 2;
+
+struct Edge {
+    int64_t time_us;
+    int level;
+};
+
+struct Wire {
+    std::vector<Edge> edges;
+    int64_t end_us = 0;
+    uint32_t rng = 1;
+
+    int64_t jitter(int64_t max_us) {
+        if (max_us == 0) return 0;
+        rng = rng * 1664525u + 1013904223u;
+        return static_cast<int64_t>(rng >> 8) % (2 * max_us + 1) - max_us;
+    }
+
+    // Appends the frame after a gap, edges moved by up to jitter_us
+    void add(const uint8_t *frame, int bytes, int64_t jitter_us = 0) {
+        int64_t start = end_us + 2 * kComGapBits * kHalf_us;
+        int level = 0;
+        for (int h = 0; h < bytes * 16; h++) {
+            int next = comHalfLevel(frame, h);
+            if (next != level) edges.push_back({start + h * kHalf_us + jitter(jitter_us), next});
+            level = next;
+        }
+        end_us = start + bytes * 16 * kHalf_us;
+        if (level) edges.push_back({end_us + jitter(jitter_us), 0});
+    }
+
+    void add(const ComMessage &msg, int64_t jitter_us = 0) {
+        uint8_t frame[kComMaxFrameBytes];
+        add(frame, comEncode(msg, frame), jitter_us);
+    }
+
+    std::vector<ComMessage> decode(ComDecoder &decoder) const {
+        std::vector<ComMessage> out;
+        ComMessage msg;
+        for (const Edge &e : edges) {
+            if (decoder.edge(e.time_us, e.level, msg)) out.push_back(msg);
+        }
+        return out;
+    }
+};
+
+const ComMessage kMessages[] = {
+    {COM_COUPLED, 0, 0}, {COM_OBSTACLE, 27, 0}, {COM_ARRIVED, 0, 0},
+    {COM_ABORT, 0, 0}, {COM_WEIGHT, 12345, 0}, {COM_OBSTACLE, 0xFFFF, 0},
+};
+constexpr int kMessageCount = sizeof(kMessages) / sizeof(kMessages[0]);
+
+bool same(const ComMessage &a, const ComMessage &b) {
+    return a.type == b.type && a.value == b.value;
+}
+
+void codec_test() {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    CHECK(comCrc8(check, 9) == 0xF4);                   // CRC-8 (poly 0x07) check value
+    uint8_t frame[kComMaxFrameBytes];
+    CHECK(comEncode({COM_COUPLED, 0, 0}, frame) == 4);
+    CHECK(frame[0] == kComPreamble && frame[1] == kComStart && frame[2] == 0x10);
+    CHECK(comEncode({COM_WEIGHT, 0x1234, 0}, frame) == 6);
+    CHECK(frame[2] == 0x52 && frame[3] == 0x12 && frame[4] == 0x34);
+    CHECK(comEncode({COM_NONE, 0, 0}, frame) == 0);
+    // Manchester: 1 = low then high
+    CHECK(comHalfLevel(frame, 0) == 0 && comHalfLevel(frame, 1) == 1);    // Preamble MSB is 1
+    CHECK(comHalfLevel(frame, 2) == 1 && comHalfLevel(frame, 3) == 0);
+}
+
+void round_trip_test() {
+    for (int64_t jitter : {int64_t(0), kHalf_us * 20 / 100, kHalf_us / 4 - 1}) {
+        Wire wire;
+        for (int i = 0; i < 50; i++) wire.add(kMessages[i % kMessageCount], jitter);
+        ComDecoder decoder;
+        std::vector<ComMessage> got = wire.decode(decoder);
+        CHECK(got.size() == 50);
+        bool allSame = true;
+        for (size_t i = 0; i < got.size(); i++) allSame &= same(got[i], kMessages[i % kMessageCount]);
+        CHECK(allSame);
+        CHECK(decoder.stats().frames == 50 && decoder.stats().crcErrors == 0 && decoder.stats().framingErrors == 0);
+    }
+    // Frame time at the default bit period: tens of milliseconds
+    Wire wire;
+    wire.add({COM_COUPLED, 0, 0});
+    CHECK(wire.end_us - 2 * kComGapBits * kHalf_us == 32000);
+}
+
+// Decodes a frame with body edge 'index' moved by shift_us; true if it came out whole
+bool decodedWithEdgeMoved(const ComMessage &msg, size_t index, int64_t shift_us) {
+    Wire wire;
+    wire.add(msg);
+    wire.edges[index].time_us += shift_us;
+    ComDecoder decoder;
+    std::vector<ComMessage> got = wire.decode(decoder);
+    return got.size() == 1 && same(got[0], msg) && decoder.stats().framingErrors + decoder.stats().crcErrors == 0;
+}
+
+void tolerance_test() {
+    int inside = 0, outside = 0, edges = 0;
+    for (const ComMessage &msg : kMessages) {
+        Wire wire;
+        wire.add(msg);
+        int64_t body_us = 2 * kComGapBits * kHalf_us + 32 * kHalf_us;   // Past the preamble and start byte
+        for (size_t i = 0; i + 1 < wire.edges.size(); i++) {
+            if (wire.edges[i].time_us < body_us) continue;
+            edges++;
+            if (decodedWithEdgeMoved(msg, i, -(kHalf_us / 2 - 1))) inside++;
+            if (decodedWithEdgeMoved(msg, i, kHalf_us / 2 - 1)) inside++;
+            // Late, so the interval before it rounds up; early only breaks the one after it
+            if (!decodedWithEdgeMoved(msg, i, kHalf_us / 2)) outside++;
+        }
+    }
+    CHECK(edges > 0);
+    CHECK(inside == 2 * edges);         // 249 us off at 1 ms bits
+    CHECK(outside == edges);            // 250 us late
+}
+
+// Decodes a corrupted frame followed by a clean one; true if only the clean one came out
+bool rejected(const ComMessage &msg, const std::vector<int> &flips, ComDecoder &decoder) {
+    uint8_t frame[kComMaxFrameBytes];
+    int bytes = comEncode(msg, frame);
+    for (int b : flips) frame[2 + b / 8] ^= 0x80 >> (b % 8);     // Header, payload and CRC bits
+    Wire wire;
+    wire.add(frame, bytes);
+    wire.add({COM_ARRIVED, 0, 0});
+    std::vector<ComMessage> got = wire.decode(decoder);
+    return got.size() == 1 && same(got[0], {COM_ARRIVED, 0, 0});
+}
+
+void bit_error_test() {
+    int frames = 0, escaped = 0;
+    ComDecoder decoder;
+    for (const ComMessage &msg : kMessages) {
+        int bits = (comPayloadLength(msg.type) + 2) * 8;
+        for (int a = 0; a < bits; a++) {
+            frames++;
+            if (!rejected(msg, {a}, decoder)) escaped++;
+            for (int b = a + 1; b < bits; b++) {
+                frames++;
+                if (!rejected(msg, {a, b}, decoder)) escaped++;
+            }
+        }
+    }
+    uint32_t rng = 7;
+    for (int i = 0; i < 3000; i++) {
+        const ComMessage &msg = kMessages[i % kMessageCount];
+        int bits = (comPayloadLength(msg.type) + 2) * 8;
+        std::vector<int> flips;
+        while (flips.size() < 3) {
+            rng = rng * 1664525u + 1013904223u;
+            int b = static_cast<int>((rng >> 8) % bits);
+            bool repeated = false;
+            for (int f : flips) repeated |= f == b;
+            if (!repeated) flips.push_back(b);
+        }
+        frames++;
+        if (!rejected(msg, flips, decoder)) escaped++;
+    }
+    CHECK(escaped == 0);
+    const ComLinkStats &stats = decoder.stats();
+    CHECK(stats.frames == static_cast<uint32_t>(frames));           // Only the clean frames
+    CHECK(stats.crcErrors + stats.framingErrors == static_cast<uint32_t>(frames));
+    CHECK(stats.crcErrors > 0 && stats.framingErrors > 0);
+}
+
+void glitch_test() {
+    Wire wire;
+    wire.add({COM_WEIGHT, 500, 0});
+    // 40 us spike a quarter bit after an edge in the middle of the frame
+    size_t i = wire.edges.size() / 2;
+    Edge e = wire.edges[i];
+    wire.edges.insert(wire.edges.begin() + i + 1, {{e.time_us + kHalf_us / 2, !e.level}, {e.time_us + kHalf_us / 2 + 40, e.level}});
+    wire.add({COM_ABORT, 0, 0});
+    ComDecoder decoder;
+    std::vector<ComMessage> got = wire.decode(decoder);
+    CHECK(got.size() == 1 && got[0].type == COM_ABORT);
+    CHECK(decoder.stats().framingErrors == 1);
+}
+
+// AGV output wired to the lift input
+class WireWorld : public hostsim::World {
+public:
+    static constexpr int kTxPin = 16;
+    static constexpr int kRxPin = 35;
+    const char *name() const override { return "Com wire"; }
+    bool missionComplete() const override { return true; }
+    void pinWritten(int pin, int value) override {
+        if (pin == kTxPin) drive(kRxPin, value);
+    }
+};
+
+void transmit_receive_test() {
+    WireWorld world;
+    hostsim::install(world);
+    SimpleGPIO txPin;
+    txPin.setup(WireWorld::kTxPin, GPO);
+    ComTransmitter tx;
+    ComReceiver rx;
+    CHECK(tx.setup(txPin));
+    CHECK(rx.setup(WireWorld::kRxPin));
+    ComMessage msg;
+    CHECK(!rx.waitMessage(msg, 20));                   // Nothing sent yet
+    int64_t sentAt = hostsim::clock().now();
+    for (int i = 0; i < 4; i++) CHECK(tx.send(kMessages[i + 1]));
+    CHECK(tx.busy());
+    CHECK(rx.waitMessage(msg, 100));
+    CHECK(same(msg, kMessages[1]));
+    int64_t latency = msg.time_us - sentAt;
+    CHECK(latency >= 48000 && latency <= 48000 + kHalf_us + 1000);      // Six bytes plus the first timer tick
+    for (int i = 1; i < 4; i++) {
+        CHECK(rx.waitMessage(msg, 100));
+        CHECK(same(msg, kMessages[i + 1]));
+    }
+    hostsim::clock().advance(10000);
+    CHECK(!tx.busy() && tx.sent() == 4);
+    CHECK(world.level[WireWorld::kTxPin] == 0);         // Idle low
+    // Queue full: kQueueLength frames wait, the rest are refused
+    int accepted = 0;
+    for (int i = 0; i < 20; i++) accepted += tx.send({COM_COUPLED, 0, 0}) ? 1 : 0;
+    CHECK(accepted == static_cast<int>(ComTransmitter::kQueueLength) + 1);     // One is already on the wire
+    CHECK(!tx.send({COM_NONE, 0, 0}));
+    hostsim::clock().advance(accepted * 40000);
+    ComLinkStats stats = rx.stats();
+    CHECK(stats.frames == static_cast<uint32_t>(4 + accepted));
+    CHECK(stats.crcErrors == 0 && stats.framingErrors == 0);
+    CHECK(stats.dropped == 0);
+    CHECK(!tx.busy());
+}
+
+void wait_for_test() {
+    WireWorld world;
+    hostsim::install(world);
+    SimpleGPIO txPin;
+    txPin.setup(WireWorld::kTxPin, GPO);
+    ComTransmitter tx;
+    ComReceiver rx;
+    CHECK(tx.setup(txPin));
+    CHECK(rx.setup(WireWorld::kRxPin));
+    const ComPattern patterns[] = {comExpect(COM_ARRIVED), comHeld(1, 20), comHeld(0, 300)};
+    ComMessage msg;
+    // A message nobody waits for is skipped, the expected one returns as soon as it is decoded
+    hostsim::clock().at(10000, [&tx]() {
+        tx.send({COM_COUPLED, 0, 0});
+        tx.send({COM_ARRIVED, 0, 0});
+    });
+    CHECK(rx.waitFor(patterns, 3, 1000, msg) == 0);
+    CHECK(msg.type == COM_ARRIVED);
+    int64_t frameEnd = 10000 + kHalf_us + 32000 + 2 * kComGapBits * kHalf_us + 32000;
+    CHECK(msg.time_us >= frameEnd - kHalf_us && msg.time_us <= frameEnd);
+    CHECK(hostsim::clock().now() - msg.time_us <= 1000);                    // Woken by the ISR, not a poll
+    // A 10 ms high pulse is too short, a 25 ms one matches when it has lasted 20 ms
+    int64_t t0 = hostsim::clock().now();
+    hostsim::clock().at(t0 + 50000, [&world]() { world.drive(WireWorld::kRxPin, 1); });
+    hostsim::clock().at(t0 + 60000, [&world]() { world.drive(WireWorld::kRxPin, 0); });
+    hostsim::clock().at(t0 + 100000, [&world]() { world.drive(WireWorld::kRxPin, 1); });
+    hostsim::clock().at(t0 + 125000, [&world]() { world.drive(WireWorld::kRxPin, 0); });
+    CHECK(rx.waitFor(patterns, 3, 1000, msg) == 1);
+    CHECK(hostsim::clock().now() >= t0 + 120000 && hostsim::clock().now() <= t0 + 121000);
+    // Silence counts from the call, not from the last edge
+    hostsim::clock().advance(200000);                  // Already low for 200 ms
+    t0 = hostsim::clock().now();
+    CHECK(rx.waitFor(patterns, 3, 1000, msg) == 2);
+    CHECK(hostsim::clock().now() >= t0 + 300000 && hostsim::clock().now() <= t0 + 301000);
+    // Deadline
+    t0 = hostsim::clock().now();
+    CHECK(rx.waitFor(patterns, 1, 250, msg) == kComTimeout);
+    CHECK(hostsim::clock().now() >= t0 + 250000 && hostsim::clock().now() <= t0 + 251000);
+}
+
+int main() {
+    RUN_TEST(codec_test);
+    RUN_TEST(round_trip_test);
+    RUN_TEST(tolerance_test);
+    RUN_TEST(bit_error_test);
+    RUN_TEST(glitch_test);
+    RUN_TEST(transmit_receive_test);
+    RUN_TEST(wait_for_test);
+    return hostTestFailures();
+}
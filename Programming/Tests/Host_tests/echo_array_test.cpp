@@ -0,0 +1,171 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: echo_array_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests EchoArray against simulated HC-SR04 sensors whose bursts reach
+ *   their neighbours: a sensor still listening when a neighbour's burst
+ *   arrives ends its echo early and reads a wrong distance.
+ *   - Staggered groups: every sensor reads its own distance, no burst is
+ *     ever heard by a listening neighbour
+ *   - The same sensors in one group: the model produces the crosstalk
+ *   - Slot length from the listening range and the per-sensor repeat
+ *     limit, "nothing found" pulses spanning other groups' slots (cut
+ *     short at worst past the listening range), and invalid pin lists
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <EchoArray.h>
+#include <HostSim.h>
+#include "HostTest.h"
+
+constexpr int kSensors = 4;
+constexpr int kTrigPins[kSensors] = {13, 14, 17, 21};
+constexpr int kEchoPins[kSensors] = {34, 35, 18, 39};
+constexpr int64_t kBurstDelay_us = 450;         // Trigger to burst and echo rising edge
+constexpr double kEchoPerCm_us = 58.3;          // Round trip at 343 m/s
+constexpr int64_t kNoEcho_us = 38000;
+
+enum { FRONT, LEFT, RIGHT, REAR };
+
+class CrosstalkWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Echo array"; }
+    bool missionComplete() const override { return true; }
+
+    void pinWritten(int pin, int value) override {
+        for (int i = 0; i < kSensors; i++) {
+            if (pin != kTrigPins[i]) continue;
+            if (lastTrig[i] == 1 && value == 0) ping(i);
+            lastTrig[i] = value;
+        }
+    }
+
+    void ping(int i) {
+        pings[i]++;
+        int64_t burst = hostsim::clock().now() + kBurstDelay_us;
+        int64_t width = distance_cm[i] > 0 ? static_cast<int64_t>(distance_cm[i] * kEchoPerCm_us) : kNoEcho_us;
+        hostsim::clock().at(burst, [this, i]() { drive(kEchoPins[i], 1); });
+        endEcho(i, burst + width);
+        // The burst also travels to every neighbour, the long way round an obstacle
+        for (int j = 0; j < kSensors; j++) {
+            if ((hears[j] >> i & 1) == 0) continue;
+            int64_t arrival = burst + static_cast<int64_t>(crossPath_cm * kEchoPerCm_us);
+            hostsim::clock().at(arrival, [this, j, arrival]() {
+                if (level[kEchoPins[j]] == 1 && arrival < echoEnd[j]) {
+                    crosstalk++;
+                    endEcho(j, arrival);
+                }
+            });
+        }
+    }
+
+    // (Re)schedules the falling edge; an older one still queued is ignored
+    void endEcho(int i, int64_t at) {
+        echoEnd[i] = at;
+        uint32_t mine = ++generation[i];
+        hostsim::clock().at(at, [this, i, mine]() {
+            if (generation[i] == mine) drive(kEchoPins[i], 0);
+        });
+    }
+
+    double distance_cm[kSensors] = {80, 150, 60, 200};
+    uint32_t hears[kSensors] = {1u << LEFT | 1u << RIGHT, 1u << FRONT | 1u << REAR, 1u << FRONT | 1u << REAR,
+                                1u << LEFT | 1u << RIGHT};
+    double crossPath_cm = 120;
+    int lastTrig[kSensors] = {};
+    int pings[kSensors] = {};
+    int64_t echoEnd[kSensors] = {};
+    uint32_t generation[kSensors] = {};
+    int crosstalk = 0;
+};
+
+void pinList(EchoSensorPins *pins, const uint8_t *groups) {
+    for (int i = 0; i < kSensors; i++) pins[i] = {kTrigPins[i], kEchoPins[i], groups[i]};
+}
+
+void staggered_test() {
+    CrosstalkWorld world;
+    hostsim::install(world);
+    const uint8_t groups[kSensors] = {0, 1, 1, 0};      // Front with rear, left with right
+    EchoSensorPins pins[kSensors];
+    pinList(pins, groups);
+    EchoArray array;
+    CHECK(array.setup(pins, kSensors));
+    CHECK(array.groups() == 2);
+    CHECK(array.slot_us() == EchoArray::kEchoDelay_us + 23323 + EchoArray::kGuard_us);  // 4 m and back
+    array.start();
+    hostsim::clock().advance(1000000);
+    array.stop();
+    CHECK(world.crosstalk == 0);
+    EchoSample table[kSensors];
+    array.table(table);
+    for (int i = 0; i < kSensors; i++) {
+        CHECK(table[i].status == ECHO_OK);
+        CHECK_NEAR(table[i].distance_cm, world.distance_cm[i], 0.5);
+        CHECK(world.pings[i] >= 19 && world.pings[i] <= 20);   // Once per 51.6 ms cycle
+    }
+    CHECK_NEAR(array.nearest_cm(), 60, 0.5);
+    CHECK(array.timeouts() == 0);
+    // Four samples per cycle instead of one sensor every 60 ms
+    int total = 0;
+    for (int i = 0; i < kSensors; i++) total += world.pings[i];
+    CHECK(total >= 76);
+}
+
+void overlap_test() {
+    CrosstalkWorld world;
+    hostsim::install(world);
+    const uint8_t groups[kSensors] = {0, 0, 0, 0};      // Everybody at once
+    EchoSensorPins pins[kSensors];
+    pinList(pins, groups);
+    EchoArray array;
+    CHECK(array.setup(pins, kSensors));
+    array.start();
+    hostsim::clock().advance(500000);
+    array.stop();
+    CHECK(world.crosstalk > 0);
+    CHECK_NEAR(array.latest(LEFT).distance_cm, world.crossPath_cm, 0.5);   // Heard the front burst
+    CHECK_NEAR(array.latest(REAR).distance_cm, world.crossPath_cm, 0.5);
+    CHECK_NEAR(array.latest(FRONT).distance_cm, 80, 0.5);                  // Own echo came first
+}
+
+void slot_test() {
+    CrosstalkWorld world;
+    hostsim::install(world);
+    EchoSensorPins pins[kSensors];
+    EchoArray one;
+    const uint8_t together[kSensors] = {0, 0, 0, 0};
+    pinList(pins, together);
+    CHECK(one.setup(pins, 2));
+    CHECK(one.slot_us() == EchoArray::kMinRepeat_us);   // A lone group waits for its own pulses
+    // A small room: short slots, the repeat limit spread over three groups
+    const uint8_t three[kSensors] = {0, 1, 2, 0};
+    pinList(pins, three);
+    EchoArray room;
+    CHECK(room.setup(pins, kSensors, 343.0f, 150));
+    CHECK(room.slot_us() == (EchoArray::kMinRepeat_us + 2) / 3);
+    world.distance_cm[LEFT] = 0;                        // Nothing there: 38 ms pulse over two other slots
+    room.start();
+    hostsim::clock().advance(1000000);
+    room.stop();
+    CHECK(room.latest(LEFT).distance_cm > 150);        // Cut short by the next front burst, still past the room
+    CHECK(room.timeouts() == 0);
+    CHECK(room.slots() == 1000000 / room.slot_us());
+    for (int i : {FRONT, RIGHT, REAR}) CHECK_NEAR(room.latest(i).distance_cm, world.distance_cm[i], 0.5);
+    // Invalid pin lists
+    EchoArray bad;
+    const uint8_t gap[kSensors] = {0, 2, 2, 0};         // No group 1
+    pinList(pins, gap);
+    CHECK(!bad.setup(pins, kSensors));
+    CHECK(!bad.setup(pins, 0));
+}
+
+int main() {
+    RUN_TEST(staggered_test);
+    RUN_TEST(overlap_test);
+    RUN_TEST(slot_test);
+    return hostTestFailures();
+}
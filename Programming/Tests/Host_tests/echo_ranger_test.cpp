@@ -0,0 +1,139 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: echo_ranger_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests EchoRanger against a simulated HC-SR04 echo pin:
+ *   - In-range distance and trigger latency
+ *   - Nothing in range (38 ms pulse)
+ *   - Lost echo and echo stuck high (timeouts) and recovery
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <EchoRanger.h>
+#include "HostTest.h"
+
+constexpr int kTrigPin = 17;
+constexpr int kEchoPin = 18;
+
+// Simulated HC-SR04
+enum EchoMode {NORMAL, NO_ECHO, STUCK_HIGH};
+
+class EchoWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Echo"; }
+    bool missionComplete() const override { return true; }
+
+    void pinWritten(int pin, int value) override {
+        if (pin != kTrigPin) return;
+        if (lastTrig == 1 && value == 0) {
+            pings++;
+            if (mode == NO_ECHO) return;
+            int64_t width = distance_cm > 0 ? static_cast<int64_t>(distance_cm * 58.3) : 38000;
+            hostsim::clock().after(450, [this]() { drive(kEchoPin, 1); });
+            if (mode == NORMAL) hostsim::clock().after(450 + width, [this]() { drive(kEchoPin, 0); });
+        }
+        lastTrig = value;
+    }
+
+    EchoMode mode = NORMAL;
+    double distance_cm = 100;   // <= 0: nothing in range
+    int lastTrig = 0;
+    int pings = 0;
+};
+
+SimpleGPIO trig;
+
+void setupRanger(EchoWorld &world, EchoRanger &ranger) {
+    hostsim::install(world);
+    trig.setup(kTrigPin, GPIO);
+    CHECK(ranger.setup(trig, kEchoPin));
+}
+
+void in_range_test() {
+    EchoWorld world;
+    EchoRanger ranger;
+    setupRanger(world, ranger);
+    CHECK(ranger.latest().status == ECHO_PENDING);
+    int64_t before = hostsim::clock().now();
+    ranger.trigger();
+    CHECK(hostsim::clock().now() - before <= 12);   // Only the 10 us trigger pulse
+    hostsim::clock().advance(20000);
+    EchoSample sample = ranger.latest();
+    CHECK(sample.status == ECHO_OK);
+    CHECK_NEAR(sample.distance_cm, 100.0, 0.5);
+    ranger.stop();
+}
+
+void periodic_test() {
+    EchoWorld world;
+    EchoRanger ranger;
+    setupRanger(world, ranger);
+    ranger.start();
+    hostsim::clock().advance(610000);               // 10 pings of 60 ms plus the last echo
+    EchoSample sample = ranger.latest();
+    CHECK(world.pings == 10);
+    CHECK(sample.seq == 10);
+    world.distance_cm = 25;
+    hostsim::clock().advance(70000);                // Next ping plus its echo
+    CHECK_NEAR(ranger.latest().distance_cm, 25.0, 0.5);
+    CHECK(ranger.timeouts() == 0);
+    ranger.stop();
+}
+
+void out_of_range_test() {
+    EchoWorld world;
+    EchoRanger ranger;
+    setupRanger(world, ranger);
+    world.distance_cm = 0;
+    ranger.trigger();
+    hostsim::clock().advance(60000);
+    EchoSample sample = ranger.latest();
+    CHECK(sample.status == ECHO_OUT_OF_RANGE);
+    CHECK(sample.distance_cm > EchoRanger::kMaxRange_cm);
+    ranger.stop();
+}
+
+void lost_echo_test() {
+    EchoWorld world;
+    EchoRanger ranger;
+    setupRanger(world, ranger);
+    world.mode = NO_ECHO;
+    ranger.trigger();
+    hostsim::clock().advance(EchoRanger::kDefaultTimeout_us - 100);
+    CHECK(ranger.latest().status == ECHO_PENDING);  // Still waiting, not hung
+    hostsim::clock().advance(200);
+    CHECK(ranger.latest().status == ECHO_TIMEOUT);
+    CHECK(ranger.timeouts() == 1);
+    // Sensor comes back
+    world.mode = NORMAL;
+    ranger.trigger();
+    hostsim::clock().advance(20000);
+    CHECK(ranger.latest().status == ECHO_OK);
+    ranger.stop();
+}
+
+void stuck_high_test() {
+    EchoWorld world;
+    EchoRanger ranger;
+    setupRanger(world, ranger);
+    world.mode = STUCK_HIGH;
+    ranger.start();
+    hostsim::clock().advance(250000);               // Pings at 60..240 ms, timeouts at 100, 160, 220 ms
+    EchoSample sample = ranger.latest();
+    CHECK(sample.status == ECHO_TIMEOUT);
+    CHECK(ranger.timeouts() == 3);
+    ranger.stop();
+}
+
+int main() {
+    RUN_TEST(in_range_test);
+    RUN_TEST(periodic_test);
+    RUN_TEST(out_of_range_test);
+    RUN_TEST(lost_echo_test);
+    RUN_TEST(stuck_high_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,114 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: fixed_point_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the Q-format math and the integer conversions built on it:
+ *   - Rounding of products, quotients and format changes, and constant
+ *     folding (the checks in static_assert run in the compiler)
+ *   - Echo width to cm, uV to kg and distance to duty against the float
+ *     code they replace, over the whole input range
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <EchoRanger.h>
+#include <FixedPoint.h>
+#include <HostSim.h>
+#include <LoadCellCalibration.h>
+#include <SpeedGovernor.h>
+#include "HostTest.h"
+
+#include <algorithm>
+#include <cmath>
+
+static_assert(Q16::fromInt(3) * Q16::fromFloat(0.5f) == Q16::fromFloat(1.5f), "Folded by the compiler");
+static_assert(FixedLine<16, 30>::fromFloat(0.01715, 0).at(5831).round() == 100, "100 cm echo");
+static_assert(FixedLine<20, 40>::fromFloat(0.5, 0).at(1000).round() == 500, "Slope past 31 bits of raw value");
+
+class IdleWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Fixed point"; }
+    bool missionComplete() const override { return true; }
+};
+
+void format_test() {
+    CHECK(Q16::fromFloat(1.25f).raw() == 81920);
+    CHECK(Q16::fromFloat(-1.25f).toInt() == -2);                   // Rounded down
+    CHECK(Q16::fromFloat(-1.5f).round() == -2 && Q16::fromFloat(1.5f).round() == 2);
+    CHECK(Q16::fromFloat(2.5f).round() == 3 && Q16::fromFloat(2.49f).round() == 2);
+    CHECK_NEAR((Q16::fromFloat(-3.7f) * Q16::fromFloat(2.2f)).toFloat(), -8.14, 1e-4);
+    CHECK_NEAR((Q16::fromFloat(10.0f) / Q16::fromFloat(3.0f)).toFloat(), 3.33333, 2e-5);
+    CHECK_NEAR((Q16::fromFloat(-10.0f) / Q16::fromFloat(3.0f)).toFloat(), -3.33333, 2e-5);
+    CHECK(Q16::fromRaw(1) * Q16::fromRaw(1) == Q16());                                  // Below one LSB
+    CHECK(Q16::fromFloat(0.75f).scale(-4) == Q16::fromInt(-3));
+    CHECK(Q20::from(Q16::fromFloat(1.5f)) == Q20::fromFloat(1.5f));
+    CHECK(Q16::from(Q20::fromRaw(24)) == Q16::fromRaw(2));          // 1.5 LSB rounds up
+    CHECK(Q16::from(Q20::fromRaw(-24)) == Q16::fromRaw(-2));
+    Q16 sum;
+    for (int i = 0; i < 10; i++) sum += Q16::fromFloat(0.1f);
+    CHECK_NEAR(sum.toFloat(), 1.0, 1e-4);
+}
+
+void echo_test() {
+    // The ranger's integer conversion against width * cm/us in float, at three air temperatures
+    IdleWorld world;
+    hostsim::install(world);
+    SimpleGPIO trig;
+    trig.setup(17, GPO);
+    for (float celsius : {0.0f, 20.0f, 40.0f}) {
+        EchoRanger ranger;
+        float speed = EchoRanger::soundSpeed_m_s(celsius);
+        CHECK(ranger.setup(trig, 18, speed));
+        float cmPerUs = speed * 100.0f * 1e-6f / 2.0f;
+        double worst = 0;
+        for (int64_t width = 0; width <= 40000; width += 7) {
+            worst = std::max(worst, std::fabs(ranger.widthToCm(width) - width * static_cast<double>(cmPerUs)));
+        }
+        CHECK(worst < 0.001);                                       // 10 um up to the 40 ms timeout
+    }
+}
+
+void load_cell_test() {
+    LoadCalibration calibration;
+    CHECK(twoPointCalibration(16.0f, 416.0f, 10.0f, calibration));  // 25 g per mV, tare at 16 mV
+    FixedLine<20, 40> line = calibration.fixedKg();
+    CHECK_NEAR(line.slope(), calibration.slope / 1000, 1e-10);
+    double worst = 0;
+    for (int32_t uv = -50000; uv <= 2000000; uv += 37) {
+        double exact = calibration.slope * (uv / 1000.0) + calibration.offset;
+        worst = std::max(worst, std::fabs(line.at(uv).toFloat() - exact));
+    }
+    CHECK(worst < 0.0005);                                          // Half a gram up to 2 V
+    CHECK_NEAR(line.at(416000).toFloat(), 10.0, 0.0005);
+    CHECK_NEAR(line.at(16000).toFloat(), 0.0, 0.0005);
+}
+
+void duty_test() {
+    SpeedGovernor governor;
+    governor.setup();                                               // The AGV limits
+    FixedRamp<16> ramp = governor.standingRamp();
+    double worst = 0;
+    for (int mm = 0; mm <= 5000; mm++) {
+        float cm = mm / 10.0f;
+        double fixed = ramp.at(Q16::fromFloat(cm)).toFloat();
+        worst = std::max(worst, std::fabs(fixed - governor.standingDuty(cm)));
+    }
+    CHECK(worst < 0.001);
+    CHECK(ramp.at(Q16::fromInt(10)) == Q16() && ramp.at(Q16::fromInt(5)) == Q16());
+    CHECK(ramp.at(Q16::fromInt(400)) == Q16::fromInt(80));
+    // Gentle brakes: the braking bound is lower than the time margin line below maxDuty
+    GovernorLimits soft;
+    soft.decel_cm_s2 = 10;
+    governor.setup(soft);
+    CHECK(governor.standingRamp().at(Q16::fromInt(40)).toFloat() > governor.standingDuty(40) + 1);
+}
+
+int main() {
+    RUN_TEST(format_test);
+    RUN_TEST(echo_test);
+    RUN_TEST(load_cell_test);
+    RUN_TEST(duty_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,97 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: fleet_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the work-stealing pool and the fleet model (Host_Sim):
+ *   - parallelFor runs every index once, with uneven chunks stolen
+ *   - A fleet gives the same result on one thread and on several
+ *   - One AGV spends most of its time driving, more AGVs deliver more
+ *     until the lift is busy all the time and the dock queue grows
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <Fleet.h>
+#include <WorkPool.h>
+#include "HostTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+void pool_test() {
+    WorkPool pool(4);
+    CHECK(pool.threads() == 4);
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto &h : hits) h = 0;
+    for (int round = 0; round < 50; round++) {
+        pool.parallelFor(hits.size(), 7, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) hits[i]++;
+        });
+    }
+    bool once = true;
+    for (auto &h : hits) once = once && h == 50;
+    CHECK(once);
+    CHECK(pool.chunks() == 50 * ((1000 + 6) / 7));
+    // Thread 0's chunks are slow: the others finish theirs and take some of it
+    pool.parallelFor(64, 1, [&](size_t begin, size_t) {
+        if (begin < 16) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    CHECK(pool.steals() > 0);
+    WorkPool single(1);
+    size_t covered = 0;
+    single.parallelFor(10, 3, [&](size_t begin, size_t end) { covered += end - begin; });
+    CHECK(covered == 10);
+}
+
+void determinism_test() {
+    FleetConfig config;
+    config.agvs = 9;
+    config.lifts = 2;
+    config.hours = 0.25;
+    config.seed = 7;
+    config.threads = 1;
+    FleetReport serial = runFleet(config);
+    config.threads = 4;
+    FleetReport parallel = runFleet(config);
+    CHECK(serial.deliveries > 0);
+    CHECK(serial.deliveries == parallel.deliveries);
+    CHECK(serial.delivered_kg == parallel.delivered_kg);
+    CHECK(serial.queued == parallel.queued && serial.queueMax_s == parallel.queueMax_s);
+    for (int p = 0; p < agvPhaseCount; p++) CHECK(serial.agvShare[p] == parallel.agvShare[p]);
+    for (int p = 0; p < liftPhaseCount; p++) CHECK(serial.liftShare[p] == parallel.liftShare[p]);
+}
+
+void throughput_test() {
+    FleetConfig config;
+    config.lifts = 1;
+    config.hours = 0.5;
+    config.agvs = 1;
+    FleetReport one = runFleet(config);
+    double cycle_s = 1800.0 / one.deliveries;
+    CHECK(cycle_s > 45 && cycle_s < 80);                                // Two legs, station and dock
+    CHECK(one.agvShare[agvToLift] + one.agvShare[agvToStation] > 0.6);
+    CHECK(one.queueMax_s < 1.0);                                        // The basket is full before it is back
+    double kgPerLoad = one.delivered_kg / one.deliveries;
+    CHECK(kgPerLoad > 8.0 && kgPerLoad < 12.0);
+    config.agvs = 3;
+    FleetReport three = runFleet(config);
+    CHECK(three.deliveries > 2.5 * one.deliveries);
+    config.agvs = 12;
+    FleetReport many = runFleet(config);
+    CHECK(many.liftShare[liftWaiting] < 0.05);                          // Lift is the bottleneck
+    CHECK(many.queueMean_s > 10 * three.queueMean_s);
+    double sum = 0;
+    for (int p = 0; p < agvPhaseCount; p++) sum += many.agvShare[p];
+    CHECK_NEAR(sum, 1.0, 0.01);
+}
+
+int main() {
+    RUN_TEST(pool_test);
+    RUN_TEST(determinism_test);
+    RUN_TEST(throughput_test);
+    return hostTestFailures();
+}
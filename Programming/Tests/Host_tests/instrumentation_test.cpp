@@ -0,0 +1,185 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: instrumentation_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the timing probes (built twice, see CMakeLists.txt):
+ *   - TimingStats: min, max, mean and the histogram percentiles
+ *   - CycleScope measures a block, PeriodProbe sees a stalled loop,
+ *     LatencyProbe sees a callback armed for the wrong time
+ *   - StateTimer and the probe list: find(), dumpAll(), resetAll()
+ *   - With INSTRUMENTATION=0 the probes are empty and print nothing
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <Instrumentation.h>
+#include <SimpleTimer.h>
+#include "HostTest.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+class QuietWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Instrumentation"; }
+    bool missionComplete() const override { return true; }
+};
+
+// Everything dump functions write
+template <typename F>
+std::string captured(F dump) {
+    FILE *out = tmpfile();
+    dump(out);
+    std::string text(static_cast<size_t>(ftell(out)), '\0');
+    rewind(out);
+    if (!text.empty() && fread(&text[0], 1, text.size(), out) != text.size()) text.clear();
+    fclose(out);
+    return text;
+}
+
+void stats_test() {
+    TimingStats stats;
+    CHECK(stats.percentile(99) == 0 && stats.average() == 0);
+    for (uint32_t v = 1; v <= 100; v++) stats.add(v);
+    stats.add(5000);
+    CHECK(stats.count == 101 && stats.min == 1 && stats.max == 5000);
+    CHECK(stats.average() == (5050 + 5000) / 101);
+    CHECK(stats.percentile(50) >= 50 && stats.percentile(50) <= 127);   // Within a factor of two
+    CHECK(stats.percentile(99) >= 100 && stats.percentile(99) <= 127);
+    CHECK(stats.percentile(100) == 5000);                               // Never above max
+    stats.add(0);
+    CHECK(stats.min == 0 && stats.buckets[0] == 1);
+    stats.add(UINT32_MAX);
+    CHECK(stats.buckets[TimingStats::kBuckets - 1] == 1);
+    stats.reset();
+    CHECK(stats.count == 0 && stats.max == 0);
+}
+
+#if INSTRUMENTATION
+
+int timerCalls = 0;
+LatencyProbe *timerLate = nullptr;
+
+void lateCallback(void *arg) {
+    timerLate->fired();
+    timerCalls++;
+}
+
+void cycle_scope_test() {
+    CycleTimer timer("test_block");
+    {
+        CycleScope scope(timer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));     // The host cycle counter is wall time
+    }
+    CHECK(timer.stats().count == 1);
+    CHECK(timer.stats().min >= 2000 * INSTRUMENTATION_CPU_MHZ);
+}
+
+void period_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    PeriodProbe loop("test_loop", 10000);
+    for (int i = 0; i < 50; i++) {
+        loop.tick();
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    CHECK(loop.stats().count == 49 && loop.stats().max == 0);
+    vTaskDelay(pdMS_TO_TICKS(15));                      // One 25 ms period
+    loop.tick();
+    CHECK(loop.stats().max == 15000 && loop.maxPeriod() == 25000);
+    loop.restart();
+    vTaskDelay(pdMS_TO_TICKS(1000));                    // Between two runs: not a period
+    loop.tick();
+    CHECK(loop.stats().count == 50 && loop.maxPeriod() == 25000);
+}
+
+void latency_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    LatencyProbe late("test_timer_late");
+    timerLate = &late;
+    timerCalls = 0;
+    SimpleTimer timer;
+    timer.setup(lateCallback, "test_timer");
+    late.fired();                                       // Not armed yet: ignored
+    CHECK(late.stats().count == 0);
+    timer.startOnce(1000);
+    late.expect(esp_timer_get_time() + 1000);
+    hostsim::clock().advance(2000);
+    timer.startOnce(800);
+    late.expect(esp_timer_get_time() + 500);            // Armed for earlier than it runs
+    hostsim::clock().advance(2000);
+    CHECK(timerCalls == 2);
+    CHECK(late.stats().count == 2 && late.stats().min == 0 && late.stats().max == 300);
+}
+
+void registry_test() {
+    const char *const names[3] = {"idle", "busy", "done"};
+    StateTimer<3> states("test_state", names);
+    CycleTimer isr("test_isr");
+    states.record(0, 1500);
+    states.record(1, 250000);
+    states.record(1, 350000);
+    isr.add(480);
+    CHECK(states.stats(1).count == 2 && states.stats(1).average() == 300000);
+    CHECK(TimingProbe::find("test_isr") == &isr);
+    CHECK(TimingProbe::find("test_state") == &states);
+    CHECK(TimingProbe::find("missing") == nullptr);
+    std::string text = captured([](FILE *out) { TimingProbe::dumpAll(out); });
+    CHECK(text.find("test_state idle") != std::string::npos);
+    CHECK(text.find("test_state busy") != std::string::npos);
+    CHECK(text.find("test_state done") == std::string::npos);      // Never entered, no row
+    CHECK(text.find("test_isr") != std::string::npos && text.find("2.00") != std::string::npos);  // 480 cycles = 2 us
+    TimingProbe::resetAll();
+    CHECK(states.stats(1).count == 0 && isr.stats().count == 0);
+    {
+        CycleTimer scoped("test_scoped");
+    }
+    CHECK(TimingProbe::find("test_scoped") == nullptr);             // Unlinked when destroyed
+}
+
+#else // INSTRUMENTATION
+
+static_assert(std::is_empty<CycleTimer>::value && std::is_empty<CycleScope>::value, "Probes must compile out");
+static_assert(std::is_empty<PeriodProbe>::value && std::is_empty<LatencyProbe>::value, "Probes must compile out");
+static_assert(std::is_empty<StateTimer<4>>::value, "Probes must compile out");
+
+void compiled_out_test() {
+    const char *const names[2] = {"a", "b"};
+    StateTimer<2> states("test_state", names);
+    CycleTimer isr("test_isr");
+    PeriodProbe loop("test_loop", 1000);
+    LatencyProbe late("test_late");
+    {
+        CycleScope scope(isr);
+    }
+    states.record(1, 100);
+    loop.tick();
+    loop.tick();
+    late.expect(10);
+    late.fired();
+    CHECK(isr.stats().count == 0 && states.stats(1).count == 0);
+    CHECK(loop.stats().count == 0 && late.stats().count == 0);
+    CHECK(TimingProbe::find("test_isr") == nullptr);
+    CHECK(captured([](FILE *out) { TimingProbe::dumpAll(out); }).empty());
+}
+
+#endif // INSTRUMENTATION
+
+int main() {
+    RUN_TEST(stats_test);
+#if INSTRUMENTATION
+    RUN_TEST(cycle_scope_test);
+    RUN_TEST(period_test);
+    RUN_TEST(latency_test);
+    RUN_TEST(registry_test);
+#else
+    RUN_TEST(compiled_out_test);
+#endif
+    return hostTestFailures();
+}
@@ -0,0 +1,136 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: keypad_scanner_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests KeypadScanner on a simulated 4x4 matrix with bouncing contacts:
+ *   - One press and one release event per keystroke, despite the bounce
+ *   - Fast typing keeps every key, in order
+ *   - waitKey() reacts within a few milliseconds and times out
+ *   - Two keys held together, and a full queue counting drops
+ *   - KeypadEntry: two digits at most, 'B' deletes, 'C' clears, 'A'
+ *     accepts only a number, other keys are left to the caller
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostKeypad.h>
+#include <HostSim.h>
+#include <KeypadScanner.h>
+#include "HostTest.h"
+
+#include <string>
+
+const uint8_t kRows[4] = {5, 18, 19, 21};
+const uint8_t kCols[4] = {15, 4, 22, 23};
+const char *const kMap[4] = {"123A", "456B", "789C", "*0#D"};
+
+class MatrixWorld : public hostsim::World {
+public:
+    MatrixWorld() : keypad(kRows, kCols, kMap) {}
+    const char *name() const override { return "Keypad"; }
+    bool missionComplete() const override { return true; }
+
+    int pinLevel(int pin) override {
+        if (keypad.isColumn(pin)) return keypad.columnLevel(pin, level);
+        return World::pinLevel(pin);
+    }
+
+    hostsim::KeyMatrix keypad;
+};
+
+void press_release_test() {
+    MatrixWorld world;
+    hostsim::install(world);
+    KeypadScanner scanner;
+    CHECK(scanner.setup(kRows, kCols));
+    world.keypad.press('5', 10000, 100000);
+    hostsim::clock().advance(200000);
+    KeyEvent press, release, extra;
+    CHECK(scanner.nextEvent(press));
+    CHECK(scanner.nextEvent(release));
+    CHECK(!scanner.nextEvent(extra));                   // Bounce produced nothing else
+    CHECK(press.key == '5' && press.pressed);
+    CHECK(release.key == '5' && !release.pressed);
+    CHECK(press.time_us >= 10000 && press.time_us <= 10000 + hostsim::KeyMatrix::kBounce_us + 1000);
+    CHECK(release.time_us >= 110000 && release.time_us <= 110000 + hostsim::KeyMatrix::kBounce_us + 1000);
+    scanner.stop();
+}
+
+void typing_order_test() {
+    MatrixWorld world;
+    hostsim::install(world);
+    KeypadScanner scanner;
+    CHECK(scanner.setup(kRows, kCols));
+    const std::string typed = "1204#*D9";
+    for (size_t i = 0; i < typed.size(); i++) world.keypad.press(typed[i], 5000 + i * 60000, 40000);
+    hostsim::clock().advance(1000000);
+    std::string read;
+    for (char key = scanner.getKey(); key != '\0'; key = scanner.getKey()) read += key;
+    CHECK(read == typed);
+    CHECK(scanner.dropped() == 0);
+    scanner.stop();
+}
+
+void wait_key_test() {
+    MatrixWorld world;
+    hostsim::install(world);
+    KeypadScanner scanner;
+    CHECK(scanner.setup(kRows, kCols));
+    world.keypad.press('A', 250000, 80000);
+    CHECK(scanner.waitKey(100) == '\0');                // Times out before the press
+    CHECK(hostsim::clock().now() >= 100000 && hostsim::clock().now() < 110000);
+    CHECK(scanner.waitKey(1000) == 'A');
+    int64_t reaction = hostsim::clock().now() - 250000;
+    // Bounce, debounce scans and one poll period
+    CHECK(reaction <= hostsim::KeyMatrix::kBounce_us + KeypadScanner::kDefaultDebounceScans * 1000 +
+                          KeypadScanner::kWaitPoll_ms * 1000 + 1000);
+    scanner.stop();
+}
+
+void chord_and_overflow_test() {
+    MatrixWorld world;
+    hostsim::install(world);
+    KeypadScanner scanner;
+    CHECK(scanner.setup(kRows, kCols));
+    world.keypad.press('1', 10000, 100000);
+    world.keypad.press('9', 30000, 100000);
+    hostsim::clock().advance(50000);
+    CHECK(scanner.getKey() == '1');
+    CHECK(scanner.getKey() == '9');
+    hostsim::clock().advance(150000);
+    // 20 keystrokes, nobody reading: 40 events for 32 slots
+    for (int i = 0; i < 20; i++) world.keypad.press('0', 300000 + i * 50000, 20000);
+    hostsim::clock().advance(1500000);
+    CHECK(scanner.dropped() == 40 - 32 + 2);            // Plus the two releases still queued from the chord
+    scanner.stop();
+}
+
+void entry_test() {
+    KeypadEntry entry;
+    CHECK(entry.key('A') == KeypadEntry::ENTRY_IGNORED);           // Nothing typed
+    CHECK(entry.key('B') == KeypadEntry::ENTRY_IGNORED);
+    CHECK(entry.key('1') == KeypadEntry::ENTRY_CHANGED && std::string(entry.text()) == "1");
+    CHECK(entry.key('2') == KeypadEntry::ENTRY_CHANGED);
+    CHECK(entry.key('3') == KeypadEntry::ENTRY_IGNORED && std::string(entry.text()) == "12");  // Full
+    CHECK(entry.key('#') == KeypadEntry::ENTRY_IGNORED && entry.key('D') == KeypadEntry::ENTRY_IGNORED);
+    CHECK(entry.key('B') == KeypadEntry::ENTRY_CHANGED && std::string(entry.text()) == "1");
+    CHECK(entry.key('7') == KeypadEntry::ENTRY_CHANGED);
+    CHECK(entry.key('A') == KeypadEntry::ENTRY_DONE && entry.value() == 17.0f);
+    CHECK(entry.key('C') == KeypadEntry::ENTRY_CLEARED && std::string(entry.text()).empty());
+    CHECK(entry.key('C') == KeypadEntry::ENTRY_CLEARED);           // The caller clears the screen anyway
+    CHECK(entry.key('5') == KeypadEntry::ENTRY_CHANGED && entry.key('A') == KeypadEntry::ENTRY_DONE);
+    CHECK(entry.value() == 5.0f);
+    entry.clear();
+    CHECK(entry.key('A') == KeypadEntry::ENTRY_IGNORED);
+}
+
+int main() {
+    RUN_TEST(press_release_test);
+    RUN_TEST(typing_order_test);
+    RUN_TEST(wait_key_test);
+    RUN_TEST(chord_and_overflow_test);
+    RUN_TEST(entry_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,106 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: lcd_framebuffer_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests LcdFramebuffer against the simulated 16x2 display:
+ *   - Posting costs no bus time and the flush task shows the text
+ *   - Only changed cells are sent
+ *   - Posts between flushes collapse into one flush of the newest screen
+ *   - printAt() and clear() edit the draft
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LcdFramebuffer.h>
+#include "HostTest.h"
+
+#include <string>
+
+class ScreenWorld : public hostsim::World {
+public:
+    const char *name() const override { return "LCD"; }
+    bool missionComplete() const override { return true; }
+    void lcdText(const char *text) override { screen = text; }
+
+    std::string screen;
+};
+
+ScreenWorld world;
+NibbleLCD lcd;
+LcdFramebuffer framebuffer;                     // One flush task for the whole program
+uint8_t pins[11] = {0};
+
+// Waits past the next flush
+void settle() {
+    vTaskDelay(pdMS_TO_TICKS(2 * LcdFramebuffer::kDefaultFlush_ms));
+}
+
+void post_test() {
+    int64_t before = hostsim::clock().now();
+    framebuffer.print("Loading beans\nPlease wait...");
+    CHECK(hostsim::clock().now() == before);    // No bus access from the caller
+    settle();
+    CHECK(world.screen == "Loading beans\nPlease wait...");
+    CHECK(framebuffer.stats().characters == 13 + 14);      // One run per row, the single blanks merged in
+    CHECK(framebuffer.stats().commands == 2);
+    // A direct write of the same screen costs the caller the whole bus time
+    before = hostsim::clock().now();
+    lcd.writeCommand(CMD_CLEAR);
+    lcd.printStr("Loading beans\nPlease wait...");
+    CHECK(hostsim::clock().now() - before == hostsim::kLcdClearCost_us + 27 * hostsim::kLcdByteCost_us);
+}
+
+void diff_test() {
+    framebuffer.print("Current Weight:\n1.23 kg");
+    settle();
+    LcdFlushStats start = framebuffer.stats();
+    framebuffer.print("Current Weight:\n1.24 kg");
+    settle();
+    CHECK(world.screen == "Current Weight:\n1.24 kg");
+    CHECK(framebuffer.stats().characters - start.characters == 1);
+    CHECK(framebuffer.stats().commands - start.commands == 1);
+    // Nothing changed: nothing sent
+    start = framebuffer.stats();
+    framebuffer.print("Current Weight:\n1.24 kg");
+    settle();
+    CHECK(framebuffer.stats().characters == start.characters);
+    CHECK(framebuffer.stats().flushes == start.flushes);
+}
+
+void rate_limit_test() {
+    LcdFlushStats start = framebuffer.stats();
+    char text[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(text, sizeof(text), "Count\n%d", i);
+        framebuffer.print(text);
+    }
+    settle();
+    CHECK(world.screen == "Count\n999");
+    CHECK(framebuffer.stats().posts - start.posts == 1000);
+    CHECK(framebuffer.stats().flushes - start.flushes == 1);
+}
+
+void edit_test() {
+    framebuffer.print("Weight:\n0.00 kg");
+    framebuffer.printAt(1, 0, "2.50");
+    framebuffer.printAt(0, 14, "OK!");                  // Clipped at the edge
+    settle();
+    CHECK(world.screen == "Weight:       OK\n2.50 kg");
+    framebuffer.clear();
+    settle();
+    CHECK(world.screen == "");
+    CHECK(framebuffer.shown().cells[0][0] == ' ');
+}
+
+int main() {
+    hostsim::install(world);
+    CHECK(framebuffer.setup(lcd, pins));
+    RUN_TEST(post_test);
+    RUN_TEST(diff_test);
+    RUN_TEST(rate_limit_test);
+    RUN_TEST(edit_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,163 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: lift_statics_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the scissor lift statics (lib/LiftStatics):
+ *   - Solutions satisfy A·x = b, the ground carries every weight and the
+ *     thrust matches the virtual work of lifting
+ *   - Forces grow linearly with the load; the grid sweep gives the same
+ *     numbers as single solves
+ *   - The table compiled into the firmware is the one the sweep gives
+ *     today, and its lookup takes the worst row of a travel
+ *   - Steps and heights convert both ways through the geometry, and the
+ *     compiled height table interpolates them within a fraction of a mm
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LiftLoadLimits.h>
+#include <LiftStatics.h>
+#include <LiftStepHeights.h>
+#include "HostTest.h"
+
+#include <algorithm>
+#include <vector>
+
+constexpr int N = LiftStatics::kEquations;
+constexpr double kPi = 3.14159265358979323846;
+
+void equilibrium_test() {
+    LiftStatics statics;
+    const ScissorGeometry &g = statics.geometry();
+    double a[N * N], bWeights[N], bPerKg[N];
+    for (double h : {0.04, 0.12, 0.25, 0.35}) {
+        for (double kg : {0.0, 5.0, 12.0}) {
+            LiftForces f;
+            CHECK(statics.solve(h, kg, f));
+            statics.build(h, a, bWeights, bPerKg);
+            double worst = 0;
+            for (int i = 0; i < N; i++) {
+                double sum = 0;
+                for (int j = 0; j < N; j++) sum += a[i * N + j] * f.x[j];
+                worst = std::max(worst, std::fabs(sum - bWeights[i] - kg * bPerKg[i]));
+            }
+            CHECK(worst < 1e-9);
+            double weight = 9.81 * (kg + g.platformMass_kg + 4 * g.linkMass_kg + g.baseMass_kg);
+            CHECK_NEAR(f.x[FORCE_GROUND_A] + f.x[FORCE_GROUND_B], weight, 1e-9);
+            CHECK_NEAR(f.x[FORCE_GROUND_X], 0, 1e-9);
+            // Screw travel dx = L sin(a) da lifts the platform 2 L cos(a) da and the link centres 4 L cos(a) da in all
+            double angle = statics.angleFor(h);
+            double expected = (2 * 9.81 * (kg + g.platformMass_kg) + 4 * 9.81 * g.linkMass_kg) / std::tan(angle);
+            CHECK_NEAR(f.thrust(), expected, 1e-9);
+        }
+    }
+    LiftForces f;
+    CHECK(!statics.solve(0, 5, f));                     // Flat: no solution
+    CHECK(!statics.solve(2 * g.link_m, 5, f));          // Links upright
+}
+
+void linearity_test() {
+    LiftStatics statics;
+    LiftForces none, one, two;
+    statics.solve(0.1, 0, none);
+    statics.solve(0.1, 3, one);
+    statics.solve(0.1, 6, two);
+    double worst = 0;
+    for (int i = 0; i < kLiftUnknowns; i++) worst = std::max(worst, std::fabs((two.x[i] - one.x[i]) - (one.x[i] - none.x[i])));
+    CHECK(worst < 1e-9);
+    CHECK(one.maxPin() > none.maxPin());
+    LiftForces high;
+    statics.solve(0.3, 3, high);
+    CHECK(high.thrust() < one.thrust() / 3);            // Far less thrust once the links stand up
+}
+
+void sweep_test() {
+    LiftStatics statics;
+    std::vector<double> heights = {0.036, 0.08, 0.2, 0.35}, loads;
+    for (int i = 0; i <= 40; i++) loads.push_back(i * 0.5);
+    LiftSweep grid;
+    CHECK(statics.sweep(heights, loads, grid));
+    CHECK(grid.maxPin_N.size() == heights.size() * loads.size());
+    for (size_t h = 0; h < heights.size(); h++) {
+        for (size_t k = 0; k < loads.size(); k += 7) {
+            LiftForces f;
+            statics.solve(heights[h], loads[k], f);
+            CHECK_NEAR(grid.maxPin_N[grid.at(h, k)], f.maxPin(), 1e-3 * f.maxPin());
+            CHECK_NEAR(grid.thrust_N[grid.at(h, k)], f.thrust(), 1e-3 * f.thrust());
+        }
+    }
+    CHECK(!statics.sweep({0.1, 0.5}, loads, grid));     // 0.5 m is out of reach
+}
+
+void table_test() {
+    LiftStatics statics;
+    LiftLoadLimits limits;
+    CHECK(statics.loadLimits(LiftRatings(), limits));
+    // Regenerate with: lift_statics --header lib/LiftStatics/LiftLoadLimits.h
+    CHECK(limits.minHeight_mm == liftLoadTable.minHeight_mm && limits.step_mm == liftLoadTable.step_mm);
+    CHECK(limits.limit_hg.size() == liftLoadTable.rows);
+    bool same = limits.limit_hg.size() == liftLoadTable.rows;
+    for (size_t i = 0; same && i < limits.limit_hg.size(); i++) same = limits.limit_hg[i] == liftLoadTable.limit_hg[i];
+    CHECK(same);
+    // Rows never promise more than the solver allows at the bin's lowest point
+    LiftRatings ratings;
+    for (int i = 0; i < liftLoadTable.rows; i++) {
+        double h = std::max(statics.minHeight_m(), (liftLoadTable.minHeight_mm + i * liftLoadTable.step_mm) / 1000.0);
+        LiftForces f;
+        statics.solve(h, liftLoadTable.limit_hg[i] / 10.0, f);
+        CHECK(f.maxPin() <= ratings.pin_N && std::fabs(f.thrust()) <= ratings.thrust_N);
+    }
+    const uint16_t rows[] = {150, 200, 120, 400};
+    LiftLoadTable table = {30, 10, 4, rows};
+    CHECK_NEAR(table.limit_kg(30, 60), 12.0f, 1e-6);    // Worst row of the travel
+    CHECK_NEAR(table.limit_kg(60, 30), 12.0f, 1e-6);
+    CHECK_NEAR(table.limit_kg(0, 35), 15.0f, 1e-6);     // Below the table: first row
+    CHECK_NEAR(table.limit_kg(65, 900), 40.0f, 1e-6);   // Above: last row
+    CHECK_NEAR(table.limit_kg(40, 49), 20.0f, 1e-6);
+}
+
+void height_table_test() {
+    LiftStatics statics;
+    const ScissorGeometry &g = statics.geometry();
+    CHECK_NEAR(statics.stepsFor(statics.minHeight_m()), 0, 1e-9);
+    CHECK_NEAR(statics.heightAtStep_m(0), statics.minHeight_m(), 1e-12);
+    for (double h : {0.04, 0.15, 0.3, 0.35}) CHECK_NEAR(statics.heightAtStep_m(statics.stepsFor(h)), h, 1e-9);
+    // Rest to the sensor moves H by L (cos 5 - cos 60)
+    double travel = g.link_m * (std::cos(g.minAngle_deg * kPi / 180) - std::cos(g.maxAngle_deg * kPi / 180));
+    CHECK_NEAR(statics.stepsFor(statics.maxHeight_m()), travel / g.screwStep_m, 1e-6);
+
+    // Regenerate with: lift_statics --height-header lib/LiftStatics/LiftStepHeights.h
+    LiftStepHeights heights;
+    statics.stepHeights(liftHeightTable.stride_steps, heights);
+    bool same = heights.height_dmm.size() == liftHeightTable.rows;
+    for (size_t i = 0; same && i < heights.height_dmm.size(); i++) same = heights.height_dmm[i] == liftHeightTable.height_dmm[i];
+    CHECK(same);
+    CHECK(liftHeightTable.maxSteps() >= statics.stepsFor(statics.maxHeight_m()));
+
+    double worst = 0;
+    int lost = 0;
+    for (int32_t s = 0; s <= liftHeightTable.maxSteps(); s++) {
+        float mm = liftHeightTable.height_mm(s);
+        worst = std::max(worst, std::fabs(mm - statics.heightAtStep_m(s) * 1000));
+        if (liftHeightTable.steps(mm) != s) lost++;
+    }
+    CHECK(worst < 0.3);                                 // Interpolation, worst next to rest
+    CHECK(lost == 0);                                   // Every step count comes back
+    for (double mm : {40.0, 120.0, 200.0, 320.0}) {
+        CHECK(std::abs(liftHeightTable.steps(mm) - std::lround(statics.stepsFor(mm / 1000))) <= 1);
+    }
+    CHECK(liftHeightTable.steps(10) == 0);              // Clamped to the travel
+    CHECK(liftHeightTable.steps(900) == liftHeightTable.maxSteps());
+    CHECK_NEAR(liftHeightTable.height_mm(-5), liftHeightTable.height_dmm[0] / 10.0f, 1e-6);
+}
+
+int main() {
+    RUN_TEST(equilibrium_test);
+    RUN_TEST(linearity_test);
+    RUN_TEST(sweep_test);
+    RUN_TEST(table_test);
+    RUN_TEST(height_table_test);
+    return hostTestFailures();
+}
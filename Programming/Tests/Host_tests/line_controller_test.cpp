@@ -0,0 +1,213 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: line_controller_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests LineEstimator and LineController against latched sensor pins:
+ *   - Error levels, lost-line side and station mark detection, also when
+ *     the mark is reached off-centre
+ *   - Duty table values and saturation
+ *   - Timer rate, duties following the sensors and stopping on a mark;
+ *     a stop on the lost-line budget is reported as lost, not as a mark
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LineController.h>
+#include "HostTest.h"
+
+constexpr int kMotor1Pin = 25;
+constexpr int kMotor2Pin = 26;
+constexpr int kLine1Pin = 33;
+constexpr int kLine2Pin = 32;
+
+class LineWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Line"; }
+    bool missionComplete() const override { return true; }
+
+    void pwmDuty(int pin, float percent) override {
+        if (pin == kMotor1Pin) right = percent;
+        else if (pin == kMotor2Pin) left = percent;
+        writes++;
+    }
+
+    int pinLevel(int pin) override {
+        if (pin == kLine1Pin) reads++;
+        return World::pinLevel(pin);
+    }
+
+    void sensors(int l, int r) {
+        level[kLine1Pin] = l;
+        level[kLine2Pin] = r;
+    }
+
+    float left = -1, right = -1;
+    int writes = 0, reads = 0;
+};
+
+SimpleGPIO leftSensor, rightSensor;
+SimplePWM motor1, motor2;
+
+void setupController(LineWorld &world, LineController &controller) {
+    hostsim::install(world);
+    leftSensor.setup(kLine1Pin, GPI);
+    rightSensor.setup(kLine2Pin, GPI);
+    motor1.setup(kMotor1Pin, 0);
+    motor2.setup(kMotor2Pin, 1);
+    CHECK(controller.setup(leftSensor, rightSensor, motor1, motor2));
+}
+
+void estimator_test() {
+    LineEstimator estimator;
+    estimator.reset();
+    CHECK(estimator.update(0, 0) == 0);             // Starting on a mark is not a mark
+    CHECK(estimator.update(0, 0) == 0);
+    CHECK(estimator.update(0, 0) == 0);
+    CHECK(!estimator.atMark());
+    CHECK(estimator.update(1, 1) == 0);
+    CHECK(estimator.update(0, 1) == 1);
+    CHECK(estimator.update(0, 0) == 2);             // Lost on the right-turn side
+    CHECK(estimator.lost());
+    CHECK(!estimator.atMark());
+    CHECK(estimator.update(1, 0) == -1);
+    CHECK(!estimator.lost());
+    CHECK(estimator.update(0, 0) == -2);
+    CHECK(estimator.update(1, 1) == 0);
+    for (int i = 0; i < LineEstimator::kMarkSamples - 1; i++) estimator.update(0, 0);
+    CHECK(!estimator.atMark());                     // One short of the debounce
+    estimator.update(0, 0);
+    CHECK(estimator.atMark());
+}
+
+void lost_line_test() {
+    LineEstimator estimator;
+    estimator.reset();
+    estimator.update(1, 1);
+    estimator.update(0, 1);
+    for (int i = 0; i < LineEstimator::kLostSamples - 1; i++) CHECK(estimator.update(0, 0) == 2);
+    CHECK(estimator.lost() && !estimator.atMark());     // Still steering back
+    estimator.update(0, 1);                             // Found again: the budget starts over
+    for (int i = 0; i < LineEstimator::kLostSamples - 1; i++) estimator.update(0, 0);
+    CHECK(!estimator.atMark());
+    estimator.update(0, 0);
+    CHECK(estimator.atMark());
+}
+
+void duty_table_test() {
+    LineWorld world;
+    LineController controller;
+    setupController(world, controller);
+    const int straight = LineController::kSteerSteps;
+    const int half = LineController::kSpeedSteps / 2;             // 50 %
+    CHECK(controller.dutyLeft(half, straight) == 50);
+    CHECK(controller.dutyRight(half, straight) == 50);
+    CHECK(controller.dutyLeft(half, straight + straight / 2) == 75);  // Same as the old 25/75 turn
+    CHECK(controller.dutyRight(half, straight + straight / 2) == 25);
+    CHECK(controller.dutyLeft(LineController::kSpeedSteps, 2 * straight) == 100);   // Saturates
+    CHECK(controller.dutyRight(LineController::kSpeedSteps, 2 * straight) == 0);
+    CHECK(controller.dutyLeft(0, 0) == 0);
+}
+
+void timer_rate_test() {
+    LineWorld world;
+    LineController controller;
+    setupController(world, controller);
+    world.sensors(1, 1);
+    controller.start(50);
+    CHECK(controller.running());
+    CHECK(world.left == 50 && world.right == 50);
+    hostsim::clock().advance(1000000);
+    CHECK(world.reads >= 499 && world.reads <= 501);   // 500 Hz
+    CHECK(controller.jitter().maxDeviation_us <= hostsim::kGpioReadCost_us * 2);
+    int writes = world.writes;
+    hostsim::clock().advance(100000);
+    CHECK(world.writes == writes);                     // Nothing changed, nothing written
+    controller.stop();
+    CHECK(world.left == 0 && world.right == 0);
+    int reads = world.reads;
+    hostsim::clock().advance(100000);
+    CHECK(world.reads == reads);
+}
+
+void steering_test() {
+    LineWorld world;
+    LineController controller;
+    setupController(world, controller);
+    world.sensors(1, 1);
+    controller.start(50);
+    hostsim::clock().advance(100000);
+    world.sensors(0, 1);                               // Drifted left: speed up the left wheel
+    hostsim::clock().advance(20000);
+    CHECK(world.left > world.right);
+    hostsim::clock().advance(200000);
+    float early = controller.steering();
+    hostsim::clock().advance(800000);
+    CHECK(controller.steering() > early);              // Integral keeps pushing on a held error
+    world.sensors(1, 0);
+    hostsim::clock().advance(1500000);
+    CHECK(world.right > world.left);
+    controller.setSpeed(20);
+    world.sensors(1, 1);
+    hostsim::clock().advance(1000000);
+    CHECK_NEAR(world.left + world.right, 40, 12);
+    controller.stop();
+}
+
+void mark_test() {
+    LineWorld world;
+    LineController controller;
+    setupController(world, controller);
+    world.sensors(0, 0);                               // Parked on the previous mark
+    controller.start(50);
+    hostsim::clock().advance(50000);
+    CHECK(!controller.atMark());
+    CHECK(world.left == 50);
+    world.sensors(1, 1);
+    hostsim::clock().advance(50000);
+    world.sensors(0, 0);
+    hostsim::clock().advance(LineController::kDefaultPeriod_us * LineEstimator::kMarkSamples + 10);
+    CHECK(controller.atMark() && !controller.lost());
+    CHECK(world.left == 0 && world.right == 0);
+    world.sensors(1, 1);
+    hostsim::clock().advance(50000);
+    CHECK(world.left == 0);                            // Stays parked until restarted
+    controller.stop();
+}
+
+// Arriving at the mark with only one sensor on the tape: lost, then stopped and reported lost
+void off_centre_mark_test() {
+    LineWorld world;
+    LineController controller;
+    setupController(world, controller);
+    world.sensors(1, 1);
+    controller.start(50);
+    hostsim::clock().advance(50000);
+    world.sensors(1, 0);
+    hostsim::clock().advance(20000);
+    world.sensors(0, 0);
+    hostsim::clock().advance(LineController::kDefaultPeriod_us * LineEstimator::kLostSamples / 2);
+    CHECK(!controller.atMark());
+    CHECK(world.right > world.left);                    // Steering back towards the line first
+    CHECK(!controller.lost());
+    hostsim::clock().advance(LineController::kDefaultPeriod_us * LineEstimator::kLostSamples / 2 + 10);
+    CHECK(controller.atMark() && controller.lost());
+    CHECK(world.left == 0 && world.right == 0);
+    controller.stop();
+    controller.start(50);                               // Restarted: the budget and the flag start over
+    CHECK(!controller.lost());
+    controller.stop();
+}
+
+int main() {
+    RUN_TEST(estimator_test);
+    RUN_TEST(lost_line_test);
+    RUN_TEST(duty_table_test);
+    RUN_TEST(timer_rate_test);
+    RUN_TEST(steering_test);
+    RUN_TEST(mark_test);
+    RUN_TEST(off_centre_mark_test);
+    return hostTestFailures();
+}
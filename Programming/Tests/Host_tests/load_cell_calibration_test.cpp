@@ -0,0 +1,123 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: load_cell_calibration_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the two-point calibration and CalibrationStore on the
+ *   file-backed NVS stand-in:
+ *   - Coefficients from two points, rejected degenerate points
+ *   - Save, reboot (nvs_flash_init) and load from the file
+ *   - Missing, corrupted and other-version records are refused
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LoadCellCalibration.h>
+#include "HostTest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+std::string nvsPath() {
+    const char *tmp = getenv("TMPDIR");
+    return std::string(tmp != nullptr ? tmp : "/tmp") + "/load_cell_calibration_test.nvs";
+}
+
+// Fresh flash file and a booted store
+void blankFlash(CalibrationStore &store) {
+    remove(nvsPath().c_str());
+    hostsim::setNvsFile(nvsPath().c_str());
+    CHECK(store.begin());
+}
+
+void two_point_test() {
+    LoadCalibration cal;
+    CHECK(twoPointCalibration(12.0f, 112.0f, 10.0f, cal));
+    CHECK_NEAR(cal.slope, 0.1, 1e-6);
+    CHECK_NEAR(cal.kg(12.0f), 0.0, 1e-5);
+    CHECK_NEAR(cal.kg(112.0f), 10.0, 1e-5);
+    CHECK_NEAR(cal.kg(62.0f), 5.0, 1e-5);
+    CHECK(!twoPointCalibration(12.0f, 14.0f, 10.0f, cal));         // Span under the minimum
+    CHECK(!twoPointCalibration(12.0f, 112.0f, 0.0f, cal));         // No reference mass
+}
+
+void persist_test() {
+    CalibrationStore store;
+    blankFlash(store);
+    LoadCalibration cal = {0.0f, 0.0f, 0.0f, 0.0f};
+    CHECK(store.load(cal) == CAL_MISSING);
+    CHECK(cal.slope == 0.0f);                                      // Untouched on failure
+    LoadCalibration saved;
+    CHECK(twoPointCalibration(3.0f, 53.0f, 5.0f, saved));
+    CHECK(store.save(saved));
+    // Reboot: everything comes back from the file
+    CalibrationStore rebooted;
+    hostsim::setNvsFile(nvsPath().c_str());
+    CHECK(rebooted.begin());
+    CHECK(rebooted.load(cal) == CAL_OK);
+    CHECK(cal.slope == saved.slope && cal.offset == saved.offset);
+    CHECK(cal.tare_mV == 3.0f && cal.reference_kg == 5.0f);
+    // Erase survives a reboot too
+    CHECK(rebooted.erase());
+    CHECK(rebooted.begin());
+    CHECK(rebooted.load(cal) == CAL_MISSING);
+}
+
+// Reads the stored record, lets edit() change it and writes it back without a new CRC
+void tamper(void (*edit)(std::vector<uint8_t> &record)) {
+    nvs_handle_t handle;
+    CHECK(nvs_open(LOAD_CAL_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK);
+    size_t length = 0;
+    CHECK(nvs_get_blob(handle, LOAD_CAL_KEY, nullptr, &length) == ESP_OK);
+    std::vector<uint8_t> record(length);
+    CHECK(nvs_get_blob(handle, LOAD_CAL_KEY, record.data(), &length) == ESP_OK);
+    edit(record);
+    CHECK(nvs_set_blob(handle, LOAD_CAL_KEY, record.data(), record.size()) == ESP_OK);
+    CHECK(nvs_commit(handle) == ESP_OK);
+    nvs_close(handle);
+}
+
+void corrupt_test() {
+    CalibrationStore store;
+    LoadCalibration cal = {0.1f, 0.1f, 0.0f, 0.0f};
+    blankFlash(store);
+    CHECK(store.save(cal));
+    tamper([](std::vector<uint8_t> &r) { r[10] ^= 0x01; });        // One bit of the slope
+    CHECK(store.load(cal) == CAL_BAD_CHECKSUM);
+    CHECK(store.save(cal));
+    tamper([](std::vector<uint8_t> &r) { r[4] = 2; });             // Version 2 layout
+    CHECK(store.load(cal) == CAL_BAD_VERSION);
+    CHECK(store.save(cal));
+    tamper([](std::vector<uint8_t> &r) { r.resize(r.size() - 4); });
+    CHECK(store.load(cal) == CAL_BAD_CHECKSUM);
+    CHECK(store.save(cal));
+    tamper([](std::vector<uint8_t> &r) { r.resize(r.size() + 16); });
+    CHECK(store.load(cal) == CAL_BAD_CHECKSUM);
+    // A corrupted file on disk is refused after a reboot as well
+    CHECK(store.save(cal));
+    FILE *f = fopen(nvsPath().c_str(), "r+b");
+    CHECK(f != nullptr);
+    if (f != nullptr) {
+        fseek(f, -8, SEEK_END);
+        int c = fgetc(f);
+        fseek(f, -8, SEEK_END);
+        fputc(c ^ 0x80, f);
+        fclose(f);
+    }
+    CHECK(store.begin());
+    CHECK(store.load(cal) == CAL_BAD_CHECKSUM);
+    CHECK(store.save(cal));
+    CHECK(store.load(cal) == CAL_OK);
+    remove(nvsPath().c_str());
+}
+
+int main() {
+    RUN_TEST(two_point_test);
+    RUN_TEST(persist_test);
+    RUN_TEST(corrupt_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,149 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: load_cell_filter_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests LoadCellStats and LoadCellFilter:
+ *   - Running sums match a brute force window after wrapping
+ *   - Median drops single spikes
+ *   - Settled only at the target, with a full quiet window and no trend
+ *   - Timer sampling rate and time to settle on a noisy simulated cell
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <LoadCellFilter.h>
+#include "HostTest.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+constexpr int kCellPin = 39;
+
+void window_sums_test() {
+    LoadCellStats stats;
+    stats.setTarget(5.0f);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> grams(0, 20000);
+    std::deque<int> raw, medians;
+    LoadStats out = {};
+    for (int i = 0; i < 1000; i++) {
+        int g = grams(rng);
+        out = stats.push(g / 1000.0f);
+        raw.push_back(g);
+        if (raw.size() > LoadCellStats::kMedianWindow) raw.pop_front();
+        std::vector<int> sorted(raw.begin(), raw.end());
+        std::sort(sorted.begin(), sorted.end());
+        medians.push_back(sorted[sorted.size() / 2]);
+        if (medians.size() > LoadCellStats::kWindow) medians.pop_front();
+    }
+    double mean = 0, squares = 0, newer = 0;
+    for (size_t i = 0; i < medians.size(); i++) {
+        mean += medians[i];
+        if (i >= medians.size() / 2) newer += medians[i];
+    }
+    double older = (mean - newer) / (medians.size() / 2);
+    newer /= medians.size() / 2;
+    mean /= medians.size();
+    for (int m : medians) squares += (m - mean) * (m - mean);
+    CHECK_NEAR(out.weight_kg, mean / 1000, 1e-4);
+    CHECK_NEAR(out.stddev_kg, std::sqrt(squares / medians.size()) / 1000, 1e-3);
+    CHECK_NEAR(out.trend_kg, (newer - older) / 1000, 1e-3);
+    CHECK(out.seq == 1000);
+}
+
+void spike_test() {
+    LoadCellStats stats;
+    stats.setTarget(2.0f);
+    LoadStats out = {};
+    for (int i = 0; i < 200; i++) out = stats.push(i % 20 == 10 ? 12.0f : 2.0f);
+    CHECK_NEAR(out.weight_kg, 2.0, 1e-6);
+    CHECK_NEAR(out.stddev_kg, 0.0, 1e-6);
+    CHECK(out.settled);
+}
+
+void settle_test() {
+    LoadCellStats stats;
+    // Exactly at the target: settled once the window is full, not before
+    stats.setTarget(2.0f);
+    int firstSettled = -1;
+    for (int i = 0; i < 100 && firstSettled < 0; i++) {
+        if (stats.push(2.0f).settled) firstSettled = i + 1;
+    }
+    CHECK(firstSettled == LoadCellStats::kWindow);
+    // Quiet but 0.1 kg off
+    stats.reset();
+    stats.setTarget(2.1f);
+    bool settled = false;
+    for (int i = 0; i < 500; i++) settled |= stats.push(2.0f).settled;
+    CHECK(!settled);
+    // Slow creep through the target: the trend holds the decision back
+    stats.reset();
+    stats.setTarget(2.0f);
+    settled = false;
+    for (int i = 0; i < 200; i++) settled |= stats.push(1.8f + i * 0.002f).settled;
+    CHECK(!settled);
+    // Noisy beyond maxStddev: not quiet even with the mean on target
+    stats.reset();
+    settled = false;
+    for (int i = 0; i < 500; i++) settled |= stats.push(i % 2 ? 2.5f : 1.5f).settled;
+    CHECK(!settled);
+}
+
+// Cell filling to 3 kg over 1 s, 1 mV conversion noise
+class CellWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Load cell"; }
+    bool missionComplete() const override { return true; }
+
+    float adcMilliVolts(int pin) override {
+        if (pin != kCellPin) return 0;
+        reads++;
+        double kg = std::min(1.0, hostsim::clock().now() / 1e6) * 3.0;
+        return static_cast<float>(std::max(0.0, std::round((kg - 0.1) * 10.0 + noise(rng))));
+    }
+
+    int reads = 0;
+    std::mt19937 rng{3};
+    std::normal_distribution<double> noise{0.0, 1.0};
+};
+
+void filter_timer_test() {
+    CellWorld world;
+    hostsim::install(world);
+    SimpleADC adc;
+    adc.setup(kCellPin);
+    LoadCellFilter filter;
+    CHECK(filter.setup(adc, 0.1f, 0.1f));
+    filter.start(3.0f);
+    CHECK(filter.latest().seq == 0);
+    int64_t settledAt = -1;
+    while (settledAt < 0 && hostsim::clock().now() < 5000000) {
+        hostsim::clock().advance(10000);
+        LoadStats out = filter.latest();
+        if (out.settled) settledAt = out.timestamp_us;
+    }
+    filter.stop();
+    LoadStats last = filter.latest();
+    CHECK(settledAt > 1000000);                         // Not before the weight is there
+    CHECK(settledAt < 1400000);                         // Within a few windows after it
+    CHECK_NEAR(last.weight_kg, 3.0, 0.05);
+    // 500 Hz, four conversions per sample
+    CHECK_NEAR(last.seq, settledAt / 2000.0, 2);
+    CHECK(world.reads == static_cast<int>(last.seq) * LoadCellFilter::kDefaultOversample);
+    int reads = world.reads;
+    hostsim::clock().advance(100000);
+    CHECK(world.reads == reads);                        // stop() ends the sampling
+}
+
+int main() {
+    RUN_TEST(window_sums_test);
+    RUN_TEST(spike_test);
+    RUN_TEST(settle_test);
+    RUN_TEST(filter_timer_test);
+    return hostTestFailures();
+}
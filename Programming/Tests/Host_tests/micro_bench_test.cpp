@@ -0,0 +1,110 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: micro_bench_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the benchmark harness (Benchmarks/MicroBench.h) on made-up
+ *   timings, so the regression check is not itself timing dependent:
+ *   - Median, MAD, min and p90 of a batch set with one outlier
+ *   - JSON written by benchJson() reads back the same, bad files fail
+ *   - Regressions flagged beyond the tolerance and the noise only, and
+ *     after scaling by the reference case when both runs have it
+ *   - measure() sizes its batches and runs the operation
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <MicroBench.h>
+#include "HostTest.h"
+
+BenchResult result(const char *name, double median, double mad) {
+    BenchResult r;
+    r.name = name;
+    r.median_ns = median;
+    r.mad_ns = mad;
+    return r;
+}
+
+void summary_test() {
+    std::vector<double> batches = {10.2, 10.0, 9.9, 10.1, 10.0, 10.3, 9.8, 10.0, 10.1, 55.0};  // One preempted batch
+    BenchResult r = benchSummary("case", batches, 1000);
+    CHECK_NEAR(r.median_ns, 10.05, 1e-9);
+    CHECK_NEAR(r.mad_ns, 0.1, 1e-9);
+    CHECK_NEAR(r.min_ns, 9.8, 1e-9);
+    CHECK_NEAR(r.p90_ns, 55.0, 1e-9);
+    CHECK(r.samples == 10 && r.iterations == 1000);
+    CHECK(benchSummary("empty", {}, 1).median_ns == 0);
+}
+
+void json_round_trip_test() {
+    std::vector<BenchResult> written = {benchSummary("line_estimator", {2.5, 2.25, 2.75}, 800000),
+                                        benchSummary("keypad_entry", {41.0, 40.0, 42.0, 39.5}, 50000)};
+    std::vector<BenchResult> read;
+    CHECK(parseBenchJson(benchJson("kernel_bench", written), read));
+    CHECK(read.size() == 2);
+    for (size_t i = 0; i < read.size() && i < written.size(); i++) {
+        CHECK(read[i].name == written[i].name);
+        CHECK_NEAR(read[i].median_ns, written[i].median_ns, 1e-3);
+        CHECK_NEAR(read[i].mad_ns, written[i].mad_ns, 1e-3);
+        CHECK_NEAR(read[i].p90_ns, written[i].p90_ns, 1e-3);
+        CHECK(read[i].samples == written[i].samples && read[i].iterations == written[i].iterations);
+    }
+    CHECK(parseBenchJson("{\"results\": []}", read) && read.empty());
+    CHECK(!parseBenchJson("not json", read));
+    CHECK(!parseBenchJson("{\"results\": [{\"median_ns\": 3}]}", read));        // No name
+    CHECK(!parseBenchJson("{\"results\": [{\"name\": \"cut\", \"median_ns\": 3", read));
+}
+
+void compare_test() {
+    std::vector<BenchResult> baseline = {result("same", 100, 1), result("slower", 100, 1), result("faster", 100, 1),
+                                         result("noisy", 100, 15)};
+    std::vector<BenchResult> current = {result("same", 108, 1), result("slower", 130, 1), result("faster", 60, 1),
+                                        result("noisy", 130, 12), result("added", 10, 1)};
+    std::vector<BenchComparison> c = compareBench(current, baseline, 0.15);
+    CHECK(c.size() == 5);
+    if (c.size() != 5) return;
+    CHECK(c[0].verdict == BENCH_SAME);                  // Within the tolerance
+    CHECK(c[1].verdict == BENCH_SLOWER && std::fabs(c[1].change - 0.30) < 1e-9);
+    CHECK(c[2].verdict == BENCH_FASTER);
+    CHECK(c[3].verdict == BENCH_SAME);                  // 30 % up, but inside 3 MADs
+    CHECK(c[4].verdict == BENCH_NEW);                   // Not in the baseline, never a regression
+}
+
+void reference_scaling_test() {
+    std::vector<BenchResult> baseline = {result("reference", 20, 0.1), result("kernel", 100, 1),
+                                         result("worse", 100, 1)};
+    std::vector<BenchResult> current = {result("reference", 40, 0.1), result("kernel", 205, 1),
+                                        result("worse", 260, 1)};                  // Host at half the clock
+    std::vector<BenchComparison> raw = compareBench(current, baseline, 0.15);
+    std::vector<BenchComparison> scaled = compareBench(current, baseline, 0.15, "reference");
+    CHECK(raw.size() == 3 && scaled.size() == 3);
+    if (raw.size() != 3 || scaled.size() != 3) return;
+    CHECK(raw[1].verdict == BENCH_SLOWER);
+    CHECK(scaled[0].verdict == BENCH_SAME && std::fabs(scaled[0].change) < 1e-9);
+    CHECK(scaled[1].verdict == BENCH_SAME && std::fabs(scaled[1].change - 0.025) < 1e-9);
+    CHECK(scaled[2].verdict == BENCH_SLOWER && std::fabs(scaled[2].change - 0.30) < 1e-9);
+    std::vector<BenchComparison> missing = compareBench(current, {result("kernel", 100, 1)}, 0.15, "reference");
+    CHECK(missing[0].verdict == BENCH_NEW && missing[1].verdict == BENCH_SLOWER);  // No reference: raw times
+    CHECK(benchReference(1) == benchReference(1) && benchReference(1) != benchReference(2));
+}
+
+void measure_test() {
+    uint64_t calls = 0;
+    BenchOptions options;
+    options.samples = 5;
+    options.batch_ns = 1e5;
+    BenchResult r = measure("count", [&](uint64_t i) { benchKeep(calls += i & 1); }, options);
+    CHECK(r.samples == 5 && r.iterations > 1);
+    CHECK(r.median_ns > 0 && r.min_ns <= r.median_ns && r.median_ns <= r.p90_ns);
+    CHECK(calls > 0);
+}
+
+int main() {
+    RUN_TEST(summary_test);
+    RUN_TEST(json_round_trip_test);
+    RUN_TEST(compare_test);
+    RUN_TEST(reference_scaling_test);
+    RUN_TEST(measure_test);
+    return hostTestFailures();
+}
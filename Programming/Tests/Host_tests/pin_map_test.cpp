@@ -0,0 +1,135 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: pin_map_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the pin map checks and the register pins:
+ *   - Conflicts found in map order: missing and flash GPIOs, outputs and
+ *     pull-ups on 34-39, analog inputs off ADC1, a GPIO used twice
+ *   - FastPin and FastPinGroup on the simulated register file: writes
+ *     reach the World like gpio_set_level(), a group is read with one
+ *     register load
+ *   Built with PIN_MAP_DUPLICATE or PIN_MAP_INPUT_ONLY defined it must fail
+ *   to compile.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <FastPin.h>
+#include <HostSim.h>
+#include <PinMap.h>
+#include "HostTest.h"
+
+#include <vector>
+
+// Two stepper pins and the test height output of the lift bench sketch (Tests/Scissor_Lift_tests)
+constexpr PinSpec benchPins[] = {
+    {25, PIN_OUTPUT, "Tilt enable"},
+    {12, PIN_OUTPUT, "Lift direction"},
+#ifdef PIN_MAP_DUPLICATE
+    {25, PIN_OUTPUT, "Test height output"},    // On the tilt enable
+#else
+    {3, PIN_OUTPUT, "Test height output"},
+#endif
+    {34, PIN_INPUT, "Height sensor"},
+    {39, PIN_ADC, "Load cell"},
+};
+static_assert(kPinMapChecked<benchPins>);
+
+#ifdef PIN_MAP_INPUT_ONLY
+void driveInputOnly() {
+    FastPin<35> pin;
+    pin.high();
+}
+#endif
+
+class LatchWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Pin map"; }
+    bool missionComplete() const override { return true; }
+    void pinWritten(int pin, int level) override { writes.push_back(pin * 10 + level); }
+
+    std::vector<int> writes;    // pin * 10 + level
+};
+
+void capability_test() {
+    CHECK(pinExists(0) && pinExists(39) && !pinExists(20) && !pinExists(24) && !pinExists(28) && !pinExists(40));
+    CHECK(pinIsFlash(6) && pinIsFlash(11) && !pinIsFlash(12));
+    CHECK(pinCanOutput(33) && !pinCanOutput(34) && !pinCanOutput(36) && !pinCanOutput(8));
+    CHECK(pinCapability({36, PIN_INPUT, ""}) == PIN_OK);
+    CHECK(pinCapability({36, PIN_INPUT_PULLUP, ""}) == PIN_NO_PULLUP);
+    CHECK(pinCapability({36, PIN_PWM, ""}) == PIN_INPUT_ONLY);
+    CHECK(pinCapability({34, PIN_UART_TX, ""}) == PIN_INPUT_ONLY);
+    CHECK(pinCapability({35, PIN_UART_RX, ""}) == PIN_OK);
+    CHECK(pinCapability({25, PIN_ADC, ""}) == PIN_NO_ADC1);                 // ADC2, taken by the radio
+    CHECK(pinCapability({7, PIN_INPUT, ""}) == PIN_FLASH);
+    CHECK(pinCapability({30, PIN_OUTPUT, ""}) == PIN_MISSING);
+}
+
+void map_check_test() {
+    constexpr PinSpec good[] = {{25, PIN_OUTPUT, "a"}, {1, PIN_UART_TX, "b"}, {3, PIN_OUTPUT, "c"}};
+    static_assert(pinMapCheck(good).ok());
+    constexpr PinSpec twice[] = {{25, PIN_OUTPUT, "a"}, {26, PIN_OUTPUT, "b"}, {25, PIN_OUTPUT, "c"}};
+    CHECK(pinMapCheck(twice).conflict == PIN_DUPLICATE && pinMapCheck(twice).index == 2);
+    constexpr PinSpec console[] = {{1, PIN_UART_TX, "Telemetry"}, {1, PIN_OUTPUT, "Buzzer"}};  // The old lift buzzer
+    CHECK(pinMapCheck(console).conflict == PIN_DUPLICATE);
+    constexpr PinSpec servo[] = {{23, PIN_OUTPUT, "a"}, {36, PIN_PWM, "Servo"}, {36, PIN_INPUT, "b"}};
+    CHECK(pinMapCheck(servo).conflict == PIN_INPUT_ONLY && pinMapCheck(servo).index == 1);  // Capability first
+    CHECK(pinMapUses(good, 1, PIN_UART_TX) && !pinMapUses(good, 1, PIN_OUTPUT) && !pinMapUses(good, 2, PIN_OUTPUT));
+}
+
+void fast_pin_test() {
+    LatchWorld world;
+    hostsim::install(world);
+    FastPin<25> pul;
+    FastPin<33> ena;
+    pul.setup<GPO>();
+    pul.high();
+    pul.low();
+    pul.set(1);
+    ena.set(1);
+    ena.set(0);
+    CHECK((world.writes == std::vector<int>{251, 250, 251, 331, 330}));
+    CHECK(world.level[25] == 1 && world.level[33] == 0);
+    CHECK(REG_READ(GPIO_OUT_REG) == gpioBit(25));
+    CHECK(REG_READ(GPIO_OUT1_REG) == 0);
+    world.level[34] = 1;
+    FastPin<34> height;
+    int64_t before = hostsim::clock().now();
+    CHECK(height.get() == 1 && pul.get() == 1 && ena.get() == 0);
+    CHECK(hostsim::clock().now() - before == 3 * hostsim::kGpioReadCost_us);
+}
+
+void group_test() {
+    LatchWorld world;
+    hostsim::install(world);
+    FastPinGroup<15, 4, 22> columns;
+    static_assert(FastPinGroup<15, 4, 22>::mask() == ((1u << 15) | (1u << 4) | (1u << 22)));
+    world.level[15] = 1;
+    world.level[22] = 1;
+    int64_t before = hostsim::clock().now();
+    CHECK(columns.read() == 0b101);                                         // Bit i is the i-th pin
+    CHECK(hostsim::clock().now() - before == hostsim::kGpioReadCost_us);   // One load for all of them
+    FastPinGroup<5, 18, 19, 21> rows;
+    rows.high();
+    CHECK(world.level[5] && world.level[18] && world.level[19] && world.level[21]);
+    world.writes.clear();
+    rows.write(0b0100);                                                     // Row 3 up, the others down
+    CHECK(world.level[19] == 1 && world.level[5] == 0 && world.level[18] == 0 && world.level[21] == 0);
+    CHECK(world.writes.size() == 4);                                        // One set, three cleared
+    rows.low();
+    CHECK((REG_READ(GPIO_OUT_REG) & rows.mask()) == 0);
+    FastPinGroup<32, 33> bank1;
+    bank1.write(0b10);
+    CHECK(world.level[33] == 1 && world.level[32] == 0);
+    CHECK(REG_READ(GPIO_OUT1_REG) == 0b10);
+}
+
+int main() {
+    RUN_TEST(capability_test);
+    RUN_TEST(map_check_test);
+    RUN_TEST(fast_pin_test);
+    RUN_TEST(group_test);
+    return hostTestFailures();
+}
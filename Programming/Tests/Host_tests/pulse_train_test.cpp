@@ -0,0 +1,169 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: pulse_train_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests PulseTrain on the simulated RMT against the one-callback-per-
+ *   edge timer path:
+ *   - Same step times for the same profile
+ *   - Interrupts per chunk instead of per edge
+ *   - Chunk hook stop (limit sensor) and abort
+ *   - stepsOut() never ahead of the pin, stepsDone() a chunk ahead
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <SimpleGPIO.h>
+#include <SimpleTimer.h>
+#include <StepPulseTrain.h>
+#include "HostTest.h"
+
+#include <vector>
+
+constexpr int kPulPin = 25;
+
+class StepWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Steps"; }
+    bool missionComplete() const override { return true; }
+
+    void pinWritten(int pin, int value) override {
+        if (pin == kPulPin && value == 1) stepTimes.push_back(hostsim::clock().now());
+    }
+
+    std::vector<int64_t> stepTimes;
+};
+
+const MotionProfile kProfile = {200, 1000, 4000, PROFILE_TRAPEZOID};
+
+SimpleGPIO pul;
+SimpleTimer stepTimer;
+StepProfile profile;
+StepLoad load;
+PulseTrain pulses;
+int32_t limitStep = -1;                         // Chunk hook stops the move past this step
+
+void IRAM_ATTR edgeCallback(void *arg) {
+    StepLoadScope scope(load);
+    StepEdge edge = profile.nextEdge();
+    if (edge.delay_us == 0) return;
+    pul.set(edge.level);
+    if (edge.level == 1) load.steps++;
+    stepTimer.startOnce(edge.delay_us);
+}
+
+void IRAM_ATTR limitHook(void *arg) {
+    if (limitStep >= 0 && profile.stepsDone() >= limitStep) profile.stop();
+}
+
+void waitFor(bool (*running)()) {
+    while (running() && hostsim::clock().now() < 60000000) hostsim::clock().advance(1000);
+}
+
+std::vector<int64_t> runEdges(StepWorld &world, int32_t steps) {
+    hostsim::install(world);
+    pul.setup(kPulPin, GPO);
+    stepTimer.setup(edgeCallback, "steps");
+    CHECK(profile.build(kProfile));
+    profile.begin(steps);
+    load.reset();
+    edgeCallback(nullptr);
+    waitFor([]() { return profile.busy(); });
+    return world.stepTimes;
+}
+
+std::vector<int64_t> runPulses(StepWorld &world, int32_t steps, int chunk) {
+    hostsim::install(world);
+    CHECK(profile.build(kProfile));
+    CHECK(pulses.setup(kPulPin, RMT_CHANNEL_0, profile, load, chunk, limitHook));
+    profile.begin(steps);
+    load.reset();
+    pulses.start();
+    CHECK(pulses.busy());
+    waitFor([]() { return pulses.busy(); });
+    return world.stepTimes;
+}
+
+void same_steps_test() {
+    StepWorld edgeWorld, rmtWorld;
+    std::vector<int64_t> edges = runEdges(edgeWorld, 500);
+    uint32_t edgeInterrupts = load.interrupts;
+    std::vector<int64_t> trains = runPulses(rmtWorld, 500, PulseTrain::kMaxChunkSteps);
+    CHECK(edges.size() == 500);
+    CHECK(trains.size() == 500);
+    bool same = edges.size() == trains.size();
+    for (size_t i = 1; same && i < edges.size(); i++) {
+        same = edges[i] - edges[0] == trains[i] - trains[0];
+    }
+    CHECK(same);
+    CHECK(edgeInterrupts == 2 * 500 + 1);           // Every edge plus the final check
+    CHECK(load.interrupts == (500 + 62) / 63);      // One per chunk refill, the last one ends the move
+    CHECK(load.steps == 500);
+}
+
+void chunk_size_test() {
+    StepWorld world;
+    runPulses(world, 200, 16);
+    CHECK(world.stepTimes.size() == 200);
+    CHECK(load.interrupts == 200 / 16 + 1);
+    CHECK(load.interruptsPerSecond() > 0);
+    CHECK(load.cpuLoad() > 0 && load.cpuLoad() < 100);
+}
+
+void limit_stop_test() {
+    StepWorld world;
+    limitStep = 300;
+    runPulses(world, StepProfile::kContinuous, 16);
+    limitStep = -1;
+    // Seen at the first chunk boundary past 300, then the ramp down
+    size_t steps = world.stepTimes.size();
+    CHECK(steps >= 300 + 120);
+    CHECK(steps <= 300 + 16 + 120 + 1);
+    CHECK(world.stepTimes[steps - 1] - world.stepTimes[steps - 2] == profile.rampInterval(0));
+}
+
+void steps_out_test() {
+    StepWorld world;
+    hostsim::install(world);
+    CHECK(profile.build(kProfile));
+    CHECK(pulses.setup(kPulPin, RMT_CHANNEL_0, profile, load, 16));
+    profile.begin(200);
+    pulses.start();
+    bool behind = true, lagged = false;
+    while (pulses.busy() && hostsim::clock().now() < 60000000) {
+        hostsim::clock().advance(500);
+        int32_t out = pulses.stepsOut();
+        behind = behind && out <= static_cast<int32_t>(world.stepTimes.size());
+        lagged = lagged || profile.stepsDone() - out == 16;     // The queued chunk, not on the pin yet
+    }
+    CHECK(behind);
+    CHECK(lagged);
+    CHECK(pulses.stepsOut() == 200);
+}
+
+void abort_test() {
+    StepWorld world;
+    hostsim::install(world);
+    CHECK(profile.build(kProfile));
+    CHECK(pulses.setup(kPulPin, RMT_CHANNEL_0, profile, load));
+    profile.begin(1000);
+    pulses.start();
+    hostsim::clock().advance(100000);
+    pulses.stop();
+    size_t steps = world.stepTimes.size();
+    hostsim::clock().advance(1000000);
+    CHECK(!pulses.busy());
+    CHECK(world.stepTimes.size() == steps);
+    CHECK(world.level[kPulPin] == 0);
+}
+
+int main() {
+    RUN_TEST(same_steps_test);
+    RUN_TEST(chunk_size_test);
+    RUN_TEST(limit_stop_test);
+    RUN_TEST(steps_out_test);
+    RUN_TEST(abort_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,166 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: sensor_trace_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the sensor trace (lib/SensorTrace):
+ *   - Samples read back as written: levels, analog steps both ways,
+ *     long gaps, an ISR sample stamped before the one ahead of it
+ *   - A bad header, an unknown tag or a cut sample end the parse
+ *   - The recorder keeps level changes only, counts what a full ring
+ *     drops and sends that count
+ *   - The hooks record only while a recorder is started
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <SensorTrace.h>
+#include "HostTest.h"
+
+#include <cstring>
+#include <vector>
+
+class TraceWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Sensor trace"; }
+    bool missionComplete() const override { return true; }
+    float adcMilliVolts(int pin) override { return pin == 39 ? mv : 0.0f; }
+
+    float mv = 0.0f;
+};
+
+std::vector<uint8_t> captured;
+
+void captureSink(const uint8_t *data, size_t length) {
+    captured.insert(captured.end(), data, data + length);
+}
+
+bool same(const SensorSample &a, const SensorSample &b) {
+    return a.time_us == b.time_us && a.gpio == b.gpio && a.analog == b.analog && a.value == b.value;
+}
+
+void codec_test() {
+    const SensorSample written[] = {
+        {1200, 33, false, 1},
+        {1201, 32, false, 0},
+        {5000, 39, true, 152000},
+        {5010, 39, true, 148250},               // Falling reading
+        {4990, 18, false, 1},                   // ISR stamped before the sample ahead of it
+        {4000000000LL, 39, true, -2000},        // Hours later, below zero
+    };
+    SensorTraceEncoder encoder;
+    uint8_t bytes[256];
+    size_t length = encoder.header(bytes);
+    size_t sampleBytes = 0;
+    for (const SensorSample &s : written) {
+        size_t n = encoder.encode(s, bytes + length);
+        CHECK(n <= kSensorTraceMaxSampleBytes);
+        length += n;
+        sampleBytes += n;
+    }
+    CHECK(sampleBytes < 6 * 8);                 // Well under the 16 bytes of a raw sample
+    length += encoder.dropped(7, bytes + length);
+    std::vector<SensorSample> read;
+    SensorTraceStats stats = sensorTraceParse(bytes, length, read);
+    CHECK(stats.complete && stats.samples == 6 && stats.dropped == 7);
+    CHECK(read.size() == 6);
+    for (size_t i = 0; i < read.size() && i < 6; i++) CHECK(same(read[i], written[i]));
+}
+
+void parse_errors_test() {
+    SensorTraceEncoder encoder;
+    uint8_t bytes[64];
+    size_t length = encoder.header(bytes);
+    length += encoder.encode({300, 15, false, 1}, bytes + length);
+    length += encoder.encode({70000, 39, true, 90000}, bytes + length);
+    std::vector<SensorSample> read;
+    CHECK(!sensorTraceParse(bytes, 3, read).complete);                  // Header cut
+    uint8_t wrongMagic[64];
+    memcpy(wrongMagic, bytes, length);
+    wrongMagic[0] = 'X';
+    CHECK(!sensorTraceParse(wrongMagic, length, read).complete && read.empty());
+    SensorTraceStats cut = sensorTraceParse(bytes, length - 1, read);   // Last sample cut short
+    CHECK(!cut.complete && cut.samples == 1 && read.size() == 1);
+    read.clear();
+    bytes[length] = 0x80 | 45;                                          // No such pin
+    bytes[length + 1] = 0;
+    SensorTraceStats bad = sensorTraceParse(bytes, length + 2, read);
+    CHECK(!bad.complete && bad.samples == 2);
+}
+
+void recorder_test() {
+    TraceWorld world;
+    hostsim::install(world);
+    captured.clear();
+    static SensorRecorder recorder;
+    CHECK(recorder.setup(captureSink, 0));              // No task, drained here
+    recorder.start();
+    CHECK(recorder.record(100, 33, false, 1));
+    CHECK(!recorder.record(110, 33, false, 1));         // Same level, not needed
+    CHECK(recorder.record(120, 33, false, 0));
+    CHECK(recorder.record(130, 39, true, 5000));
+    CHECK(recorder.record(140, 39, true, 5000));        // Readings are always kept
+    CHECK(!recorder.record(150, 40, false, 1));         // No such pin
+    CHECK(recorder.drain() == 4 && recorder.sent() == 4);
+    int level = 0;
+    for (uint32_t i = 0; i < SensorRecorder::kCapacity + 10; i++) recorder.record(200 + i, 15, false, level ^= 1);
+    CHECK(recorder.dropped() == 10);
+    recorder.flush();
+    CHECK(recorder.pending() == 0);
+    std::vector<SensorSample> read;
+    SensorTraceStats stats = sensorTraceParse(captured.data(), captured.size(), read);
+    CHECK(stats.complete && stats.dropped == 10);
+    CHECK(stats.samples == 4 + SensorRecorder::kCapacity);
+    CHECK(recorder.bytes() == captured.size());
+    if (read.size() < 4) return;
+    CHECK(same(read[1], {120, 33, false, 0}) && same(read[3], {140, 39, true, 5000}));
+    recorder.stop();
+}
+
+#if SENSOR_TRACE
+
+void hooks_test() {
+    TraceWorld world;
+    hostsim::install(world);
+    captured.clear();
+    SimpleGPIO line;
+    line.setup(33, GPI);
+    SimpleADC cell;
+    cell.setup(39);
+    world.level[33] = 1;
+    world.mv = 151.0f;
+    CHECK(SensorRecorder::active() == nullptr);
+    CHECK(sensorTraceGet(line) == 1);                   // Nothing started: a plain read
+    static SensorRecorder recorder;
+    recorder.setup(captureSink, 0);
+    recorder.start();
+    CHECK(SensorRecorder::active() == &recorder);
+    int64_t before = esp_timer_get_time();
+    CHECK(sensorTraceGet(line) == 1);
+    CHECK(sensorTraceMilliVolts(cell) == 151.0f);
+    CHECK(sensorTraceLevel(18) == 0);
+    recorder.stop();
+    CHECK(sensorTraceGet(line) == 1);
+    recorder.flush();
+    std::vector<SensorSample> read;
+    sensorTraceParse(captured.data(), captured.size(), read);
+    CHECK(read.size() == 3);
+    if (read.size() != 3) return;
+    CHECK(same(read[0], {before + hostsim::kGpioReadCost_us, 33, false, 1}));   // Stamped when the read returned
+    CHECK(read[1].analog && read[1].gpio == 39 && read[1].value == 151000);
+    CHECK(read[2].gpio == 18 && read[2].time_us == read[1].time_us);            // Stamped at the edge
+}
+
+#endif // SENSOR_TRACE
+
+int main() {
+    RUN_TEST(codec_test);
+    RUN_TEST(parse_errors_test);
+    RUN_TEST(recorder_test);
+#if SENSOR_TRACE
+    RUN_TEST(hooks_test);
+#endif
+    return hostTestFailures();
+}
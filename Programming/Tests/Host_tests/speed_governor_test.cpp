@@ -0,0 +1,183 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: speed_governor_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests RangeTracker and SpeedGovernor:
+ *   - The tracker settles on distance and closing speed through noisy
+ *     samples, restarts on jumps, clears past the range and coasts
+ *     through lost echoes
+ *   - Scripted obstacles driven in closed loop (10 ms control, a noisy
+ *     sample every 51.6 ms, drive train lag), the governor against the
+ *     old linear distance law: a standing obstacle is reached sooner and
+ *     without touching, an oncoming one is braked for earlier, keeping
+ *     the time to collision up
+ *   - Sound speed over temperature
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <SpeedGovernor.h>
+#include "HostTest.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+
+constexpr int64_t kSample_us = 51600;           // EchoArray cycle on the AGV
+constexpr int64_t kControl_us = 10000;          // CONTROL_PERIOD_MS
+constexpr double kCmPerDuty = 0.4;              // 40 cm/s at 100 %, as in AgvWorld
+constexpr double kLag_s = 0.15;
+
+EchoSample sampleAt(double distance_cm, int64_t now_us, std::mt19937 &rng) {
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    if (distance_cm >= EchoRanger::kMaxRange_cm) return {ECHO_OUT_OF_RANGE, 651.8f, now_us, 0};
+    return {ECHO_OK, static_cast<float>(distance_cm + noise(rng)), now_us, 0};
+}
+
+void tracker_test() {
+    std::mt19937 rng(3);
+    RangeTracker tracker;
+    tracker.setup();
+    CHECK(tracker.at(0).distance_cm < 0);
+    // Closing at 30 cm/s from 300 cm
+    int64_t t = 0;
+    for (; t <= 2000000; t += kSample_us) tracker.update(sampleAt(300 - 30 * t * 1e-6, t, rng));
+    RangeEstimate now = tracker.at(t);
+    CHECK_NEAR(now.distance_cm, 300 - 30 * t * 1e-6, 1.5);
+    CHECK_NEAR(now.closing_cm_s, 30, 4);
+    CHECK(tracker.restarts() == 1);
+    CHECK(!tracker.update(sampleAt(200, t - kSample_us, rng)));     // Already seen
+    // The nearest sensor changes: a new track standing still
+    tracker.update(sampleAt(80, t, rng));
+    CHECK(tracker.restarts() == 2);
+    CHECK(tracker.at(t).closing_cm_s == 0);
+    // Lost echoes are coasted for a while, then dropped
+    t += kSample_us;
+    tracker.update({ECHO_TIMEOUT, 0, t, 0});
+    CHECK(tracker.at(t + 100000).distance_cm > 0);
+    CHECK(tracker.at(t + 300000).distance_cm < 0);
+    // Nothing ahead
+    tracker.update(sampleAt(70, t, rng));
+    CHECK(tracker.tracking());
+    tracker.update(sampleAt(500, t + kSample_us, rng));
+    CHECK(!tracker.tracking() && tracker.at(t + kSample_us).distance_cm < 0);
+}
+
+// Obstacle ahead of the AGV: starts at obstacle_cm, comes closer at speed_cm_s until the gap is stopGap_cm
+struct Scenario {
+    double obstacle_cm;
+    double speed_cm_s;
+    double stopGap_cm;
+};
+
+struct RunResult {
+    double arrive_s = -1;       // First time the gap reached arriveGap_cm
+    double minGap_cm = 1e9;
+    double minTtc_s = 1e9;      // While the obstacle moves: gap to the 10 cm stop gap over the true closing speed
+    double maxSpeed_cm_s = 0;
+};
+
+using SpeedLaw = std::function<int(const EchoSample &sample, int64_t now_us)>;
+
+RunResult drive(const Scenario &s, const SpeedLaw &law, double arriveGap_cm, double limit_s) {
+    std::mt19937 rng(11);
+    RunResult r;
+    double position = 0, speed = 0, obstacle = s.obstacle_cm, duty = 0;
+    bool moving = s.speed_cm_s > 0;
+    EchoSample sample = {ECHO_PENDING, -1, 0, 0};
+    for (int64_t t = 0; t < limit_s * 1e6; t += kControl_us) {
+        if (t % kSample_us < kControl_us) sample = sampleAt(obstacle - position, t, rng);
+        duty = law(sample, t);
+        double dt = kControl_us * 1e-6, target = duty * kCmPerDuty, decay = std::exp(-dt / kLag_s);
+        position += target * dt + (speed - target) * kLag_s * (1.0 - decay);
+        speed = target + (speed - target) * decay;
+        if (moving) obstacle -= s.speed_cm_s * dt;
+        double gap = obstacle - position;
+        if (moving) r.minTtc_s = std::min(r.minTtc_s, std::max(gap - 10, 0.0) / (speed + s.speed_cm_s));
+        moving = moving && gap > s.stopGap_cm;
+        r.minGap_cm = std::min(r.minGap_cm, gap);
+        r.maxSpeed_cm_s = std::max(r.maxSpeed_cm_s, speed);
+        if (r.arrive_s < 0 && gap <= arriveGap_cm) r.arrive_s = t * 1e-6;
+    }
+    return r;
+}
+
+// Before: cruise at 50 % past 30 cm, a straight line to 0 % at 10 cm (with the slope in float)
+SpeedLaw linearLaw() {
+    return [](const EchoSample &sample, int64_t) {
+        float d = sample.distance_cm;
+        if (sample.status == ECHO_PENDING || d > 30) return 50;
+        if (d < 10) return 0;
+        return static_cast<int>(50.0f / (30 - 10) * (d - 10));
+    };
+}
+
+SpeedLaw governorLaw(RangeTracker &tracker, SpeedGovernor &governor) {
+    tracker.setup();
+    governor.setup();
+    return [&tracker, &governor](const EchoSample &sample, int64_t now_us) {
+        tracker.update(sample);
+        return governor.update(tracker.at(now_us));
+    };
+}
+
+void standing_obstacle_test() {
+    RangeTracker tracker;
+    SpeedGovernor governor;
+    const Scenario wall = {300, 0, 0};
+    RunResult before = drive(wall, linearLaw(), 15, 30);
+    RunResult after = drive(wall, governorLaw(tracker, governor), 15, 30);
+    printf("  standing: linear %.2f s, governor %.2f s to 15 cm; gaps %.1f / %.1f cm\n", before.arrive_s,
+           after.arrive_s, before.minGap_cm, after.minGap_cm);
+    CHECK(after.arrive_s > 0 && after.arrive_s < before.arrive_s * 0.8);     // Faster down the open aisle
+    CHECK(after.maxSpeed_cm_s > 30);
+    CHECK(after.minGap_cm > 9 && after.minGap_cm < 12);                      // And stopped at the gap
+    CHECK(governor.limiting());
+}
+
+void oncoming_obstacle_test() {
+    RangeTracker tracker;
+    SpeedGovernor governor;
+    const Scenario cart = {350, 25, 40};        // A cart pushed towards the AGV, stopping 40 cm short
+    RunResult before = drive(cart, linearLaw(), 12, 15);
+    RunResult after = drive(cart, governorLaw(tracker, governor), 12, 15);
+    printf("  oncoming: minimum time to collision linear %.2f s, governor %.2f s; gaps %.1f / %.1f cm\n",
+           before.minTtc_s, after.minTtc_s, before.minGap_cm, after.minGap_cm);
+    CHECK(after.minTtc_s > 0.8);                        // 1 s asked, less the filter lag
+    CHECK(after.minTtc_s > before.minTtc_s * 1.25);
+    CHECK(after.minGap_cm > 9);
+    CHECK(before.minGap_cm < after.minGap_cm);
+}
+
+void appearing_obstacle_test() {
+    // Nothing ahead, then something steps in at 120 cm while driving at full duty
+    RangeTracker tracker;
+    SpeedGovernor governor;
+    SpeedLaw law = governorLaw(tracker, governor);
+    SpeedLaw stepIn = [&law](const EchoSample &sample, int64_t now_us) {
+        EchoSample seen = sample;
+        if (now_us < 3000000) seen = {ECHO_OUT_OF_RANGE, 651.8f, sample.timestamp_us, 0};
+        return law(seen, now_us);
+    };
+    const Scenario person = {120 + 0.4 * 80 * 3, 0, 0};    // 120 cm ahead after 3 s at full duty
+    RunResult r = drive(person, stepIn, 12, 10);
+    CHECK(r.minGap_cm > 9);
+    CHECK(tracker.restarts() == 1);
+}
+
+void sound_speed_test() {
+    CHECK_NEAR(EchoRanger::soundSpeed_m_s(20), 343.2, 0.2);
+    CHECK_NEAR(EchoRanger::soundSpeed_m_s(0), 331.3, 0.01);
+    CHECK_NEAR(EchoRanger::soundSpeed_m_s(35) - EchoRanger::soundSpeed_m_s(15), 11.9, 0.3);
+}
+
+int main() {
+    RUN_TEST(tracker_test);
+    RUN_TEST(standing_obstacle_test);
+    RUN_TEST(oncoming_obstacle_test);
+    RUN_TEST(appearing_obstacle_test);
+    RUN_TEST(sound_speed_test);
+    return hostTestFailures();
+}
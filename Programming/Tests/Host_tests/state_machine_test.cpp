@@ -0,0 +1,136 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: state_machine_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests the StateMachine transition table:
+ *   - Compile-time table queries and lookups
+ *   - Rejection of tables with duplicated (state, event) pairs or states
+ *     and events out of range
+ *   - Runtime dispatch, rejected events and guards
+ *   - Per-state timing and the transition hook
+ *   Built with ILLEGAL_TRANSITION or INVALID_TABLE defined it must fail to
+ *   compile.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <StateMachine.h>
+#include "HostTest.h"
+
+#include <cstring>
+
+enum doorStates {closed, open, locked, doorStateCount};
+enum doorEvents {push, pull, lock, unlock, doorEventCount};
+
+int64_t fakeNow = 0;
+int64_t fakeClock() { return fakeNow; }
+
+bool keyPresent = false;
+bool hasKey() { return keyPresent; }
+
+int alarms = 0;
+void ringAlarm() {
+    alarms++;
+    fakeNow += 5;                       // Action takes 5 us
+}
+
+int hookCalls = 0;
+int64_t lastStateTime = 0;
+void countHook(const TransitionTiming<doorStates, doorEvents> &t) {
+    hookCalls++;
+    lastStateTime = t.stateTime_us;
+}
+
+constexpr Transition<doorStates, doorEvents> doorTransitions[] = {
+    {closed, pull, open, nullptr, nullptr},
+    {open, push, closed, nullptr, nullptr},
+    {closed, lock, locked, nullptr, ringAlarm},
+    {locked, unlock, closed, hasKey, nullptr},
+};
+constexpr auto doorTable = makeTable<doorStateCount, doorEventCount>(doorTransitions);
+
+// Compile-time queries
+static_assert(doorTable.allows(closed, pull), "closed --pull--> open");
+static_assert(!doorTable.allows(open, lock), "cannot lock an open door");
+static_assert(nextState<doorTable, closed, lock>() == locked, "closed --lock--> locked");
+#ifdef ILLEGAL_TRANSITION
+static_assert(nextState<doorTable, open, lock>() == locked, "must not compile");
+#endif
+
+// Invalid tables
+constexpr Transition<doorStates, doorEvents> twiceTransitions[] = {
+    {closed, pull, open, nullptr, nullptr},
+    {open, push, closed, nullptr, nullptr},
+    {closed, pull, locked, nullptr, nullptr},       // closed --pull--> again
+};
+constexpr Transition<doorStates, doorEvents> stateRangeTransitions[] = {
+    {closed, pull, doorStateCount, nullptr, nullptr},
+};
+constexpr Transition<doorStates, doorEvents> eventRangeTransitions[] = {
+    {open, doorEventCount, closed, nullptr, nullptr},
+};
+static_assert(tableError<doorStateCount, doorEventCount>(doorTransitions) == nullptr, "door table is valid");
+static_assert(tableError<doorStateCount, doorEventCount>(twiceTransitions) != nullptr, "duplicate pair rejected");
+static_assert(tableError<doorStateCount, doorEventCount>(stateRangeTransitions) != nullptr, "target state rejected");
+static_assert(tableError<doorStateCount, doorEventCount>(eventRangeTransitions) != nullptr, "event rejected");
+static_assert(tableError<doorStateCount - 1, doorEventCount>(doorTransitions) != nullptr, "locked out of range");
+#ifdef INVALID_TABLE
+constexpr auto twiceTable = makeTable<doorStateCount, doorEventCount>(twiceTransitions);
+#endif
+
+void dispatch_test() {
+    StateMachine<doorTable> door(closed, nullptr, fakeClock);
+    CHECK(door.dispatch(pull));
+    CHECK(door.in(open));
+    CHECK(!door.dispatch(lock));        // Undefined: stays open
+    CHECK(door.in(open));
+    CHECK(door.rejections() == 1);
+    CHECK(door.dispatch(push));
+    CHECK(door.taken(closed, pull) == 1);
+    CHECK(door.taken(open, push) == 1);
+}
+
+void guard_test() {
+    StateMachine<doorTable> door(closed, nullptr, fakeClock);
+    alarms = 0;
+    CHECK(door.dispatch(lock));
+    CHECK(alarms == 1);
+    keyPresent = false;
+    CHECK(!door.dispatch(unlock));
+    CHECK(door.in(locked));
+    keyPresent = true;
+    CHECK(door.dispatch(unlock));
+    CHECK(door.in(closed));
+}
+
+void invalid_table_test() {
+    CHECK(strcmp(tableError<doorStateCount, doorEventCount>(twiceTransitions), "duplicate (state, event) transition") == 0);
+    CHECK(strcmp(tableError<doorStateCount, doorEventCount>(stateRangeTransitions), "state out of range") == 0);
+    CHECK(strcmp(tableError<doorStateCount, doorEventCount>(eventRangeTransitions), "event out of range") == 0);
+}
+
+void timing_test() {
+    fakeNow = 1000;
+    hookCalls = 0;
+    StateMachine<doorTable> door(closed, countHook, fakeClock);
+    fakeNow += 300;
+    door.dispatch(lock);                // 300 us closed, 5 us alarm action
+    CHECK(hookCalls == 1);
+    CHECK(lastStateTime == 300);
+    fakeNow += 40;
+    keyPresent = true;
+    door.dispatch(unlock);
+    CHECK(lastStateTime == 40);         // Action time not charged to the next state
+    CHECK(door.timeIn(closed) == 300);
+    CHECK(door.timeIn(locked) == 40);
+}
+
+int main() {
+    RUN_TEST(dispatch_test);
+    RUN_TEST(guard_test);
+    RUN_TEST(invalid_table_test);
+    RUN_TEST(timing_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,149 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: stepper_profile_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests StepProfile ramp tables and moves driven by a one-shot timer,
+ *   the way the Scissor Lift callbacks use it:
+ *   - Trapezoid and S-curve tables (length, start and cruise intervals)
+ *   - Fixed moves: exact step count, symmetric ramps, predicted time
+ *   - Short moves that never reach cruise, and stop() from cruise
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <SimpleGPIO.h>
+#include <SimpleTimer.h>
+#include <StepperProfile.h>
+#include "HostTest.h"
+
+#include <algorithm>
+#include <vector>
+
+constexpr int kPulPin = 25;
+
+class StepWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Steps"; }
+    bool missionComplete() const override { return true; }
+
+    void pinWritten(int pin, int value) override {
+        if (pin == kPulPin && value == 1) stepTimes.push_back(hostsim::clock().now());
+    }
+
+    std::vector<int64_t> stepTimes;
+};
+
+SimpleGPIO pul;
+SimpleTimer stepTimer;
+StepProfile profile;
+int32_t stopAfter = -1;                         // Call stop() at this step, -1 = never
+
+void IRAM_ATTR stepCallback(void *arg) {
+    StepEdge edge = profile.nextEdge();
+    if (edge.delay_us == 0) return;
+    pul.set(edge.level);
+    if (edge.level == 1 && profile.stepsDone() == stopAfter) profile.stop();
+    stepTimer.startOnce(edge.delay_us);
+}
+
+// Runs a move to completion, returns the rising edge times
+std::vector<int64_t> runMove(int32_t steps) {
+    StepWorld world;
+    hostsim::install(world);
+    pul.setup(kPulPin, GPO);
+    stepTimer.setup(stepCallback, "steps");
+    profile.begin(steps);
+    stepCallback(nullptr);
+    while (profile.busy() && hostsim::clock().now() < 60000000) hostsim::clock().advance(1000);
+    return world.stepTimes;
+}
+
+const MotionProfile kTrapezoid = {200, 1000, 4000, PROFILE_TRAPEZOID};
+const MotionProfile kSCurve = {200, 1000, 4000, PROFILE_SCURVE};
+
+void trapezoid_table_test() {
+    CHECK(profile.build(kTrapezoid));
+    CHECK(profile.rampLength() == 120);                     // (1000^2 - 200^2) / (2 * 4000)
+    CHECK_NEAR(profile.rampInterval(0), 4772, 2);           // (sqrt(200^2 + 2 * 4000) - 200) / 4000 s
+    CHECK(profile.cruiseInterval() == 1000);
+    bool decreasing = true;
+    for (int i = 1; i < profile.rampLength(); i++) decreasing &= profile.rampInterval(i) <= profile.rampInterval(i - 1);
+    CHECK(decreasing);
+    CHECK_NEAR(profile.rampInterval(profile.rampLength() - 1), 1000, 10);
+}
+
+void scurve_table_test() {
+    CHECK(profile.build(kTrapezoid));
+    uint32_t trapezoidStart = profile.rampInterval(0);
+    CHECK(profile.build(kSCurve));
+    CHECK(profile.rampLength() == 180);                     // (200 + 1000) / 2 * 0.3 s
+    CHECK(profile.rampInterval(0) > trapezoidStart);        // Gentle start, no acceleration step
+    bool decreasing = true;
+    for (int i = 1; i < profile.rampLength(); i++) decreasing &= profile.rampInterval(i) <= profile.rampInterval(i - 1);
+    CHECK(decreasing);
+    // Smooth end: the last intervals change less than the middle ones
+    int mid = profile.rampLength() / 2, last = profile.rampLength() - 1;
+    CHECK(profile.rampInterval(last - 1) - profile.rampInterval(last) <
+          profile.rampInterval(mid - 1) - profile.rampInterval(mid));
+}
+
+void invalid_profile_test() {
+    CHECK(!profile.build({0, 1000, 4000, PROFILE_TRAPEZOID}));
+    CHECK(!profile.build({500, 100, 4000, PROFILE_TRAPEZOID}));
+    CHECK(!profile.build({200, 1000, 0, PROFILE_SCURVE}));
+}
+
+void fixed_move_test() {
+    const MotionProfile *shapes[] = {&kTrapezoid, &kSCurve};
+    for (const MotionProfile *shape : shapes) {
+        CHECK(profile.build(*shape));
+        stopAfter = -1;
+        std::vector<int64_t> steps = runMove(1000);
+        CHECK(steps.size() == 1000);
+        CHECK(!profile.busy());
+        CHECK_NEAR(steps.back() - steps.front(), profile.moveTime_us(1000), 2);
+        CHECK(steps[1] - steps[0] == steps[999] - steps[998]);       // Ramp down mirrors ramp up
+        int64_t shortest = INT64_MAX;
+        for (size_t i = 1; i < steps.size(); i++) shortest = std::min(shortest, steps[i] - steps[i - 1]);
+        CHECK(shortest >= 1000);                                     // Never above the cruise rate
+        CHECK(steps.back() - steps.front() < 7000000 / 4);           // Old constant 143 steps/s took 7 s
+    }
+}
+
+void short_move_test() {
+    CHECK(profile.build(kTrapezoid));
+    stopAfter = -1;
+    std::vector<int64_t> steps = runMove(20);                        // Far shorter than two ramps
+    CHECK(steps.size() == 20);
+    int64_t middle = steps[10] - steps[9];
+    CHECK(middle > 1000);                                            // Never reached cruise
+    CHECK(middle < steps[1] - steps[0]);
+    CHECK(runMove(1).size() == 1);
+    CHECK(runMove(0).empty());
+}
+
+void stop_test() {
+    CHECK(profile.build(kTrapezoid));
+    stopAfter = 400;                                                 // Well into cruise
+    std::vector<int64_t> steps = runMove(StepProfile::kContinuous);
+    CHECK(steps.size() == 400 + 120 + 1);                            // Ramp down as long as the ramp up
+    CHECK(steps[400] - steps[399] == 1000);
+    CHECK(steps.back() - steps[steps.size() - 2] == profile.rampInterval(0));
+    stopAfter = 30;                                                  // Still ramping up
+    steps = runMove(StepProfile::kContinuous);
+    CHECK(steps.size() == 30 + 30 + 1);
+    stopAfter = -1;
+}
+
+int main() {
+    RUN_TEST(trapezoid_table_test);
+    RUN_TEST(scurve_table_test);
+    RUN_TEST(invalid_profile_test);
+    RUN_TEST(fixed_move_test);
+    RUN_TEST(short_move_test);
+    RUN_TEST(stop_test);
+    return hostTestFailures();
+}
@@ -0,0 +1,207 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tests
+ * File: telemetry_log_test.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Tests TelemetryLog and TelemetryDecoder:
+ *   - Records come out in order and print with their catalogue format
+ *   - A full ring drops and counts, and the count reaches the stream
+ *   - Four threads logging against a draining reader lose nothing
+ *     silently and keep each writer's order
+ *   - The decoder finds records split across reads and mixed with console
+ *     text and noise, counts missing ones and unwraps the 32-bit time
+ *   - The drain task empties the ring on its own; flush() before exit
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <HostSim.h>
+#include <TelemetryDecoder.h>
+#include <TelemetryLog.h>
+#include "HostTest.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+class QuietWorld : public hostsim::World {
+public:
+    const char *name() const override { return "Telemetry"; }
+    bool missionComplete() const override { return true; }
+};
+
+std::vector<uint8_t> captured;
+
+void captureSink(const uint8_t *data, size_t length) {
+    captured.insert(captured.end(), data, data + length);
+}
+
+std::vector<TelemetryRecord> capturedRecords() {
+    std::vector<TelemetryRecord> records;
+    for (size_t i = 0; i + kTelemetryRecordBytes <= captured.size(); i += kTelemetryRecordBytes) {
+        TelemetryRecord rec;
+        if (telemetryParse(&captured[i], rec)) records.push_back(rec);
+    }
+    return records;
+}
+
+std::string decodeAll(TelemetryDecoder &decoder, const std::vector<uint8_t> &bytes) {
+    std::string text;
+    decoder.feed(bytes.data(), bytes.size(), text);
+    decoder.finish(text);
+    return text;
+}
+
+void order_and_format_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    captured.clear();
+    TelemetryLog log;
+    CHECK(log.setup(captureSink, 0));                  // No task, drained here
+    hostsim::clock().advance(1500);
+    CHECK(log.log(TLM_AGV_OBSTACLE, tlmFloat(25.0f), 37));
+    hostsim::clock().advance(10000);
+    CHECK(log.log(TLM_AGV_CLEAR, tlmFloat(31.5f)));
+    CHECK(log.log(TLM_COM_SENT, 2, 25));
+    CHECK(log.pending() == 3);
+    CHECK(log.drain() == 3);
+    CHECK(log.pending() == 0 && log.sent() == 3);
+    CHECK(captured.size() == 3 * kTelemetryRecordBytes);
+    std::vector<TelemetryRecord> records = capturedRecords();
+    CHECK(records.size() == 3);
+    CHECK(records[0].time_us == 1500 && records[1].time_us == 11500);
+    CHECK(records[0].seq == 0 && records[2].seq == 2);
+    TelemetryDecoder decoder;
+    std::string text = decodeAll(decoder, captured);
+    CHECK(text == "[     1.500 ms] obstacle: Obstacle detected! At 25.00 cm, speed 37 %\n"
+                  "[    11.500 ms] clear: No obstacle nearby! Distance is 31.50 cm\n"
+                  "[    11.500 ms] com_sent: Com frame sent: type 2, value 25\n");
+    CHECK(decoder.stats().records == 3 && decoder.stats().lost == 0);
+}
+
+void overflow_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    captured.clear();
+    TelemetryLog log;
+    CHECK(log.setup(captureSink, 0));
+    int accepted = 0;
+    for (uint32_t i = 0; i < TelemetryLog::kCapacity + 10; i++) accepted += log.log(TLM_LIFT_HEIGHT, i) ? 1 : 0;
+    CHECK(accepted == static_cast<int>(TelemetryLog::kCapacity));
+    CHECK(log.dropped() == 10);
+    CHECK(log.drain() == TelemetryLog::kCapacity + 1);  // The drop report first
+    std::vector<TelemetryRecord> records = capturedRecords();
+    CHECK(records.front().event == TLM_DROPPED && records.front().args[0] == 10);
+    CHECK(records.back().args[0] == static_cast<int32_t>(TelemetryLog::kCapacity - 1));   // The oldest are kept
+    CHECK(log.log(TLM_LIFT_HEIGHT, 1));                 // Room again
+    CHECK(log.drain() == 1);                            // No new drops, no new report
+    TelemetryDecoder decoder;
+    decodeAll(decoder, captured);
+    CHECK(decoder.stats().dropped == 10 && decoder.stats().lost == 0);
+    CHECK(decoder.stats().records == TelemetryLog::kCapacity + 2);
+}
+
+void concurrent_writers_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    captured.clear();
+    TelemetryLog log;
+    CHECK(log.setup(captureSink, 0));
+    constexpr int kWriters = 4;
+    constexpr int kPerWriter = 50000;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; w++) {
+        writers.emplace_back([w, &log, &finished]() {
+            for (int i = 0; i < kPerWriter; i++) log.log(TLM_COM_SENT, w, i);
+            finished++;
+        });
+    }
+    while (finished < kWriters) log.drain();           // Reading while they write
+    for (std::thread &t : writers) t.join();
+    log.drain();
+    int last[kWriters] = {-1, -1, -1, -1};
+    uint32_t received = 0;
+    bool ordered = true;
+    for (const TelemetryRecord &rec : capturedRecords()) {
+        if (rec.event != TLM_COM_SENT) continue;
+        ordered = ordered && rec.args[1] > last[rec.args[0]];
+        last[rec.args[0]] = rec.args[1];
+        received++;
+    }
+    CHECK(ordered);
+    CHECK(received + log.dropped() == kWriters * kPerWriter);
+    CHECK(log.pending() == 0);
+}
+
+void decoder_resync_test() {
+    std::vector<uint8_t> stream;
+    auto addText = [&stream](const char *text) { stream.insert(stream.end(), text, text + strlen(text)); };
+    auto addRecord = [&stream](TelemetryRecord rec) {
+        uint8_t bytes[kTelemetryRecordBytes];
+        telemetryEncode(rec, bytes);
+        stream.insert(stream.end(), bytes, bytes + kTelemetryRecordBytes);
+    };
+    addText("State 0 -> 1 after 1000 ms\r\n");
+    addRecord({0xFFFFFF00u, TLM_AGV_CLEAR, 7, {tlmFloat(40.0f), 0}});
+    addText("Load ");                                   // Console line cut by a record
+    addRecord({0xFFFFFFF0u, TLM_AGV_CLEAR, 8, {tlmFloat(41.0f), 0}});
+    addText("cell\n");
+    stream.push_back(kTelemetrySync);                   // Noise that starts like a record
+    stream.push_back(0xFF);
+    addRecord({0x00000010u, TLM_AGV_CLEAR, 10, {tlmFloat(42.0f), 0}});  // Time wrapped, seq 9 lost
+    std::vector<uint8_t> corrupt = stream;
+    // Every split point must give the same text
+    TelemetryDecoder whole;
+    std::string expected = decodeAll(whole, stream);
+    bool same = true;
+    for (size_t split = 1; split < stream.size(); split++) {
+        TelemetryDecoder decoder;
+        std::string text;
+        decoder.feed(stream.data(), split, text);
+        decoder.feed(stream.data() + split, stream.size() - split, text);
+        decoder.finish(text);
+        same = same && text == expected;
+    }
+    CHECK(same);
+    CHECK(whole.stats().records == 3 && whole.stats().lost == 1);
+    CHECK(whole.stats().textLines == 2 && whole.stats().skippedBytes == 2);
+    CHECK(expected.find("State 0 -> 1 after 1000 ms\n") == 0);
+    CHECK(expected.find("\nLoad cell\n") != std::string::npos);
+    CHECK(expected.find("[4294967.312 ms] clear: No obstacle nearby! Distance is 42.00 cm") != std::string::npos);
+    // A flipped bit fails the sum: the record is not printed
+    corrupt[28 + 9] ^= 0x04;
+    TelemetryDecoder flipped;
+    std::string text = decodeAll(flipped, corrupt);
+    CHECK(flipped.stats().records == 2);
+    CHECK(text.find("40.00") == std::string::npos);
+}
+
+void drain_task_test() {
+    QuietWorld world;
+    hostsim::install(world);
+    captured.clear();
+    static TelemetryLog log;                            // Outlives the test: the drain task keeps it
+    CHECK(log.setup(captureSink));                      // Drain task every 20 ms
+    for (int i = 0; i < 100; i++) {
+        log.log(TLM_AGV_CYCLE, tlmFloat(20.0f + i), i);
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    CHECK(log.sent() >= 80);                            // Drained along the way
+    log.log(TLM_AGV_CLEAR, tlmFloat(50.0f));
+    log.flush();
+    CHECK(log.pending() == 0 && log.sent() == 101);
+    CHECK(capturedRecords().size() == 101);
+}
+
+int main() {
+    RUN_TEST(order_and_format_test);
+    RUN_TEST(overflow_test);
+    RUN_TEST(concurrent_writers_test);
+    RUN_TEST(decoder_resync_test);
+    RUN_TEST(drain_task_test);
+    return hostTestFailures();
+}
@@ -36,13 +36,16 @@
 #include <cmath>                    //Math functions
 #include <algorithm>                //Process data
 #include <stdio.h>                  //Get in the terminal answers
+#include <PinMap.h>                 //Pin map checked by the compiler
+#include <esp_rom_gpio.h>           //Console RX detached from its pin
+#include <soc/gpio_sig_map.h>
 
 //GPIO PINS
-// Basket servomotor
+// Basket servomotor: on the console TX pin, the tests print nothing
 #define SERVOMOTOR_GPIO 1
 // Tilting stepper motor
-#define TILT_PUL_GPIO 35
-#define TILT_DIR_GPIO 34
+#define TILT_PUL_GPIO 32
+// Tilt direction: not wired, no output pin is left on the bench; the test runs the driver's default direction
 #define TILT_ENA_GPIO 25
 // Lifting stepper motor
 #define LIFT_PUL_GPIO 13
@@ -50,28 +53,70 @@
 #define LIFT_ENA_GPIO 14
 // Height sensor
 #define HEIGHT_SEN_GPIO 39
-#define TEST_HEIGHT_OUT_GPIO 25
+#define TEST_HEIGHT_OUT_GPIO 3     // Console RX pin, nothing is typed there; UART0 is detached from it first
 // Load cell
 #define LOAD_CELL_GPIO 36
 // LED
 #define LED_GPIO 33
 // LCD
 #define PIN_UNUSED 255
-//                      D4  D5  D6  D7  RS  RW          EN
-uint8_t lcd_pins[11] = {19, 21, 22, 23, 26, PIN_UNUSED, 27};
-// 19, 21, 22, 23, 25, PIN_UNUSED, 27
+#define LCD_D4_GPIO 19
+#define LCD_D5_GPIO 21
+#define LCD_D6_GPIO 22
+#define LCD_D7_GPIO 23
+#define LCD_RS_GPIO 26
+#define LCD_EN_GPIO 27
+//                      D4           D5           D6           D7           RS           RW          EN
+uint8_t lcd_pins[11] = {LCD_D4_GPIO, LCD_D5_GPIO, LCD_D6_GPIO, LCD_D7_GPIO, LCD_RS_GPIO, PIN_UNUSED, LCD_EN_GPIO};
 //  Keypad
-uint8_t keypad_rows[4] = {18, 5, 17, 16};
-uint8_t keypad_cols[4] = {4, 0, 2, 15};
+#define KEYPAD_ROW1_GPIO 18
+#define KEYPAD_ROW2_GPIO 5
+#define KEYPAD_ROW3_GPIO 17
+#define KEYPAD_ROW4_GPIO 16
+#define KEYPAD_COL1_GPIO 4
+#define KEYPAD_COL2_GPIO 0
+#define KEYPAD_COL3_GPIO 2
+#define KEYPAD_COL4_GPIO 15
+uint8_t keypad_rows[4] = {KEYPAD_ROW1_GPIO, KEYPAD_ROW2_GPIO, KEYPAD_ROW3_GPIO, KEYPAD_ROW4_GPIO};
+uint8_t keypad_cols[4] = {KEYPAD_COL1_GPIO, KEYPAD_COL2_GPIO, KEYPAD_COL3_GPIO, KEYPAD_COL4_GPIO};
 //  Communication sensor
-#define COMM_SENSOR_GPIO 32
+#define COMM_SENSOR_GPIO 35
+
+//Pin map: every pin above, the build stops on a pin used twice or beyond its pad (PinMap.h)
+constexpr PinSpec testPins[] = {
+    {SERVOMOTOR_GPIO, PIN_PWM, "Basket servomotor"},
+    {TILT_PUL_GPIO, PIN_OUTPUT, "Tilt pulse"},
+    {TILT_ENA_GPIO, PIN_OUTPUT, "Tilt enable"},
+    {LIFT_PUL_GPIO, PIN_OUTPUT, "Lift pulse"},
+    {LIFT_DIR_GPIO, PIN_OUTPUT, "Lift direction"},
+    {LIFT_ENA_GPIO, PIN_OUTPUT, "Lift enable"},
+    {HEIGHT_SEN_GPIO, PIN_INPUT, "Height sensor"},
+    {TEST_HEIGHT_OUT_GPIO, PIN_OUTPUT, "Test height output"},
+    {LOAD_CELL_GPIO, PIN_ADC, "Load cell"},
+    {LED_GPIO, PIN_OUTPUT, "LED"},
+    {LCD_D4_GPIO, PIN_OUTPUT, "LCD D4"},
+    {LCD_D5_GPIO, PIN_OUTPUT, "LCD D5"},
+    {LCD_D6_GPIO, PIN_OUTPUT, "LCD D6"},
+    {LCD_D7_GPIO, PIN_OUTPUT, "LCD D7"},
+    {LCD_RS_GPIO, PIN_OUTPUT, "LCD RS"},
+    {LCD_EN_GPIO, PIN_OUTPUT, "LCD EN"},
+    {KEYPAD_ROW1_GPIO, PIN_OUTPUT, "Keypad row 1"},
+    {KEYPAD_ROW2_GPIO, PIN_OUTPUT, "Keypad row 2"},
+    {KEYPAD_ROW3_GPIO, PIN_OUTPUT, "Keypad row 3"},
+    {KEYPAD_ROW4_GPIO, PIN_OUTPUT, "Keypad row 4"},
+    {KEYPAD_COL1_GPIO, PIN_INPUT_PULLUP, "Keypad column 1"},
+    {KEYPAD_COL2_GPIO, PIN_INPUT_PULLUP, "Keypad column 2"},
+    {KEYPAD_COL3_GPIO, PIN_INPUT_PULLUP, "Keypad column 3"},
+    {KEYPAD_COL4_GPIO, PIN_INPUT_PULLUP, "Keypad column 4"},
+    {COMM_SENSOR_GPIO, PIN_INPUT, "Communication sensor"},
+};
+static_assert(kPinMapChecked<testPins>);
 
 // SCISSOR LIFT OBJECTS
 //  Basket servomotor
 SimplePWM servoMotor;
 //  Tilting stepper motor
 SimpleGPIO tiltPul; //Pulse
-SimpleGPIO tiltDir; //Direction
 SimpleGPIO tiltEna; //Enable
 SimpleTimer tiltTimer;
 SimpleTimer tiltStopTimer;
@@ -154,6 +154,7 @@ bool lifting_motor_test() {
     // LCD Setup
     lcdDisplay.setup(lcd_pins);
     heightSensor.setup(HEIGHT_SEN_GPIO, GPI);           // GPIO pin, input mode, default pull
+    esp_rom_gpio_connect_in_signal(GPIO_FUNC_IN_HIGH, U0RXD_IN_IDX, false);   // UART0 stops reading the console RX pin
     testOutHeight.setup(TEST_HEIGHT_OUT_GPIO, GPIO); // GPIO pin, output, default pull
     // Lift Stepper Motor Setup
     liftPul.setup(LIFT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
@@ -201,9 +202,7 @@ bool tilting_motor_test() {
     lcdDisplay.setup(lcd_pins);
     // Tilt stepper motor setup
     tiltPul.setup(TILT_PUL_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltDir.setup(TILT_DIR_GPIO, GPO);                  // GPIO pin, output mode, default pull
     tiltEna.setup(TILT_ENA_GPIO, GPO);                  // GPIO pin, output mode, default pull
-    tiltDir.set(0);                                     // Direction for tilt motor
     tiltEna.set(1);                                     // tilt motor off
     // Timer setup
     tiltTimer.setup(tiltCallback, "tilt_timer");
@@ -0,0 +1,99 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tools
+ * File: fleet_sim.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Delivery throughput of a fleet of AGVs and scissor lifts (Fleet.h).
+ *   Usage: fleet_sim [--agvs n] [--lifts m] [--threads t] [--hours h] [--seed s]
+ *                    [--sweep] [--scaling]
+ *     --sweep    one line per fleet size, 1 to n AGVs on the m lifts
+ *     --scaling  the same fleet on 1, 2, 4 ... t threads; the results must match
+ *     e.g. ./build/fleet_sim --agvs 12 --lifts 2 --sweep
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <Fleet.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool sameResult(const FleetReport &a, const FleetReport &b) {
+    return a.deliveries == b.deliveries && a.delivered_kg == b.delivered_kg && a.queued == b.queued &&
+           a.queueMean_s == b.queueMean_s && a.queueMax_s == b.queueMax_s;
+}
+
+void printRow(const FleetReport &r) {
+    printf("%5d %6d %8d %10.1f %9.2f %9.2f %8.1f %8.1f %9.3f\n", r.config.agvs, r.config.lifts, r.config.threads,
+           r.deliveriesPerHour, r.queueMean_s, r.queueP95_s, (r.agvShare[agvToLift] + r.agvShare[agvToStation]) * 100,
+           (1.0 - r.liftShare[liftWaiting]) * 100, r.wall_s);
+}
+
+void printHeader() {
+    printf("%5s %6s %8s %10s %9s %9s %8s %8s %9s\n", "AGVs", "lifts", "threads", "per hour", "wait s", "p95 s",
+           "AGV %", "lift %", "wall s");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    FleetConfig config;
+    bool sweep = false, scaling = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--agvs") == 0 && i + 1 < argc) config.agvs = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--lifts") == 0 && i + 1 < argc) config.lifts = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) config.threads = std::max(0, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) config.hours = std::max(0.01, atof(argv[++i]));
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.seed = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--sweep") == 0) sweep = true;
+        else if (strcmp(argv[i], "--scaling") == 0) scaling = true;
+        else {
+            fprintf(stderr,
+                    "Usage: %s [--agvs n] [--lifts m] [--threads t] [--hours h] [--seed s] [--sweep] [--scaling]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (sweep) {
+        printHeader();
+        for (int agvs = 1; agvs <= config.agvs; agvs++) {
+            FleetConfig size = config;
+            size.agvs = agvs;
+            printRow(runFleet(size));
+        }
+        return 0;
+    }
+
+    if (scaling) {
+        int most = config.threads > 0 ? config.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        printHeader();
+        FleetConfig serial = config;
+        serial.threads = 1;
+        FleetReport base = runFleet(serial);
+        printRow(base);
+        bool same = true;
+        std::vector<int> counts;
+        for (int threads = 2; threads < most; threads *= 2) counts.push_back(threads);
+        if (most > 1) counts.push_back(most);
+        for (int threads : counts) {
+            FleetConfig parallel = config;
+            parallel.threads = threads;
+            FleetReport r = runFleet(parallel);
+            printRow(r);
+            printf("%52s speed-up %.2fx\n", "", r.wall_s > 0 ? base.wall_s / r.wall_s : 0.0);
+            same = same && sameResult(base, r);
+        }
+        if (!same) printf("Results differ between thread counts\n");
+        return same ? 0 : 1;
+    }
+
+    runFleet(config).print(stdout);
+    return 0;
+}
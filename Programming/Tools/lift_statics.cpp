@@ -0,0 +1,160 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tools
+ * File: lift_statics.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Static forces of the scissor lift (lib/LiftStatics) and the load and
+ *   height tables compiled into the lift firmware.
+ *   Usage: lift_statics [--height mm] [--load kg]    forces of one case
+ *          lift_statics --sweep                      safe load per height
+ *          lift_statics --header <file>              write LiftLoadLimits.h
+ *          lift_statics --height-header <file>       write LiftStepHeights.h
+ *     e.g. ./build/lift_statics --header lib/LiftStatics/LiftLoadLimits.h
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LiftStatics.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr unsigned kHeightStride_steps = 4;     // Lift steps between height rows
+
+const char *const kUnknownNames[kLiftUnknowns] = {"Ax", "Ay", "By", "Cx", "Cy", "Dx", "Dy", "Ex", "Ey",
+                                                 "Fx", "Fy", "Gx", "Gy", "Hy", "thrust", "ground x",
+                                                 "ground A", "ground B"};
+
+void printCase(const LiftStatics &statics, double height_mm, double load_kg) {
+    LiftForces f;
+    if (!statics.solve(height_mm / 1000, load_kg, f)) {
+        fprintf(stderr, "No solution at %.1f mm\n", height_mm);
+        return;
+    }
+    printf("Height %.1f mm (links at %.2f deg), load %.2f kg\n\n", height_mm,
+           statics.angleFor(height_mm / 1000) * 180 / 3.14159265358979323846, load_kg);
+    for (int i = 0; i < kLiftUnknowns; i++) printf("%-10s %10.3f N\n", kUnknownNames[i], f.x[i]);
+    printf("\nPin resultants:");
+    for (int j = 0; j < kLiftJoints; j++) printf(" %c %.1f N%s", 'A' + j, f.pin(j), j + 1 < kLiftJoints ? "," : "\n");
+}
+
+bool computeLimits(const LiftStatics &statics, const LiftRatings &ratings, LiftLoadLimits &limits) {
+    auto start = std::chrono::steady_clock::now();
+    if (!statics.loadLimits(ratings, limits)) {
+        fprintf(stderr, "Sweep failed\n");
+        return false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "Swept %zu cases in %.1f ms\n", limits.cases, seconds * 1000);
+    return true;
+}
+
+bool writeHeader(const char *path, const LiftStatics &statics, const LiftRatings &ratings,
+                 const LiftLoadLimits &limits) {
+    FILE *out = fopen(path, "w");
+    if (out == nullptr) return false;
+    const ScissorGeometry &g = statics.geometry();
+    fprintf(out, "/*\n");
+    fprintf(out, " * Project: AGV and Scissor Lift Control - Scissor Lift Statics\n");
+    fprintf(out, " * File: LiftLoadLimits.h\n");
+    fprintf(out, " * Author: Oscar Gadiel Ramo Martínez\n");
+    fprintf(out, " * Description:\n");
+    fprintf(out, " *   Generated by lift_statics --header from the statics sweep, do not edit.\n");
+    fprintf(out, " *   Links %.1f mm, platform %.1f mm, base %.1f mm, %.0f to %.0f deg;\n", g.link_m * 1000,
+            g.platform_m * 1000, g.base_m * 1000, g.minAngle_deg, g.maxAngle_deg);
+    fprintf(out, " *   pins %.0f N, lead screw %.0f N.\n", ratings.pin_N, ratings.thrust_N);
+    fprintf(out, " *\n * Date: October 2026\n * License: MIT (see LICENSE file in repository)\n */\n\n");
+    fprintf(out, "#ifndef _LIFT_LOAD_LIMITS_H_\n#define _LIFT_LOAD_LIMITS_H_\n\n#include \"LiftLoadTable.h\"\n\n");
+    fprintf(out, "// Safe load (0.1 kg) per %u mm of platform height from %u mm\n", limits.step_mm,
+            limits.minHeight_mm);
+    fprintf(out, "const uint16_t liftLoadLimits_hg[%zu] = {", limits.limit_hg.size());
+    for (size_t i = 0; i < limits.limit_hg.size(); i++) {
+        fprintf(out, "%s%u,", i % 12 == 0 ? "\n    " : " ", limits.limit_hg[i]);
+    }
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "const LiftLoadTable liftLoadTable = {%u, %u, %zu, liftLoadLimits_hg};\n\n", limits.minHeight_mm,
+            limits.step_mm, limits.limit_hg.size());
+    fprintf(out, "#endif // _LIFT_LOAD_LIMITS_H_\n");
+    return fclose(out) == 0;
+}
+
+bool writeHeightHeader(const char *path, const LiftStatics &statics, const LiftStepHeights &heights) {
+    FILE *out = fopen(path, "w");
+    if (out == nullptr) return false;
+    const ScissorGeometry &g = statics.geometry();
+    fprintf(out, "/*\n");
+    fprintf(out, " * Project: AGV and Scissor Lift Control - Scissor Lift Statics\n");
+    fprintf(out, " * File: LiftStepHeights.h\n");
+    fprintf(out, " * Author: Oscar Gadiel Ramo Martínez\n");
+    fprintf(out, " * Description:\n");
+    fprintf(out, " *   Generated by lift_statics --height-header from the geometry, do not edit.\n");
+    fprintf(out, " *   Links %.1f mm, %.0f to %.0f deg, %.3f mm of screw travel per step.\n", g.link_m * 1000,
+            g.minAngle_deg, g.maxAngle_deg, g.screwStep_m * 1000);
+    fprintf(out, " *\n * Date: October 2026\n * License: MIT (see LICENSE file in repository)\n */\n\n");
+    fprintf(out, "#ifndef _LIFT_STEP_HEIGHTS_H_\n#define _LIFT_STEP_HEIGHTS_H_\n\n#include \"LiftHeightTable.h\"\n\n");
+    fprintf(out, "// Platform height (0.1 mm) every %u lift steps from rest\n", heights.stride_steps);
+    fprintf(out, "const uint16_t liftStepHeights_dmm[%zu] = {", heights.height_dmm.size());
+    for (size_t i = 0; i < heights.height_dmm.size(); i++) {
+        fprintf(out, "%s%u,", i % 12 == 0 ? "\n    " : " ", heights.height_dmm[i]);
+    }
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "const LiftHeightTable liftHeightTable = {%u, %zu, liftStepHeights_dmm};\n\n", heights.stride_steps,
+            heights.height_dmm.size());
+    fprintf(out, "#endif // _LIFT_STEP_HEIGHTS_H_\n");
+    return fclose(out) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    double height_mm = -1, load_kg = 5;
+    const char *headerPath = nullptr, *heightPath = nullptr;
+    bool sweep = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--height") == 0 && i + 1 < argc) height_mm = atof(argv[++i]);
+        else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) load_kg = atof(argv[++i]);
+        else if (strcmp(argv[i], "--header") == 0 && i + 1 < argc) headerPath = argv[++i];
+        else if (strcmp(argv[i], "--height-header") == 0 && i + 1 < argc) heightPath = argv[++i];
+        else if (strcmp(argv[i], "--sweep") == 0) sweep = true;
+        else {
+            fprintf(stderr, "Usage: %s [--height mm] [--load kg] [--sweep] [--header file] [--height-header file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    LiftStatics statics;
+    LiftRatings ratings;
+    if (heightPath != nullptr) {
+        LiftStepHeights heights;
+        statics.stepHeights(kHeightStride_steps, heights);
+        if (!writeHeightHeader(heightPath, statics, heights)) {
+            fprintf(stderr, "Cannot write %s\n", heightPath);
+            return 1;
+        }
+        if (!sweep && headerPath == nullptr) return 0;
+    }
+    if (!sweep && headerPath == nullptr) {
+        printCase(statics, height_mm > 0 ? height_mm : statics.maxHeight_m() * 1000, load_kg);
+        return 0;
+    }
+    LiftLoadLimits limits;
+    if (!computeLimits(statics, ratings, limits)) return 1;
+    if (sweep) {
+        printf("%8s %10s\n", "from mm", "limit kg");
+        for (size_t i = 0; i < limits.limit_hg.size(); i++) {
+            printf("%8u %10.1f\n", limits.minHeight_mm + static_cast<unsigned>(i) * limits.step_mm,
+                   limits.limit_hg[i] / 10.0);
+        }
+    }
+    if (headerPath != nullptr && !writeHeader(headerPath, statics, ratings, limits)) {
+        fprintf(stderr, "Cannot write %s\n", headerPath);
+        return 1;
+    }
+    return 0;
+}
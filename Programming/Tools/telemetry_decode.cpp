@@ -0,0 +1,44 @@
+/*
+ * Project: AGV and Scissor Lift Control - Host Tools
+ * File: telemetry_decode.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Prints a captured telemetry stream (TelemetryLog records, possibly
+ *   mixed with console text) as text, one line per record or text line,
+ *   and a summary of lost records on stderr.
+ *   Usage: telemetry_decode [capture file]     (stdin without one)
+ *     e.g. ./build/agv_sim --uart1 agv.tlm && ./build/telemetry_decode agv.tlm
+ *          cat /dev/ttyUSB1 | ./build/telemetry_decode
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <TelemetryDecoder.h>
+
+#include <cstdio>
+
+int main(int argc, char **argv) {
+    FILE *in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+    if (in == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+    TelemetryDecoder decoder;
+    std::string text;
+    uint8_t chunk[4096];
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        decoder.feed(chunk, length, text);
+        fputs(text.c_str(), stdout);
+        fflush(stdout);                                 // Live when reading a serial port
+        text.clear();
+    }
+    decoder.finish(text);
+    fputs(text.c_str(), stdout);
+    if (in != stdin) fclose(in);
+    const TelemetryDecodeStats &stats = decoder.stats();
+    fprintf(stderr, "%u records, %u text lines, %u lost on the way, %u dropped by the ring, %u bytes skipped\n",
+            stats.records, stats.textLines, stats.lost, stats.dropped, stats.skippedBytes);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Project: AGV and Scissor Lift Control - Actuator Job Scheduler
+ * File: ActuatorScheduler.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Job admission, polling loop and timing of ActuatorScheduler.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include "ActuatorScheduler.h"
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cstdio>
+
+int ActuatorScheduler::add(const ActuatorJob &job) {
+    if (count == kMaxJobs || job.start == nullptr || job.poll == nullptr) return kNoJob;
+    if ((job.after >> count) != 0) return kNoJob;       // Only earlier jobs, so there is no cycle
+    list[count] = job;
+    state[count] = JOB_WAITING;
+    times[count] = JobTiming();
+    return count++;
+}
+
+// INTERLOCKS
+bool ActuatorScheduler::startable(int job) const {
+    for (int j = 0; j < count; j++) {
+        if ((list[job].after >> j & 1) != 0 && state[j] != JOB_DONE) return false;
+        if (state[j] == JOB_RUNNING && (list[j].resources & list[job].resources) != 0) return false;
+    }
+    return list[job].ready == nullptr || list[job].ready();
+}
+
+// LOOP
+bool ActuatorScheduler::run(uint32_t poll_ms, uint32_t timeout_ms) {
+    int64_t deadline = esp_timer_get_time() + static_cast<int64_t>(timeout_ms) * 1000;
+    failed = kNoJob;
+    int finished = 0;
+    while (finished < count && failed == kNoJob) {
+        for (int j = 0; j < count && failed == kNoJob; j++) {
+            if (state[j] == JOB_RUNNING) {
+                JobStatus now = list[j].poll();
+                if (now == JOB_RUNNING) continue;
+                state[j] = now;
+                times[j].end_us = esp_timer_get_time();
+                if (now == JOB_FAILED) failed = j;
+                else finished++;
+            }
+            if (state[j] == JOB_WAITING && startable(j)) {
+                times[j].start_us = esp_timer_get_time();
+                state[j] = list[j].start() ? JOB_RUNNING : JOB_FAILED;
+                if (state[j] == JOB_FAILED) {
+                    times[j].end_us = times[j].start_us;
+                    failed = j;
+                }
+            }
+        }
+        if (finished == count || failed != kNoJob) break;
+        if (esp_timer_get_time() >= deadline) {
+            for (int j = 0; j < count && failed == kNoJob; j++) {
+                if (state[j] != JOB_DONE) failed = j;    // Blame the first unfinished one
+            }
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(poll_ms));
+    }
+    if (failed == kNoJob) return true;
+    for (int j = 0; j < count; j++) {
+        if (state[j] == JOB_RUNNING && list[j].abort != nullptr) list[j].abort();
+    }
+    return false;
+}
+
+// TIMING
+int64_t ActuatorScheduler::makespan_us() const {
+    int64_t first = -1, last = -1;
+    for (int j = 0; j < count; j++) {
+        if (times[j].start_us >= 0 && (first < 0 || times[j].start_us < first)) first = times[j].start_us;
+        if (times[j].end_us > last) last = times[j].end_us;
+    }
+    return first < 0 || last < 0 ? 0 : last - first;
+}
+
+int64_t ActuatorScheduler::serial_us() const {
+    int64_t sum = 0;
+    for (int j = 0; j < count; j++) {
+        if (times[j].start_us >= 0 && times[j].end_us >= 0) sum += times[j].end_us - times[j].start_us;
+    }
+    return sum;
+}
+
+void ActuatorScheduler::print() const {
+    static const char *const statusNames[] = {"waiting", "running", "done", "failed"};
+    int64_t first = times[0].start_us;
+    for (int j = 1; j < count; j++) {
+        if (times[j].start_us >= 0 && (first < 0 || times[j].start_us < first)) first = times[j].start_us;
+    }
+    for (int j = 0; j < count; j++) {
+        printf("Job %-8s %-7s %6lld to %6lld ms\n", list[j].name, statusNames[state[j]],
+               static_cast<long long>(times[j].start_us < 0 ? 0 : (times[j].start_us - first) / 1000),
+               static_cast<long long>(times[j].end_us < 0 ? 0 : (times[j].end_us - first) / 1000));
+    }
+    printf("Jobs took %lld ms, %lld ms one after another\n", static_cast<long long>(makespan_us() / 1000),
+           static_cast<long long>(serial_us() / 1000));
+}
@@ -0,0 +1,74 @@
+/*
+ * Project: AGV and Scissor Lift Control - Actuator Job Scheduler
+ * File: ActuatorScheduler.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Runs several actuator motions at once, each as a job that:
+ *     - Declares the actuators it drives (resources): two jobs sharing
+ *       one never run together
+ *     - Declares the jobs that must be finished before it (after) and a
+ *       safety precondition read from the machine itself (ready), e.g.
+ *       "the platform is above the tilt clearance"
+ *     - Starts without blocking and is polled until done or failed
+ *   run() polls every job from one task and starts each one as soon as
+ *   all three allow it, so compatible motions overlap instead of running
+ *   one after another. Every start is checked against the declared
+ *   interlocks; a job that fails aborts the ones still running.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _ACTUATOR_SCHEDULER_H_
+#define _ACTUATOR_SCHEDULER_H_
+
+#include <cstdint>
+
+enum JobStatus : uint8_t { JOB_WAITING, JOB_RUNNING, JOB_DONE, JOB_FAILED };
+
+struct ActuatorJob {
+    const char *name;
+    uint32_t resources;                 // One bit per actuator driven
+    uint32_t after;                     // One bit per job index that must be done first
+    bool (*ready)();                    // Safety precondition to start, nullptr = none
+    bool (*start)();                    // Begins the motion without blocking, false = fault
+    JobStatus (*poll)();                // JOB_RUNNING until JOB_DONE or JOB_FAILED
+    void (*abort)();                    // Stops the motion when another job fails, nullptr = none
+};
+
+struct JobTiming {
+    int64_t start_us = -1;
+    int64_t end_us = -1;
+};
+
+class ActuatorScheduler {
+public:
+    static constexpr int kMaxJobs = 8;
+    static constexpr int kNoJob = -1;
+
+    // Job index for the after masks, kNoJob when full or the job waits on itself or a later job
+    int add(const ActuatorJob &job);
+
+    // Polls every poll_ms until all jobs are done; false when one fails or timeout_ms passes
+    bool run(uint32_t poll_ms, uint32_t timeout_ms);
+
+    int jobs() const { return count; }
+    JobStatus status(int job) const { return state[job]; }
+    const JobTiming &timing(int job) const { return times[job]; }
+    int failedJob() const { return failed; }
+    // First start to last end, and the same jobs back to back
+    int64_t makespan_us() const;
+    int64_t serial_us() const;
+    void print() const;
+
+private:
+    bool startable(int job) const;
+
+    ActuatorJob list[kMaxJobs] = {};
+    JobStatus state[kMaxJobs] = {};
+    JobTiming times[kMaxJobs];
+    int count = 0;
+    int failed = kNoJob;
+};
+
+#endif // _ACTUATOR_SCHEDULER_H_
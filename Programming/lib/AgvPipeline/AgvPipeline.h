@@ -0,0 +1,50 @@
+/*
+ * Project: AGV and Scissor Lift Control - AGV Sensing/Control Pipeline
+ * File: AgvPipeline.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Types shared by the AGV sensing task, the control loop and the host
+ *   pipeline benchmark:
+ *     - AgvSnapshot: one time-stamped reading of every AGV sensor
+ *     - LatencyStats: sensor-to-PWM latency accumulator
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _AGV_PIPELINE_H_
+#define _AGV_PIPELINE_H_
+
+#include <TripleBuffer.h>
+#include <cstdint>
+
+// Core assignment: app_main (and the control loop) stays on core 0
+#define AGV_CONTROL_CORE 0
+#define AGV_SENSING_CORE 1
+
+struct AgvSnapshot {
+    int lineLeft;               // Line follower 1
+    int lineRight;              // Line follower 2
+    int button;                 // golpeAvisa switch
+    float distance;             // cm, -1 if no valid ranging sample
+    float range_cm;             // Tracked distance ahead at timestamp_us, -1 if nothing tracked
+    float closing_cm_s;         // Tracked closing speed, positive when getting closer
+    int64_t timestamp_us;       // When the sensors were read
+    uint32_t seq;               // Increments with every snapshot
+};
+
+struct LatencyStats {
+    int64_t count = 0;
+    int64_t sum_us = 0;
+    int64_t max_us = 0;
+
+    void add(int64_t latency_us) {
+        count++;
+        sum_us += latency_us;
+        if (latency_us > max_us) max_us = latency_us;
+    }
+    int64_t average_us() const { return count > 0 ? sum_us / count : 0; }
+    void reset() { *this = LatencyStats(); }
+};
+
+#endif // _AGV_PIPELINE_H_
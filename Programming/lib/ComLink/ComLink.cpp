@@ -0,0 +1,286 @@
+/*
+ * Project: AGV and Scissor Lift Control - AGV/Lift Communication Link
+ * File: ComLink.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Frame codec, Manchester decoder, timer-driven transmitter and
+ *   edge-ISR receiver of the communication link.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <ComLink.h>
+#include <SensorTrace.h>
+#include <algorithm>
+
+// CODEC
+int comPayloadLength(ComMessageType type) {
+    switch (type) {
+        case COM_COUPLED:
+        case COM_ARRIVED:
+        case COM_ABORT:
+            return 0;
+        case COM_OBSTACLE:
+        case COM_WEIGHT:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+int comEncode(const ComMessage &msg, uint8_t *frame) {
+    int length = comPayloadLength(msg.type);
+    if (length < 0) return 0;
+    frame[0] = kComPreamble;
+    frame[1] = kComStart;
+    frame[2] = static_cast<uint8_t>(msg.type << 4 | length);
+    if (length == 2) {
+        frame[3] = static_cast<uint8_t>(msg.value >> 8);
+        frame[4] = static_cast<uint8_t>(msg.value);
+    }
+    frame[3 + length] = comCrc8(frame + 2, 1 + length);
+    return 4 + length;
+}
+
+uint8_t comCrc8(const uint8_t *data, int length) {
+    uint8_t crc = 0;
+    for (int i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? static_cast<uint8_t>(crc << 1 ^ 0x07) : static_cast<uint8_t>(crc << 1);
+    }
+    return crc;
+}
+
+const char *comTypeName(ComMessageType type) {
+    switch (type) {
+        case COM_COUPLED: return "coupled";
+        case COM_OBSTACLE: return "obstacle";
+        case COM_ARRIVED: return "arrived";
+        case COM_ABORT: return "abort";
+        case COM_WEIGHT: return "weight";
+        default: return "unknown";
+    }
+}
+
+// DECODER
+void ComDecoder::setBitPeriod(uint32_t bitPeriod_us) {
+    half_us = bitPeriod_us / 2 > 0 ? bitPeriod_us / 2 : 1;
+    reset();
+}
+
+void ComDecoder::reset() {
+    phase = HUNT;
+    atBoundary = false;
+    shift = 0;
+    bits = bytes = length = 0;
+}
+
+void ComDecoder::lose() {
+    if (phase == BODY) counters.framingErrors++;
+    reset();
+}
+
+bool ComDecoder::edge(int64_t time_us, int level, ComMessage &out) {
+    int64_t dt = time_us - lastEdge_us;
+    lastEdge_us = time_us;
+    // Interval in half-bits, rounded: off by under half a half-bit still counts
+    int halves = dt < half_us / 2 ? 0 : dt < half_us * 3 / 2 ? 1 : dt < half_us * 5 / 2 ? 2 : 3;
+    if (phase == HUNT) {
+        if (halves != 2) return false;          // Only mid-bit edges are a full bit apart
+        phase = SYNC;
+    }
+    else if (atBoundary) {
+        if (halves != 1) {
+            lose();
+            return false;
+        }
+        atBoundary = false;
+    }
+    else if (halves == 1) {
+        atBoundary = true;                      // Two equal bits, mid-bit edge follows
+        return false;
+    }
+    else if (halves != 2) {
+        lose();
+        return false;
+    }
+    return bit(level, time_us, out);            // Level after a mid-bit edge is the bit
+}
+
+bool ComDecoder::bit(int value, int64_t time_us, ComMessage &out) {
+    shift = static_cast<uint8_t>(shift << 1 | (value ? 1 : 0));
+    if (phase == SYNC) {
+        if (shift == kComStart) {
+            phase = BODY;
+            bits = bytes = 0;
+        }
+        return false;
+    }
+    if (++bits < 8) return false;
+    bits = 0;
+    frame[bytes++] = shift;
+    if (bytes == 1) {
+        length = comPayloadLength(static_cast<ComMessageType>(shift >> 4));
+        if (length < 0 || (shift & 0x0F) != length) {
+            lose();                             // Unknown type or wrong length for it
+            return false;
+        }
+    }
+    if (bytes < length + 2) return false;
+    bool good = comCrc8(frame, bytes - 1) == frame[bytes - 1];
+    ComMessageType type = static_cast<ComMessageType>(frame[0] >> 4);
+    uint16_t payload = length == 2 ? static_cast<uint16_t>(frame[1] << 8 | frame[2]) : 0;
+    reset();
+    if (!good) {
+        counters.crcErrors++;
+        return false;
+    }
+    counters.frames++;
+    out = {type, payload, time_us};
+    return true;
+}
+
+// TRANSMITTER
+bool ComTransmitter::setup(SimpleGPIO &pin, uint32_t bitPeriod_us) {
+    this->pin = &pin;
+    half_us = bitPeriod_us / 2 > 0 ? bitPeriod_us / 2 : 1;
+    pin.set(0);                                 // Idle low
+    esp_timer_create_args_t args = {halfBitCallback, this, ESP_TIMER_TASK, "com_tx", true};
+    return esp_timer_create(&args, &timer) == ESP_OK;
+}
+
+bool ComTransmitter::send(const ComMessage &msg) {
+    if (comPayloadLength(msg.type) < 0 || !queue.push(msg)) return false;
+    if (!active.exchange(true, std::memory_order_acq_rel)) {   // Wire idle: this task starts the timer
+        loadNext();
+        esp_timer_start_periodic(timer, half_us);
+    }
+    return true;
+}
+
+// Only the owner of 'active' pops the queue
+bool ComTransmitter::loadNext() {
+    ComMessage msg;
+    if (!queue.pop(msg)) return false;
+    halves = comEncode(msg, frame) * 16;
+    index = 0;
+    return true;
+}
+
+void IRAM_ATTR ComTransmitter::halfBitCallback(void *arg) {
+    static_cast<ComTransmitter *>(arg)->nextHalfBit();
+}
+
+void IRAM_ATTR ComTransmitter::nextHalfBit() {
+    if (index < halves) {
+        pin->set(comHalfLevel(frame, index++));
+        return;
+    }
+    if (index++ == halves) {
+        pin->set(0);                            // Back to idle
+        sentFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (index < halves + 2 * kComGapBits) return;
+    if (loadNext()) return;
+    // Queue empty: release the wire, then take it back if send() queued a frame meanwhile
+    esp_timer_stop(timer);
+    active.store(false, std::memory_order_release);
+    if (!queue.empty() && !active.exchange(true, std::memory_order_acq_rel)) {
+        loadNext();
+        esp_timer_start_periodic(timer, half_us);
+    }
+}
+
+// RECEIVER
+bool ComReceiver::setup(int gpio, uint32_t bitPeriod_us) {
+    this->gpio = gpio;
+    decoder.setBitPeriod(bitPeriod_us);
+    line.store(esp_timer_get_time() * 2 + sensorTraceLevel(gpio), std::memory_order_release);
+    if (gpio_set_intr_type((gpio_num_t)gpio, GPIO_INTR_ANYEDGE) != ESP_OK) return false;
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) return false;   // Already installed is fine
+    return gpio_isr_handler_add((gpio_num_t)gpio, edgeIsr, this) == ESP_OK;
+}
+
+bool ComReceiver::receive(ComMessage &msg) {
+    return messages.pop(msg);
+}
+
+bool ComReceiver::waitMessage(ComMessage &msg, uint32_t timeout_ms) {
+    int64_t deadline = esp_timer_get_time() + static_cast<int64_t>(timeout_ms) * 1000;
+    waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    bool got;
+    while (!(got = messages.pop(msg)) && esp_timer_get_time() < deadline) sleepUntil(deadline);
+    waiter.store(nullptr, std::memory_order_release);
+    return got;
+}
+
+int ComReceiver::waitFor(const ComPattern *patterns, int count, uint32_t timeout_ms, ComMessage &msg) {
+    int64_t start = esp_timer_get_time();
+    int64_t deadline = start + static_cast<int64_t>(timeout_ms) * 1000;
+    waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    int match = kComTimeout;
+    while (match == kComTimeout) {
+        ComMessage frame;
+        while (match == kComTimeout && messages.pop(frame)) {
+            for (int i = 0; i < count; i++) {
+                if (patterns[i].type != COM_NONE && patterns[i].type == frame.type) {
+                    match = i;
+                    msg = frame;
+                    break;
+                }
+            }
+        }
+        if (match != kComTimeout) break;
+        // Level holds: the current level matches once held long enough, the other one
+        // cannot match before its shortest hold has passed from now
+        int64_t now = esp_timer_get_time();
+        int64_t state = line.load(std::memory_order_acquire);
+        int level = static_cast<int>(state & 1);
+        int64_t since = std::max(state >> 1, start);
+        int64_t wake = deadline;
+        for (int i = 0; i < count && match == kComTimeout; i++) {
+            if (patterns[i].type != COM_NONE) continue;
+            int64_t hold = static_cast<int64_t>(patterns[i].hold_ms) * 1000;
+            if (patterns[i].level != level) wake = std::min(wake, now + hold);
+            else if (now - since >= hold) match = i;
+            else wake = std::min(wake, since + hold);
+        }
+        if (match != kComTimeout || now >= deadline) break;
+        sleepUntil(wake);
+    }
+    waiter.store(nullptr, std::memory_order_release);
+    return match;
+}
+
+// Blocks until time_us (rounded up to a tick) or a frame arrives
+void ComReceiver::sleepUntil(int64_t time_us) {
+    int64_t wait_us = time_us - esp_timer_get_time();
+    TickType_t ticks = pdMS_TO_TICKS((wait_us + 999) / 1000);
+    ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+}
+
+ComLinkStats ComReceiver::stats() const {
+    ComLinkStats s = decoder.stats();
+    s.dropped = droppedMessages.load(std::memory_order_relaxed);
+    return s;
+}
+
+void IRAM_ATTR ComReceiver::edgeIsr(void *arg) {
+    ComReceiver *self = static_cast<ComReceiver *>(arg);
+    int64_t now = esp_timer_get_time();
+    int level = sensorTraceLevel(self->gpio);
+    self->line.store(now * 2 + level, std::memory_order_release);
+    ComMessage msg;
+    if (!self->decoder.edge(now, level, msg)) return;
+    if (!self->messages.push(msg)) {
+        self->droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    TaskHandle_t task = self->waiter.load(std::memory_order_acquire);
+    if (task == nullptr) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &woken);
+    if (woken == pdTRUE) portYIELD_FROM_ISR();
+}
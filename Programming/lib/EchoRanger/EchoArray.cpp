@@ -0,0 +1,81 @@
+/*
+ * Project: AGV and Scissor Lift Control - Ultrasonic Ranging Engine
+ * File: EchoArray.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Slot timing and group rotation of EchoArray. The echoes themselves are
+ *   timed by each sensor's EchoRanger.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <EchoArray.h>
+
+bool EchoArray::setup(const EchoSensorPins *pins, int count, float soundSpeed_m_s, float listen_cm) {
+    if (count < 1 || count > kMaxSensors || listen_cm <= 0) return false;
+    this->count = count;
+    groupCount = 0;
+    for (int i = 0; i < count; i++) {
+        if (pins[i].group >= kMaxSensors) return false;
+        groupOf[i] = pins[i].group;
+        if (groupOf[i] + 1 > groupCount) groupCount = groupOf[i] + 1;
+        trig[i].setup(pins[i].trigGpio, GPO);           // GPIO, output mode, default pull
+        echo[i].setup(pins[i].echoGpio, GPI);           // GPIO, input mode, default pull
+        if (!rangers[i].setup(trig[i], pins[i].echoGpio, soundSpeed_m_s)) return false;
+    }
+    for (int g = 0; g < groupCount; g++) {
+        bool used = false;
+        for (int i = 0; i < count; i++) used = used || groupOf[i] == g;
+        if (!used) return false;                        // Numbered without gaps
+    }
+    // Round trip from listen_cm, then the guard; and no sensor pinged again within kMinRepeat_us
+    float cmPerUs = soundSpeed_m_s * 100.0f * 1e-6f / 2.0f;
+    uint32_t airTime = kEchoDelay_us + static_cast<uint32_t>(listen_cm / cmPerUs) + kGuard_us;
+    uint32_t repeatShare = (kMinRepeat_us + groupCount - 1) / groupCount;
+    slotPeriod_us = airTime > repeatShare ? airTime : repeatShare;
+    esp_timer_create_args_t slot = {slotCallback, this, ESP_TIMER_TASK, "echo_slot", true};
+    if (slotTimer == nullptr && esp_timer_create(&slot, &slotTimer) != ESP_OK) return false;
+    return true;
+}
+
+void EchoArray::start() {
+    if (slotTimer == nullptr || esp_timer_is_active(slotTimer)) return;
+    nextGroup = 0;
+    esp_timer_start_periodic(slotTimer, slotPeriod_us);
+}
+
+void EchoArray::stop() {
+    if (slotTimer != nullptr && esp_timer_is_active(slotTimer)) esp_timer_stop(slotTimer);
+    for (int i = 0; i < count; i++) rangers[i].stop();
+}
+
+void EchoArray::slotCallback(void *arg) {
+    EchoArray *self = static_cast<EchoArray *>(arg);
+    for (int i = 0; i < self->count; i++) {
+        if (self->groupOf[i] == self->nextGroup) self->rangers[i].trigger();
+    }
+    self->nextGroup = (self->nextGroup + 1) % self->groupCount;
+    self->slotCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// RESULTS
+uint32_t EchoArray::timeouts() const {
+    uint32_t total = 0;
+    for (int i = 0; i < count; i++) total += rangers[i].timeouts();
+    return total;
+}
+
+void EchoArray::table(EchoSample *out) const {
+    for (int i = 0; i < count; i++) out[i] = rangers[i].latest();
+}
+
+EchoSample EchoArray::nearest() const {
+    EchoSample nearest = {ECHO_PENDING, -1, 0, 0};
+    for (int i = 0; i < count; i++) {
+        EchoSample sample = rangers[i].latest();
+        if (sample.status != ECHO_OK && sample.status != ECHO_OUT_OF_RANGE) continue;
+        if (nearest.distance_cm < 0 || sample.distance_cm < nearest.distance_cm) nearest = sample;
+    }
+    return nearest;
+}
@@ -0,0 +1,79 @@
+/*
+ * Project: AGV and Scissor Lift Control - Ultrasonic Ranging Engine
+ * File: EchoArray.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Several HC-SR04 sensors (one EchoRanger each) pinging in turns so a
+ *   sensor never hears another one's burst:
+ *     - Sensors are split into groups by the caller; sensors of one group
+ *       face away from each other and ping together
+ *     - One periodic esp_timer gives the air to the next group every slot,
+ *       long enough for the farthest reflection of the previous group
+ *       (listen_cm) to come back and die out
+ *     - A sensor is never pinged again before its own "nothing found"
+ *       pulse can have ended, which sets the slot when there are few groups
+ *   A burst of a later group can still end a long "nothing found" echo,
+ *   but never before listen_cm: a reading past it means nothing in range.
+ *   latest(i) and table() read the newest result of each sensor without
+ *   waiting, like EchoRanger::latest().
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _ECHO_ARRAY_H_
+#define _ECHO_ARRAY_H_
+
+#include <EchoRanger.h>
+#include <SimpleGPIO.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cstdint>
+
+struct EchoSensorPins {
+    int trigGpio;
+    int echoGpio;
+    uint8_t group;                      // Pings with the other sensors of its group, groups numbered from 0
+};
+
+class EchoArray {
+public:
+    static constexpr int kMaxSensors = 8;
+    static constexpr uint32_t kEchoDelay_us = 500;         // Trigger to the burst leaving the sensor
+    static constexpr uint32_t kGuard_us = 2000;            // Late reflections dying out
+    static constexpr uint32_t kMinRepeat_us = EchoRanger::kDefaultTimeout_us + 2000;  // Same sensor again
+
+    // Sets up every pin; listen_cm is the farthest a burst can still come back from
+    bool setup(const EchoSensorPins *pins, int count, float soundSpeed_m_s = 343.0f,
+               float listen_cm = EchoRanger::kMaxRange_cm);
+    void start();                       // Groups take turns from group 0
+    void stop();
+
+    int sensors() const { return count; }
+    int groups() const { return groupCount; }
+    uint32_t slot_us() const { return slotPeriod_us; }     // Air time of one group
+    uint32_t cycle_us() const { return slotPeriod_us * groupCount; }
+    uint32_t slots() const { return slotCount.load(std::memory_order_relaxed); }
+    uint32_t timeouts() const;
+
+    EchoSample latest(int sensor) const { return rangers[sensor].latest(); }
+    void table(EchoSample *out) const;  // Newest result of every sensor, in setup() order
+    EchoSample nearest() const;         // Closest measured result, ECHO_PENDING and -1 cm if none yet
+    float nearest_cm() const { return nearest().distance_cm; }
+
+private:
+    static void slotCallback(void *arg);
+
+    SimpleGPIO trig[kMaxSensors];
+    SimpleGPIO echo[kMaxSensors];
+    EchoRanger rangers[kMaxSensors];
+    uint8_t groupOf[kMaxSensors] = {};
+    int count = 0;
+    int groupCount = 0;
+    int nextGroup = 0;
+    uint32_t slotPeriod_us = 0;
+    esp_timer_handle_t slotTimer = nullptr;
+    std::atomic<uint32_t> slotCount{0};
+};
+
+#endif // _ECHO_ARRAY_H_
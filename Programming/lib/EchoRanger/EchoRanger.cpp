@@ -0,0 +1,113 @@
+/*
+ * Project: AGV and Scissor Lift Control - Ultrasonic Ranging Engine
+ * File: EchoRanger.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Edge-capture implementation of EchoRanger. Only integer work happens
+ *   in the ISR, including the width to Q16 cm conversion; latest() turns
+ *   the published distance into a float.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <EchoRanger.h>
+#include <SensorTrace.h>
+#include <rom/ets_sys.h>
+
+bool EchoRanger::setup(SimpleGPIO &trig, int echoGpio, float soundSpeed_m_s, uint32_t period_us, uint32_t timeout_us) {
+    trigPin = &trig;
+    this->echoGpio = echoGpio;
+    float cmPerUs = soundSpeed_m_s * 100.0f * 1e-6f / 2.0f;  // Round trip, m/s to cm/us
+    toCm = FixedLine<16, 30>::fromFloat(cmPerUs, 0);
+    maxWidth_us = static_cast<int64_t>(kMaxRange_cm / cmPerUs);      // Out of range test without floats in the ISR
+    this->period_us = period_us;
+    this->timeout_us = timeout_us;
+    trigPin->set(0);
+    // Echo edges
+    if (gpio_set_intr_type((gpio_num_t)echoGpio, GPIO_INTR_ANYEDGE) != ESP_OK) return false;
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) return false;   // Already installed is fine
+    if (gpio_isr_handler_add((gpio_num_t)echoGpio, echoIsr, this) != ESP_OK) return false;
+    // Timers
+    esp_timer_create_args_t ping = {pingCallback, this, ESP_TIMER_TASK, "echo_ping", true};
+    esp_timer_create_args_t timeout = {timeoutCallback, this, ESP_TIMER_TASK, "echo_timeout", true};
+    if (esp_timer_create(&ping, &pingTimer) != ESP_OK) return false;
+    if (esp_timer_create(&timeout, &timeoutTimer) != ESP_OK) return false;
+    return true;
+}
+
+void EchoRanger::start() {
+    if (!esp_timer_is_active(pingTimer)) esp_timer_start_periodic(pingTimer, period_us);
+}
+
+void EchoRanger::stop() {
+    if (esp_timer_is_active(pingTimer)) esp_timer_stop(pingTimer);
+    if (esp_timer_is_active(timeoutTimer)) esp_timer_stop(timeoutTimer);
+    inFlight.store(false);
+}
+
+void EchoRanger::trigger() {
+    if (inFlight.exchange(false)) {                 // Previous ping never finished
+        timeoutCount.fetch_add(1, std::memory_order_relaxed);
+        publish(ECHO_TIMEOUT, Q16());
+    }
+    if (esp_timer_is_active(timeoutTimer)) esp_timer_stop(timeoutTimer);
+    riseTime_us = 0;
+    inFlight.store(true);
+    esp_timer_start_once(timeoutTimer, timeout_us);
+    // 10 us trigger pulse, the sensor fires on the falling edge
+    trigPin->set(1);
+    ets_delay_us(10);
+    trigPin->set(0);
+}
+
+EchoSample EchoRanger::latest() const {
+    EchoSample sample;
+    uint32_t before, after;
+    int32_t cm;
+    do {
+        before = seq.load(std::memory_order_acquire);
+        sample.status = lastStatus;
+        cm = lastCm_q16;
+        sample.timestamp_us = lastTime_us;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);      // Retry only if the ISR wrote meanwhile
+    sample.seq = before / 2;
+    sample.distance_cm = (sample.status == ECHO_OK || sample.status == ECHO_OUT_OF_RANGE) ? Q16::fromRaw(cm).toFloat() : -1;
+    return sample;
+}
+
+void IRAM_ATTR EchoRanger::echoIsr(void *arg) {
+    EchoRanger *self = static_cast<EchoRanger *>(arg);
+    int64_t now = esp_timer_get_time();
+    if (sensorTraceLevel(self->echoGpio) == 1) {
+        self->riseTime_us = now;                    // Echo started
+        return;
+    }
+    if (self->riseTime_us == 0 || !self->inFlight.exchange(false)) return;  // Stray edge or already timed out
+    int64_t width = now - self->riseTime_us;
+    self->publish(width <= self->maxWidth_us ? ECHO_OK : ECHO_OUT_OF_RANGE, self->widthToCmQ(width));
+}
+
+void EchoRanger::pingCallback(void *arg) {
+    static_cast<EchoRanger *>(arg)->trigger();
+}
+
+void EchoRanger::timeoutCallback(void *arg) {
+    EchoRanger *self = static_cast<EchoRanger *>(arg);
+    if (!self->inFlight.exchange(false)) return;    // Echo already published
+    self->timeoutCount.fetch_add(1, std::memory_order_relaxed);
+    self->publish(ECHO_TIMEOUT, Q16());
+}
+
+void IRAM_ATTR EchoRanger::publish(EchoStatus status, Q16 distance) {
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);    // Odd: readers retry
+    std::atomic_thread_fence(std::memory_order_release);
+    lastStatus = status;
+    lastCm_q16 = distance.raw();
+    lastTime_us = esp_timer_get_time();
+    seq.store(s + 2, std::memory_order_release);
+}
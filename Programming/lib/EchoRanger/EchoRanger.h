@@ -0,0 +1,92 @@
+/*
+ * Project: AGV and Scissor Lift Control - Ultrasonic Ranging Engine
+ * File: EchoRanger.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Non-blocking HC-SR04 ranging. A periodic esp_timer fires the trigger
+ *   pulse, a GPIO any-edge ISR timestamps the echo, and a one-shot timer
+ *   publishes an explicit "no echo" result when the echo never ends.
+ *   The control loop reads the newest sample with latest(), which never
+ *   waits on the sensor. The echo ISR converts the width to Q16 cm with
+ *   integer math (FixedLine), so it never touches the FPU; latest() only
+ *   turns that into a float.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _ECHO_RANGER_H_
+#define _ECHO_RANGER_H_
+
+#include <FixedPoint.h>
+#include <SimpleGPIO.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+// Measurement results
+enum EchoStatus {
+    ECHO_PENDING,       // No measurement completed yet
+    ECHO_OK,            // Echo inside the sensor range
+    ECHO_OUT_OF_RANGE,  // Echo returned but longer than the range limit (nothing close)
+    ECHO_TIMEOUT,       // Echo never started or never ended (sensor fault or lost echo)
+};
+
+struct EchoSample {
+    EchoStatus status;
+    float distance_cm;          // Valid for ECHO_OK and ECHO_OUT_OF_RANGE
+    int64_t timestamp_us;       // Time the result was published
+    uint32_t seq;               // Increments with every published result
+};
+
+class EchoRanger {
+public:
+    static constexpr uint32_t kDefaultPeriod_us = 60000;   // HC-SR04 recommends >= 60 ms between pings
+    static constexpr uint32_t kDefaultTimeout_us = 40000;  // Longer than the 38 ms "nothing found" pulse
+    static constexpr float kMaxRange_cm = 400.0f;
+
+    // Trigger must already be set up as an output; the echo pin is configured here
+    bool setup(SimpleGPIO &trig, int echoGpio, float soundSpeed_m_s = 343.0f,
+               uint32_t period_us = kDefaultPeriod_us, uint32_t timeout_us = kDefaultTimeout_us);
+    void start();                       // Ping every period
+    void stop();
+    void trigger();                     // Fire one measurement now, returns after the 10 us pulse
+    EchoSample latest() const;          // Newest result, lock-free and never blocking
+    uint32_t timeouts() const { return timeoutCount.load(std::memory_order_relaxed); }
+    float widthToCm(int64_t width_us) const { return widthToCmQ(width_us).toFloat(); }
+    Q16 widthToCmQ(int64_t width_us) const { return toCm.at(static_cast<int32_t>(width_us)); }  // Integer only, the echo ISR's
+
+    // Speed of sound in dry air, 343 m/s at 20 C and about 0.6 m/s more per degree
+    static float soundSpeed_m_s(float airTemp_C) { return 331.3f * std::sqrt(1.0f + airTemp_C / 273.15f); }
+
+private:
+    static void IRAM_ATTR echoIsr(void *arg);
+    static void pingCallback(void *arg);
+    static void timeoutCallback(void *arg);
+    void IRAM_ATTR publish(EchoStatus status, Q16 distance);
+
+    SimpleGPIO *trigPin = nullptr;
+    int echoGpio = -1;
+    FixedLine<16, 30> toCm = FixedLine<16, 30>::fromFloat(0.01715, 0);   // Half of the sound speed in cm/us
+    int64_t maxWidth_us = 23323;        // Echo of kMaxRange_cm
+    uint32_t period_us = kDefaultPeriod_us;
+    uint32_t timeout_us = kDefaultTimeout_us;
+    esp_timer_handle_t pingTimer = nullptr;
+    esp_timer_handle_t timeoutTimer = nullptr;
+
+    // Shared with the echo ISR
+    std::atomic<bool> inFlight{false};
+    volatile int64_t riseTime_us = 0;
+    std::atomic<uint32_t> timeoutCount{0};
+
+    // Seqlock protected result: odd seq = write in progress
+    std::atomic<uint32_t> seq{0};
+    volatile EchoStatus lastStatus = ECHO_PENDING;
+    volatile int32_t lastCm_q16 = 0;   // Q16 raw
+    volatile int64_t lastTime_us = 0;
+};
+
+#endif // _ECHO_RANGER_H_
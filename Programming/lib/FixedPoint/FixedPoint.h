@@ -0,0 +1,127 @@
+/*
+ * Project: AGV and Scissor Lift Control - Fixed-Point Math
+ * File: FixedPoint.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Q-format numbers for code that must not touch the FPU (IRAM_ATTR
+ *   ISRs on the ESP32 do not save the FPU registers):
+ *     - Fixed<FracBits>: a 32 bit value with FracBits fraction bits, the
+ *       format chosen at compile time. Products and quotients go through
+ *       64 bits and are rounded to nearest; there is no saturation, the
+ *       caller picks FracBits so the range fits (Q16: +-32767, Q20: +-2047)
+ *     - FixedLine: y = slope * x + offset for an integer reading (echo us,
+ *       ADC uV), the calibration behind a sensor conversion. The slope has
+ *       its own, finer format in 64 bits: cm per us or kg per uV need more
+ *       fraction bits than the result
+ *     - FixedRamp: y = (x - from) * slope clamped to [0, max], a distance
+ *       to duty law
+ *   fromFloat() and toFloat() are for setup, tests and the host; from a
+ *   constant they are evaluated by the compiler.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _FIXED_POINT_H_
+#define _FIXED_POINT_H_
+
+#include <cstdint>
+
+// v / 2^bits, rounded to nearest with halves away from zero
+constexpr int64_t fixedShift(int64_t v, int bits) {
+    if (bits == 0) return v;
+    int64_t half = int64_t(1) << (bits - 1);
+    return v >= 0 ? (v + half) >> bits : -((-v + half) >> bits);
+}
+
+template <int FracBits>
+class Fixed {
+public:
+    static_assert(FracBits > 0 && FracBits < 31, "Fixed needs 1 to 30 fraction bits");
+    static constexpr int kFracBits = FracBits;
+    static constexpr int32_t kOne = int32_t(1) << FracBits;
+
+    constexpr Fixed() = default;
+    static constexpr Fixed fromRaw(int32_t raw) { return Fixed(raw); }
+    static constexpr Fixed fromInt(int32_t value) { return Fixed(value * kOne); }
+    static constexpr Fixed fromFloat(float value) {
+        return Fixed(static_cast<int32_t>(value * kOne + (value < 0 ? -0.5f : 0.5f)));
+    }
+    // Other format, rounded when fraction bits are dropped
+    template <int Other>
+    static constexpr Fixed from(Fixed<Other> value) {
+        if constexpr (Other > FracBits) return Fixed(static_cast<int32_t>(fixedShift(value.raw(), Other - FracBits)));
+        else return Fixed(value.raw() * (int32_t(1) << (FracBits - Other)));
+    }
+
+    constexpr int32_t raw() const { return value; }
+    constexpr int32_t toInt() const { return value >> FracBits; }          // Rounded down
+    constexpr int32_t round() const { return static_cast<int32_t>(fixedShift(value, FracBits)); }
+    constexpr float toFloat() const { return static_cast<float>(value) / kOne; }
+
+    constexpr Fixed operator+(Fixed other) const { return Fixed(value + other.value); }
+    constexpr Fixed operator-(Fixed other) const { return Fixed(value - other.value); }
+    constexpr Fixed operator-() const { return Fixed(-value); }
+    constexpr Fixed operator*(Fixed other) const {
+        return Fixed(static_cast<int32_t>(fixedShift(static_cast<int64_t>(value) * other.value, FracBits)));
+    }
+    constexpr Fixed operator/(Fixed other) const {
+        int64_t scaled = static_cast<int64_t>(value) * kOne;
+        int64_t half = (other.value < 0 ? -other.value : other.value) / 2;
+        return Fixed(static_cast<int32_t>((scaled + (scaled < 0 ? -half : half)) / other.value));
+    }
+    constexpr Fixed scale(int32_t factor) const { return Fixed(value * factor); }   // Times an integer, exact
+    constexpr Fixed &operator+=(Fixed other) { value += other.value; return *this; }
+    constexpr Fixed &operator-=(Fixed other) { value -= other.value; return *this; }
+
+    constexpr bool operator==(Fixed other) const { return value == other.value; }
+    constexpr bool operator!=(Fixed other) const { return value != other.value; }
+    constexpr bool operator<(Fixed other) const { return value < other.value; }
+    constexpr bool operator<=(Fixed other) const { return value <= other.value; }
+    constexpr bool operator>(Fixed other) const { return value > other.value; }
+    constexpr bool operator>=(Fixed other) const { return value >= other.value; }
+
+private:
+    constexpr explicit Fixed(int32_t raw) : value(raw) {}
+
+    int32_t value = 0;
+};
+
+using Q16 = Fixed<16>;
+using Q20 = Fixed<20>;
+
+// y = slope * x + offset, x an integer reading; the slope keeps SlopeBits fraction bits. slopeRaw * x
+// fits 64 bits whenever slope * x fits the result format, since SlopeBits - FracBits <= 32
+template <int FracBits, int SlopeBits = FracBits>
+struct FixedLine {
+    static_assert(SlopeBits >= FracBits, "The slope needs at least the result's fraction bits");
+    static_assert(SlopeBits - FracBits <= 32 && SlopeBits < 48, "slopeRaw * x would not fit 64 bits");
+    int64_t slopeRaw;           // slope * 2^SlopeBits
+    Fixed<FracBits> offset;
+
+    static constexpr FixedLine fromFloat(double slope, double offset) {
+        return {static_cast<int64_t>(slope * (int64_t(1) << SlopeBits) + (slope < 0 ? -0.5 : 0.5)),
+                Fixed<FracBits>::fromFloat(static_cast<float>(offset))};
+    }
+    constexpr float slope() const { return static_cast<float>(static_cast<double>(slopeRaw) / (int64_t(1) << SlopeBits)); }
+    // Product in 64 bits, rounded once to the result format
+    constexpr Fixed<FracBits> at(int32_t x) const {
+        return Fixed<FracBits>::fromRaw(static_cast<int32_t>(fixedShift(slopeRaw * x, SlopeBits - FracBits))) + offset;
+    }
+};
+
+// y = (x - from) * slope, clamped to [0, max]
+template <int FracBits>
+struct FixedRamp {
+    Fixed<FracBits> from;
+    Fixed<FracBits> slope;
+    Fixed<FracBits> max;
+
+    constexpr Fixed<FracBits> at(Fixed<FracBits> x) const {
+        if (x <= from) return Fixed<FracBits>();
+        Fixed<FracBits> y = (x - from) * slope;
+        return y > max ? max : y;
+    }
+};
+
+#endif // _FIXED_POINT_H_
@@ -0,0 +1,297 @@
+/*
+ * Project: AGV and Scissor Lift Control - Instrumentation
+ * File: Instrumentation.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Timing probes that stay in the firmware:
+ *     - CycleTimer + CycleScope: cycle-counter duration of a block, e.g.
+ *       a step ISR
+ *     - PeriodProbe: period jitter of a loop, tick() once per iteration
+ *     - LatencyProbe: how late a timer callback runs, expect() when it is
+ *       armed and fired() first thing in the callback
+ *     - StateTimer: time spent in each state machine state
+ *   Every probe keeps count, min, max, mean and a log2 histogram (for the
+ *   percentiles) in a TimingStats, readable at any time, and registers
+ *   itself by name: TimingProbe::find() looks one up and dumpAll()
+ *   prints them all. Recording is a few adds and compares, safe in an
+ *   ISR; a dump taken while a probe records can be one sample off.
+ *   Build with INSTRUMENTATION=0 (release) and every probe is an empty
+ *   class with inline no-op members, so the calls compile to nothing.
+ *   Header only, include it from application code.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _INSTRUMENTATION_H_
+#define _INSTRUMENTATION_H_
+
+#ifndef INSTRUMENTATION
+#define INSTRUMENTATION 1
+#endif
+
+#include <esp_attr.h>
+#include <esp_cpu.h>
+#include <esp_timer.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define INSTRUMENTATION_CPU_MHZ 240         // Cycle counter rate
+
+enum TimingUnit : uint8_t { TIMING_CYCLES, TIMING_US };
+
+// Distribution of one measured quantity
+struct TimingStats {
+    static constexpr int kBuckets = 33;     // Bucket b counts values in [2^(b-1), 2^b), bucket 0 the zeros
+
+    uint32_t count = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t total = 0;
+    uint32_t buckets[kBuckets] = {};
+
+    void IRAM_ATTR add(uint32_t value) {
+        count++;
+        total += value;
+        if (value < min) min = value;
+        if (value > max) max = value;
+        buckets[value == 0 ? 0 : 32 - __builtin_clz(value)]++;
+    }
+    uint32_t average() const { return count > 0 ? static_cast<uint32_t>(total / count) : 0; }
+    // Upper bound of the p-th percentile (0-100), within a factor of two, never above max
+    uint32_t percentile(float p) const {
+        if (count == 0) return 0;
+        double rank = p / 100.0 * count;
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; b++) {
+            seen += buckets[b];
+            if (seen > 0 && seen >= rank) {
+                uint32_t bound = b == 0 ? 0 : (b >= 32 ? UINT32_MAX : (1u << b) - 1);
+                return bound < max ? bound : max;
+            }
+        }
+        return max;
+    }
+    void reset() { *this = TimingStats(); }
+};
+
+#if INSTRUMENTATION
+
+// Named entry in the probe list
+class TimingProbe {
+public:
+    explicit TimingProbe(const char *name) : label(name), next(first()) { first() = this; }
+    TimingProbe(const TimingProbe &) = delete;
+    TimingProbe &operator=(const TimingProbe &) = delete;
+    virtual ~TimingProbe() {
+        for (TimingProbe **p = &first(); *p != nullptr; p = &(*p)->next) {
+            if (*p == this) {
+                *p = next;
+                break;
+            }
+        }
+    }
+
+    const char *name() const { return label; }
+    virtual void dump(FILE *out) const = 0;
+    virtual void reset() = 0;
+
+    static TimingProbe *find(const char *name) {
+        for (TimingProbe *p = first(); p != nullptr; p = p->next) {
+            if (strcmp(p->label, name) == 0) return p;
+        }
+        return nullptr;
+    }
+    static void dumpAll(FILE *out = stdout) {
+        fprintf(out, "%-28s %8s %10s %10s %10s %10s\n", "probe (us)", "count", "min", "avg", "p99 <=", "max");
+        for (const TimingProbe *p = first(); p != nullptr; p = p->next) p->dump(out);
+    }
+    static void resetAll() {
+        for (TimingProbe *p = first(); p != nullptr; p = p->next) p->reset();
+    }
+
+protected:
+    static void row(FILE *out, const char *name, const TimingStats &s, TimingUnit unit) {
+        if (s.count == 0) return;
+        double scale = unit == TIMING_CYCLES ? 1.0 / INSTRUMENTATION_CPU_MHZ : 1.0;
+        fprintf(out, "%-28s %8lu %10.2f %10.2f %10.2f %10.2f\n", name, static_cast<unsigned long>(s.count),
+                s.min * scale, s.average() * scale, s.percentile(99) * scale, s.max * scale);
+    }
+
+private:
+    static TimingProbe *&first() {
+        static TimingProbe *head = nullptr;
+        return head;
+    }
+
+    const char *label;
+    TimingProbe *next;
+};
+
+// Duration of a block in CPU cycles, recorded by CycleScope
+class CycleTimer : public TimingProbe {
+public:
+    explicit CycleTimer(const char *name) : TimingProbe(name) {}
+    void IRAM_ATTR add(uint32_t cycles) { data.add(cycles); }
+    const TimingStats &stats() const { return data; }
+    void dump(FILE *out) const override { row(out, name(), data, TIMING_CYCLES); }
+    void reset() override { data.reset(); }
+
+private:
+    TimingStats data;
+};
+
+class CycleScope {
+public:
+    explicit IRAM_ATTR CycleScope(CycleTimer &timer) : timer(timer), start(esp_cpu_get_cycle_count()) {}
+    IRAM_ATTR ~CycleScope() { timer.add(static_cast<uint32_t>(esp_cpu_get_cycle_count() - start)); }
+
+private:
+    CycleTimer &timer;
+    esp_cpu_cycle_count_t start;
+};
+
+// Period of a loop: stats of |period - nominal| in us, plus the longest period
+class PeriodProbe : public TimingProbe {
+public:
+    PeriodProbe(const char *name, uint32_t nominal_us) : TimingProbe(name), nominal_us(nominal_us) {}
+    void IRAM_ATTR tick() {
+        int64_t now = esp_timer_get_time();
+        if (last_us >= 0) {
+            int64_t period = now - last_us;
+            data.add(static_cast<uint32_t>(period > nominal_us ? period - nominal_us : nominal_us - period));
+            if (period > maxPeriod_us) maxPeriod_us = period;
+        }
+        last_us = now;
+    }
+    void restart() { last_us = -1; }            // Next tick starts a new run, the gap is not a period
+    const TimingStats &stats() const { return data; }
+    int64_t maxPeriod() const { return maxPeriod_us; }
+    void dump(FILE *out) const override {
+        row(out, name(), data, TIMING_US);
+        if (data.count > 0) fprintf(out, "%-28s %8s %10s %10s %10s %10lld\n", "  longest period", "", "", "", "",
+                                    static_cast<long long>(maxPeriod_us));
+    }
+    void reset() override {
+        data.reset();
+        maxPeriod_us = 0;
+        last_us = -1;
+    }
+
+private:
+    uint32_t nominal_us;
+    int64_t last_us = -1;
+    int64_t maxPeriod_us = 0;
+    TimingStats data;
+};
+
+// Lateness of a callback against the time it was armed for, in us
+class LatencyProbe : public TimingProbe {
+public:
+    explicit LatencyProbe(const char *name) : TimingProbe(name) {}
+    void IRAM_ATTR expect(int64_t due_us) {
+        this->due_us = due_us;
+        armed = true;
+    }
+    void IRAM_ATTR fired() {
+        if (!armed) return;                     // First call of a move, nobody armed it
+        int64_t late = esp_timer_get_time() - due_us;
+        data.add(static_cast<uint32_t>(late > 0 ? late : 0));
+        armed = false;
+    }
+    const TimingStats &stats() const { return data; }
+    void dump(FILE *out) const override { row(out, name(), data, TIMING_US); }
+    void reset() override {
+        data.reset();
+        armed = false;
+    }
+
+private:
+    int64_t due_us = 0;
+    bool armed = false;
+    TimingStats data;
+};
+
+// Time in each of N states, in us; names[s] labels state s in the dump
+template <int N>
+class StateTimer : public TimingProbe {
+public:
+    StateTimer(const char *name, const char *const (&names)[N]) : TimingProbe(name), names(names) {}
+    void record(int state, int64_t time_us) {
+        if (state >= 0 && state < N) data[state].add(static_cast<uint32_t>(time_us > 0 ? time_us : 0));
+    }
+    const TimingStats &stats(int state) const { return data[state]; }
+    void dump(FILE *out) const override {
+        for (int s = 0; s < N; s++) {
+            char label[64];
+            snprintf(label, sizeof(label), "%s %s", name(), names[s]);
+            row(out, label, data[s], TIMING_US);
+        }
+    }
+    void reset() override {
+        for (TimingStats &s : data) s.reset();
+    }
+
+private:
+    const char *const (&names)[N];
+    TimingStats data[N];
+};
+
+#else // INSTRUMENTATION
+
+// Release build: same interface, no state, no code
+class TimingProbe {
+public:
+    const char *name() const { return ""; }
+    void dump(FILE *) const {}
+    void reset() {}
+    static TimingProbe *find(const char *) { return nullptr; }
+    static void dumpAll(FILE * = stdout) {}
+    static void resetAll() {}
+};
+
+class CycleTimer {
+public:
+    explicit CycleTimer(const char *) {}
+    void add(uint32_t) {}
+    TimingStats stats() const { return TimingStats(); }
+    void reset() {}
+};
+
+class CycleScope {
+public:
+    explicit CycleScope(CycleTimer &) {}
+};
+
+class PeriodProbe {
+public:
+    PeriodProbe(const char *, uint32_t) {}
+    void tick() {}
+    void restart() {}
+    TimingStats stats() const { return TimingStats(); }
+    int64_t maxPeriod() const { return 0; }
+    void reset() {}
+};
+
+class LatencyProbe {
+public:
+    explicit LatencyProbe(const char *) {}
+    void expect(int64_t) {}
+    void fired() {}
+    TimingStats stats() const { return TimingStats(); }
+    void reset() {}
+};
+
+template <int N>
+class StateTimer {
+public:
+    StateTimer(const char *, const char *const (&)[N]) {}
+    void record(int, int64_t) {}
+    TimingStats stats(int) const { return TimingStats(); }
+    void reset() {}
+};
+
+#endif // INSTRUMENTATION
+
+#endif // _INSTRUMENTATION_H_
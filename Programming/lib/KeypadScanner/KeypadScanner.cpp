@@ -0,0 +1,117 @@
+/*
+ * Project: AGV and Scissor Lift Control - Keypad Scanner
+ * File: KeypadScanner.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Matrix scan, per-key debounce and event queue of KeypadScanner, and
+ *   the number entry of KeypadEntry.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <KeypadScanner.h>
+#include <SensorTrace.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cstdlib>
+
+const char KeypadScanner::kDefaultMap[kRows][kCols + 1] = {"123A", "456B", "789C", "*0#D"};
+
+bool KeypadScanner::setup(const uint8_t *rowPins, const uint8_t *colPins, uint32_t period_us, int debounceScans) {
+    this->debounceScans = debounceScans > 0 ? debounceScans : 1;
+    for (int r = 0; r < kRows; r++) {
+        rows[r].setup(rowPins[r], GPO);
+        rows[r].set(1);                                 // Idle high, low selects the row
+    }
+    for (int c = 0; c < kCols; c++) {
+        cols[c].setup(colPins[c], GPI);
+        gpio_pullup_en((gpio_num_t)colPins[c]);         // Open key reads high
+    }
+    esp_timer_create_args_t args = {scanCallback, this, ESP_TIMER_TASK, "keypad_scan", true};
+    if (esp_timer_create(&args, &timer) != ESP_OK) return false;
+    return esp_timer_start_periodic(timer, period_us) == ESP_OK;
+}
+
+void KeypadScanner::stop() {
+    if (timer != nullptr && esp_timer_is_active(timer)) esp_timer_stop(timer);
+}
+
+// CONSUMER
+bool KeypadScanner::nextEvent(KeyEvent &event) {
+    return events.pop(event);
+}
+
+char KeypadScanner::getKey() {
+    KeyEvent event;
+    while (events.pop(event)) {
+        if (event.pressed) return event.key;
+    }
+    return '\0';
+}
+
+char KeypadScanner::waitKey(uint32_t timeout_ms) {
+    int64_t deadline = esp_timer_get_time() + static_cast<int64_t>(timeout_ms) * 1000;
+    while (true) {
+        char key = getKey();
+        if (key != '\0') return key;
+        if (esp_timer_get_time() >= deadline) return '\0';
+        vTaskDelay(pdMS_TO_TICKS(kWaitPoll_ms));
+    }
+}
+
+// SCANNER
+void IRAM_ATTR KeypadScanner::scanCallback(void *arg) {
+    static_cast<KeypadScanner *>(arg)->scan();
+}
+
+void IRAM_ATTR KeypadScanner::scan() {
+    int64_t now = esp_timer_get_time();
+    for (int r = 0; r < kRows; r++) {
+        rows[r].set(0);
+        for (int c = 0; c < kCols; c++) {
+            bool down = sensorTraceGet(cols[c]) == 0;
+            if (down == stable[r][c]) {
+                count[r][c] = 0;                        // Bounce back, start over
+                continue;
+            }
+            if (count[r][c]++ == 0) edge_us[r][c] = now;
+            if (count[r][c] < debounceScans) continue;
+            stable[r][c] = down;
+            count[r][c] = 0;
+            KeyEvent event = {kDefaultMap[r][c], down, edge_us[r][c]};
+            if (!events.push(event)) droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+        rows[r].set(1);
+    }
+}
+
+// ENTRY
+KeypadEntry::Result KeypadEntry::key(char key) {
+    if (key >= '0' && key <= '9') {
+        if (length >= kMaxDigits) return ENTRY_IGNORED;
+        buffer[length++] = key;
+        buffer[length] = '\0';
+        return ENTRY_CHANGED;
+    }
+    if (key == 'A') return length > 0 ? ENTRY_DONE : ENTRY_IGNORED;
+    if (key == 'B') {
+        if (length == 0) return ENTRY_IGNORED;
+        buffer[--length] = '\0';
+        return ENTRY_CHANGED;
+    }
+    if (key == 'C') {
+        clear();
+        return ENTRY_CLEARED;
+    }
+    return ENTRY_IGNORED;
+}
+
+void KeypadEntry::clear() {
+    buffer[0] = '\0';
+    length = 0;
+}
+
+float KeypadEntry::value() const {
+    return atof(buffer);
+}
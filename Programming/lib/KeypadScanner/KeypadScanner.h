@@ -0,0 +1,97 @@
+/*
+ * Project: AGV and Scissor Lift Control - Keypad Scanner
+ * File: KeypadScanner.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Background scanner for the 4x4 matrix keypad.
+ *     - A 1 kHz esp_timer drives one row low at a time and reads the
+ *       four pulled-up columns
+ *     - Each key is debounced on its own: a change counts only after it
+ *       holds for debounceScans scans in a row (5 ms by default)
+ *     - Press and release events go into a lock-free SpscQueue, stamped
+ *       with the scan that first saw the change, so the consumer sees
+ *       every key in order and can measure its reaction time
+ *   getKey() is a non-blocking pop; waitKey() polls the queue every
+ *   kWaitPoll_ms, so a task reacts within a few milliseconds.
+ *   KeypadEntry turns pressed keys into a number: digits, 'B' deletes
+ *   the last one, 'C' clears, 'A' accepts.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _KEYPAD_SCANNER_H_
+#define _KEYPAD_SCANNER_H_
+
+#include <SimpleGPIO.h>
+#include <SpscQueue.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cstdint>
+
+struct KeyEvent {
+    char key;
+    bool pressed;               // false = released
+    int64_t time_us;            // Scan that first saw the change
+};
+
+class KeypadScanner {
+public:
+    static constexpr int kRows = 4;
+    static constexpr int kCols = 4;
+    static constexpr uint32_t kDefaultPeriod_us = 1000;
+    static constexpr int kDefaultDebounceScans = 5;
+    static constexpr uint32_t kWaitPoll_ms = 2;
+    static const char kDefaultMap[kRows][kCols + 1];
+
+    bool setup(const uint8_t *rowPins, const uint8_t *colPins, uint32_t period_us = kDefaultPeriod_us,
+               int debounceScans = kDefaultDebounceScans);
+    void stop();
+    bool nextEvent(KeyEvent &event);        // Presses and releases, never blocks
+    char getKey();                          // Next press, '\0' when none (releases are skipped)
+    char waitKey(uint32_t timeout_ms);      // Next press within timeout_ms, '\0' on timeout
+    uint32_t dropped() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    static void IRAM_ATTR scanCallback(void *arg);
+    void IRAM_ATTR scan();
+
+    SimpleGPIO rows[kRows];
+    SimpleGPIO cols[kCols];
+    int debounceScans = kDefaultDebounceScans;
+    esp_timer_handle_t timer = nullptr;
+
+    // Scanner side only
+    bool stable[kRows][kCols] = {};         // Debounced state
+    uint8_t count[kRows][kCols] = {};       // Consecutive scans disagreeing with stable
+    int64_t edge_us[kRows][kCols] = {};     // First scan of the current disagreement
+
+    SpscQueue<KeyEvent, 32> events;
+    std::atomic<uint32_t> droppedEvents{0};
+};
+
+// Number typed on the keypad, one key at a time; other keys are left to the caller
+class KeypadEntry {
+public:
+    static constexpr int kMaxDigits = 2;
+
+    enum Result : uint8_t {
+        ENTRY_IGNORED,          // Not an entry key, or nothing to do (full, empty)
+        ENTRY_CHANGED,          // Digit added or deleted, text() to show
+        ENTRY_CLEARED,
+        ENTRY_DONE,             // Accepted, value() is the number
+    };
+
+    Result key(char key);
+    void clear();
+    const char *text() const { return buffer; }
+    float value() const;
+
+private:
+    char buffer[kMaxDigits + 1] = {};
+    int length = 0;
+};
+
+#endif // _KEYPAD_SCANNER_H_
@@ -0,0 +1,108 @@
+/*
+ * Project: AGV and Scissor Lift Control - LCD Framebuffer
+ * File: LcdFramebuffer.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Draft editing, diffing and the flush task of LcdFramebuffer.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LcdFramebuffer.h>
+#include <cstring>
+
+namespace {
+
+void blank(LcdScreen &screen) {
+    memset(screen.cells, ' ', sizeof(screen.cells));
+}
+
+}
+
+// SETUP
+bool LcdFramebuffer::setup(NibbleLCD &lcd, uint8_t *pins, uint32_t flush_ms, UBaseType_t priority, BaseType_t core) {
+    this->lcd = &lcd;
+    flushPeriod_ms = flush_ms > 0 ? flush_ms : 1;
+    lcd.setup(pins);
+    lcd.writeCommand(CMD_CLEAR);                        // Display and shadow start out blank
+    blank(onDisplay);
+    blank(draft);
+    posted.publish(draft);
+    return xTaskCreatePinnedToCore(flushTask, "lcd_flush", 2048, this, priority, nullptr, core) == pdPASS;
+}
+
+// POSTING (constant time, no bus access)
+void LcdFramebuffer::print(const char *text) {
+    blank(draft);
+    int row = 0, col = 0;
+    for (const char *c = text; *c != '\0' && row < LcdScreen::kRows; c++) {
+        if (*c == '\n') {
+            row++;
+            col = 0;
+        }
+        else if (col < LcdScreen::kCols) draft.cells[row][col++] = *c;  // Past the edge is not visible
+    }
+    counters.posts++;
+    posted.publish(draft);
+}
+
+void LcdFramebuffer::printAt(int row, int col, const char *text) {
+    if (row < 0 || row >= LcdScreen::kRows) return;
+    for (const char *c = text; *c != '\0' && *c != '\n' && col < LcdScreen::kCols; c++, col++) {
+        if (col >= 0) draft.cells[row][col] = *c;
+    }
+    counters.posts++;
+    posted.publish(draft);
+}
+
+void LcdFramebuffer::clear() {
+    blank(draft);
+    counters.posts++;
+    posted.publish(draft);
+}
+
+// FLUSH
+void LcdFramebuffer::flush() {
+    if (!posted.read(next)) return;                     // Nothing new since the last flush
+    bool sent = false;
+    for (int row = 0; row < LcdScreen::kRows; row++) {
+        int col = 0;
+        while (col < LcdScreen::kCols) {
+            if (next.cells[row][col] == onDisplay.cells[row][col]) {
+                col++;
+                continue;
+            }
+            // Extend the run over single unchanged cells: one character costs the same as a new address
+            int end = col + 1;
+            while (end < LcdScreen::kCols) {
+                if (next.cells[row][end] != onDisplay.cells[row][end]) end++;
+                else if (end + 1 < LcdScreen::kCols && next.cells[row][end + 1] != onDisplay.cells[row][end + 1]) end += 2;
+                else break;
+            }
+            sendRun(row, col, end - col);
+            sent = true;
+            col = end;
+        }
+    }
+    if (sent) counters.flushes++;
+}
+
+void LcdFramebuffer::sendRun(int row, int col, int length) {
+    char run[LcdScreen::kCols + 1];
+    memcpy(run, &next.cells[row][col], length);
+    run[length] = '\0';
+    lcd->writeCommand(LCD_SET_DDRAM | (row * LCD_ROW_ADDRESS + col));
+    lcd->printStr(run);
+    memcpy(&onDisplay.cells[row][col], run, length);
+    counters.commands++;
+    counters.characters += length;
+}
+
+void LcdFramebuffer::flushTask(void *arg) {
+    LcdFramebuffer *self = static_cast<LcdFramebuffer *>(arg);
+    while (true) {
+        self->flush();
+        vTaskDelay(pdMS_TO_TICKS(self->flushPeriod_ms));   // Rate limit: at most one flush per period
+    }
+}
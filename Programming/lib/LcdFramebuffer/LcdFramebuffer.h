@@ -0,0 +1,75 @@
+/*
+ * Project: AGV and Scissor Lift Control - LCD Framebuffer
+ * File: LcdFramebuffer.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Shadow framebuffer over NibbleLCD (16x2 HD44780, 4-bit bus).
+ *     - print()/printAt()/clear() only edit a 32-cell draft and publish
+ *       it through a TripleBuffer: constant time, no bus access, so
+ *       control loops never wait on the display
+ *     - A low-priority task wakes every flush period, takes the newest
+ *       screen and sends only the cells that differ from what the
+ *       display shows (a DDRAM address command plus the changed run);
+ *       screens posted in between are simply skipped
+ *   One task posts text; only the flush task touches the NibbleLCD.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LCD_FRAMEBUFFER_H_
+#define _LCD_FRAMEBUFFER_H_
+
+#include <NibbleLCD.h>
+#include <TripleBuffer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cstdint>
+
+#define LCD_SET_DDRAM 0x80                  // HD44780 "set DDRAM address" command, OR the address
+#define LCD_ROW_ADDRESS 0x40                // DDRAM address of the second row
+
+struct LcdScreen {
+    static constexpr int kRows = 2;
+    static constexpr int kCols = 16;
+    char cells[kRows][kCols];
+};
+
+// Bus traffic since setup(), for checking the savings
+struct LcdFlushStats {
+    uint32_t posts = 0;                     // print()/printAt()/clear() calls
+    uint32_t flushes = 0;                   // Flushes that sent something
+    uint32_t commands = 0;                  // DDRAM address commands sent
+    uint32_t characters = 0;                // Characters sent
+};
+
+class LcdFramebuffer {
+public:
+    static constexpr uint32_t kDefaultFlush_ms = 50;
+    static constexpr UBaseType_t kDefaultPriority = 1;
+
+    // Initializes the display and starts the flush task
+    bool setup(NibbleLCD &lcd, uint8_t *pins, uint32_t flush_ms = kDefaultFlush_ms,
+               UBaseType_t priority = kDefaultPriority, BaseType_t core = tskNO_AFFINITY);
+    void print(const char *text);           // Whole screen: '\n' starts row 2, the rest is blanked
+    void printAt(int row, int col, const char *text);  // Overwrite part of a row, rest of the screen kept
+    void clear();
+    void flush();                           // Send the newest screen now (the flush task calls this)
+
+    const LcdScreen &shown() const { return onDisplay; }
+    const LcdFlushStats &stats() const { return counters; }
+
+private:
+    static void flushTask(void *arg);
+    void sendRun(int row, int col, int length);
+
+    NibbleLCD *lcd = nullptr;
+    uint32_t flushPeriod_ms = kDefaultFlush_ms;
+    LcdScreen draft;                        // Posting task only
+    TripleBuffer<LcdScreen> posted;
+    LcdScreen onDisplay;                    // Flush side only
+    LcdScreen next;
+    LcdFlushStats counters;
+};
+
+#endif // _LCD_FRAMEBUFFER_H_
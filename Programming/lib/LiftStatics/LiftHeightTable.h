@@ -0,0 +1,54 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftHeightTable.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Platform height per lift motor step, counted from rest. The rows are
+ *   generated on the host from the scissor geometry (lift_statics
+ *   --height-header LiftStepHeights.h), one every stride_steps; the
+ *   firmware interpolates between them both ways to turn a target height
+ *   into a step count and its step counter back into a height. No
+ *   trigonometry runs on the ESP32.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LIFT_HEIGHT_TABLE_H_
+#define _LIFT_HEIGHT_TABLE_H_
+
+#include <cstdint>
+
+struct LiftHeightTable {
+    uint16_t stride_steps;              // Steps between rows
+    uint16_t rows;
+    const uint16_t *height_dmm;         // Platform height per row, 0.1 mm, row 0 at rest
+
+    int32_t maxSteps() const { return static_cast<int32_t>(rows - 1) * stride_steps; }
+
+    // Platform height after a number of steps from rest, clamped to the table
+    float height_mm(int32_t steps) const {
+        if (steps <= 0) return height_dmm[0] / 10.0f;
+        if (steps >= maxSteps()) return height_dmm[rows - 1] / 10.0f;
+        int i = steps / stride_steps;
+        float t = static_cast<float>(steps - i * stride_steps) / stride_steps;
+        return (height_dmm[i] + t * (height_dmm[i + 1] - height_dmm[i])) / 10.0f;
+    }
+
+    // Nearest step count from rest for a platform height, clamped to the table
+    int32_t steps(float height_mm) const {
+        float dmm = height_mm * 10;
+        if (dmm <= height_dmm[0]) return 0;
+        if (dmm >= height_dmm[rows - 1]) return maxSteps();
+        int low = 0, high = rows - 1;                   // height_dmm[low] < dmm <= height_dmm[high]
+        while (high - low > 1) {
+            int mid = (low + high) / 2;
+            if (height_dmm[mid] < dmm) low = mid;
+            else high = mid;
+        }
+        float t = (dmm - height_dmm[low]) / (height_dmm[high] - height_dmm[low]);
+        return low * stride_steps + static_cast<int32_t>(t * stride_steps + 0.5f);
+    }
+};
+
+#endif // _LIFT_HEIGHT_TABLE_H_
@@ -0,0 +1,28 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftLoadLimits.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Generated by lift_statics --header from the statics sweep, do not edit.
+ *   Links 202.5 mm, platform 215.0 mm, base 232.5 mm, 5 to 60 deg;
+ *   pins 6233 N, lead screw 4000 N.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LIFT_LOAD_LIMITS_H_
+#define _LIFT_LOAD_LIMITS_H_
+
+#include "LiftLoadTable.h"
+
+// Safe load (0.1 kg) per 10 mm of platform height from 35 mm
+const uint16_t liftLoadLimits_hg[32] = {
+    150, 199, 251, 303, 356, 409, 463, 500, 500, 500, 500, 500,
+    500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 500,
+    500, 500, 500, 500, 500, 500, 500, 500,
+};
+
+const LiftLoadTable liftLoadTable = {35, 10, 32, liftLoadLimits_hg};
+
+#endif // _LIFT_LOAD_LIMITS_H_
@@ -0,0 +1,50 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftLoadTable.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Safe platform load per height, looked up by the lift firmware before
+ *   it moves. The rows are generated on the host from the statics sweep
+ *   (lift_statics --header LiftLoadLimits.h): each row is the largest load
+ *   that keeps every pin and the lead screw within their ratings anywhere
+ *   inside its height bin. No solve runs on the ESP32.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LIFT_LOAD_TABLE_H_
+#define _LIFT_LOAD_TABLE_H_
+
+#include <cstdint>
+
+struct LiftLoadTable {
+    uint16_t minHeight_mm;              // Row 0 starts here (links at rest)
+    uint16_t step_mm;                   // Height bin of one row
+    uint16_t rows;
+    const uint16_t *limit_hg;           // Safe load per row, 0.1 kg
+
+    // Lowest safe load over a travel between two platform heights, in kg
+    float limit_kg(int from_mm, int to_mm) const {
+        if (from_mm > to_mm) {
+            int swap = from_mm;
+            from_mm = to_mm;
+            to_mm = swap;
+        }
+        int first = row(from_mm), last = row(to_mm);
+        uint16_t lowest = limit_hg[first];
+        for (int i = first + 1; i <= last; i++) {
+            if (limit_hg[i] < lowest) lowest = limit_hg[i];
+        }
+        return lowest / 10.0f;
+    }
+
+private:
+    int row(int height_mm) const {
+        if (height_mm <= minHeight_mm) return 0;
+        int i = (height_mm - minHeight_mm) / step_mm;
+        return i < rows ? i : rows - 1;
+    }
+};
+
+#endif // _LIFT_LOAD_TABLE_H_
@@ -0,0 +1,300 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftStatics.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Geometry, equilibrium system, LU factorization and grid sweep of
+ *   LiftStatics.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include "LiftStatics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int N = LiftStatics::kEquations;
+constexpr double kGravity = 9.81;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kTinyPivot = 1e-12;
+
+enum Body { BODY_PLATFORM, BODY_LINK5, BODY_LINK6, BODY_LINK3, BODY_LINK4, BODY_BASE };
+
+struct Point {
+    double x, y;
+};
+
+// Rows of one body: sum Fx, sum Fy, sum of moments about its reference point
+struct Assembly {
+    double *a, *b;
+    Point ref[6];
+
+    void unknown(int body, Point p, int column, double ux, double uy) {
+        double *row = a + 3 * body * N;
+        row[column] += ux;
+        row[N + column] += uy;
+        row[2 * N + column] += (p.x - ref[body].x) * uy - (p.y - ref[body].y) * ux;
+    }
+    void known(int body, Point p, double fx, double fy) {
+        b[3 * body] -= fx;
+        b[3 * body + 1] -= fy;
+        b[3 * body + 2] -= (p.x - ref[body].x) * fy - (p.y - ref[body].y) * fx;
+    }
+};
+
+// LU with partial pivoting, in place; false for a singular system
+bool factor(double *a, int *pivot) {
+    for (int k = 0; k < N; k++) {
+        int best = k;
+        for (int i = k + 1; i < N; i++) {
+            if (std::fabs(a[i * N + k]) > std::fabs(a[best * N + k])) best = i;
+        }
+        if (std::fabs(a[best * N + k]) < kTinyPivot) return false;
+        pivot[k] = best;
+        if (best != k) std::swap_ranges(a + k * N, a + k * N + N, a + best * N);
+        for (int i = k + 1; i < N; i++) {
+            double f = a[i * N + k] /= a[k * N + k];
+            for (int j = k + 1; j < N; j++) a[i * N + j] -= f * a[k * N + j];
+        }
+    }
+    return true;
+}
+
+// Solves for every column of b (N rows of 'columns' values) at once
+void substitute(const double *lu, const int *pivot, double *b, size_t columns) {
+    for (int k = 0; k < N; k++) {
+        if (pivot[k] != k) std::swap_ranges(b + k * columns, b + (k + 1) * columns, b + pivot[k] * columns);
+    }
+    for (int i = 1; i < N; i++) {
+        double *row = b + i * columns;
+        for (int j = 0; j < i; j++) {
+            const double l = lu[i * N + j];
+            const double *from = b + j * columns;
+            for (size_t c = 0; c < columns; c++) row[c] -= l * from[c];
+        }
+    }
+    for (int i = N - 1; i >= 0; i--) {
+        double *row = b + i * columns;
+        for (int j = i + 1; j < N; j++) {
+            const double u = lu[i * N + j];
+            const double *from = b + j * columns;
+            for (size_t c = 0; c < columns; c++) row[c] -= u * from[c];
+        }
+        const double inverse = 1.0 / lu[i * N + i];
+        for (size_t c = 0; c < columns; c++) row[c] *= inverse;
+    }
+}
+
+} // namespace
+
+// FORCES
+double LiftForces::pin(int joint) const {
+    switch (joint) {
+        case JOINT_A: return std::hypot(x[FORCE_AX], x[FORCE_AY]);
+        case JOINT_B: return std::fabs(x[FORCE_BY]);
+        case JOINT_C: return std::hypot(x[FORCE_CX], x[FORCE_CY]);
+        case JOINT_D: return std::hypot(x[FORCE_DX], x[FORCE_DY]);
+        case JOINT_E: return std::hypot(x[FORCE_EX], x[FORCE_EY]);
+        case JOINT_F: return std::hypot(x[FORCE_FX], x[FORCE_FY]);
+        case JOINT_G: return std::hypot(x[FORCE_GX], x[FORCE_GY]);
+        case JOINT_H: return std::hypot(x[FORCE_THRUST], x[FORCE_HY]);    // Roller and screw share the pin
+        default: return 0;
+    }
+}
+
+double LiftForces::maxPin() const {
+    double most = 0;
+    for (int j = 0; j < kLiftJoints; j++) most = std::max(most, pin(j));
+    return most;
+}
+
+// GEOMETRY
+double LiftStatics::height_m(double angle_rad) const {
+    return 2 * geo.link_m * std::sin(angle_rad);
+}
+
+double LiftStatics::angleFor(double height_m) const {
+    return std::asin(std::min(1.0, std::max(0.0, height_m / (2 * geo.link_m))));
+}
+
+double LiftStatics::minHeight_m() const {
+    return height_m(geo.minAngle_deg * kPi / 180);
+}
+
+double LiftStatics::maxHeight_m() const {
+    return height_m(geo.maxAngle_deg * kPi / 180);
+}
+
+double LiftStatics::stepsFor(double height_m) const {
+    double travel = geo.link_m * (std::cos(geo.minAngle_deg * kPi / 180) - std::cos(angleFor(height_m)));
+    return travel / geo.screwStep_m;
+}
+
+double LiftStatics::heightAtStep_m(double steps) const {
+    double c = std::cos(geo.minAngle_deg * kPi / 180) - steps * geo.screwStep_m / geo.link_m;
+    return height_m(std::acos(std::min(1.0, std::max(0.0, c))));
+}
+
+void LiftStatics::stepHeights(unsigned stride_steps, LiftStepHeights &out) const {
+    out.stride_steps = std::max(1u, stride_steps);
+    unsigned rows = static_cast<unsigned>(std::ceil(stepsFor(maxHeight_m()) / out.stride_steps)) + 1;
+    out.height_dmm.resize(rows);
+    for (unsigned i = 0; i < rows; i++) {
+        out.height_dmm[i] = static_cast<unsigned>(std::lround(heightAtStep_m(i * out.stride_steps) * 10000));
+    }
+}
+
+// SYSTEM
+void LiftStatics::build(double height_m, double *a, double *bWeights, double *bPerKg) const {
+    double angle = angleFor(height_m);
+    double c = geo.link_m * std::cos(angle), s = geo.link_m * std::sin(angle);
+    const Point G = {0, 0}, H = {c, 0}, F = {c / 2, s / 2}, D = {0, s}, E = {c, s};
+    const Point C = {c / 2, 1.5 * s}, A = {0, 2 * s}, B = {c, 2 * s};
+    const Point platformCentre = {geo.platform_m / 2, 2 * s};
+    const Point load = {geo.platform_m / 2 + geo.loadOffset_m, 2 * s};
+    const Point groundB = {geo.base_m, 0}, baseCentre = {geo.base_m / 2, 0};
+    const double linkWeight = geo.linkMass_kg * kGravity;
+
+    std::fill(a, a + N * N, 0.0);
+    std::fill(bWeights, bWeights + N, 0.0);
+    std::fill(bPerKg, bPerKg + N, 0.0);
+    Assembly sys = {a, bWeights, {A, D, E, G, H, G}};
+
+    // Platform: pinned at A, resting on the roller at B
+    sys.unknown(BODY_PLATFORM, A, FORCE_AX, -1, 0);
+    sys.unknown(BODY_PLATFORM, A, FORCE_AY, 0, -1);
+    sys.unknown(BODY_PLATFORM, B, FORCE_BY, 0, -1);
+    sys.known(BODY_PLATFORM, platformCentre, 0, -geo.platformMass_kg * kGravity);
+    // Link 5: D to B through C
+    sys.unknown(BODY_LINK5, B, FORCE_BY, 0, 1);
+    sys.unknown(BODY_LINK5, C, FORCE_CX, 1, 0);
+    sys.unknown(BODY_LINK5, C, FORCE_CY, 0, 1);
+    sys.unknown(BODY_LINK5, D, FORCE_DX, 1, 0);
+    sys.unknown(BODY_LINK5, D, FORCE_DY, 0, 1);
+    sys.known(BODY_LINK5, C, 0, -linkWeight);
+    // Link 6: E to A through C
+    sys.unknown(BODY_LINK6, A, FORCE_AX, 1, 0);
+    sys.unknown(BODY_LINK6, A, FORCE_AY, 0, 1);
+    sys.unknown(BODY_LINK6, C, FORCE_CX, -1, 0);
+    sys.unknown(BODY_LINK6, C, FORCE_CY, 0, -1);
+    sys.unknown(BODY_LINK6, E, FORCE_EX, 1, 0);
+    sys.unknown(BODY_LINK6, E, FORCE_EY, 0, 1);
+    sys.known(BODY_LINK6, C, 0, -linkWeight);
+    // Link 3: G to E through F
+    sys.unknown(BODY_LINK3, E, FORCE_EX, -1, 0);
+    sys.unknown(BODY_LINK3, E, FORCE_EY, 0, -1);
+    sys.unknown(BODY_LINK3, F, FORCE_FX, 1, 0);
+    sys.unknown(BODY_LINK3, F, FORCE_FY, 0, 1);
+    sys.unknown(BODY_LINK3, G, FORCE_GX, 1, 0);
+    sys.unknown(BODY_LINK3, G, FORCE_GY, 0, 1);
+    sys.known(BODY_LINK3, F, 0, -linkWeight);
+    // Link 4: H to D through F, pulled at H by the lead screw
+    sys.unknown(BODY_LINK4, D, FORCE_DX, -1, 0);
+    sys.unknown(BODY_LINK4, D, FORCE_DY, 0, -1);
+    sys.unknown(BODY_LINK4, F, FORCE_FX, -1, 0);
+    sys.unknown(BODY_LINK4, F, FORCE_FY, 0, -1);
+    sys.unknown(BODY_LINK4, H, FORCE_HY, 0, 1);
+    sys.unknown(BODY_LINK4, H, FORCE_THRUST, -1, 0);
+    sys.known(BODY_LINK4, F, 0, -linkWeight);
+    // Base: carries G, H and the screw, stands on the ground at both ends
+    sys.unknown(BODY_BASE, G, FORCE_GX, -1, 0);
+    sys.unknown(BODY_BASE, G, FORCE_GY, 0, -1);
+    sys.unknown(BODY_BASE, H, FORCE_HY, 0, -1);
+    sys.unknown(BODY_BASE, H, FORCE_THRUST, 1, 0);
+    sys.unknown(BODY_BASE, G, FORCE_GROUND_X, 1, 0);
+    sys.unknown(BODY_BASE, G, FORCE_GROUND_A, 0, 1);
+    sys.unknown(BODY_BASE, groundB, FORCE_GROUND_B, 0, 1);
+    sys.known(BODY_BASE, baseCentre, 0, -geo.baseMass_kg * kGravity);
+
+    // 1 kg on the platform
+    sys.b = bPerKg;
+    sys.known(BODY_PLATFORM, load, 0, -kGravity);
+}
+
+bool LiftStatics::solve(double height_m, double load_kg, LiftForces &out) const {
+    if (height_m <= 0 || height_m >= 2 * geo.link_m) return false;
+    double a[N * N], bWeights[N], bPerKg[N];
+    int pivot[N];
+    build(height_m, a, bWeights, bPerKg);
+    if (!factor(a, pivot)) return false;
+    for (int i = 0; i < N; i++) out.x[i] = bWeights[i] + load_kg * bPerKg[i];
+    substitute(a, pivot, out.x, 1);
+    return true;
+}
+
+bool LiftStatics::sweep(const std::vector<double> &heights_m, const std::vector<double> &loads_kg,
+                        LiftSweep &out) const {
+    const size_t loads = loads_kg.size();
+    out.heights_m = heights_m;
+    out.loads_kg = loads_kg;
+    out.maxPin_N.assign(heights_m.size() * loads, 0.0f);
+    out.thrust_N.assign(heights_m.size() * loads, 0.0f);
+    double a[N * N], bWeights[N], bPerKg[N];
+    int pivot[N];
+    std::vector<double> x(N * loads);           // Unknown i of load k at x[i * loads + k]
+    std::vector<double> most(loads);
+    for (size_t h = 0; h < heights_m.size(); h++) {
+        if (heights_m[h] <= 0 || heights_m[h] >= 2 * geo.link_m) return false;
+        build(heights_m[h], a, bWeights, bPerKg);
+        if (!factor(a, pivot)) return false;
+        for (int i = 0; i < N; i++) {
+            double *row = x.data() + i * loads;
+            for (size_t k = 0; k < loads; k++) row[k] = bWeights[i] + loads_kg[k] * bPerKg[i];
+        }
+        substitute(a, pivot, x.data(), loads);
+
+        // Largest pin resultant per load, one joint at a time
+        auto component = [&](int unknown) { return x.data() + unknown * loads; };
+        std::fill(most.begin(), most.end(), 0.0);
+        const int pairs[][2] = {{FORCE_AX, FORCE_AY}, {FORCE_CX, FORCE_CY}, {FORCE_DX, FORCE_DY}, {FORCE_EX, FORCE_EY},
+                                {FORCE_FX, FORCE_FY}, {FORCE_GX, FORCE_GY}, {FORCE_THRUST, FORCE_HY}};
+        for (const auto &pair : pairs) {
+            const double *fx = component(pair[0]), *fy = component(pair[1]);
+            for (size_t k = 0; k < loads; k++) most[k] = std::max(most[k], fx[k] * fx[k] + fy[k] * fy[k]);
+        }
+        const double *by = component(FORCE_BY), *thrust = component(FORCE_THRUST);
+        float *pinOut = out.maxPin_N.data() + h * loads, *thrustOut = out.thrust_N.data() + h * loads;
+        for (size_t k = 0; k < loads; k++) {
+            pinOut[k] = static_cast<float>(std::sqrt(std::max(most[k], by[k] * by[k])));
+            thrustOut[k] = static_cast<float>(std::fabs(thrust[k]));
+        }
+    }
+    return true;
+}
+
+// LOAD TABLE
+bool LiftStatics::loadLimits(const LiftRatings &ratings, LiftLoadLimits &out, unsigned step_mm,
+                             double maxLoad_kg) const {
+    const int kPerBin = 4;
+    out.minHeight_mm = static_cast<unsigned>(std::floor(minHeight_m() * 1000));
+    out.step_mm = std::max(1u, step_mm);
+    unsigned bins = static_cast<unsigned>((maxHeight_m() * 1000 - out.minHeight_mm) / out.step_mm) + 1;
+    std::vector<double> heights, loads;
+    for (unsigned i = 0; i < bins * kPerBin + 1; i++) {
+        double h = (out.minHeight_mm + i * out.step_mm / static_cast<double>(kPerBin)) / 1000;
+        heights.push_back(std::min(maxHeight_m(), std::max(minHeight_m(), h)));
+    }
+    for (int hg = 0; hg <= static_cast<int>(std::lround(maxLoad_kg * 10)); hg++) loads.push_back(hg / 10.0);
+    LiftSweep grid;
+    if (!sweep(heights, loads, grid)) return false;
+    out.cases = heights.size() * loads.size();
+    out.limit_hg.assign(bins, 0);
+    for (unsigned bin = 0; bin < bins; bin++) {
+        size_t limit = loads.size() - 1;
+        for (size_t h = bin * kPerBin; h <= (bin + 1) * kPerBin; h++) {
+            size_t safe = 0;
+            while (safe < loads.size() && grid.safe(h, safe, ratings)) safe++;
+            if (safe == 0) {
+                limit = 0;                      // Not even empty
+                break;
+            }
+            limit = std::min(limit, safe - 1);
+        }
+        out.limit_hg[bin] = static_cast<unsigned>(limit);
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftStatics.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Static force solver of the two-stage scissor lift (Static_Analysis/):
+ *     - Builds the equilibrium system A·x = b of the platform (7), the four
+ *       links (3, 4, 5, 6) and the base (2): three equations per body, the
+ *       pin forces, the lead-screw thrust and the ground reactions as the
+ *       unknowns in x, every known weight and the load in b
+ *     - The actuator pulls the lower roller (H) towards the fixed pin (G),
+ *       which makes the system square and statically determinate
+ *     - sweep() solves a height × load grid: A only depends on the height,
+ *       so it is factorized once per height and every load is solved in
+ *       the same pass, loads contiguous in memory
+ *   Joints as in Digital_3.jpeg: A and B on the platform (B rolls), C and
+ *   F where the links cross, D and E between the stages, G and H on the
+ *   base (H rolls). H sits L·cos(a) from G, so the lead screw's step
+ *   count sets the link angle and the platform height.
+ *   Host tools only: the firmware uses the tables that lift_statics
+ *   generates (LiftLoadTable.h, LiftHeightTable.h).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LIFT_STATICS_H_
+#define _LIFT_STATICS_H_
+
+#include <cstddef>
+#include <vector>
+
+// Dimensions and masses from Static_Analysis/Digital_2.jpeg
+struct ScissorGeometry {
+    double link_m = 0.2025;             // y, pin to pin
+    double platform_m = 0.215;          // x
+    double base_m = 0.2325;             // z
+    double platformMass_kg = 2.4962;    // mp
+    double linkMass_kg = 0.1569;        // ms, each of the four links
+    double baseMass_kg = 9.4907;        // mb
+    double loadOffset_m = 0;            // Load centre from the platform centre, towards B
+    double minAngle_deg = 5;            // Links at rest
+    double maxAngle_deg = 60;           // Links at the height sensor
+    double screwStep_m = 0.0001;        // Roller H travel per lift motor step (lead screw)
+};
+
+// What the parts can take
+struct LiftRatings {
+    double pin_N = 6233;                // 8 mm pins in double shear at 62 MPa (304 steel, safety factor 2)
+    double thrust_N = 4000;             // Axial load rating of the lead-screw nut
+};
+
+enum LiftUnknown {
+    FORCE_AX, FORCE_AY,                 // Platform on link 6
+    FORCE_BY,                           // Platform on link 5, vertical only (roller)
+    FORCE_CX, FORCE_CY,                 // Link 6 on link 5
+    FORCE_DX, FORCE_DY,                 // Link 4 on link 5
+    FORCE_EX, FORCE_EY,                 // Link 3 on link 6
+    FORCE_FX, FORCE_FY,                 // Link 4 on link 3
+    FORCE_GX, FORCE_GY,                 // Base on link 3
+    FORCE_HY,                           // Base on link 4, vertical only (roller)
+    FORCE_THRUST,                       // Lead screw pulling link 4 at H towards G
+    FORCE_GROUND_X,                     // Ground on the base
+    FORCE_GROUND_A,                     // Ground under G's end of the base
+    FORCE_GROUND_B,                     // Ground under the far end of the base
+    kLiftUnknowns,
+};
+
+enum LiftJoint { JOINT_A, JOINT_B, JOINT_C, JOINT_D, JOINT_E, JOINT_F, JOINT_G, JOINT_H, kLiftJoints };
+
+struct LiftForces {
+    double x[kLiftUnknowns];            // N, in LiftUnknown order
+
+    double pin(int joint) const;        // Resultant carried by a joint pin
+    double maxPin() const;
+    double thrust() const { return x[FORCE_THRUST]; }
+};
+
+// Maximum pin force and thrust over a height × load grid, [height][load]
+struct LiftSweep {
+    std::vector<double> heights_m, loads_kg;
+    std::vector<float> maxPin_N, thrust_N;
+
+    size_t at(size_t height, size_t load) const { return height * loads_kg.size() + load; }
+    bool safe(size_t height, size_t load, const LiftRatings &ratings) const {
+        return maxPin_N[at(height, load)] <= ratings.pin_N && thrust_N[at(height, load)] <= ratings.thrust_N;
+    }
+};
+
+// Rows of a LiftLoadTable: safe load per height bin, the worst case inside the bin
+struct LiftLoadLimits {
+    unsigned minHeight_mm = 0;
+    unsigned step_mm = 0;
+    std::vector<unsigned> limit_hg;     // 0.1 kg
+    size_t cases = 0;                   // Height × load cases swept
+};
+
+// Rows of a LiftHeightTable: platform height every stride_steps from rest
+struct LiftStepHeights {
+    unsigned stride_steps = 0;
+    std::vector<unsigned> height_dmm;   // 0.1 mm
+};
+
+class LiftStatics {
+public:
+    static constexpr int kEquations = kLiftUnknowns;     // Three per body, six bodies
+
+    explicit LiftStatics(const ScissorGeometry &geometry = ScissorGeometry()) : geo(geometry) {}
+
+    // Platform height above the base pins (G to A) and the link angle giving it
+    double height_m(double angle_rad) const;
+    double angleFor(double height_m) const;
+    double minHeight_m() const;
+    double maxHeight_m() const;
+    // Lift motor steps from rest for a height, and back: the screw moves H by screwStep_m per step
+    double stepsFor(double height_m) const;
+    double heightAtStep_m(double steps) const;
+    // From rest to the height sensor, one row every stride_steps
+    void stepHeights(unsigned stride_steps, LiftStepHeights &out) const;
+
+    // The system for one height: A (row major), b split into weights and 1 kg of load
+    void build(double height_m, double *a, double *bWeights, double *bPerKg) const;
+
+    // false for a height the links cannot reach (singular system)
+    bool solve(double height_m, double load_kg, LiftForces &out) const;
+    bool sweep(const std::vector<double> &heights_m, const std::vector<double> &loads_kg, LiftSweep &out) const;
+    // Sweeps the travel in step_mm bins (4 heights each) and loads up to maxLoad_kg in 0.1 kg steps
+    bool loadLimits(const LiftRatings &ratings, LiftLoadLimits &out, unsigned step_mm = 10, double maxLoad_kg = 50) const;
+
+    const ScissorGeometry &geometry() const { return geo; }
+
+private:
+    ScissorGeometry geo;
+};
+
+#endif // _LIFT_STATICS_H_
@@ -0,0 +1,46 @@
+/*
+ * Project: AGV and Scissor Lift Control - Scissor Lift Statics
+ * File: LiftStepHeights.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Generated by lift_statics --height-header from the geometry, do not edit.
+ *   Links 202.5 mm, 5 to 60 deg, 0.100 mm of screw travel per step.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LIFT_STEP_HEIGHTS_H_
+#define _LIFT_STEP_HEIGHTS_H_
+
+#include "LiftHeightTable.h"
+
+// Platform height (0.1 mm) every 4 lift steps from rest
+const uint16_t liftStepHeights_dmm[253] = {
+    353, 435, 503, 564, 618, 668, 714, 757, 798, 837, 874, 909,
+    943, 976, 1008, 1039, 1068, 1097, 1125, 1152, 1179, 1205, 1230, 1255,
+    1279, 1303, 1327, 1349, 1372, 1394, 1415, 1437, 1458, 1478, 1498, 1518,
+    1538, 1557, 1576, 1595, 1614, 1632, 1650, 1668, 1686, 1703, 1720, 1737,
+    1754, 1770, 1787, 1803, 1819, 1835, 1850, 1866, 1881, 1896, 1911, 1926,
+    1941, 1956, 1970, 1984, 1998, 2013, 2026, 2040, 2054, 2067, 2081, 2094,
+    2107, 2120, 2133, 2146, 2159, 2172, 2184, 2197, 2209, 2221, 2233, 2245,
+    2257, 2269, 2281, 2293, 2304, 2316, 2327, 2339, 2350, 2361, 2372, 2383,
+    2394, 2405, 2416, 2427, 2437, 2448, 2458, 2469, 2479, 2489, 2500, 2510,
+    2520, 2530, 2540, 2550, 2560, 2569, 2579, 2589, 2598, 2608, 2617, 2627,
+    2636, 2645, 2655, 2664, 2673, 2682, 2691, 2700, 2709, 2718, 2727, 2735,
+    2744, 2753, 2761, 2770, 2779, 2787, 2795, 2804, 2812, 2820, 2829, 2837,
+    2845, 2853, 2861, 2869, 2877, 2885, 2893, 2900, 2908, 2916, 2924, 2931,
+    2939, 2947, 2954, 2962, 2969, 2976, 2984, 2991, 2998, 3006, 3013, 3020,
+    3027, 3034, 3041, 3048, 3055, 3062, 3069, 3076, 3083, 3090, 3096, 3103,
+    3110, 3116, 3123, 3130, 3136, 3143, 3149, 3156, 3162, 3168, 3175, 3181,
+    3187, 3194, 3200, 3206, 3212, 3218, 3224, 3231, 3237, 3243, 3249, 3254,
+    3260, 3266, 3272, 3278, 3284, 3289, 3295, 3301, 3307, 3312, 3318, 3323,
+    3329, 3335, 3340, 3345, 3351, 3356, 3362, 3367, 3372, 3378, 3383, 3388,
+    3393, 3399, 3404, 3409, 3414, 3419, 3424, 3429, 3434, 3439, 3444, 3449,
+    3454, 3459, 3464, 3469, 3474, 3478, 3483, 3488, 3493, 3497, 3502, 3506,
+    3511,
+};
+
+const LiftHeightTable liftHeightTable = {4, 253, liftStepHeights_dmm};
+
+#endif // _LIFT_STEP_HEIGHTS_H_
@@ -0,0 +1,187 @@
+/*
+ * Project: AGV and Scissor Lift Control - Line Following Controller
+ * File: LineController.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Pattern-history error estimate, PID step and duty table of the
+ *   LineController. update() runs in the esp_timer task every period.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LineController.h>
+#include <SensorTrace.h>
+#include <algorithm>
+#include <cmath>
+
+// ERROR ESTIMATE
+void LineEstimator::reset() {
+    lastError = 0;
+    centred = false;
+    lostLine = false;
+    markSeen = false;
+    offCount = 0;
+}
+
+int8_t LineEstimator::update(int left, int right) {
+    int8_t error;
+    switch ((left << 1) | right) {
+        case 0b11: // Centred on the tape
+            error = 0;
+            centred = true;
+            lostLine = false;
+            offCount = 0;
+            break;
+        case 0b01: // Left sensor off the tape: line is to the right
+            error = 1;
+            lostLine = false;
+            offCount = 0;
+            break;
+        case 0b10: // Right sensor off the tape: line is to the left
+            error = -1;
+            lostLine = false;
+            offCount = 0;
+            break;
+        default: // Both off: lost on the side seen last, or a mark after a centred reading
+            if (lastError != 0) {
+                error = lastError > 0 ? 2 : -2;
+                lostLine = true;
+                if (++offCount >= kLostSamples) markSeen = true;    // Reached the mark off-centre, or no line
+            }
+            else {
+                error = 0;
+                if (centred && ++offCount >= kMarkSamples) markSeen = true;
+            }
+            break;
+    }
+    lastError = error;
+    return error;
+}
+
+// SETUP
+bool LineController::setup(SimpleGPIO &leftSensor, SimpleGPIO &rightSensor, SimplePWM &motorRight, SimplePWM &motorLeft,
+                           const LineGains &gains, uint32_t period_us, float deadband) {
+    this->leftSensor = &leftSensor;
+    this->rightSensor = &rightSensor;
+    this->motorRight = &motorRight;
+    this->motorLeft = &motorLeft;
+    this->gains = gains;
+    period = period_us;
+    buildTable(deadband);
+    esp_timer_create_args_t args = {timerCallback, this, ESP_TIMER_TASK, "line_pid", true};
+    return esp_timer_create(&args, &timer) == ESP_OK;
+}
+
+// Duty % for every speed step and steering step, with the motor dead band folded in
+void LineController::buildTable(float deadband) {
+    for (int s = 0; s <= kSpeedSteps; s++) {
+        float speed = 100.0f * s / kSpeedSteps;
+        for (int i = 0; i <= 2 * kSteerSteps; i++) {
+            float steer = static_cast<float>(i - kSteerSteps) / kSteerSteps;
+            float wheel[2] = {speed * (1.0f - steer), speed * (1.0f + steer)};  // Right, left
+            for (int w = 0; w < 2; w++) {
+                float duty = std::clamp(wheel[w], 0.0f, 100.0f);
+                if (duty > 0) duty = deadband + duty * (100.0f - deadband) / 100.0f;
+                dutyTable[s][i][w] = static_cast<uint8_t>(std::lround(duty));
+            }
+        }
+    }
+}
+
+// RUN CONTROL
+void LineController::start(float speed, bool useTimer) {
+    if (running()) stop();
+    estimator.reset();
+    error = 0;
+    errorStep = 0;
+    errorChangedAt_us = previousChangeAt_us = esp_timer_get_time();
+    integral = 0;
+    derivative = 0;
+    lastSteering = 0;
+    lastRun_us = 0;
+    appliedRight = appliedLeft = 255;
+    loopJitter = LoopJitter();
+    mark.store(false, std::memory_order_relaxed);
+    lineLost.store(false, std::memory_order_relaxed);
+    setSpeed(speed);
+    active.store(true, std::memory_order_relaxed);
+    applyDuties(kSteerSteps);                        // Straight until the first sample
+    if (useTimer) esp_timer_start_periodic(timer, period);
+}
+
+void LineController::stop() {
+    if (esp_timer_is_active(timer)) esp_timer_stop(timer);
+    active.store(false, std::memory_order_relaxed);
+    motorRight->setDuty(0);
+    motorLeft->setDuty(0);
+    appliedRight = appliedLeft = 0;
+}
+
+void LineController::setSpeed(float speed) {
+    int index = static_cast<int>(std::lround(std::clamp(speed, 0.0f, 100.0f) * kSpeedSteps / 100.0f));
+    speedIndex.store(index, std::memory_order_relaxed);
+}
+
+void LineController::timerCallback(void *arg) {
+    static_cast<LineController *>(arg)->update();
+}
+
+void LineController::update() {
+    int64_t now = esp_timer_get_time();
+    int64_t dt_us = period;
+    if (lastRun_us != 0) {
+        dt_us = now - lastRun_us;
+        int64_t deviation = dt_us > period ? dt_us - period : period - dt_us;
+        loopJitter.count++;
+        loopJitter.sumDeviation_us += deviation;
+        loopJitter.maxDeviation_us = std::max(loopJitter.maxDeviation_us, deviation);
+        loopJitter.maxPeriod_us = std::max(loopJitter.maxPeriod_us, dt_us);
+    }
+    lastRun_us = now;
+    if (mark.load(std::memory_order_relaxed)) return;   // Parked on the mark until stop()
+
+    int8_t e = estimator.update(sensorTraceGet(*leftSensor), sensorTraceGet(*rightSensor));
+    if (estimator.atMark()) {
+        motorRight->setDuty(0);
+        motorLeft->setDuty(0);
+        appliedRight = appliedLeft = 0;
+        lineLost.store(estimator.lost(), std::memory_order_relaxed);
+        mark.store(true, std::memory_order_release);     // Publishes lineLost too
+        return;
+    }
+    // Digital sensors: slope = last step over the time between the last two changes, fading after
+    if (e != error) {
+        errorStep = static_cast<int8_t>(e - error);
+        previousChangeAt_us = errorChangedAt_us;
+        errorChangedAt_us = now;
+        error = e;
+    }
+    float dt = dt_us * 1e-6f;
+    float sinceChange = std::max<int64_t>(now - previousChangeAt_us, period) * 1e-6f;
+    float rawDerivative = errorStep / sinceChange;
+    derivative += (rawDerivative - derivative) * dt / (gains.derivativeLag_s + dt);
+    if (gains.ki > 0) {
+        integral += e * dt;
+        float limit = gains.integralLimit / gains.ki;
+        integral = std::clamp(integral, -limit, limit);
+    }
+    float u = gains.kp * e + gains.ki * integral + gains.kd * derivative;
+    lastSteering = std::clamp(u, -1.0f, 1.0f);
+    applyDuties(static_cast<int>(std::lround(lastSteering * kSteerSteps)) + kSteerSteps);
+}
+
+// Writes only the duties that changed
+void LineController::applyDuties(int steerIndex) {
+    int s = speedIndex.load(std::memory_order_relaxed);
+    uint8_t right = dutyTable[s][steerIndex][0];
+    uint8_t left = dutyTable[s][steerIndex][1];
+    if (right != appliedRight) {
+        motorRight->setDuty(right);
+        appliedRight = right;
+    }
+    if (left != appliedLeft) {
+        motorLeft->setDuty(left);
+        appliedLeft = left;
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Project: AGV and Scissor Lift Control - Line Following Controller
+ * File: LineController.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Fixed-rate PID steering for the two digital line follower sensors.
+ *     - A periodic esp_timer (500 Hz by default) samples both sensors and
+ *       updates the motor duties, independent of the control loop
+ *     - The error is estimated from the sensor pattern and its history:
+ *       a sensor that leaves the tape after the other one says on which
+ *       side the line was lost, and the derivative is taken over the
+ *       time between error changes
+ *     - The derivative goes through a first order lag (lead-lag instead
+ *       of a raw D term) and the integral is clamped against windup
+ *     - Duties come from a [speed][steering] table built once in setup(),
+ *       so the timer callback does no clamping or scaling
+ *     - Both sensors off after a centred reading is a station mark: the
+ *       motors stop and atMark() latches. Lost on one side for longer
+ *       than kLostSamples also stops and latches, with lost() set: that
+ *       is a line that was never found again (or a mark reached far
+ *       off-centre), which the caller must not take for a station
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LINE_CONTROLLER_H_
+#define _LINE_CONTROLLER_H_
+
+#include <SimpleGPIO.h>
+#include <SimplePWM.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cstdint>
+
+struct LineGains {
+    float kp = 0.35f;                   // Steering per error unit
+    float ki = 0.4f;                    // Per error unit and second
+    float kd = 0.03f;                   // Seconds
+    float derivativeLag_s = 0.01f;      // First order filter on the D term
+    float integralLimit = 0.5f;         // Clamp of ki * integral
+};
+
+// Period statistics of the timer callback
+struct LoopJitter {
+    int64_t count = 0;
+    int64_t sumDeviation_us = 0;        // Sum of |period - nominal|
+    int64_t maxDeviation_us = 0;
+    int64_t maxPeriod_us = 0;
+
+    int64_t average_us() const { return count > 0 ? sumDeviation_us / count : 0; }
+};
+
+// Sensor pattern history to error, shared by the firmware and host tests
+class LineEstimator {
+public:
+    static constexpr int kMarkSamples = 3;      // Consecutive off readings before a mark counts
+    static constexpr int kLostSamples = 150;    // Lost readings before giving up on the line (300 ms at 500 Hz)
+
+    void reset();
+    // left/right = 1 when the sensor is over the tape; returns the error in [-2, 2]
+    int8_t update(int left, int right);
+    bool atMark() const { return markSeen; }
+    bool lost() const { return lostLine; }
+
+private:
+    int8_t lastError = 0;
+    bool centred = false;               // Both sensors on the tape since the last reset
+    bool lostLine = false;
+    bool markSeen = false;
+    int offCount = 0;
+};
+
+class LineController {
+public:
+    static constexpr uint32_t kDefaultPeriod_us = 2000;    // 500 Hz
+    static constexpr int kSteerSteps = 32;                  // Table resolution per side
+    static constexpr int kSpeedSteps = 20;                  // 5 % speed steps
+
+    // motorRight/motorLeft as wired: a positive steering speeds up the left wheel
+    bool setup(SimpleGPIO &leftSensor, SimpleGPIO &rightSensor, SimplePWM &motorRight, SimplePWM &motorLeft,
+               const LineGains &gains = LineGains(), uint32_t period_us = kDefaultPeriod_us, float deadband = 0.0f);
+    // Reset the history and follow the line at speed % duty; without the timer
+    // the caller runs update() itself (host benchmarks)
+    void start(float speed, bool useTimer = true);
+    void stop();                        // Stop the timer and both motors
+    void setSpeed(float speed);         // Cruise duty %, safe to call while running
+    void update();                      // One control step, called by the timer
+
+    bool running() const { return active.load(std::memory_order_relaxed); }
+    bool atMark() const { return mark.load(std::memory_order_acquire); }    // Stopped, on a mark or lost
+    bool lost() const { return lineLost.load(std::memory_order_acquire); }  // Stopped by the lost-line budget
+    float steering() const { return lastSteering; }
+    const LoopJitter &jitter() const { return loopJitter; }
+    uint32_t period_us() const { return period; }
+
+    // Table lookup, exposed for tests
+    uint8_t dutyLeft(int speedIndex, int steerIndex) const { return dutyTable[speedIndex][steerIndex][1]; }
+    uint8_t dutyRight(int speedIndex, int steerIndex) const { return dutyTable[speedIndex][steerIndex][0]; }
+
+private:
+    static void timerCallback(void *arg);
+    void buildTable(float deadband);
+    void applyDuties(int steerIndex);
+
+    SimpleGPIO *leftSensor = nullptr;
+    SimpleGPIO *rightSensor = nullptr;
+    SimplePWM *motorRight = nullptr;
+    SimplePWM *motorLeft = nullptr;
+    LineGains gains;
+    uint32_t period = kDefaultPeriod_us;
+    esp_timer_handle_t timer = nullptr;
+
+    // [speed][steering][right, left] duty %, built once
+    uint8_t dutyTable[kSpeedSteps + 1][2 * kSteerSteps + 1][2];
+
+    // Controller state, only touched by update() once running
+    LineEstimator estimator;
+    int8_t error = 0;
+    int8_t errorStep = 0;               // Size of the last error change
+    int64_t errorChangedAt_us = 0;
+    int64_t previousChangeAt_us = 0;
+    float integral = 0;
+    float derivative = 0;
+    float lastSteering = 0;
+    int64_t lastRun_us = 0;
+    uint8_t appliedRight = 255, appliedLeft = 255;   // 255 = nothing written yet
+    LoopJitter loopJitter;
+
+    // Shared with the control loop
+    std::atomic<int> speedIndex{0};
+    std::atomic<bool> active{false};
+    std::atomic<bool> mark{false};
+    std::atomic<bool> lineLost{false};
+};
+
+#endif // _LINE_CONTROLLER_H_
@@ -0,0 +1,99 @@
+/*
+ * Project: AGV and Scissor Lift Control - Load Cell Calibration
+ * File: LoadCellCalibration.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Two-point coefficients and the NVS record of CalibrationStore.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LoadCellCalibration.h>
+#include <cmath>
+#include <cstring>
+
+bool twoPointCalibration(float tare_mV, float reference_mV, float reference_kg, LoadCalibration &out) {
+    float span = reference_mV - tare_mV;
+    if (!(reference_kg > 0) || !(std::fabs(span) >= LOAD_CAL_MIN_SPAN_MV)) return false;
+    out.slope = reference_kg / span;
+    out.offset = -out.slope * tare_mV;
+    out.tare_mV = tare_mV;
+    out.reference_kg = reference_kg;
+    return true;
+}
+
+// NVS STORE
+bool CalibrationStore::begin() {
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        if (nvs_flash_erase() != ESP_OK) return false;  // Partition from another layout, start blank
+        err = nvs_flash_init();
+    }
+    return err == ESP_OK;
+}
+
+CalibrationStatus CalibrationStore::load(LoadCalibration &out) {
+    nvs_handle_t handle;
+    if (nvs_open(LOAD_CAL_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) return CAL_NVS_ERROR;
+    Record record;
+    size_t length = sizeof(record);
+    esp_err_t err = nvs_get_blob(handle, LOAD_CAL_KEY, &record, &length);
+    nvs_close(handle);
+    if (err == ESP_ERR_NVS_NOT_FOUND) return CAL_MISSING;
+    if (err == ESP_ERR_NVS_INVALID_LENGTH) return CAL_BAD_CHECKSUM;    // Larger than any record
+    if (err != ESP_OK) return CAL_NVS_ERROR;
+    if (length < offsetof(Record, calibration) || record.magic != kMagic) return CAL_BAD_CHECKSUM;
+    if (record.version != kVersion) return CAL_BAD_VERSION;
+    if (length != sizeof(record) || record.size != sizeof(record)) return CAL_BAD_CHECKSUM;
+    if (record.crc != crc32(&record, offsetof(Record, crc))) return CAL_BAD_CHECKSUM;
+    const LoadCalibration &c = record.calibration;
+    if (!std::isfinite(c.slope) || !std::isfinite(c.offset) || c.slope == 0) return CAL_BAD_CHECKSUM;
+    out = c;
+    return CAL_OK;
+}
+
+bool CalibrationStore::save(const LoadCalibration &calibration) {
+    Record record;
+    memset(&record, 0, sizeof(record));                 // Padding is part of the CRC
+    record.magic = kMagic;
+    record.version = kVersion;
+    record.size = sizeof(record);
+    record.calibration = calibration;
+    record.crc = crc32(&record, offsetof(Record, crc));
+    nvs_handle_t handle;
+    if (nvs_open(LOAD_CAL_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) return false;
+    bool ok = nvs_set_blob(handle, LOAD_CAL_KEY, &record, sizeof(record)) == ESP_OK && nvs_commit(handle) == ESP_OK;
+    nvs_close(handle);
+    return ok;
+}
+
+bool CalibrationStore::erase() {
+    nvs_handle_t handle;
+    if (nvs_open(LOAD_CAL_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) return false;
+    esp_err_t err = nvs_erase_key(handle, LOAD_CAL_KEY);
+    bool ok = (err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND) && nvs_commit(handle) == ESP_OK;
+    nvs_close(handle);
+    return ok;
+}
+
+const char *CalibrationStore::statusName(CalibrationStatus status) {
+    switch (status) {
+        case CAL_OK: return "ok";
+        case CAL_MISSING: return "missing";
+        case CAL_BAD_VERSION: return "old version";
+        case CAL_BAD_CHECKSUM: return "corrupt";
+        default: return "NVS error";
+    }
+}
+
+// CRC-32 (IEEE, reflected), bitwise: runs once per boot on a few bytes
+uint32_t CalibrationStore::crc32(const void *data, size_t length) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
@@ -0,0 +1,74 @@
+/*
+ * Project: AGV and Scissor Lift Control - Load Cell Calibration
+ * File: LoadCellCalibration.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Two-point load cell calibration kept in NVS across power cycles.
+ *     - twoPointCalibration() turns the empty (tare) reading and the
+ *       reading of a known mass into kg = slope * mV + offset; fixedKg()
+ *       is the same line in integer math, for readings in uV
+ *     - CalibrationStore saves one fixed-size record (magic, version,
+ *       size, coefficients, CRC-32) as an NVS blob and only hands it back
+ *       when every field checks out; a single blob read at setup()
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LOAD_CELL_CALIBRATION_H_
+#define _LOAD_CELL_CALIBRATION_H_
+
+#include <FixedPoint.h>
+#include <nvs_flash.h>
+#include <cstddef>
+#include <cstdint>
+
+#define LOAD_CAL_NAMESPACE "loadcell"       // NVS namespace and key of the record
+#define LOAD_CAL_KEY "cal"
+#define LOAD_CAL_MIN_SPAN_MV 5.0f           // Reference mass must move the reading at least this much
+
+struct LoadCalibration {
+    float slope;                // kg per mV
+    float offset;               // kg at 0 mV
+    float tare_mV;              // Empty reading when calibrated
+    float reference_kg;         // Mass used for the second point
+
+    float kg(float mV) const { return slope * mV + offset; }
+    FixedLine<20, 40> fixedKg() const { return FixedLine<20, 40>::fromFloat(slope / 1000.0, offset); }  // Q20 kg from uV
+};
+
+// false when the points are too close or the mass is not positive
+bool twoPointCalibration(float tare_mV, float reference_mV, float reference_kg, LoadCalibration &out);
+
+enum CalibrationStatus {
+    CAL_OK,
+    CAL_MISSING,                // Never saved or erased
+    CAL_BAD_VERSION,            // Saved by another record layout
+    CAL_BAD_CHECKSUM,           // Wrong size, magic or CRC, or unusable coefficients
+    CAL_NVS_ERROR,
+};
+
+class CalibrationStore {
+public:
+    static constexpr uint32_t kMagic = 0x4C43414C;     // "LCAL"
+    static constexpr uint16_t kVersion = 1;
+
+    bool begin();                                       // Initializes NVS, erasing an unreadable partition
+    CalibrationStatus load(LoadCalibration &out);       // out is untouched unless CAL_OK
+    bool save(const LoadCalibration &calibration);
+    bool erase();
+
+    static const char *statusName(CalibrationStatus status);
+    static uint32_t crc32(const void *data, size_t length);
+
+private:
+    struct Record {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t size;
+        LoadCalibration calibration;
+        uint32_t crc;                                   // Over every byte before it
+    };
+};
+
+#endif // _LOAD_CELL_CALIBRATION_H_
@@ -0,0 +1,120 @@
+/*
+ * Project: AGV and Scissor Lift Control - Load Cell Filter
+ * File: LoadCellFilter.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Running-sum statistics and the timer sampling of LoadCellFilter.
+ *   Samples are kept in integer grams so the sums are exact.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <LoadCellFilter.h>
+#include <SensorTrace.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// STREAMING STATISTICS
+void LoadCellStats::reset() {
+    recentPos = recentCount = 0;
+    pos = count = 0;
+    sum = sumSquares = newerSum = 0;
+}
+
+void LoadCellStats::setTarget(float target_kg, const SettleLimits &limits) {
+    this->target_kg = target_kg;
+    this->limits = limits;
+}
+
+int32_t LoadCellStats::median() const {
+    int n = std::min(recentCount, kMedianWindow);
+    if (n <= 0) return 0;                               // Nothing pushed since reset()
+    std::array<int32_t, kMedianWindow> sorted;
+    std::copy(recent, recent + n, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + n);
+    return sorted[n / 2];
+}
+
+LoadStats LoadCellStats::push(float kg) {
+    // Spike rejection
+    recent[recentPos] = static_cast<int32_t>(std::lround(kg * 1000.0f));
+    recentPos = (recentPos + 1) % kMedianWindow;
+    if (recentCount < kMedianWindow) recentCount++;
+    int32_t grams = median();
+
+    // Window update: drop the oldest sample, move the middle one to the older half
+    const int half = kWindow / 2;
+    if (count == kWindow) {
+        int32_t oldest = window[pos];
+        sum -= oldest;
+        sumSquares -= static_cast<int64_t>(oldest) * oldest;
+    }
+    else count++;
+    if (count > half) newerSum -= window[(pos + kWindow - half) % kWindow];
+    window[pos] = grams;
+    pos = (pos + 1) % kWindow;
+    sum += grams;
+    sumSquares += static_cast<int64_t>(grams) * grams;
+    newerSum += grams;
+
+    LoadStats out = {};
+    float mean = static_cast<float>(sum) / count;
+    float variance = std::max(0.0f, static_cast<float>(sumSquares - sum * sum / count) / count);
+    out.weight_kg = mean / 1000.0f;
+    out.stddev_kg = std::sqrt(variance) / 1000.0f;
+    if (count > half) {
+        float newer = static_cast<float>(newerSum) / half;
+        float older = static_cast<float>(sum - newerSum) / (count - half);
+        out.trend_kg = (newer - older) / 1000.0f;
+    }
+    float standardError = out.stddev_kg / std::sqrt(static_cast<float>(count));
+    out.settled = count == kWindow && out.stddev_kg <= limits.maxStddev_kg &&
+                  std::fabs(out.trend_kg) <= limits.maxTrend_kg &&
+                  std::fabs(out.weight_kg - target_kg) + 2.0f * standardError <= limits.tolerance_kg;
+    out.timestamp_us = esp_timer_get_time();
+    out.seq = ++seq;
+    return out;
+}
+
+// SAMPLING
+bool LoadCellFilter::setup(SimpleADC &adc, float slope, float offset, uint32_t period_us, int oversample) {
+    this->adc = &adc;
+    setCalibration(slope, offset);
+    period = period_us;
+    this->oversample = std::max(1, oversample);
+    esp_timer_create_args_t args = {sampleCallback, this, ESP_TIMER_TASK, "load_cell", true};
+    return esp_timer_create(&args, &timer) == ESP_OK;
+}
+
+void LoadCellFilter::setCalibration(float slope, float offset) {
+    this->slope = slope;
+    this->offset = offset;
+}
+
+void LoadCellFilter::start(float target_kg, const SettleLimits &limits) {
+    stop();
+    stats.reset();
+    stats.setTarget(target_kg, limits);
+    output.publish(LoadStats());
+    esp_timer_start_periodic(timer, period);
+}
+
+void LoadCellFilter::stop() {
+    if (timer != nullptr && esp_timer_is_active(timer)) esp_timer_stop(timer);
+}
+
+LoadStats LoadCellFilter::latest() {
+    LoadStats newest;
+    output.read(newest);
+    return output.current();
+}
+
+void LoadCellFilter::sampleCallback(void *arg) {
+    LoadCellFilter *self = static_cast<LoadCellFilter *>(arg);
+    float mv = 0;
+    for (int i = 0; i < self->oversample; i++) mv += sensorTraceMilliVolts(*self->adc);
+    float kg = self->slope * (mv / self->oversample) + self->offset;
+    self->output.publish(self->stats.push(kg));
+}
@@ -0,0 +1,95 @@
+/*
+ * Project: AGV and Scissor Lift Control - Load Cell Filter
+ * File: LoadCellFilter.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Streaming filter and settling detector for the load cell.
+ *     - LoadCellFilter samples the ADC from a periodic esp_timer (500 Hz),
+ *       averaging several reads per tick (oversampling below one LSB,
+ *       which is 0.1 kg with the current calibration)
+ *     - LoadCellStats runs a 5-sample moving median (drops bumps and
+ *       spikes) into a 64-sample window with running sums in grams, so
+ *       mean, variance and the trend between both window halves cost
+ *       O(1) per sample and never drift
+ *     - "Settled at target" is declared as soon as the window is quiet
+ *       (standard deviation and trend under their limits) and the mean
+ *       is within the tolerance by two standard errors
+ *   The control loop reads the newest LoadStats without waiting.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _LOAD_CELL_FILTER_H_
+#define _LOAD_CELL_FILTER_H_
+
+#include <SimpleADC.h>
+#include <TripleBuffer.h>
+#include <esp_timer.h>
+#include <cstdint>
+
+struct LoadStats {
+    float weight_kg;            // Window mean
+    float stddev_kg;
+    float trend_kg;             // Newer half mean minus older half mean
+    bool settled;               // Quiet and at the target
+    int64_t timestamp_us;
+    uint32_t seq;
+};
+
+struct SettleLimits {
+    float tolerance_kg = 0.05f; // Accepted distance from the target
+    float maxStddev_kg = 0.15f; // Above this the beans are still pouring or bouncing
+    float maxTrend_kg = 0.02f;  // Above this the weight is still moving
+};
+
+// Pure streaming stage, also used by the host tests and the trace benchmark
+class LoadCellStats {
+public:
+    static constexpr int kMedianWindow = 5;
+    static constexpr int kWindow = 64;
+
+    void reset();
+    void setTarget(float target_kg, const SettleLimits &limits = SettleLimits());
+    LoadStats push(float kg);   // One sample in, updated statistics out
+
+private:
+    int32_t median() const;
+
+    float target_kg = 0;
+    SettleLimits limits;
+    int32_t recent[kMedianWindow];
+    int recentPos = 0, recentCount = 0;
+    int32_t window[kWindow];
+    int pos = 0, count = 0;
+    int64_t sum = 0, sumSquares = 0;    // Grams
+    int64_t newerSum = 0;               // Newest kWindow / 2 samples
+    uint32_t seq = 0;
+};
+
+class LoadCellFilter {
+public:
+    static constexpr uint32_t kDefaultPeriod_us = 2000;    // 500 Hz
+    static constexpr int kDefaultOversample = 4;
+
+    // kg = slope * mV + offset
+    bool setup(SimpleADC &adc, float slope, float offset, uint32_t period_us = kDefaultPeriod_us,
+               int oversample = kDefaultOversample);
+    void setCalibration(float slope, float offset);
+    void start(float target_kg, const SettleLimits &limits = SettleLimits());
+    void stop();
+    LoadStats latest();         // Newest statistics, never blocks (single reader)
+
+private:
+    static void sampleCallback(void *arg);
+
+    SimpleADC *adc = nullptr;
+    float slope = 0, offset = 0;
+    uint32_t period = kDefaultPeriod_us;
+    int oversample = kDefaultOversample;
+    esp_timer_handle_t timer = nullptr;
+    LoadCellStats stats;
+    TripleBuffer<LoadStats> output;
+};
+
+#endif // _LOAD_CELL_FILTER_H_
@@ -0,0 +1,111 @@
+/*
+ * Project: AGV and Scissor Lift Control - Register GPIO
+ * File: FastPin.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   GPIOs named by a template argument, driven through the GPIO registers:
+ *     - FastPin<Gpio>: set and clear are one store to the W1TS / W1TC
+ *       register, get() one load of the IN register. The object holds no
+ *       state; an output member on an input-only pad does not compile
+ *     - FastPinGroup<Gpios...>: several pins of one register bank (0-31
+ *       or 32-39) read in one load, raised or lowered in one store
+ *   setup<Mode>() still goes through the driver (pad function and
+ *   direction), once. On the host the registers are a file in the
+ *   simulator that forwards to the World like gpio_set_level().
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _FAST_PIN_H_
+#define _FAST_PIN_H_
+
+#include <PinMap.h>
+#include <SimpleGPIO.h>
+#include <driver/gpio.h>
+#include <soc/gpio_reg.h>
+#include <soc/soc.h>
+#include <cstdint>
+
+#define FAST_PIN_INLINE __attribute__((always_inline)) inline   // Also inside IRAM_ATTR callers
+
+// Registers of the bank a GPIO is in
+constexpr uint32_t gpioSetReg(int gpio) { return gpio < 32 ? GPIO_OUT_W1TS_REG : GPIO_OUT1_W1TS_REG; }
+constexpr uint32_t gpioClearReg(int gpio) { return gpio < 32 ? GPIO_OUT_W1TC_REG : GPIO_OUT1_W1TC_REG; }
+constexpr uint32_t gpioInReg(int gpio) { return gpio < 32 ? GPIO_IN_REG : GPIO_IN1_REG; }
+constexpr uint32_t gpioBit(int gpio) { return uint32_t(1) << (gpio & 31); }
+
+template <int Gpio>
+class FastPin {
+public:
+    static_assert(pinExists(Gpio) && !pinIsFlash(Gpio), "FastPin: the GPIO does not exist or is wired to the SPI flash");
+    static constexpr int kGpio = Gpio;
+
+    // GPI, GPO or GPIO as in SimpleGPIO
+    template <int Mode>
+    void setup() const {
+        static_assert(!(Mode & GPO) || pinCanOutput(Gpio), "FastPin: output on an input-only GPIO (34-39)");
+        gpio_reset_pin(static_cast<gpio_num_t>(Gpio));
+        gpio_set_direction(static_cast<gpio_num_t>(Gpio), Mode == GPIO ? GPIO_MODE_INPUT_OUTPUT
+                                                          : Mode == GPO ? GPIO_MODE_OUTPUT : GPIO_MODE_INPUT);
+    }
+
+    FAST_PIN_INLINE void high() const {
+        static_assert(pinCanOutput(Gpio), "FastPin: output on an input-only GPIO (34-39)");
+        REG_WRITE(gpioSetReg(Gpio), gpioBit(Gpio));
+    }
+    FAST_PIN_INLINE void low() const {
+        static_assert(pinCanOutput(Gpio), "FastPin: output on an input-only GPIO (34-39)");
+        REG_WRITE(gpioClearReg(Gpio), gpioBit(Gpio));
+    }
+    FAST_PIN_INLINE void set(int level) const {
+        static_assert(pinCanOutput(Gpio), "FastPin: output on an input-only GPIO (34-39)");
+        REG_WRITE(level ? gpioSetReg(Gpio) : gpioClearReg(Gpio), gpioBit(Gpio));
+    }
+    FAST_PIN_INLINE int get() const { return (REG_READ(gpioInReg(Gpio)) >> (Gpio & 31)) & 1; }
+};
+
+// Pin i of the group is bit i of read() and write()
+template <int... Gpios>
+class FastPinGroup {
+public:
+    static constexpr int kCount = sizeof...(Gpios);
+    static_assert(kCount > 0 && kCount <= 32, "FastPinGroup: 1 to 32 pins");
+    static_assert(((pinExists(Gpios) && !pinIsFlash(Gpios)) && ...), "FastPinGroup: a GPIO does not exist or is wired to the SPI flash");
+
+private:
+    static constexpr int kGpios[kCount] = {Gpios...};
+    static constexpr bool kHighBank = kGpios[0] >= 32;
+    static constexpr uint32_t kMask = (gpioBit(Gpios) | ...);
+    static_assert((((Gpios >= 32) == kHighBank) && ...), "FastPinGroup: all pins in 0-31 or all in 32-39, one register");
+    static_assert(__builtin_popcount(kMask) == kCount, "FastPinGroup: a GPIO is listed twice");
+
+public:
+    static constexpr uint32_t mask() { return kMask; }
+
+    // Every pin sampled by the same load
+    FAST_PIN_INLINE uint32_t read() const {
+        uint32_t in = REG_READ(gpioInReg(kGpios[0]));
+        uint32_t value = 0;
+        for (int i = 0; i < kCount; i++) value |= ((in >> (kGpios[i] & 31)) & 1) << i;
+        return value;
+    }
+    FAST_PIN_INLINE void high() const {
+        static_assert((pinCanOutput(Gpios) && ...), "FastPinGroup: output on an input-only GPIO (34-39)");
+        REG_WRITE(gpioSetReg(kGpios[0]), kMask);
+    }
+    FAST_PIN_INLINE void low() const {
+        static_assert((pinCanOutput(Gpios) && ...), "FastPinGroup: output on an input-only GPIO (34-39)");
+        REG_WRITE(gpioClearReg(kGpios[0]), kMask);
+    }
+    // Two stores: the raised pins change one store before the lowered ones
+    FAST_PIN_INLINE void write(uint32_t value) const {
+        static_assert((pinCanOutput(Gpios) && ...), "FastPinGroup: output on an input-only GPIO (34-39)");
+        uint32_t raise = 0;
+        for (int i = 0; i < kCount; i++) raise |= ((value >> i) & 1) ? gpioBit(kGpios[i]) : 0;
+        REG_WRITE(gpioSetReg(kGpios[0]), raise);
+        REG_WRITE(gpioClearReg(kGpios[0]), kMask & ~raise);
+    }
+};
+
+#endif // _FAST_PIN_H_
@@ -0,0 +1,126 @@
+/*
+ * Project: AGV and Scissor Lift Control - Pin Map
+ * File: PinMap.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Every GPIO a board uses, in one constexpr table checked by the
+ *   compiler against the ESP32 (WROOM-32) pads:
+ *     - Two entries on one GPIO (a UART TX pin counts, it is driven by
+ *       the peripheral)
+ *     - GPIOs that do not exist (20, 24, 28-31) or carry the SPI flash
+ *       (6-11)
+ *     - Outputs, PWM and UART TX on the input-only pads 34-39
+ *     - Internal pull-ups asked of 34-39, which have none (use
+ *       PIN_INPUT with a resistor on the board)
+ *     - Analog inputs off ADC1 (32-39); ADC2 is unusable with the radio on
+ *   static_assert(kPinMapChecked<map>) stops the build on the first
+ *   conflict; the GPIO and the kind of conflict are in the template
+ *   arguments of the error.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _PIN_MAP_H_
+#define _PIN_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+enum PinUse : uint8_t {
+    PIN_INPUT,          // Digital input, no pull or a resistor on the board
+    PIN_INPUT_PULLUP,   // Digital input on the internal pull-up
+    PIN_OUTPUT,         // Digital output
+    PIN_PWM,            // LEDC output
+    PIN_ADC,            // Analog input
+    PIN_UART_TX,
+    PIN_UART_RX,
+};
+
+struct PinSpec {
+    int gpio;
+    PinUse use;
+    const char *name;
+};
+
+enum PinConflict : uint8_t {
+    PIN_OK,
+    PIN_MISSING,        // No such GPIO on the ESP32
+    PIN_FLASH,          // Wired to the SPI flash
+    PIN_INPUT_ONLY,     // Driven, but 34-39 have no output driver
+    PIN_NO_PULLUP,      // Internal pull-up on 34-39
+    PIN_NO_ADC1,        // Analog input outside ADC1
+    PIN_DUPLICATE,      // GPIO already in the map
+};
+
+// PAD CAPABILITIES
+constexpr bool pinExists(int gpio) {
+    return gpio >= 0 && gpio <= 39 && gpio != 20 && gpio != 24 && (gpio < 28 || gpio > 31);
+}
+
+constexpr bool pinIsFlash(int gpio) { return gpio >= 6 && gpio <= 11; }
+
+constexpr bool pinCanOutput(int gpio) { return pinExists(gpio) && !pinIsFlash(gpio) && gpio < 34; }
+
+constexpr bool pinHasPullup(int gpio) { return pinCanOutput(gpio); }
+
+constexpr bool pinHasAdc1(int gpio) { return gpio >= 32 && gpio <= 39; }
+
+constexpr PinConflict pinCapability(const PinSpec &pin) {
+    if (!pinExists(pin.gpio)) return PIN_MISSING;
+    if (pinIsFlash(pin.gpio)) return PIN_FLASH;
+    switch (pin.use) {
+    case PIN_OUTPUT:
+    case PIN_PWM:
+    case PIN_UART_TX: return pinCanOutput(pin.gpio) ? PIN_OK : PIN_INPUT_ONLY;
+    case PIN_INPUT_PULLUP: return pinHasPullup(pin.gpio) ? PIN_OK : PIN_NO_PULLUP;
+    case PIN_ADC: return pinHasAdc1(pin.gpio) ? PIN_OK : PIN_NO_ADC1;
+    default: return PIN_OK;
+    }
+}
+
+// MAP CHECK
+struct PinCheck {
+    PinConflict conflict;
+    size_t index;       // Entry with the conflict (0 when there is none)
+    constexpr bool ok() const { return conflict == PIN_OK; }
+};
+
+// First conflict in map order
+template <size_t N>
+constexpr PinCheck pinMapCheck(const PinSpec (&map)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        PinConflict capability = pinCapability(map[i]);
+        if (capability != PIN_OK) return {capability, i};
+        for (size_t j = 0; j < i; j++) {
+            if (map[j].gpio == map[i].gpio) return {PIN_DUPLICATE, i};
+        }
+    }
+    return {PIN_OK, 0};
+}
+
+// Use of a GPIO in the map, false when it is not there
+template <size_t N>
+constexpr bool pinMapUses(const PinSpec (&map)[N], int gpio, PinUse use) {
+    for (size_t i = 0; i < N; i++) {
+        if (map[i].gpio == gpio) return map[i].use == use;
+    }
+    return false;
+}
+
+// Carries the failing GPIO into the compiler's message
+template <int Gpio, PinConflict Conflict>
+struct PinConflictAt {
+    static_assert(Conflict != PIN_MISSING, "Pin map: the GPIO does not exist on the ESP32");
+    static_assert(Conflict != PIN_FLASH, "Pin map: the GPIO is wired to the SPI flash");
+    static_assert(Conflict != PIN_INPUT_ONLY, "Pin map: output on an input-only GPIO (34-39)");
+    static_assert(Conflict != PIN_NO_PULLUP, "Pin map: GPIO 34-39 have no internal pull-up");
+    static_assert(Conflict != PIN_NO_ADC1, "Pin map: analog input outside ADC1 (32-39)");
+    static_assert(Conflict != PIN_DUPLICATE, "Pin map: the GPIO is used twice");
+    static constexpr bool ok = Conflict == PIN_OK;
+};
+
+template <const auto &Map>
+inline constexpr bool kPinMapChecked = PinConflictAt<Map[pinMapCheck(Map).index].gpio, pinMapCheck(Map).conflict>::ok;
+
+#endif // _PIN_MAP_H_
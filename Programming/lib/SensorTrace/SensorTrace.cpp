@@ -0,0 +1,197 @@
+/*
+ * Project: AGV and Scissor Lift Control - Sensor Trace
+ * File: SensorTrace.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Trace stream codec and the drain side of SensorRecorder.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <SensorTrace.h>
+#include <cstring>
+
+namespace {
+
+const uint8_t kMagic[4] = {'S', 'T', 'R', 'C'};
+constexpr uint8_t kAnalogFlag = 0x80;
+constexpr uint8_t kLevelFlag = 0x40;
+constexpr uint8_t kPinMask = 0x3F;
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+size_t putVarint(uint64_t value, uint8_t *out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+bool getVarint(const uint8_t *data, size_t length, size_t &pos, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < length; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;                                       // Cut short, or longer than 64 bits
+}
+
+}
+
+// CODEC
+void SensorTraceEncoder::reset() {
+    lastTime_us = 0;
+    for (int32_t &value : lastAnalog) value = 0;
+}
+
+size_t SensorTraceEncoder::header(uint8_t *out) {
+    memcpy(out, kMagic, sizeof(kMagic));
+    out[4] = kSensorTraceVersion;
+    return kSensorTraceHeaderBytes;
+}
+
+size_t SensorTraceEncoder::encode(const SensorSample &sample, uint8_t *out) {
+    size_t n = 1;
+    out[0] = sample.analog ? static_cast<uint8_t>(kAnalogFlag | sample.gpio)
+                           : static_cast<uint8_t>(sample.gpio | (sample.value != 0 ? kLevelFlag : 0));
+    n += putVarint(zigzag(sample.time_us - lastTime_us), out + n);    // Negative when an ISR got ahead
+    lastTime_us = sample.time_us;
+    if (sample.analog) {
+        n += putVarint(zigzag(static_cast<int64_t>(sample.value) - lastAnalog[sample.gpio]), out + n);
+        lastAnalog[sample.gpio] = sample.value;
+    }
+    return n;
+}
+
+size_t SensorTraceEncoder::dropped(uint32_t total, uint8_t *out) {
+    out[0] = kSensorTraceDropTag;
+    return 1 + putVarint(total, out + 1);
+}
+
+SensorTraceStats sensorTraceParse(const uint8_t *data, size_t length, std::vector<SensorSample> &samples) {
+    SensorTraceStats stats;
+    if (length < kSensorTraceHeaderBytes || memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        data[4] != kSensorTraceVersion) {
+        stats.complete = false;
+        return stats;
+    }
+    int64_t time_us = 0;
+    int32_t lastAnalog[kSensorTracePins] = {};
+    size_t pos = kSensorTraceHeaderBytes;
+    while (pos < length) {
+        stats.complete = false;                         // Until the whole record is read
+        uint8_t tag = data[pos++];
+        uint64_t value;
+        if (tag == kSensorTraceDropTag) {
+            if (!getVarint(data, length, pos, value)) break;
+            stats.dropped = static_cast<uint32_t>(value);
+            stats.complete = true;
+            continue;
+        }
+        SensorSample sample = {0, static_cast<uint8_t>(tag & kPinMask), (tag & kAnalogFlag) != 0, 0};
+        if (sample.gpio >= kSensorTracePins || (sample.analog && (tag & kLevelFlag) != 0)) break;
+        if (!getVarint(data, length, pos, value)) break;
+        time_us += unzigzag(value);
+        sample.time_us = time_us;
+        if (sample.analog) {
+            if (!getVarint(data, length, pos, value)) break;
+            lastAnalog[sample.gpio] = static_cast<int32_t>(lastAnalog[sample.gpio] + unzigzag(value));
+            sample.value = lastAnalog[sample.gpio];
+        }
+        else {
+            sample.value = (tag & kLevelFlag) != 0 ? 1 : 0;
+        }
+        samples.push_back(sample);
+        stats.samples++;
+        stats.complete = true;
+    }
+    return stats;
+}
+
+// RECORDER
+bool SensorRecorder::setup(Sink sink, uint32_t drain_ms, UBaseType_t priority, BaseType_t core) {
+    this->sink = sink;
+    drainPeriod_ms = drain_ms;
+    if (drain_ms == 0) return true;
+    return xTaskCreatePinnedToCore(drainTask, "trace_drain", 2048, this, priority, nullptr, core) == pdPASS;
+}
+
+void SensorRecorder::start() {
+    for (std::atomic<int8_t> &level : lastLevel) level.store(-1, std::memory_order_relaxed);
+    headerPending.store(true, std::memory_order_release);
+    current().store(this, std::memory_order_release);
+}
+
+void SensorRecorder::stop() {
+    SensorRecorder *self = this;
+    current().compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+}
+
+// DRAIN
+size_t SensorRecorder::drain() {
+    if (sink == nullptr || draining.exchange(true, std::memory_order_acquire)) return 0;
+    uint8_t batch[kBatchBytes];
+    size_t queued = 0;
+    size_t count = 0;
+    auto send = [&](size_t room) {
+        if (queued + room <= sizeof(batch)) return;
+        sink(batch, queued);
+        sentBytes += queued;
+        queued = 0;
+    };
+    if (headerPending.exchange(false, std::memory_order_acquire)) {
+        encoder.reset();
+        queued += encoder.header(batch);
+    }
+    uint32_t drops = droppedSamples.load(std::memory_order_relaxed);
+    if (drops != reportedDrops.load(std::memory_order_relaxed)) {   // Ahead of the samples that made it
+        send(kSensorTraceMaxSampleBytes);
+        queued += encoder.dropped(drops, batch + queued);
+        reportedDrops.store(drops, std::memory_order_relaxed);
+    }
+    // One ring's worth at most, so busy producers cannot keep the reader here
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    for (uint32_t n = 0; n < kCapacity; n++) {
+        const Slot &slot = slots[t & (kCapacity - 1)];
+        if (slot.ready.load(std::memory_order_acquire) != t + 1) break;   // Empty, or still being written
+        SensorSample sample = slot.sample;
+        tail.store(++t, std::memory_order_release);
+        send(kSensorTraceMaxSampleBytes);
+        queued += encoder.encode(sample, batch + queued);
+        count++;
+    }
+    if (queued > 0) {
+        sink(batch, queued);
+        sentBytes += queued;
+    }
+    sentSamples += count;
+    draining.store(false, std::memory_order_release);
+    return count;
+}
+
+void SensorRecorder::flush() {
+    if (sink == nullptr) return;
+    while (pending() > 0 || dropped() != reportedDrops.load(std::memory_order_relaxed) ||
+           headerPending.load(std::memory_order_acquire)) {
+        if (drain() == 0) vTaskDelay(1);                // Drain task busy, or a writer not done yet
+    }
+}
+
+void SensorRecorder::drainTask(void *arg) {
+    SensorRecorder *self = static_cast<SensorRecorder *>(arg);
+    while (true) {
+        self->drain();
+        vTaskDelay(pdMS_TO_TICKS(self->drainPeriod_ms));
+    }
+}
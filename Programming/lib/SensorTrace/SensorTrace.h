@@ -0,0 +1,193 @@
+/*
+ * Project: AGV and Scissor Lift Control - Sensor Trace
+ * File: SensorTrace.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Recording of every raw sensor sample, so a field run can be replayed
+ *   on the host (agv_replay, scissor_lift_replay):
+ *     - The firmware and the libraries read their inputs through the
+ *       hooks below: sensorTraceGet() for a polled pin, sensorTraceLevel()
+ *       in a GPIO ISR, sensorTraceMilliVolts() for an ADC reading. Built
+ *       with SENSOR_TRACE=0 (the default) they are the plain reads
+ *     - With SENSOR_TRACE=1 the started SensorRecorder stores each sample
+ *       in a RAM ring (same claim/ready scheme as TelemetryLog). A pin is
+ *       only stored when its level changed; ADC readings always are
+ *     - A low-priority task drains the ring into a compact stream for a
+ *       sink, normally a spare UART:
+ *         "STRC" + version, then per sample a tag byte (GPIO, digital
+ *         level or analog flag), the zigzag varint time step from the
+ *         previous sample in us and, for an analog sample, the zigzag
+ *         varint change in uV from the last reading of that pin. A 0xFF
+ *         tag carries the total count of samples the full ring dropped
+ *       Digital samples take 2-4 bytes, analog ones 3-6
+ *     - sensorTraceParse() reads a stream back into absolute samples
+ *   Sample times: a polled pin or ADC reading is stamped when the read
+ *   returns, an ISR edge when the ISR starts (the edge), which is when the
+ *   replay has to change the input for the firmware to see the same.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SENSOR_TRACE_H_
+#define _SENSOR_TRACE_H_
+
+#ifndef SENSOR_TRACE
+#define SENSOR_TRACE 0
+#endif
+
+#include <SimpleADC.h>
+#include <SimpleGPIO.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int kSensorTracePins = 40;                    // ESP32 GPIO 0..39
+constexpr uint8_t kSensorTraceVersion = 1;
+constexpr size_t kSensorTraceHeaderBytes = 5;
+constexpr size_t kSensorTraceMaxSampleBytes = 1 + 10 + 5;   // Tag, time step, value change
+constexpr uint8_t kSensorTraceDropTag = 0xFF;
+
+struct SensorSample {
+    int64_t time_us;
+    uint8_t gpio;
+    bool analog;
+    int32_t value;              // Level, or uV for an analog sample
+};
+
+// CODEC
+// Keeps the previous time and analog values, so a stream is encoded by one encoder in order
+class SensorTraceEncoder {
+public:
+    void reset();
+    size_t header(uint8_t *out);
+    size_t encode(const SensorSample &sample, uint8_t *out);
+    size_t dropped(uint32_t total, uint8_t *out);
+
+private:
+    int64_t lastTime_us = 0;
+    int32_t lastAnalog[kSensorTracePins] = {};
+};
+
+struct SensorTraceStats {
+    uint32_t samples = 0;
+    uint32_t dropped = 0;       // Last count reported by the recorder
+    bool complete = true;       // false: bad header, unknown tag or a sample cut short
+};
+
+// Whole stream to samples with absolute times; stops at the first bad byte
+SensorTraceStats sensorTraceParse(const uint8_t *data, size_t length, std::vector<SensorSample> &samples);
+
+class SensorRecorder {
+public:
+    static constexpr uint32_t kCapacity = 512;              // Samples, a power of two
+    static constexpr uint32_t kDefaultDrain_ms = 10;
+    static constexpr UBaseType_t kDefaultPriority = 1;
+    static constexpr int kBatchBytes = 256;                 // Bytes per sink call, at most
+    using Sink = void (*)(const uint8_t *data, size_t length);
+
+    // Starts the drain task; with drain_ms 0 there is none and the owner calls drain()
+    bool setup(Sink sink, uint32_t drain_ms = kDefaultDrain_ms, UBaseType_t priority = kDefaultPriority,
+               BaseType_t core = tskNO_AFFINITY);
+    void start();               // Sends the header and makes this the recorder the hooks feed
+    void stop();                // Hooks stop recording, the ring still drains
+
+    // Any task or ISR; false when the sample was not needed or the ring is full
+    bool IRAM_ATTR record(int64_t time_us, int gpio, bool analog, int32_t value) {
+        if (gpio < 0 || gpio >= kSensorTracePins) return false;
+        if (!analog && lastLevel[gpio].exchange(static_cast<int8_t>(value), std::memory_order_relaxed) == value) {
+            return false;                                   // Level unchanged since the last read
+        }
+        uint32_t h = head.load(std::memory_order_relaxed);
+        do {
+            if (h - tail.load(std::memory_order_acquire) >= kCapacity) {
+                droppedSamples.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!head.compare_exchange_weak(h, h + 1, std::memory_order_relaxed));
+        Slot &slot = slots[h & (kCapacity - 1)];
+        slot.sample = {time_us, static_cast<uint8_t>(gpio), analog, value};
+        slot.ready.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The recorder the hooks feed, nullptr when none is started
+    static SensorRecorder *active() { return current().load(std::memory_order_acquire); }
+
+    size_t drain();             // Sends the ready samples, returns how many (the drain task calls this)
+    void flush();               // Waits until everything recorded so far is sent, e.g. before exit()
+
+    uint32_t pending() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    uint32_t dropped() const { return droppedSamples.load(std::memory_order_relaxed); }
+    uint32_t sent() const { return sentSamples; }
+    uint32_t bytes() const { return sentBytes; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> ready{0};     // Claim index + 1 once written
+        SensorSample sample = {};
+    };
+
+    static std::atomic<SensorRecorder *> &current() {
+        static std::atomic<SensorRecorder *> recorder{nullptr};
+        return recorder;
+    }
+    static void drainTask(void *arg);
+
+    Slot slots[kCapacity];
+    std::atomic<uint32_t> head{0};          // Next slot to claim, free-running
+    std::atomic<uint32_t> tail{0};          // Next slot to send, free-running
+    std::atomic<int8_t> lastLevel[kSensorTracePins];     // -1: not read since start()
+    std::atomic<uint32_t> droppedSamples{0};
+    std::atomic<bool> draining{false};      // One reader at a time: the task or flush()
+    std::atomic<uint32_t> reportedDrops{0};
+    std::atomic<bool> headerPending{false}; // Set by start(), sent ahead of the next samples
+
+    // Reader side only
+    Sink sink = nullptr;
+    uint32_t drainPeriod_ms = kDefaultDrain_ms;
+    SensorTraceEncoder encoder;
+    uint32_t sentSamples = 0;
+    uint32_t sentBytes = 0;
+};
+
+// HOOKS
+// Polled pin, stamped when the read returns
+inline int sensorTraceGet(SimpleGPIO &gpio) {
+    int level = gpio.get();
+#if SENSOR_TRACE
+    if (SensorRecorder *recorder = SensorRecorder::active()) recorder->record(esp_timer_get_time(), gpio.pin(), false, level);
+#endif
+    return level;
+}
+
+// Pin read in its GPIO ISR, stamped at the edge
+inline int IRAM_ATTR sensorTraceLevel(int gpio) {
+#if SENSOR_TRACE
+    int64_t edge_us = esp_timer_get_time();
+    int level = gpio_get_level((gpio_num_t)gpio);
+    if (SensorRecorder *recorder = SensorRecorder::active()) recorder->record(edge_us, gpio, false, level);
+    return level;
+#else
+    return gpio_get_level((gpio_num_t)gpio);
+#endif
+}
+
+// ADC reading in mV, stored in uV
+inline float sensorTraceMilliVolts(SimpleADC &adc) {
+    float mv = adc.read(ADC_READ_MV);
+#if SENSOR_TRACE
+    if (SensorRecorder *recorder = SensorRecorder::active()) {
+        recorder->record(esp_timer_get_time(), adc.pin(), true, static_cast<int32_t>(mv * 1000.0f + (mv < 0 ? -0.5f : 0.5f)));
+    }
+#endif
+    return mv;
+}
+
+#endif // _SENSOR_TRACE_H_
@@ -0,0 +1,99 @@
+/*
+ * Project: AGV and Scissor Lift Control - Collision Speed Governor
+ * File: SpeedGovernor.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Alpha-beta range tracking and the time to collision speed law.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <SpeedGovernor.h>
+
+#include <algorithm>
+#include <cmath>
+
+// TRACKING
+void RangeTracker::reset() {
+    active = false;
+    distance = closing = 0;
+    lastSample_us = lastTrack_us = 0;
+    restartCount = 0;
+}
+
+bool RangeTracker::update(const EchoSample &sample) {
+    if (sample.status != ECHO_OK && sample.status != ECHO_OUT_OF_RANGE) return false;  // Lost echoes coast
+    if (sample.timestamp_us <= lastSample_us) return false;
+    lastSample_us = sample.timestamp_us;
+    float measured = sample.distance_cm;
+    if (measured >= gains.clear_cm) {
+        active = false;                                 // Nothing ahead
+        return true;
+    }
+    float dt = (sample.timestamp_us - lastTrack_us) * 1e-6f;
+    float residual = measured - (distance - closing * dt);
+    if (!active || sample.timestamp_us - lastTrack_us > gains.maxCoast_us || std::fabs(residual) > gains.gate_cm) {
+        active = true;                                  // New track, standing still until proven otherwise
+        distance = measured;
+        closing = 0;
+        restartCount++;
+    }
+    else {
+        distance = distance - closing * dt + gains.alpha * residual;
+        closing -= gains.beta * residual / dt;
+    }
+    lastTrack_us = sample.timestamp_us;
+    return true;
+}
+
+RangeEstimate RangeTracker::at(int64_t now_us) const {
+    if (!active || now_us - lastTrack_us > gains.maxCoast_us) return {-1, 0, now_us};
+    float predicted = distance - closing * (now_us - lastTrack_us) * 1e-6f;
+    return {std::max(predicted, 0.0f), closing, now_us};
+}
+
+// SPEED LAW
+void SpeedGovernor::reset(float duty) {
+    lastDuty = duty;
+    ownSpeed = duty * limits.cmPerDuty;
+    lastTtc = -1;
+    last_us = -1;
+}
+
+int SpeedGovernor::update(const RangeEstimate &range) {
+    // Own speed follows the last duty with the drive train lag
+    if (last_us >= 0 && range.timestamp_us > last_us) {
+        float target = lastDuty * limits.cmPerDuty;
+        ownSpeed = target + (ownSpeed - target) * std::exp(-(range.timestamp_us - last_us) * 1e-6f / limits.lag_s);
+    }
+    last_us = range.timestamp_us;
+    float duty = limits.maxDuty;
+    lastTtc = -1;
+    if (range.distance_cm >= 0) {
+        float gap = range.distance_cm - limits.stop_cm;
+        if (range.closing_cm_s > 0) lastTtc = std::max(gap, 0.0f) / range.closing_cm_s;
+        if (gap <= 0) duty = 0;
+        else {
+            float approach = std::max(range.closing_cm_s - ownSpeed, 0.0f);   // The obstacle's own share
+            duty = std::clamp((allowed_cm_s(gap) - approach) / limits.cmPerDuty, 0.0f, limits.maxDuty);
+        }
+    }
+    lastDuty = static_cast<int>(duty);
+    return static_cast<int>(lastDuty);
+}
+
+// Closing speed allowed by the time margin and by the braking distance
+float SpeedGovernor::allowed_cm_s(float gap_cm) const {
+    return std::min(gap_cm / limits.ttc_s, std::sqrt(2.0f * limits.decel_cm_s2 * gap_cm));
+}
+
+float SpeedGovernor::standingDuty(float distance_cm) const {
+    float gap = distance_cm - limits.stop_cm;
+    if (gap <= 0) return 0;
+    return std::clamp(allowed_cm_s(gap) / limits.cmPerDuty, 0.0f, limits.maxDuty);
+}
+
+FixedRamp<16> SpeedGovernor::standingRamp() const {
+    return {Q16::fromFloat(limits.stop_cm), Q16::fromFloat(1.0f / (limits.ttc_s * limits.cmPerDuty)), Q16::fromFloat(limits.maxDuty)};
+}
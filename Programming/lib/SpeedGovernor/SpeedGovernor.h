@@ -0,0 +1,95 @@
+/*
+ * Project: AGV and Scissor Lift Control - Collision Speed Governor
+ * File: SpeedGovernor.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Drive duty from the time to collision instead of the raw distance.
+ *     - RangeTracker runs an alpha-beta filter over the ranging samples:
+ *       distance and closing speed, predicted to any instant between
+ *       samples. A sample far from the prediction starts a new track (the
+ *       nearest sensor changed, or a new obstacle came in); a reading past
+ *       the listening range clears it; lost echoes are coasted through
+ *     - SpeedGovernor picks the fastest own speed that keeps both the time
+ *       to reach the stop gap above ttc_s and the stop within the braking
+ *       deceleration. An obstacle coming towards the AGV (closing faster
+ *       than the AGV drives) takes its speed off the allowance; one moving
+ *       away is treated as standing still
+ *   The AGV's own speed is modelled from the duties it was given, with the
+ *   first order lag of the drive train. standingRamp() is the standing
+ *   obstacle duty in Q16 for integer-only callers.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SPEED_GOVERNOR_H_
+#define _SPEED_GOVERNOR_H_
+
+#include <EchoRanger.h>
+#include <FixedPoint.h>
+#include <cstdint>
+
+struct RangeEstimate {
+    float distance_cm;          // -1 when nothing is tracked
+    float closing_cm_s;         // Positive when getting closer
+    int64_t timestamp_us;       // Instant the estimate is for
+};
+
+struct TrackerGains {
+    float alpha = 0.5f;         // Distance correction
+    float beta = 0.167f;        // Closing speed correction, alpha^2 / (2 - alpha) (Benedict-Bordner)
+    float gate_cm = 30.0f;      // Farther than this from the prediction starts a new track
+    float clear_cm = EchoRanger::kMaxRange_cm;    // A reading from here on means nothing ahead
+    int64_t maxCoast_us = 200000;                 // Lost echoes bridged by the prediction
+};
+
+class RangeTracker {
+public:
+    void setup(const TrackerGains &gains = TrackerGains()) { this->gains = gains; reset(); }
+    void reset();
+    bool update(const EchoSample &sample);        // False when the sample was already seen
+    RangeEstimate at(int64_t now_us) const;       // Prediction, distance -1 if no track or coasted too long
+    bool tracking() const { return active; }
+    uint32_t restarts() const { return restartCount; }
+
+private:
+    TrackerGains gains;
+    bool active = false;
+    float distance = 0, closing = 0;
+    int64_t lastSample_us = 0;                    // Newest sample used
+    int64_t lastTrack_us = 0;                     // Newest sample that updated the track
+    uint32_t restartCount = 0;
+};
+
+struct GovernorLimits {
+    float stop_cm = 10.0f;      // Gap kept when stopped
+    float ttc_s = 1.0f;         // Time to reach the stop gap never shorter than this
+    float decel_cm_s2 = 60.0f;  // Braking the drive train can do
+    float cmPerDuty = 0.4f;     // Own speed per duty percent
+    float lag_s = 0.15f;        // Drive train time constant
+    float maxDuty = 80.0f;      // Duty with nothing ahead
+};
+
+class SpeedGovernor {
+public:
+    void setup(const GovernorLimits &limits = GovernorLimits()) { this->limits = limits; reset(); }
+    void reset(float duty = 0);                   // Drive starting from this duty
+    int update(const RangeEstimate &range);       // Duty percentage for the instant of the estimate
+    float ttc_s() const { return lastTtc; }       // Time to the stop gap at the tracked closing speed, -1 if not closing
+    bool limiting() const { return lastDuty < limits.maxDuty; }
+    float standingDuty(float distance_cm) const;  // Duty in front of an obstacle that does not move
+    // The time margin line of standingDuty(); the same up to maxDuty unless the braking bound is lower there
+    FixedRamp<16> standingRamp() const;
+    float ownSpeed_cm_s() const { return ownSpeed; }
+
+private:
+    float allowed_cm_s(float gap_cm) const;
+
+    GovernorLimits limits;
+    float lastDuty = 0;
+    float ownSpeed = 0;
+    float lastTtc = -1;
+    int64_t last_us = -1;
+};
+
+#endif // _SPEED_GOVERNOR_H_
@@ -0,0 +1,56 @@
+/*
+ * Project: AGV and Scissor Lift Control - Lock-Free Queue
+ * File: SpscQueue.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Fixed-size single-producer, single-consumer ring queue. The producer
+ *   (a timer callback or ISR) only writes the head index and the
+ *   consumer task only writes the tail, so neither side locks or waits.
+ *   Unlike TripleBuffer it keeps every value, in order, until it is
+ *   popped; push() fails when the ring is full.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T, uint32_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T &value) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return false;   // Full
+        slots[h & (N - 1)] = value;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T &out) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) return false;        // Empty
+        out = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side: a snapshot, exact only when the other side is idle
+    uint32_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    T slots[N] = {};
+    std::atomic<uint32_t> head{0};      // Next slot to write, free-running
+    std::atomic<uint32_t> tail{0};      // Next slot to read, free-running
+};
+
+#endif // _SPSC_QUEUE_H_
@@ -0,0 +1,167 @@
+/*
+ * Project: AGV and Scissor Lift Control - Transition Table State Machine
+ * File: StateMachine.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Header-only finite state machine driven by a constexpr transition table.
+ *     - makeTable() validates the table while compiling (states and events
+ *       in range, no duplicated (state, event) pair, see tableError()) and
+ *       builds a dense [state][event] lookup of row indexes
+ *     - dispatch() is a single table lookup; undefined pairs land on the
+ *       rejection row 0 instead of a switch
+ *     - nextState<table, from, event>() fails to compile for a transition
+ *       that is not in the table
+ *     - Every accepted transition records how long the state and its
+ *       action took and calls an optional timing hook
+ *   States and events must be contiguous enums starting at 0.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _STATE_MACHINE_H_
+#define _STATE_MACHINE_H_
+
+#include <esp_timer.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// One row of the table: from --event--> to, if guard() allows, running action()
+template <typename State, typename Event>
+struct Transition {
+    State from;
+    Event event;
+    State to;
+    bool (*guard)();                    // nullptr = always allowed
+    void (*action)();                   // nullptr = no action
+};
+
+// Compiled table: rows[0] is the rejection row, lut[s][e] = row index
+template <typename State, typename Event, size_t NumStates, size_t NumEvents, size_t NumRows>
+struct TransitionTable {
+    using StateType = State;
+    using EventType = Event;
+    static constexpr size_t numStates = NumStates;
+    static constexpr size_t numEvents = NumEvents;
+    static constexpr size_t numRows = NumRows + 1;
+
+    Transition<State, Event> rows[NumRows + 1];
+    uint8_t lut[NumStates][NumEvents];
+
+    constexpr bool allows(State from, Event event) const { return lut[from][event] != 0; }
+    constexpr State next(State from, Event event) const { return rows[lut[from][event]].to; }
+};
+
+namespace fsm_detail {
+inline bool reject() { return false; }
+
+// Reached only while compiling an invalid table, which stops compilation
+inline void invalidTable(const char *reason) {}
+}
+
+// Why a table is invalid, nullptr for a valid one
+template <size_t NumStates, size_t NumEvents, typename State, typename Event, size_t NumRows>
+constexpr const char *tableError(const Transition<State, Event> (&rows)[NumRows]) {
+    for (size_t i = 0; i < NumRows; i++) {
+        if (static_cast<size_t>(rows[i].from) >= NumStates || static_cast<size_t>(rows[i].to) >= NumStates) {
+            return "state out of range";
+        }
+        if (static_cast<size_t>(rows[i].event) >= NumEvents) return "event out of range";
+        for (size_t j = 0; j < i; j++) {
+            if (rows[j].from == rows[i].from && rows[j].event == rows[i].event) return "duplicate (state, event) transition";
+        }
+    }
+    return nullptr;
+}
+
+template <size_t NumStates, size_t NumEvents, typename State, typename Event, size_t NumRows>
+constexpr TransitionTable<State, Event, NumStates, NumEvents, NumRows>
+makeTable(const Transition<State, Event> (&rows)[NumRows]) {
+    static_assert(NumRows < 255, "Transition table too large for 8-bit indexes");
+    TransitionTable<State, Event, NumStates, NumEvents, NumRows> table{};
+    const char *error = tableError<NumStates, NumEvents>(rows);
+    if (error != nullptr) {
+        fsm_detail::invalidTable(error);
+        return table;
+    }
+    table.rows[0] = {State(), Event(), State(), fsm_detail::reject, nullptr};
+    for (size_t s = 0; s < NumStates; s++) {
+        for (size_t e = 0; e < NumEvents; e++) table.lut[s][e] = 0;
+    }
+    for (size_t i = 0; i < NumRows; i++) {
+        table.rows[i + 1] = rows[i];
+        table.lut[static_cast<size_t>(rows[i].from)][static_cast<size_t>(rows[i].event)] = static_cast<uint8_t>(i + 1);
+    }
+    return table;
+}
+
+// Compile-time checked transition: only compiles if (From, On) is in the table
+template <const auto &Table, auto From, auto On>
+constexpr auto nextState() {
+    static_assert(Table.allows(From, On), "Illegal transition: not in the transition table");
+    return Table.next(From, On);
+}
+
+// Timing of one accepted transition, passed to the hook
+template <typename State, typename Event>
+struct TransitionTiming {
+    State from;
+    Event event;
+    State to;
+    int64_t stateTime_us;               // Time spent in 'from' before the event
+    int64_t actionTime_us;              // Time spent in the transition action
+};
+
+template <const auto &Table>
+class StateMachine {
+public:
+    using Table_t = typename std::remove_cv<typename std::remove_reference<decltype(Table)>::type>::type;
+    using State = typename Table_t::StateType;
+    using Event = typename Table_t::EventType;
+    using Hook = void (*)(const TransitionTiming<State, Event> &timing);
+
+    explicit StateMachine(State initial, Hook hook = nullptr, int64_t (*clock)() = esp_timer_get_time)
+        : current(initial), hook(hook), clock(clock) {
+        enteredAt = clock();
+    }
+
+    State state() const { return current; }
+    bool in(State s) const { return current == s; }
+
+    // Feed an event; returns false if the transition is undefined or its guard refuses
+    bool dispatch(Event event) {
+        uint8_t index = Table.lut[current][event];
+        const Transition<State, Event> &row = Table.rows[index];
+        if (row.guard != nullptr && !row.guard()) {
+            rejected++;
+            return false;
+        }
+        int64_t start = clock();
+        if (row.action != nullptr) row.action();
+        int64_t end = clock();
+        TransitionTiming<State, Event> timing = {current, event, row.to, start - enteredAt, end - start};
+        stateTime_us[current] += timing.stateTime_us;
+        rowCount[index]++;
+        current = row.to;
+        enteredAt = end;
+        if (hook != nullptr) hook(timing);
+        return true;
+    }
+
+    // Statistics
+    int64_t timeIn(State s) const { return stateTime_us[s]; }
+    uint32_t taken(State from, Event event) const { return rowCount[Table.lut[from][event]]; }
+    uint32_t rejections() const { return rejected; }
+
+private:
+    State current;
+    Hook hook;
+    int64_t (*clock)();
+    int64_t enteredAt = 0;
+    int64_t stateTime_us[Table_t::numStates] = {0};
+    uint32_t rowCount[Table_t::numRows] = {0};
+    uint32_t rejected = 0;
+};
+
+#endif // _STATE_MACHINE_H_
@@ -0,0 +1,91 @@
+/*
+ * Project: AGV and Scissor Lift Control - Batched Step Pulse Trains
+ * File: StepPulseTrain.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   RMT chunk refill of PulseTrain. The RMT clock runs at 1 MHz so item
+ *   durations are the profile intervals in microseconds (15-bit limit,
+ *   which StepProfile's 16 steps/s minimum start rate respects).
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <StepPulseTrain.h>
+#include <algorithm>
+
+namespace {
+
+// The legacy driver has a single tx-end callback, dispatched here per channel
+PulseTrain *trains[RMT_CHANNEL_MAX] = {nullptr};
+bool callbackRegistered = false;
+
+}
+
+bool PulseTrain::setup(int gpio, rmt_channel_t channel, StepProfile &profile, StepLoad &load, int chunkSteps,
+                       void (*chunkHook)(void *arg), void *hookArg) {
+    this->gpio = gpio;
+    this->channel = channel;
+    this->profile = &profile;
+    this->load = &load;
+    this->chunkSteps = std::clamp(chunkSteps, 1, kMaxChunkSteps);
+    this->chunkHook = chunkHook;
+    this->hookArg = hookArg;
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)gpio, channel);
+    config.clk_div = 80;                                // 1 us ticks
+    if (rmt_config(&config) != ESP_OK) return false;
+    esp_err_t err = rmt_driver_install(channel, 0, 0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) return false;   // Already installed is fine
+    trains[channel] = this;
+    if (!callbackRegistered) {
+        rmt_register_tx_end_callback(txEnd, nullptr);
+        callbackRegistered = true;
+    }
+    return true;
+}
+
+void PulseTrain::start() {
+    rmt_set_gpio(channel, RMT_MODE_TX, (gpio_num_t)gpio, false);       // Take the pin back from SimpleGPIO
+    sent.store(0, std::memory_order_relaxed);
+    queued = 0;
+    transmitting.store(true, std::memory_order_release);
+    sendChunk();
+}
+
+void PulseTrain::stop() {
+    profile->halt();
+    rmt_tx_stop(channel);
+    transmitting.store(false, std::memory_order_release);
+}
+
+void IRAM_ATTR PulseTrain::txEnd(rmt_channel_t channel, void *arg) {
+    PulseTrain *train = trains[channel];
+    if (train == nullptr || !train->busy()) return;
+    StepLoadScope scope(*train->load);
+    train->sent.store(train->sent.load(std::memory_order_relaxed) + train->queued, std::memory_order_release);
+    if (train->chunkHook != nullptr) train->chunkHook(train->hookArg);
+    train->sendChunk();
+}
+
+// Fills the channel memory with the next steps and starts it; ends the move when there are none
+void IRAM_ATTR PulseTrain::sendChunk() {
+    int count = 0;
+    while (count < chunkSteps) {
+        uint32_t interval = profile->nextStep();
+        if (interval == 0) break;
+        uint32_t high = interval / 2;
+        items[count].level0 = 1;
+        items[count].duration0 = high;
+        items[count].level1 = 0;
+        items[count].duration1 = interval - high;
+        count++;
+    }
+    queued = count;
+    if (count == 0) {
+        transmitting.store(false, std::memory_order_release);
+        return;
+    }
+    load->steps += count;
+    rmt_fill_tx_items(channel, items, count, 0);
+    rmt_tx_start(channel, true);
+}
@@ -0,0 +1,106 @@
+/*
+ * Project: AGV and Scissor Lift Control - Batched Step Pulse Trains
+ * File: StepPulseTrain.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Step pulse generation by the RMT peripheral instead of one timer
+ *   callback per pulse edge.
+ *     - PulseTrain writes a chunk of steps (one RMT item per step, high
+ *       and low time from the StepProfile) into the channel memory and
+ *       starts it; the tx-end interrupt refills the next chunk, so the CPU
+ *       is interrupted once per chunk instead of twice per step
+ *     - An optional hook runs once per chunk (e.g. to check a limit
+ *       sensor and call StepProfile::stop())
+ *     - stepsOut() counts the steps of the chunks already sent; the
+ *       profile's stepsDone() also counts the chunk still in the RMT
+ *     - StepLoad counts interrupts, steps and handler cycles for either
+ *       backend, so both can be compared on the same move
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _STEP_PULSE_TRAIN_H_
+#define _STEP_PULSE_TRAIN_H_
+
+#include <StepperProfile.h>
+#include <driver/rmt.h>
+#include <esp_attr.h>
+#include <esp_cpu.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cstdint>
+
+#define STEP_LOAD_CPU_MHZ 240               // Cycle counter rate
+#define STEP_LOAD_ENTRY_CYCLES 500          // Interrupt entry, dispatch and exit per handler call (estimate)
+
+// Interrupt and CPU load of a step backend since the last reset()
+struct StepLoad {
+    uint32_t interrupts = 0;                // Handler calls
+    uint32_t steps = 0;
+    uint64_t busyCycles = 0;                // Measured inside the handlers
+    int64_t since_us = 0;
+
+    void reset() {
+        interrupts = 0;
+        steps = 0;
+        busyCycles = 0;
+        since_us = esp_timer_get_time();
+    }
+    float interruptsPerSecond() const {
+        int64_t elapsed = esp_timer_get_time() - since_us;
+        return elapsed > 0 ? interrupts * 1e6f / elapsed : 0;
+    }
+    // Percent of one core, including the fixed entry cost of every interrupt
+    float cpuLoad() const {
+        int64_t elapsed = esp_timer_get_time() - since_us;
+        if (elapsed <= 0) return 0;
+        double cycles = busyCycles + static_cast<double>(interrupts) * STEP_LOAD_ENTRY_CYCLES;
+        return static_cast<float>(100.0 * cycles / (elapsed * static_cast<double>(STEP_LOAD_CPU_MHZ)));
+    }
+};
+
+// Counts one handler call and its cycles
+class StepLoadScope {
+public:
+    explicit IRAM_ATTR StepLoadScope(StepLoad &load) : load(load), start(esp_cpu_get_cycle_count()) {}
+    IRAM_ATTR ~StepLoadScope() {
+        load.busyCycles += static_cast<uint32_t>(esp_cpu_get_cycle_count() - start);
+        load.interrupts++;
+    }
+
+private:
+    StepLoad &load;
+    esp_cpu_cycle_count_t start;
+};
+
+class PulseTrain {
+public:
+    static constexpr int kMaxChunkSteps = RMT_MEM_ITEM_NUM - 1;     // One memory block and its end marker
+
+    // Chunk size trades interrupt rate against how late a stop() is seen
+    bool setup(int gpio, rmt_channel_t channel, StepProfile &profile, StepLoad &load,
+               int chunkSteps = kMaxChunkSteps, void (*chunkHook)(void *arg) = nullptr, void *hookArg = nullptr);
+    void start();                           // profile.begin() first; returns at once
+    void stop();                            // Abort: stop the RMT and the profile
+    bool busy() const { return transmitting.load(std::memory_order_acquire); }
+    int32_t stepsOut() const { return sent.load(std::memory_order_acquire); }     // Steps on the pin since start()
+
+private:
+    static void IRAM_ATTR txEnd(rmt_channel_t channel, void *arg);
+    void IRAM_ATTR sendChunk();
+
+    int gpio = -1;
+    rmt_channel_t channel = RMT_CHANNEL_0;
+    StepProfile *profile = nullptr;
+    StepLoad *load = nullptr;
+    int chunkSteps = kMaxChunkSteps;
+    void (*chunkHook)(void *arg) = nullptr;
+    void *hookArg = nullptr;
+    rmt_item32_t items[kMaxChunkSteps];
+    int queued = 0;                         // Steps of the chunk in the RMT
+    std::atomic<bool> transmitting{false};
+    std::atomic<int32_t> sent{0};
+};
+
+#endif // _STEP_PULSE_TRAIN_H_
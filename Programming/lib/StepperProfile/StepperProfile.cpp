@@ -0,0 +1,120 @@
+/*
+ * Project: AGV and Scissor Lift Control - Stepper Motion Profiles
+ * File: StepperProfile.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Ramp table construction and the per-edge sequencing of StepProfile.
+ *   Step i of the ramp happens when the travelled distance reaches i
+ *   steps; the trapezoid is solved in closed form and the S-curve
+ *   (smoothstep velocity) by bisection, once, in build().
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <StepperProfile.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Position after t seconds of the ramp, in steps
+double rampPosition(const MotionProfile &p, double rampTime, double t) {
+    double dv = p.cruiseRate - p.startRate;
+    if (p.shape == PROFILE_TRAPEZOID) return p.startRate * t + p.accel * t * t / 2.0;
+    double tau = t / rampTime;                  // v = v0 + dv * (3 tau^2 - 2 tau^3)
+    return p.startRate * t + dv * rampTime * (tau * tau * tau - tau * tau * tau * tau / 2.0);
+}
+
+// Time at which the ramp reaches 'steps'
+double rampTimeAt(const MotionProfile &p, double rampTime, double steps) {
+    if (p.shape == PROFILE_TRAPEZOID) {
+        return (std::sqrt(p.startRate * p.startRate + 2.0 * p.accel * steps) - p.startRate) / p.accel;
+    }
+    double lo = 0, hi = rampTime;
+    for (int i = 0; i < 40; i++) {
+        double mid = (lo + hi) / 2.0;
+        if (rampPosition(p, rampTime, mid) < steps) lo = mid;
+        else hi = mid;
+    }
+    return (lo + hi) / 2.0;
+}
+
+}
+
+// SETUP
+bool StepProfile::build(const MotionProfile &profile) {
+    if (profile.startRate < 16 || profile.cruiseRate < profile.startRate || profile.accel <= 0) return false;
+    double dv = profile.cruiseRate - profile.startRate;
+    // Ramp duration and length: S-curve peak acceleration is 1.5 times its average
+    double rampTime = profile.shape == PROFILE_TRAPEZOID ? dv / profile.accel : 1.5 * dv / profile.accel;
+    double rampSteps = rampPosition(profile, rampTime, rampTime);
+    rampLen = std::clamp(static_cast<int>(std::ceil(rampSteps)), 1, kMaxRampSteps);
+    cruise_us = static_cast<uint32_t>(std::lround(1e6 / profile.cruiseRate));
+    double previous = 0;
+    for (int i = 0; i < rampLen; i++) {
+        double next = i + 1 < rampSteps ? rampTimeAt(profile, rampTime, i + 1) : previous + 1.0 / profile.cruiseRate;
+        ramp[i] = std::max(cruise_us, static_cast<uint32_t>(std::lround((next - previous) * 1e6)));
+        previous = next;
+    }
+    if (rampLen == kMaxRampSteps) cruise_us = ramp[rampLen - 1];     // Table too short: cruise where it ends
+    return true;
+}
+
+// RUN MOVES
+void StepProfile::begin(int32_t steps) {
+    done.store(0, std::memory_order_relaxed);
+    target.store(steps, std::memory_order_relaxed);
+    level = 0;
+    low_us = 0;
+    moving.store(steps != 0, std::memory_order_release);
+}
+
+void IRAM_ATTR StepProfile::stop() {
+    int32_t now = done.load(std::memory_order_relaxed);
+    int32_t stopAt = now + std::min<int32_t>(now, rampLen) + 1;      // Mirror the ramp up from here
+    int32_t current = target.load(std::memory_order_relaxed);
+    while ((current == kContinuous || stopAt < current) &&
+           !target.compare_exchange_weak(current, stopAt, std::memory_order_relaxed)) {}
+}
+
+void StepProfile::halt() {
+    target.store(done.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+StepEdge IRAM_ATTR StepProfile::nextEdge() {
+    if (level == 1) {                           // Falling edge, then wait out the rest of the interval
+        level = 0;
+        return {0, low_us};
+    }
+    uint32_t interval = nextStep();
+    if (interval == 0) return {0, 0};
+    uint32_t high = interval / 2;
+    low_us = interval - high;
+    level = 1;
+    return {1, high};
+}
+
+uint32_t IRAM_ATTR StepProfile::nextStep() {
+    int32_t step = done.load(std::memory_order_relaxed);
+    int32_t total = target.load(std::memory_order_relaxed);
+    if (!moving.load(std::memory_order_relaxed) || (total != kContinuous && step >= total)) {
+        moving.store(false, std::memory_order_release);
+        return 0;
+    }
+    done.store(step + 1, std::memory_order_relaxed);
+    return intervalAfter(step, total);
+}
+
+// Time from this step to the next one: ramp up, cruise, then the ramp mirrored down
+uint32_t IRAM_ATTR StepProfile::intervalAfter(int32_t step, int32_t total) const {
+    int32_t index = step;
+    if (total != kContinuous) index = std::max<int32_t>(0, std::min(step, total - 2 - step));
+    return index < rampLen ? ramp[index] : cruise_us;
+}
+
+int64_t StepProfile::moveTime_us(int32_t steps) const {
+    int64_t time = 0;
+    for (int32_t k = 0; k + 1 < steps; k++) time += intervalAfter(k, steps);
+    return time;
+}
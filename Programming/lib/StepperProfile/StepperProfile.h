@@ -0,0 +1,81 @@
+/*
+ * Project: AGV and Scissor Lift Control - Stepper Motion Profiles
+ * File: StepperProfile.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Acceleration ramps for the step/direction drivers of the lift and
+ *   tilt steppers.
+ *     - build() precomputes the step intervals of the ramp from rest to
+ *       the cruise rate once, for a trapezoidal (constant acceleration) or
+ *       S-curve (smooth acceleration, no jerk steps) profile
+ *     - nextEdge() is called from the step timer callback and returns the
+ *       pulse level and the delay to the next edge: table lookups only.
+ *       nextStep() hands out whole step intervals for pulse-train backends
+ *     - Moves either run a fixed step count, ramping down so the last
+ *       step lands at the start rate, or run until stop() and ramp down
+ *       from wherever they are
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _STEPPER_PROFILE_H_
+#define _STEPPER_PROFILE_H_
+
+#include <esp_attr.h>
+#include <atomic>
+#include <cstdint>
+
+enum ProfileShape {
+    PROFILE_TRAPEZOID,          // Constant acceleration
+    PROFILE_SCURVE,             // Acceleration rises and falls smoothly, peak = accel
+};
+
+struct MotionProfile {
+    float startRate;            // steps/s, safe to start from rest without stalling
+    float cruiseRate;           // steps/s
+    float accel;                // steps/s^2 (peak for the S-curve)
+    ProfileShape shape;
+};
+
+// Pulse level to write now and time until the next edge; delay_us = 0 when the move is over
+struct StepEdge {
+    int level;
+    uint32_t delay_us;
+};
+
+class StepProfile {
+public:
+    static constexpr int kMaxRampSteps = 512;
+    static constexpr int32_t kContinuous = -1;
+
+    bool build(const MotionProfile &profile);   // false for impossible rates
+    void begin(int32_t steps = kContinuous);    // Start a move, the caller starts the step timer
+    void IRAM_ATTR stop();                      // Ramp down to rest (ISR and callback safe)
+    void halt();                                // Stop at once, no ramp
+    StepEdge IRAM_ATTR nextEdge();              // Called on every pulse edge
+    uint32_t IRAM_ATTR nextStep();              // Whole step interval for pulse trains, 0 = move over
+
+    bool busy() const { return moving.load(std::memory_order_acquire); }
+    int32_t stepsDone() const { return done.load(std::memory_order_relaxed); }
+    int rampLength() const { return rampLen; }
+    uint32_t rampInterval(int i) const { return ramp[i]; }
+    uint32_t cruiseInterval() const { return cruise_us; }
+    int64_t moveTime_us(int32_t steps) const;   // First to last step of a fixed move
+
+private:
+    uint32_t IRAM_ATTR intervalAfter(int32_t step, int32_t total) const;
+
+    uint32_t ramp[kMaxRampSteps];               // ramp[i] = time from step i to step i + 1
+    int rampLen = 0;
+    uint32_t cruise_us = 0;
+
+    // Move state, shared between the task and the step timer callback
+    std::atomic<int32_t> target{0};             // Steps to issue, kContinuous until stop()
+    std::atomic<int32_t> done{0};
+    std::atomic<bool> moving{false};
+    int level = 0;
+    uint32_t low_us = 0;
+};
+
+#endif // _STEPPER_PROFILE_H_
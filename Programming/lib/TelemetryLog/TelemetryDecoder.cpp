@@ -0,0 +1,96 @@
+/*
+ * Project: AGV and Scissor Lift Control - Telemetry Log
+ * File: TelemetryDecoder.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Stream splitting, time unwrapping and record formatting of
+ *   TelemetryDecoder.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <TelemetryDecoder.h>
+#include <cstdio>
+#include <cstring>
+
+void TelemetryDecoder::feed(const uint8_t *data, size_t length, std::string &out) {
+    pending.insert(pending.end(), data, data + length);
+    size_t i = 0;
+    while (i < pending.size()) {
+        uint8_t c = pending[i];
+        if (c == kTelemetrySync) {
+            if (pending.size() - i < kTelemetryRecordBytes) break;     // Wait for the rest
+            TelemetryRecord rec;
+            if (telemetryParse(&pending[i], rec)) {
+                record(rec, out);
+                i += kTelemetryRecordBytes;
+                continue;
+            }
+        }
+        if (c == '\n') {
+            out += text + "\n";
+            text.clear();
+            counters.textLines++;
+        }
+        else if ((c >= ' ' && c < 0x7F) || c == '\t') text += static_cast<char>(c);
+        else if (c != '\r') counters.skippedBytes++;
+        i++;
+    }
+    pending.erase(pending.begin(), pending.begin() + i);
+}
+
+void TelemetryDecoder::finish(std::string &out) {
+    counters.skippedBytes += pending.size();            // A record cut short
+    pending.clear();
+    if (text.empty()) return;
+    out += text + "\n";
+    text.clear();
+    counters.textLines++;
+}
+
+void TelemetryDecoder::record(const TelemetryRecord &rec, std::string &out) {
+    if (started) {
+        counters.lost += static_cast<uint8_t>(rec.seq - nextSeq);
+        if (rec.time_us < lastTime_us && lastTime_us - rec.time_us > 0x80000000u) epoch_us += int64_t(1) << 32;
+    }
+    started = true;
+    nextSeq = static_cast<uint8_t>(rec.seq + 1);
+    lastTime_us = rec.time_us;
+    counters.records++;
+    if (rec.event == TLM_DROPPED) counters.dropped = static_cast<uint32_t>(rec.args[0]);
+    out += format(rec, epoch_us + rec.time_us) + "\n";
+}
+
+// Each conversion is printed on its own with the argument cast to its catalogue type
+std::string TelemetryDecoder::format(const TelemetryRecord &rec, int64_t time_us) {
+    const TelemetryEventInfo &info = kTelemetryEvents[rec.event];
+    char piece[64];
+    snprintf(piece, sizeof(piece), "[%10.3f ms] %s: ", time_us / 1000.0, info.name);
+    std::string line = piece;
+    int arg = 0;
+    for (const char *f = info.format; *f != '\0'; f++) {
+        if (*f != '%') {
+            line += *f;
+            continue;
+        }
+        if (f[1] == '%') {
+            line += *++f;
+            continue;
+        }
+        size_t length = strcspn(f + 1, "diuxXfgec") + 2;   // Up to and with the conversion letter
+        if (length >= sizeof(piece) || arg >= 2 || f[length - 1] == '\0') break;
+        char spec[sizeof(piece)];
+        memcpy(spec, f, length);
+        spec[length] = '\0';
+        int32_t value = rec.args[arg];
+        switch (info.args[arg++]) {
+            case TLM_ARG_FLOAT: snprintf(piece, sizeof(piece), spec, static_cast<double>(tlmToFloat(value))); break;
+            case TLM_ARG_UINT: snprintf(piece, sizeof(piece), spec, static_cast<unsigned>(value)); break;
+            default: snprintf(piece, sizeof(piece), spec, static_cast<int>(value)); break;
+        }
+        line += piece;
+        f += length - 1;
+    }
+    return line;
+}
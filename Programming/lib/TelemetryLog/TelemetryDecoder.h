@@ -0,0 +1,55 @@
+/*
+ * Project: AGV and Scissor Lift Control - Telemetry Log
+ * File: TelemetryDecoder.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Host side of the telemetry stream: splits raw UART bytes into
+ *   TelemetryLog records and the console text around them, and prints
+ *   each record with its event's format from TelemetryEvents.h:
+ *     [   1234.567 ms] obstacle: Obstacle detected! At 25.00 cm, speed 37 %
+ *   Times are unwrapped to 64 bits. Sequence jumps count records lost
+ *   between the board and the host; TLM_DROPPED records count the ones
+ *   the ring itself had no room for.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _TELEMETRY_DECODER_H_
+#define _TELEMETRY_DECODER_H_
+
+#include <TelemetryLog.h>
+#include <string>
+#include <vector>
+
+struct TelemetryDecodeStats {
+    uint32_t records = 0;
+    uint32_t lost = 0;              // Sequence numbers skipped in the stream
+    uint32_t dropped = 0;           // Latest TLM_DROPPED count
+    uint32_t textLines = 0;
+    uint32_t skippedBytes = 0;      // Neither record nor text
+};
+
+class TelemetryDecoder {
+public:
+    // Appends one line per record and per console text line to out
+    void feed(const uint8_t *data, size_t length, std::string &out);
+    void finish(std::string &out);  // End of stream: the unterminated text line, if any
+
+    // One record as text, with its unwrapped time
+    static std::string format(const TelemetryRecord &rec, int64_t time_us);
+    const TelemetryDecodeStats &stats() const { return counters; }
+
+private:
+    void record(const TelemetryRecord &rec, std::string &out);
+
+    std::vector<uint8_t> pending;   // Tail of the last feed, may be the start of a record
+    std::string text;               // Console line being collected
+    bool started = false;
+    uint8_t nextSeq = 0;
+    uint32_t lastTime_us = 0;
+    int64_t epoch_us = 0;           // Added to the 32-bit record times
+    TelemetryDecodeStats counters;
+};
+
+#endif // _TELEMETRY_DECODER_H_
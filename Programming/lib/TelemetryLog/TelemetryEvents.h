@@ -0,0 +1,50 @@
+/*
+ * Project: AGV and Scissor Lift Control - Telemetry Log
+ * File: TelemetryEvents.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Catalogue of the telemetry events of both firmwares. The firmware
+ *   only logs the id and two 32-bit arguments; the name, text and
+ *   argument types live here so the host decoder can print the record
+ *   the way the printf it replaces did. New events go at the end, ids
+ *   already in recorded streams must not move.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _TELEMETRY_EVENTS_H_
+#define _TELEMETRY_EVENTS_H_
+
+#include <cstdint>
+
+enum TelemetryEvent : uint8_t {
+    TLM_DROPPED = 0,        // Logged by the drain task: records lost to a full ring so far
+    TLM_AGV_OBSTACLE,       // Distance (float cm), speed (%)
+    TLM_AGV_CLEAR,          // Distance (float cm)
+    TLM_AGV_CYCLE,          // Distance (float cm), sensor-to-PWM latency (us)
+    TLM_COM_SENT,           // ComMessageType, value
+    TLM_LIFT_HEIGHT,        // Height sensor seen in a step ISR: lift steps from rest
+    TLM_LOAD_SETTLED,       // Weight (float kg), standard deviation (float kg)
+    TLM_EVENT_COUNT,
+};
+
+enum TelemetryArg : uint8_t { TLM_ARG_NONE, TLM_ARG_INT, TLM_ARG_UINT, TLM_ARG_FLOAT };
+
+struct TelemetryEventInfo {
+    const char *name;
+    const char *format;     // printf format, one conversion per used argument
+    TelemetryArg args[2];
+};
+
+constexpr TelemetryEventInfo kTelemetryEvents[TLM_EVENT_COUNT] = {
+    {"dropped", "%u records lost to a full ring", {TLM_ARG_UINT, TLM_ARG_NONE}},
+    {"obstacle", "Obstacle detected! At %.2f cm, speed %d %%", {TLM_ARG_FLOAT, TLM_ARG_INT}},
+    {"clear", "No obstacle nearby! Distance is %.2f cm", {TLM_ARG_FLOAT, TLM_ARG_NONE}},
+    {"cycle", "Control cycle: %.2f cm, sensor-to-PWM %d us", {TLM_ARG_FLOAT, TLM_ARG_INT}},
+    {"com_sent", "Com frame sent: type %u, value %u", {TLM_ARG_UINT, TLM_ARG_UINT}},
+    {"height", "Height sensor reached %u steps from rest", {TLM_ARG_UINT, TLM_ARG_NONE}},
+    {"load_settled", "Load settled at %.3f kg (sd %.3f kg)", {TLM_ARG_FLOAT, TLM_ARG_FLOAT}},
+};
+
+#endif // _TELEMETRY_EVENTS_H_
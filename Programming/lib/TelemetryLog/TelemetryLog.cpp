@@ -0,0 +1,108 @@
+/*
+ * Project: AGV and Scissor Lift Control - Telemetry Log
+ * File: TelemetryLog.cpp
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Stream record codec and the drain side of TelemetryLog.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#include <TelemetryLog.h>
+
+namespace {
+
+void put32(uint8_t *bytes, uint32_t value) {
+    for (int i = 0; i < 4; i++) bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint32_t get32(const uint8_t *bytes) {
+    return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint8_t sum(const uint8_t *bytes, size_t length) {
+    uint8_t total = 0;
+    for (size_t i = 0; i < length; i++) total = static_cast<uint8_t>(total + bytes[i]);
+    return total;
+}
+
+}
+
+// CODEC
+void telemetryEncode(const TelemetryRecord &rec, uint8_t *bytes) {
+    bytes[0] = kTelemetrySync;
+    bytes[1] = rec.event;
+    bytes[2] = rec.seq;
+    put32(bytes + 3, rec.time_us);
+    put32(bytes + 7, static_cast<uint32_t>(rec.args[0]));
+    put32(bytes + 11, static_cast<uint32_t>(rec.args[1]));
+    bytes[15] = static_cast<uint8_t>(-sum(bytes, kTelemetryRecordBytes - 1));
+}
+
+bool telemetryParse(const uint8_t *bytes, TelemetryRecord &rec) {
+    if (bytes[0] != kTelemetrySync || bytes[1] >= TLM_EVENT_COUNT) return false;
+    if (sum(bytes, kTelemetryRecordBytes) != 0) return false;
+    rec.event = bytes[1];
+    rec.seq = bytes[2];
+    rec.time_us = get32(bytes + 3);
+    rec.args[0] = static_cast<int32_t>(get32(bytes + 7));
+    rec.args[1] = static_cast<int32_t>(get32(bytes + 11));
+    return true;
+}
+
+// DRAIN
+bool TelemetryLog::setup(Sink sink, uint32_t drain_ms, UBaseType_t priority, BaseType_t core) {
+    this->sink = sink;
+    drainPeriod_ms = drain_ms;
+    if (drain_ms == 0) return true;
+    return xTaskCreatePinnedToCore(drainTask, "tlm_drain", 2048, this, priority, nullptr, core) == pdPASS;
+}
+
+size_t TelemetryLog::drain() {
+    if (sink == nullptr || draining.exchange(true, std::memory_order_acquire)) return 0;
+    uint8_t batch[kBatchRecords * kTelemetryRecordBytes];
+    int queued = 0;
+    size_t count = 0;
+    auto emit = [&](const TelemetryRecord &rec) {
+        telemetryEncode(rec, batch + queued * kTelemetryRecordBytes);
+        if (++queued == kBatchRecords) {
+            sink(batch, sizeof(batch));
+            queued = 0;
+        }
+        count++;
+    };
+    uint32_t drops = droppedRecords.load(std::memory_order_relaxed);
+    if (drops != reportedDrops.load(std::memory_order_relaxed)) {  // Ahead of the records that made it
+        emit({static_cast<uint32_t>(esp_timer_get_time()), TLM_DROPPED, seq++, {static_cast<int32_t>(drops), 0}});
+        reportedDrops.store(drops, std::memory_order_relaxed);
+    }
+    // One ring's worth at most, so busy producers cannot keep the reader here
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    for (uint32_t n = 0; n < kCapacity; n++) {
+        const Slot &slot = slots[t & (kCapacity - 1)];
+        if (slot.ready.load(std::memory_order_acquire) != t + 1) break;   // Empty, or still being written
+        TelemetryRecord rec = {slot.time_us, slot.event, seq++, {slot.args[0], slot.args[1]}};
+        tail.store(++t, std::memory_order_release);
+        emit(rec);
+    }
+    if (queued > 0) sink(batch, queued * kTelemetryRecordBytes);
+    sentRecords += count;
+    draining.store(false, std::memory_order_release);
+    return count;
+}
+
+void TelemetryLog::flush() {
+    if (sink == nullptr) return;
+    while (pending() > 0 || dropped() != reportedDrops.load(std::memory_order_relaxed)) {
+        if (drain() == 0) vTaskDelay(1);                // Drain task busy, or a writer not done yet
+    }
+}
+
+void TelemetryLog::drainTask(void *arg) {
+    TelemetryLog *self = static_cast<TelemetryLog *>(arg);
+    while (true) {
+        self->drain();
+        vTaskDelay(pdMS_TO_TICKS(self->drainPeriod_ms));
+    }
+}
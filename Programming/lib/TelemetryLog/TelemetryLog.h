@@ -0,0 +1,129 @@
+/*
+ * Project: AGV and Scissor Lift Control - Telemetry Log
+ * File: TelemetryLog.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Binary event log for the control loops and ISRs, replacing printf on
+ *   the hot paths.
+ *     - log() stores a timestamp, an event id (TelemetryEvents.h) and two
+ *       32-bit arguments in a fixed RAM ring: one compare-and-swap to
+ *       claim a slot, four stores and a release. No formatting, no
+ *       locks, no allocation, never blocks; a full ring drops the record
+ *       and counts it
+ *     - Any number of tasks and ISRs on both cores may log; a slot is
+ *       handed to the reader only once its writer marks it ready
+ *     - A low-priority task drains the ring every period into 16-byte
+ *       stream records (sync, event, sequence, time, arguments,
+ *       checksum) and passes them to a sink, normally a UART
+ *     - TelemetryDecoder turns the stream back into text on the host,
+ *       skipping any console text mixed in, and counts lost records
+ *   Floats are logged by their bit pattern (tlmFloat()). Records from an
+ *   ISR that preempts a task half way through log() can come out a few
+ *   microseconds out of time order.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _TELEMETRY_LOG_H_
+#define _TELEMETRY_LOG_H_
+
+#include <TelemetryEvents.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+constexpr uint8_t kTelemetrySync = 0xA5;        // Never in console text, which is ASCII
+constexpr size_t kTelemetryRecordBytes = 16;
+
+struct TelemetryRecord {
+    uint32_t time_us;           // esp_timer time, wraps after 71 minutes
+    uint8_t event;              // TelemetryEvent
+    uint8_t seq;                // Stream position, a jump means records lost on the way
+    int32_t args[2];
+};
+
+// CODEC
+// Stream record: sync, event, seq, time, arg 0, arg 1 (little endian), then a byte making the sum 0
+void telemetryEncode(const TelemetryRecord &rec, uint8_t *bytes);
+bool telemetryParse(const uint8_t *bytes, TelemetryRecord &rec);   // false: no sync, bad sum or unknown event
+
+inline int32_t tlmFloat(float value) {
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float tlmToFloat(int32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class TelemetryLog {
+public:
+    static constexpr uint32_t kCapacity = 256;              // Records, a power of two
+    static constexpr uint32_t kDefaultDrain_ms = 20;
+    static constexpr UBaseType_t kDefaultPriority = 1;
+    static constexpr int kBatchRecords = 16;                // Records per sink call
+    using Sink = void (*)(const uint8_t *data, size_t length);
+
+    // Starts the drain task; with drain_ms 0 there is none and the owner calls drain()
+    bool setup(Sink sink, uint32_t drain_ms = kDefaultDrain_ms, UBaseType_t priority = kDefaultPriority,
+               BaseType_t core = tskNO_AFFINITY);
+
+    // Any task or ISR, false when the ring is full
+    bool IRAM_ATTR log(TelemetryEvent event, int32_t arg0 = 0, int32_t arg1 = 0) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        do {
+            if (h - tail.load(std::memory_order_acquire) >= kCapacity) {
+                droppedRecords.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!head.compare_exchange_weak(h, h + 1, std::memory_order_relaxed));
+        Slot &slot = slots[h & (kCapacity - 1)];
+        slot.time_us = static_cast<uint32_t>(esp_timer_get_time());
+        slot.event = event;
+        slot.args[0] = arg0;
+        slot.args[1] = arg1;
+        slot.ready.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t drain();             // Sends the ready records, returns how many (the drain task calls this)
+    void flush();               // Waits until everything logged so far is sent, e.g. before exit()
+
+    uint32_t pending() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    uint32_t dropped() const { return droppedRecords.load(std::memory_order_relaxed); }
+    uint32_t sent() const { return sentRecords; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> ready{0};     // Claim index + 1 once written
+        uint32_t time_us = 0;
+        uint8_t event = 0;
+        int32_t args[2] = {};
+    };
+
+    static void drainTask(void *arg);
+
+    Slot slots[kCapacity];
+    std::atomic<uint32_t> head{0};          // Next slot to claim, free-running
+    std::atomic<uint32_t> tail{0};          // Next slot to send, free-running
+    std::atomic<uint32_t> droppedRecords{0};
+    std::atomic<bool> draining{false};      // One reader at a time: the task or flush()
+    std::atomic<uint32_t> reportedDrops{0};   // Drop count last sent as TLM_DROPPED
+
+    // Reader side only
+    Sink sink = nullptr;
+    uint32_t drainPeriod_ms = kDefaultDrain_ms;
+    uint32_t sentRecords = 0;
+    uint8_t seq = 0;
+};
+
+#endif // _TELEMETRY_LOG_H_
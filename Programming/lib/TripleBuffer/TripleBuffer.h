@@ -0,0 +1,54 @@
+/*
+ * Project: AGV and Scissor Lift Control - Lock-free Latest Value Buffer
+ * File: TripleBuffer.h
+ * Author: Oscar Gadiel Ramo Martínez
+ * Description:
+ *   Single producer / single consumer triple buffer. The producer always
+ *   has a free slot to write and the consumer always gets the newest
+ *   complete value, so neither side ever waits or takes a mutex (the
+ *   "double buffer" handoff between the two ESP32 cores, plus the spare
+ *   slot that makes it wait-free). Older values are overwritten, never queued.
+ *
+ * Date: October 2026
+ * License: MIT (see LICENSE file in repository)
+ */
+
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side: copy in a new value and make it the newest
+    void publish(const T &value) {
+        slots[back] = value;
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back | kFresh), std::memory_order_acq_rel);
+        back = previous & kIndex;
+    }
+
+    // Consumer side: true and the newest value if something was published since the last read
+    bool read(T &out) {
+        if ((middle.load(std::memory_order_relaxed) & kFresh) == 0) return false;
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & kIndex;
+        out = slots[front];
+        return true;
+    }
+
+    // Consumer side: the last value read (default constructed before the first read)
+    const T &current() const { return slots[front]; }
+
+private:
+    static constexpr uint8_t kIndex = 0x03;
+    static constexpr uint8_t kFresh = 0x04;
+
+    T slots[3] = {};
+    std::atomic<uint8_t> middle{1};     // Slot index in between, plus the fresh flag
+    uint8_t back = 0;                   // Owned by the producer
+    uint8_t front = 2;                  // Owned by the consumer
+};
+
+#endif // _TRIPLE_BUFFER_H_